@@ -0,0 +1,131 @@
+/***********************************************************************************************//**
+ * \file bench_capture.c
+ *
+ * \brief
+ * Host benchmark of the capture writer and reader: writing frames of 128 samples x 32 chirps x
+ * 3 RX antennas to a file through stdio, random access to the frames of the mapped capture and
+ * lookup by sequence number. Prints one JSON object per line and operation.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2022 Infineon Technologies AG
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#include "test_common.h"
+
+#include "xensiv_bgt60trxx_capture_posix.h"
+
+#define CAPTURE_FILE        "bench_capture.bin"
+
+#define NUM_FRAMES          (500U)
+#define NUM_SAMPLES         (128U * 32U * 3U)
+#define NUM_LOOKUPS         (1000000U)
+
+static const xensiv_bgt60trxx_frame_geometry_t geometry = { 128U, 32U, 3U };
+static xensiv_bgt60trxx_capture_index_t capture_index[NUM_FRAMES];
+static uint16_t samples[NUM_SAMPLES];
+
+
+static void bench_write(void)
+{
+    xensiv_bgt60trxx_capture_writer_t writer;
+    int32_t status = XENSIV_BGT60TRXX_STATUS_COM_ERROR;
+    FILE* f = fopen(CAPTURE_FILE, "wb");
+
+    for (uint32_t k = 0U; k < NUM_SAMPLES; ++k)
+    {
+        samples[k] = (uint16_t)(k & 0xFFFU);
+    }
+
+    double t0 = test_now_ns();
+    if (f != NULL)
+    {
+        status = xensiv_bgt60trxx_capture_writer_init(&writer, xensiv_bgt60trxx_capture_fwrite, f,
+                                                      XENSIV_DEVICE_BGT60TR13C, &geometry,
+                                                      test_register_list,
+                                                      (uint32_t)TEST_NUM_REGS, capture_index,
+                                                      NUM_FRAMES);
+        for (uint32_t i = 0U; i < NUM_FRAMES; ++i)
+        {
+            status |= xensiv_bgt60trxx_capture_write_frame(&writer, samples, NULL);
+        }
+        status |= xensiv_bgt60trxx_capture_writer_close(&writer);
+        status |= (fclose(f) == 0) ? XENSIV_BGT60TRXX_STATUS_OK :
+                  XENSIV_BGT60TRXX_STATUS_COM_ERROR;
+    }
+    double t1 = test_now_ns();
+
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK == status);
+    double bytes = (double)NUM_FRAMES * (double)NUM_SAMPLES * (double)sizeof(uint16_t);
+    (void)printf("{\"op\":\"capture_write\",\"calls\":%u,\"ns_per_call\":%.1f,"
+                 "\"mb_per_s\":%.1f}\n", NUM_FRAMES, (t1 - t0) / (double)NUM_FRAMES,
+                 (bytes * 1e3) / (t1 - t0));
+}
+
+
+static void bench_read(void)
+{
+    xensiv_bgt60trxx_capture_file_t file;
+    uint32_t sum = 0U;
+    uint32_t found = 0U;
+
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK ==
+               xensiv_bgt60trxx_capture_file_open(&file, CAPTURE_FILE));
+    if (NUM_FRAMES != file.reader.num_frames)
+    {
+        TEST_CHECK(NUM_FRAMES == file.reader.num_frames);
+        return;
+    }
+
+    /* frames in a pseudo-random order */
+    double t0 = test_now_ns();
+    for (uint32_t i = 0U; i < NUM_LOOKUPS; ++i)
+    {
+        uint32_t idx = (i * 2654435761U) % NUM_FRAMES;
+        const xensiv_bgt60trxx_capture_frame_t* frame =
+            xensiv_bgt60trxx_capture_get_frame(&file.reader, idx);
+        sum += xensiv_bgt60trxx_capture_get_samples(frame)[i % NUM_SAMPLES];
+    }
+    double t1 = test_now_ns();
+    (void)printf("{\"op\":\"capture_get_frame\",\"calls\":%u,\"ns_per_call\":%.1f}\n",
+                 NUM_LOOKUPS, (t1 - t0) / (double)NUM_LOOKUPS);
+
+    t0 = test_now_ns();
+    for (uint32_t i = 0U; i < NUM_LOOKUPS; ++i)
+    {
+        found += (xensiv_bgt60trxx_capture_find(&file.reader, i % NUM_FRAMES) < NUM_FRAMES) ?
+                 1U : 0U;
+    }
+    t1 = test_now_ns();
+    (void)printf("{\"op\":\"capture_find\",\"calls\":%u,\"ns_per_call\":%.1f}\n",
+                 NUM_LOOKUPS, (t1 - t0) / (double)NUM_LOOKUPS);
+
+    /* frames written without metadata are numbered in order */
+    TEST_CHECK(NUM_LOOKUPS == found);
+    TEST_CHECK(sum > 0U);
+    xensiv_bgt60trxx_capture_file_close(&file);
+}
+
+
+int main(void)
+{
+    bench_write();
+    bench_read();
+
+    (void)remove(CAPTURE_FILE);
+
+    return test_failures;
+}
@@ -0,0 +1,95 @@
+/***********************************************************************************************//**
+ * \file bench_cfar.c
+ *
+ * \brief
+ * Host benchmark of the CFAR detection of the XENSIV(TM) BGT60TRxx 60GHz FMCW radar sensors
+ * library. Prints one JSON object per line with the time per 256x128 dB map for both CFAR types
+ * and training sizes from 4 to 32 cells per side.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2022 Infineon Technologies AG
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#include "test_common.h"
+
+#include <math.h>
+
+#include "xensiv_bgt60trxx_cfar.h"
+
+#define NUM_RANGE_BINS      (256U)
+#define NUM_DOPPLER_BINS    (128U)
+#define MAX_TRAIN           (32U)
+#define MAX_DETECTIONS      (1024U)
+
+static float map[NUM_RANGE_BINS * NUM_DOPPLER_BINS];
+static float workspace[XENSIV_BGT60TRXX_CFAR_WORKSPACE_LEN(NUM_RANGE_BINS, MAX_TRAIN)];
+static xensiv_bgt60trxx_cfar_detection_t detections[MAX_DETECTIONS];
+
+
+static void bench_cfar(xensiv_bgt60trxx_cfar_type_t type, uint16_t num_train, uint32_t calls)
+{
+    const xensiv_bgt60trxx_cfar_config_t config =
+    {
+        .type = type,
+        .num_train_range = num_train,
+        .num_guard_range = 2U,
+        .num_train_doppler = (uint16_t)(num_train / 2U),
+        .num_guard_doppler = 1U,
+        .os_rank = num_train,
+        .threshold = 10.0f,
+        .log_scale = true,
+        .peaks_only = true
+    };
+    uint32_t num_detections = 0U;
+
+    double t0 = test_now_ns();
+    for (uint32_t i = 0U; i < calls; ++i)
+    {
+        num_detections += xensiv_bgt60trxx_cfar_detect(&config, map, NUM_RANGE_BINS,
+                                                       NUM_DOPPLER_BINS, workspace, detections,
+                                                       MAX_DETECTIONS);
+    }
+    double t1 = test_now_ns();
+
+    double ns = (t1 - t0) / (double)calls;
+    (void)printf("{\"op\":\"cfar_%s\",\"num_train\":%u,\"calls\":%" PRIu32 ",\"ns_per_call\":%.1f,"
+                 "\"ns_per_cell\":%.2f,\"detections\":%" PRIu32 "}\n",
+                 (XENSIV_BGT60TRXX_CFAR_CA == type) ? "ca" : "os", (unsigned)num_train, calls, ns,
+                 ns / (double)(NUM_RANGE_BINS * NUM_DOPPLER_BINS), num_detections / calls);
+}
+
+
+int main(void)
+{
+    uint32_t seed = 1U;
+
+    /* exponentially distributed noise power in dB */
+    for (uint32_t i = 0U; i < (NUM_RANGE_BINS * NUM_DOPPLER_BINS); ++i)
+    {
+        seed = (seed * 1103515245U) + 12345U;
+        double u = ((double)((seed >> 8) & 0xFFFFFFU) + 1.0) / 16777216.0;
+        map[i] = (float)(10.0 * log10(-log(u)));
+    }
+
+    for (uint16_t num_train = 4U; num_train <= MAX_TRAIN; num_train *= 2U)
+    {
+        bench_cfar(XENSIV_BGT60TRXX_CFAR_CA, num_train, 50U);
+        bench_cfar(XENSIV_BGT60TRXX_CFAR_OS, num_train, 10U);
+    }
+
+    return test_failures;
+}
@@ -0,0 +1,113 @@
+/***********************************************************************************************//**
+ * \file bench_codec.c
+ *
+ * \brief
+ * Host benchmark of the frame codec on frames of 128 samples x 32 chirps x 3 RX antennas of the
+ * simulated sensor, the LFSR test sequence and a beat signal. Prints one JSON object per line
+ * and coding with the compression ratio and the encoding and decoding throughput.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2022 Infineon Technologies AG
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#include "test_common.h"
+
+#include "xensiv_bgt60trxx_codec.h"
+#include "xensiv_bgt60trxx_sim.h"
+
+#define NUM_SAMPLES         (128U * 32U * 3U)
+#define NUM_CALLS           (1000U)
+
+static const xensiv_bgt60trxx_frame_geometry_t geometry = { 128U, 32U, 3U };
+static xensiv_bgt60trxx_sim_t sim;
+static uint16_t frame[NUM_SAMPLES];
+static uint16_t decoded[NUM_SAMPLES];
+static uint8_t encoded[XENSIV_BGT60TRXX_CODEC_HEADER_SIZE + ((NUM_SAMPLES * 3U) / 2U)];
+
+
+/* Reads one frame of the simulated sensor */
+static void sim_frame(xensiv_bgt60trxx_sim_data_t data)
+{
+    const xensiv_bgt60trxx_sim_config_t sim_cfg =
+    {
+        .device = XENSIV_DEVICE_BGT60TR13C,
+        .data = data,
+        .sample_rate_hz = 2000000U,
+        .num_samples_per_chirp = 128U,
+        .num_chirps_per_frame = 32U,
+        .num_rx_antennas = 3U,
+        .frame_period_us = 20000U,
+        .beat_freq_hz = 150000U,
+        .reset_polls = 1U
+    };
+    xensiv_bgt60trxx_t dev;
+
+    xensiv_bgt60trxx_sim_init(&sim, &sim_cfg);
+    int32_t status = xensiv_bgt60trxx_init(&dev, &sim, false);
+    status |= xensiv_bgt60trxx_start_frame(&dev, true);
+    while (sim.fifo_fill < NUM_SAMPLES)
+    {
+        xensiv_bgt60trxx_sim_advance(100U);
+        (void)xensiv_bgt60trxx_sim_irq(&sim);
+    }
+    status |= xensiv_bgt60trxx_get_fifo_data(&dev, frame, NUM_SAMPLES);
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK == status);
+}
+
+
+static void bench_codec(const char* data, xensiv_bgt60trxx_codec_mode_t mode)
+{
+    uint32_t len = 0U;
+    int32_t status = XENSIV_BGT60TRXX_STATUS_OK;
+
+    double t0 = test_now_ns();
+    for (uint32_t i = 0U; i < NUM_CALLS; ++i)
+    {
+        len = xensiv_bgt60trxx_codec_encode(&geometry, mode, frame, encoded);
+    }
+    double t1 = test_now_ns();
+    for (uint32_t i = 0U; i < NUM_CALLS; ++i)
+    {
+        status |= xensiv_bgt60trxx_codec_decode(&geometry, encoded, len, decoded);
+    }
+    double t2 = test_now_ns();
+
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK == status);
+    TEST_CHECK(frame[NUM_SAMPLES - 1U] == decoded[NUM_SAMPLES - 1U]);
+
+    /* bytes per nanosecond are GB/s */
+    double bytes = (double)NUM_CALLS * (double)NUM_SAMPLES * (double)sizeof(uint16_t);
+    (void)printf("{\"op\":\"codec_%s\",\"data\":\"%s\",\"calls\":%u,\"ratio\":%.2f,"
+                 "\"encode_gb_per_s\":%.2f,\"decode_gb_per_s\":%.2f}\n",
+                 (XENSIV_BGT60TRXX_CODEC_PACK12 == mode) ? "pack12" : "delta", data, NUM_CALLS,
+                 (double)(NUM_SAMPLES * sizeof(uint16_t)) / (double)len, bytes / (t1 - t0),
+                 bytes / (t2 - t1));
+}
+
+
+int main(void)
+{
+    sim_frame(XENSIV_BGT60TRXX_SIM_DATA_LFSR);
+    bench_codec("lfsr", XENSIV_BGT60TRXX_CODEC_PACK12);
+    bench_codec("lfsr", XENSIV_BGT60TRXX_CODEC_DELTA);
+
+    sim_frame(XENSIV_BGT60TRXX_SIM_DATA_BEAT);
+    bench_codec("beat", XENSIV_BGT60TRXX_CODEC_PACK12);
+    bench_codec("beat", XENSIV_BGT60TRXX_CODEC_DELTA);
+
+    return test_failures;
+}
@@ -0,0 +1,205 @@
+/***********************************************************************************************//**
+ * \file bench_driver.c
+ *
+ * \brief
+ * Host benchmark of the driver calls of the XENSIV(TM) BGT60TRxx 60GHz FMCW radar sensors library
+ * against the simulated sensor. Prints one JSON object per line and operation with the time, the
+ * bus bytes, the SPI transfers and the CS assertions per call. The bus figures are deterministic
+ * and can be compared exactly between driver releases, the times only on the same host.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2022 Infineon Technologies AG
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#include "test_common.h"
+
+#include "xensiv_bgt60trxx_sim.h"
+
+#define BENCH_MAX_FIFO_SAMPLES          (8192U)
+
+static xensiv_bgt60trxx_sim_t sim;
+static xensiv_bgt60trxx_t dev;
+static uint16_t samples[BENCH_MAX_FIFO_SAMPLES];
+
+static const xensiv_bgt60trxx_sim_config_t sim_cfg =
+{
+    .device = XENSIV_DEVICE_BGT60TR13C,
+    .data = XENSIV_BGT60TRXX_SIM_DATA_LFSR,
+    .sample_rate_hz = 2000000U,
+    .num_samples_per_chirp = 128U,
+    .num_chirps_per_frame = 32U,
+    .num_rx_antennas = 3U,
+    .frame_period_us = 20000U,
+    .reset_polls = 1U
+};
+
+
+/* Prints the cost per call of an operation since the bus counters were saved in *start */
+static void bench_report(const char* op, uint32_t calls, double ns,
+                         const xensiv_bgt60trxx_sim_stats_t* start)
+{
+    (void)printf("{\"op\":\"%s\",\"calls\":%" PRIu32 ",\"ns_per_call\":%.1f,"
+                 "\"bus_bytes_per_call\":%.1f,\"transfers_per_call\":%.2f,"
+                 "\"cs_per_call\":%.2f}\n",
+                 op, calls, ns / (double)calls,
+                 (double)(sim.stats.bytes - start->bytes) / (double)calls,
+                 (double)(sim.stats.transfers - start->transfers) / (double)calls,
+                 (double)(sim.stats.cs_assertions - start->cs_assertions) / (double)calls);
+}
+
+
+static void bench_set_reg(uint32_t calls)
+{
+    xensiv_bgt60trxx_sim_stats_t start = sim.stats;
+    int32_t status = XENSIV_BGT60TRXX_STATUS_OK;
+
+    double t0 = test_now_ns();
+    for (uint32_t i = 0U; i < calls; ++i)
+    {
+        status |= xensiv_bgt60trxx_set_reg(&dev, XENSIV_BGT60TRXX_REG_ADC0, i & 0xFFU);
+    }
+    double t1 = test_now_ns();
+
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK == status);
+    bench_report("set_reg", calls, t1 - t0, &start);
+}
+
+
+static void bench_get_reg(uint32_t calls)
+{
+    xensiv_bgt60trxx_sim_stats_t start = sim.stats;
+    int32_t status = XENSIV_BGT60TRXX_STATUS_OK;
+    uint32_t data;
+
+    double t0 = test_now_ns();
+    for (uint32_t i = 0U; i < calls; ++i)
+    {
+        status |= xensiv_bgt60trxx_get_reg(&dev, XENSIV_BGT60TRXX_REG_ADC0, &data);
+    }
+    double t1 = test_now_ns();
+
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK == status);
+    bench_report("get_reg", calls, t1 - t0, &start);
+}
+
+
+static void bench_config(uint32_t calls)
+{
+    xensiv_bgt60trxx_sim_stats_t start = sim.stats;
+    int32_t status = XENSIV_BGT60TRXX_STATUS_OK;
+
+    double t0 = test_now_ns();
+    for (uint32_t i = 0U; i < calls; ++i)
+    {
+        status |= xensiv_bgt60trxx_config(&dev, test_register_list, (uint32_t)TEST_NUM_REGS);
+    }
+    double t1 = test_now_ns();
+
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK == status);
+    bench_report("config", calls, t1 - t0, &start);
+}
+
+
+static void bench_soft_reset(uint32_t calls)
+{
+    xensiv_bgt60trxx_sim_stats_t start = sim.stats;
+    int32_t status = XENSIV_BGT60TRXX_STATUS_OK;
+
+    double t0 = test_now_ns();
+    for (uint32_t i = 0U; i < calls; ++i)
+    {
+        status |= xensiv_bgt60trxx_soft_reset(&dev, XENSIV_BGT60TRXX_RESET_FIFO);
+    }
+    double t1 = test_now_ns();
+
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK == status);
+    bench_report("soft_reset_fifo", calls, t1 - t0, &start);
+}
+
+
+/* Times the FIFO reads only, the FIFO is filled by the simulator before each read */
+static void bench_get_fifo_data(uint32_t num_samples, uint32_t calls)
+{
+    char op[32];
+    xensiv_bgt60trxx_sim_stats_t start;
+    int32_t status = xensiv_bgt60trxx_soft_reset(&dev, XENSIV_BGT60TRXX_RESET_FIFO);
+    uint16_t word = XENSIV_BGT60TRXX_INITIAL_TEST_WORD;
+    uint32_t errors = 0U;
+    double ns = 0.0;
+
+    sim.lfsr = XENSIV_BGT60TRXX_INITIAL_TEST_WORD;
+    status |= xensiv_bgt60trxx_start_frame(&dev, true);
+    start = sim.stats;
+
+    for (uint32_t i = 0U; i < calls; ++i)
+    {
+        while (sim.fifo_fill < num_samples)
+        {
+            xensiv_bgt60trxx_sim_advance(100U);
+            (void)xensiv_bgt60trxx_sim_irq(&sim);
+        }
+
+        double t0 = test_now_ns();
+        status |= xensiv_bgt60trxx_get_fifo_data(&dev, samples, num_samples);
+        ns += test_now_ns() - t0;
+
+        errors += test_check_lfsr(samples, num_samples, &word);
+    }
+
+    (void)snprintf(op, sizeof(op), "get_fifo_data_%" PRIu32, num_samples);
+    bench_report(op, calls, ns, &start);
+
+    status |= xensiv_bgt60trxx_start_frame(&dev, false);
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK == status);
+    TEST_CHECK(0U == errors);
+}
+
+
+static void bench_get_next_test_word(uint32_t calls)
+{
+    xensiv_bgt60trxx_sim_stats_t start = sim.stats;
+    uint16_t word = XENSIV_BGT60TRXX_INITIAL_TEST_WORD;
+
+    double t0 = test_now_ns();
+    for (uint32_t i = 0U; i < calls; ++i)
+    {
+        word = xensiv_bgt60trxx_get_next_test_word(word);
+    }
+    double t1 = test_now_ns();
+
+    /* the sequence repeats after 4095 words, keeps the loop from being optimized out */
+    TEST_CHECK(word != 0U);
+    bench_report("get_next_test_word", calls, t1 - t0, &start);
+}
+
+
+int main(void)
+{
+    xensiv_bgt60trxx_sim_init(&sim, &sim_cfg);
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK == xensiv_bgt60trxx_init(&dev, &sim, false));
+
+    bench_set_reg(200000U);
+    bench_get_reg(200000U);
+    bench_config(20000U);
+    bench_soft_reset(50000U);
+    bench_get_fifo_data(64U, 2000U);
+    bench_get_fifo_data(1024U, 2000U);
+    bench_get_fifo_data(8192U, 500U);
+    bench_get_next_test_word(10000000U);
+
+    return test_failures;
+}
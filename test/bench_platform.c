@@ -0,0 +1,209 @@
+/***********************************************************************************************//**
+ * \file bench_platform.c
+ *
+ * \brief
+ * Host benchmark of the register accesses of the XENSIV(TM) BGT60TRxx 60GHz FMCW radar sensors
+ * library with the platform functions called, and inlined through
+ * XENSIV_BGT60TRXX_PLATFORM_INLINE (bench_platform_inline build, see bench_platform_inline.h).
+ * The sensor is a register file answering each SPI transfer without bus timing, so that the time
+ * per call is the driver and platform overhead only. Prints one JSON object per line and
+ * operation with the time and the CS assertions per call.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2022 Infineon Technologies AG
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#include "test_common.h"
+
+#include <assert.h>
+#include <string.h>
+
+#include "xensiv_bgt60trxx_platform.h"
+
+#if defined(XENSIV_BGT60TRXX_PLATFORM_INLINE)
+#define BENCH_PLATFORM                  "inline"
+#else
+#define BENCH_PLATFORM                  "call"
+#endif
+
+#define BENCH_NUM_REGS                  (128U)
+#define BENCH_CHIP_ID_BGT60TR13C        (0x000303UL)
+
+/* Register file of the sensor, addressed by the first byte of each 4-byte command */
+static uint32_t bench_regs[BENCH_NUM_REGS];
+static xensiv_bgt60trxx_t dev;
+
+uint32_t bench_cs_assertions = 0U;
+
+
+/*******************************************************************************
+ * Platform functions implementation
+ ********************************************************************************/
+int32_t xensiv_bgt60trxx_platform_spi_transfer(void* iface,
+                                               uint8_t* tx_data,
+                                               uint8_t* rx_data,
+                                               uint32_t len)
+{
+    (void)iface;
+
+    if ((4U == len) && (tx_data != NULL))
+    {
+        uint32_t addr = (uint32_t)tx_data[0] >> 1;
+        uint32_t data = ((uint32_t)tx_data[1] << 16) | ((uint32_t)tx_data[2] << 8) | tx_data[3];
+
+        if ((tx_data[0] & 1U) != 0U)
+        {
+            bench_regs[addr] = data;
+        }
+        data = bench_regs[addr];
+
+        if (rx_data != NULL)
+        {
+            rx_data[0] = 0U;
+            rx_data[1] = (uint8_t)(data >> 16);
+            rx_data[2] = (uint8_t)(data >> 8);
+            rx_data[3] = (uint8_t)data;
+        }
+    }
+    else if (rx_data != NULL)
+    {
+        (void)memset(rx_data, 0, len);
+    }
+
+    return XENSIV_BGT60TRXX_STATUS_OK;
+}
+
+
+int32_t xensiv_bgt60trxx_platform_spi_fifo_read(void* iface,
+                                                uint16_t* rx_data,
+                                                uint32_t len)
+{
+    (void)iface;
+    (void)memset(rx_data, 0, len * sizeof(uint16_t));
+
+    return XENSIV_BGT60TRXX_STATUS_OK;
+}
+
+
+void xensiv_bgt60trxx_platform_rst_set(const void* iface, bool val)
+{
+    (void)iface;
+    (void)val;
+}
+
+
+void xensiv_bgt60trxx_platform_delay(uint32_t ms)
+{
+    (void)ms;
+}
+
+
+#if !defined(XENSIV_BGT60TRXX_PLATFORM_INLINE)
+void xensiv_bgt60trxx_platform_spi_cs_set(const void* iface, bool val)
+{
+    (void)iface;
+
+    if (!val)
+    {
+        ++bench_cs_assertions;
+    }
+}
+
+
+uint32_t xensiv_bgt60trxx_platform_word_reverse(uint32_t x)
+{
+    return (((x & 0x000000ffUL) << 24) |
+            ((x & 0x0000ff00UL) <<  8) |
+            ((x & 0x00ff0000UL) >>  8) |
+            ((x & 0xff000000UL) >> 24));
+}
+
+
+void xensiv_bgt60trxx_platform_assert(bool expr)
+{
+    assert(expr);
+    (void)expr; /* make release build */
+}
+
+
+#endif // !defined(XENSIV_BGT60TRXX_PLATFORM_INLINE)
+
+
+/* Prints the cost per call of an operation since the CS assertions were cs */
+static void bench_report(const char* op, uint32_t calls, double ns, uint32_t cs)
+{
+    (void)printf("{\"op\":\"%s\",\"platform\":\"%s\",\"calls\":%" PRIu32
+                 ",\"ns_per_call\":%.1f,\"cs_per_call\":%.2f}\n",
+                 op, BENCH_PLATFORM, calls, ns / (double)calls,
+                 (double)(bench_cs_assertions - cs) / (double)calls);
+}
+
+
+static void bench_set_reg(uint32_t calls)
+{
+    uint32_t cs = bench_cs_assertions;
+    int32_t status = XENSIV_BGT60TRXX_STATUS_OK;
+
+    double t0 = test_now_ns();
+    for (uint32_t i = 0U; i < calls; ++i)
+    {
+        status |= xensiv_bgt60trxx_set_reg(&dev, XENSIV_BGT60TRXX_REG_ADC0, i & 0xFFU);
+    }
+    double t1 = test_now_ns();
+
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK == status);
+    TEST_CHECK(((calls - 1U) & 0xFFU) == bench_regs[XENSIV_BGT60TRXX_REG_ADC0]);
+    TEST_CHECK(calls == (bench_cs_assertions - cs));
+    bench_report("set_reg", calls, t1 - t0, cs);
+}
+
+
+static void bench_get_reg(uint32_t calls)
+{
+    uint32_t cs = bench_cs_assertions;
+    int32_t status = XENSIV_BGT60TRXX_STATUS_OK;
+    uint32_t errors = 0U;
+    uint32_t data;
+
+    bench_regs[XENSIV_BGT60TRXX_REG_ADC0] = 0x123456UL;
+
+    double t0 = test_now_ns();
+    for (uint32_t i = 0U; i < calls; ++i)
+    {
+        status |= xensiv_bgt60trxx_get_reg(&dev, XENSIV_BGT60TRXX_REG_ADC0, &data);
+        errors += (0x123456UL == data) ? 0U : 1U;
+    }
+    double t1 = test_now_ns();
+
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK == status);
+    TEST_CHECK(0U == errors);
+    TEST_CHECK(calls == (bench_cs_assertions - cs));
+    bench_report("get_reg", calls, t1 - t0, cs);
+}
+
+
+int main(void)
+{
+    bench_regs[XENSIV_BGT60TRXX_REG_CHIP_ID] = BENCH_CHIP_ID_BGT60TR13C;
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK == xensiv_bgt60trxx_init(&dev, bench_regs, false));
+    TEST_CHECK(XENSIV_DEVICE_BGT60TR13C == xensiv_bgt60trxx_get_device(&dev));
+
+    bench_set_reg(2000000U);
+    bench_get_reg(2000000U);
+
+    return test_failures;
+}
@@ -0,0 +1,64 @@
+/***********************************************************************************************//**
+ * \file bench_platform_inline.h
+ *
+ * \brief
+ * Inline platform functions of the register access benchmark, named in
+ * XENSIV_BGT60TRXX_PLATFORM_INLINE by the bench_platform_inline build of bench_platform.c.
+ * They do the same as the functions bench_platform.c defines for the build with calls.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2022 Infineon Technologies AG
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#ifndef BENCH_PLATFORM_INLINE_H_
+#define BENCH_PLATFORM_INLINE_H_
+
+#include <assert.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/* CS assertions of the benchmark platform, defined in bench_platform.c */
+extern uint32_t bench_cs_assertions;
+
+static inline void xensiv_bgt60trxx_platform_spi_cs_set(const void* iface, bool val)
+{
+    (void)iface;
+
+    if (!val)
+    {
+        ++bench_cs_assertions;
+    }
+}
+
+
+static inline uint32_t xensiv_bgt60trxx_platform_word_reverse(uint32_t x)
+{
+    return (((x & 0x000000ffUL) << 24) |
+            ((x & 0x0000ff00UL) <<  8) |
+            ((x & 0x00ff0000UL) >>  8) |
+            ((x & 0xff000000UL) >> 24));
+}
+
+
+static inline void xensiv_bgt60trxx_platform_assert(bool expr)
+{
+    assert(expr);
+    (void)expr; /* make release build */
+}
+
+
+#endif // ifndef BENCH_PLATFORM_INLINE_H_
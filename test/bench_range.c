@@ -0,0 +1,96 @@
+/***********************************************************************************************//**
+ * \file bench_range.c
+ *
+ * \brief
+ * Host benchmark of the range FFT stage of the XENSIV(TM) BGT60TRxx 60GHz FMCW radar sensors
+ * library. Prints one JSON object per line with the time per chirp of the float and fixed point
+ * implementations, Hann window and no zero padding. Build with XENSIV_BGT60TRXX_FFT_PORTABLE or
+ * with -mavx to compare the float implementations.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2022 Infineon Technologies AG
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#include "test_common.h"
+
+#include <math.h>
+
+#include "xensiv_bgt60trxx_range.h"
+
+#define MAX_SAMPLES         (512U)
+
+static float table_f32[XENSIV_BGT60TRXX_RANGE_TABLE_LEN(MAX_SAMPLES, MAX_SAMPLES)];
+static int16_t table_q15[XENSIV_BGT60TRXX_RANGE_TABLE_LEN(MAX_SAMPLES, MAX_SAMPLES)];
+static float in_f32[MAX_SAMPLES];
+static int16_t in_q15[MAX_SAMPLES];
+static float out_f32[MAX_SAMPLES];
+static int16_t out_q15[MAX_SAMPLES];
+
+
+static void bench_report(const char* op, uint32_t num_samples, uint32_t calls, double ns)
+{
+    (void)printf("{\"op\":\"%s\",\"num_samples\":%" PRIu32 ",\"calls\":%" PRIu32
+                 ",\"ns_per_call\":%.1f}\n", op, num_samples, calls, ns / (double)calls);
+}
+
+
+static void bench_chirp(uint32_t num_samples, uint32_t calls)
+{
+    xensiv_bgt60trxx_range_t range_f32;
+    xensiv_bgt60trxx_range_t range_q15;
+
+    xensiv_bgt60trxx_range_init_f32(&range_f32, num_samples, num_samples,
+                                    XENSIV_BGT60TRXX_WINDOW_HANN, table_f32);
+    xensiv_bgt60trxx_range_init_q15(&range_q15, num_samples, num_samples,
+                                    XENSIV_BGT60TRXX_WINDOW_HANN, table_q15);
+
+    for (uint32_t n = 0U; n < num_samples; ++n)
+    {
+        in_f32[n] = sinf(0.3f * (float)n);
+        in_q15[n] = (int16_t)lrintf(1000.0f * in_f32[n]);
+    }
+
+    /* each output feeds back into the next input, keeps the calls from being optimized out */
+    double t0 = test_now_ns();
+    for (uint32_t i = 0U; i < calls; ++i)
+    {
+        xensiv_bgt60trxx_range_chirp_f32(&range_f32, in_f32, out_f32);
+        in_f32[0] += out_f32[3] * 1e-9f;
+    }
+    double t1 = test_now_ns();
+    for (uint32_t i = 0U; i < calls; ++i)
+    {
+        xensiv_bgt60trxx_range_chirp_q15(&range_q15, in_q15, out_q15);
+        in_q15[0] = (int16_t)(in_q15[0] ^ (out_q15[3] & 1));
+    }
+    double t2 = test_now_ns();
+
+    TEST_CHECK(isfinite(out_f32[2]));
+    bench_report("range_chirp_f32", num_samples, calls, t1 - t0);
+    bench_report("range_chirp_q15", num_samples, calls, t2 - t1);
+}
+
+
+int main(void)
+{
+    bench_chirp(64U, 20000U);
+    bench_chirp(128U, 20000U);
+    bench_chirp(256U, 10000U);
+    bench_chirp(512U, 5000U);
+
+    return test_failures;
+}
@@ -0,0 +1,160 @@
+/***********************************************************************************************//**
+ * \file test_async.c
+ *
+ * \brief
+ * Host test of the asynchronous FIFO read against the simulated sensor. The callback must fire
+ * exactly once per read with the FIFO data, the lock and CS must be released before it runs and
+ * a FIFO error reported by GSR0 must reach the callback. Built with the platform asynchronous read
+ * and lock, completing in the platform call and deferred, and with the synchronous fallback.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2022 Infineon Technologies AG
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#include "test_common.h"
+
+#include <string.h>
+
+#include "xensiv_bgt60trxx_sim.h"
+
+#define NUM_SAMPLES         (512U)
+#define NUM_READS           (20U)
+
+typedef struct
+{
+    uint32_t calls;
+    int32_t status;
+    bool locked;
+    bool cs_active;
+} callback_log_t;
+
+static xensiv_bgt60trxx_sim_t sim;
+static xensiv_bgt60trxx_t dev;
+static callback_log_t cb_log;
+
+static uint16_t samples[NUM_SAMPLES];
+
+static const xensiv_bgt60trxx_sim_config_t sim_cfg =
+{
+    .device = XENSIV_DEVICE_BGT60TR13C,
+    .data = XENSIV_BGT60TRXX_SIM_DATA_LFSR,
+    .sample_rate_hz = 2000000U,
+    .num_samples_per_chirp = 128U,
+    .num_chirps_per_frame = 4U,
+    .num_rx_antennas = 1U,
+    .frame_period_us = 5000U,
+    .spi_clock_hz = 25000000U,
+    .reset_polls = 3U
+};
+
+
+/* Records the state of the bus when the driver hands the read back */
+static void read_done(xensiv_bgt60trxx_fifo_xfer_t* xfer)
+{
+    TEST_CHECK(xfer->data == samples);
+    TEST_CHECK(xfer->iface == &sim);
+    ++cb_log.calls;
+    cb_log.status = xfer->status;
+    cb_log.locked = sim.locked;
+    cb_log.cs_active = sim.cs_active;
+}
+
+
+/* Starts one read and completes it, returns the status of the start */
+static int32_t read_fifo(xensiv_bgt60trxx_fifo_xfer_t* xfer)
+{
+    (void)memset(&cb_log, 0, sizeof(cb_log));
+    xfer->data = samples;
+    xfer->num_samples = NUM_SAMPLES;
+    xfer->callback = read_done;
+
+    int32_t status = xensiv_bgt60trxx_get_fifo_data_async(&dev, xfer);
+
+#if defined(XENSIV_BGT60TRXX_PLATFORM_SPI_FIFO_READ_ASYNC)
+    if (sim.cfg.async_deferred && (0U == cb_log.calls))
+    {
+        /* the read is in flight: the lock and CS stay held until the completion */
+        TEST_CHECK(sim.locked);
+        TEST_CHECK(sim.cs_active);
+        TEST_CHECK(xensiv_bgt60trxx_sim_complete_async(&sim));
+    }
+#endif
+
+    /* nothing left to complete, the callback fired exactly once */
+    TEST_CHECK(!xensiv_bgt60trxx_sim_complete_async(&sim));
+    TEST_CHECK(1U == cb_log.calls);
+    TEST_CHECK(!cb_log.locked);
+    TEST_CHECK(!cb_log.cs_active);
+    TEST_CHECK(!sim.locked);
+    TEST_CHECK(!sim.cs_active);
+
+    return status;
+}
+
+
+static void test_reads(bool deferred)
+{
+    xensiv_bgt60trxx_fifo_xfer_t xfer;
+    uint16_t word = XENSIV_BGT60TRXX_INITIAL_TEST_WORD;
+    uint32_t errors = 0U;
+
+    sim.cfg.async_deferred = deferred;
+    int32_t status = xensiv_bgt60trxx_soft_reset(&dev, XENSIV_BGT60TRXX_RESET_FIFO);
+    sim.lfsr = XENSIV_BGT60TRXX_INITIAL_TEST_WORD;
+    status |= xensiv_bgt60trxx_start_frame(&dev, true);
+
+    for (uint32_t i = 0U; i < NUM_READS; ++i)
+    {
+        while (!xensiv_bgt60trxx_sim_irq(&sim))
+        {
+            xensiv_bgt60trxx_sim_advance(10U);
+        }
+        (void)memset(samples, 0, sizeof(samples));
+        status |= read_fifo(&xfer);
+        TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK == cb_log.status);
+        errors += test_check_lfsr(samples, NUM_SAMPLES, &word);
+    }
+
+    /* overflow: the start succeeds, the error arrives in the callback */
+    xensiv_bgt60trxx_sim_advance(1000000U);
+    status |= read_fifo(&xfer);
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_GSR0_ERROR == cb_log.status);
+
+    status |= xensiv_bgt60trxx_start_frame(&dev, false);
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK == status);
+    TEST_CHECK(0U == errors);
+    (void)printf("%s: %" PRIu32 " reads, %" PRIu32 " errors\n",
+                 deferred ? "deferred" : "immediate", NUM_READS, errors);
+}
+
+
+int main(void)
+{
+    xensiv_bgt60trxx_sim_init(&sim, &sim_cfg);
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK == xensiv_bgt60trxx_init(&dev, &sim, false));
+
+    int32_t status = xensiv_bgt60trxx_config(&dev, test_register_list, (uint32_t)TEST_NUM_REGS);
+    status |= xensiv_bgt60trxx_set_fifo_limit(&dev, NUM_SAMPLES);
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK == status);
+
+    test_reads(false);
+#if defined(XENSIV_BGT60TRXX_PLATFORM_SPI_FIFO_READ_ASYNC)
+    test_reads(true);
+#endif
+
+    return test_failures;
+}
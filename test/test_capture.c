@@ -0,0 +1,166 @@
+/***********************************************************************************************//**
+ * \file test_capture.c
+ *
+ * \brief
+ * Host test of the capture writer and reader: a capture written to a file through stdio and
+ * mapped back must return the header, the register list, every frame and its metadata, and find
+ * frames by sequence number. A capture cut off before its index is read from its complete frame
+ * records, a file that is not a capture is rejected.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2022 Infineon Technologies AG
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#include "test_common.h"
+
+#include <unistd.h>
+
+#include "xensiv_bgt60trxx_capture_posix.h"
+
+#define CAPTURE_FILE        "test_capture.bin"
+#define BAD_FILE            "test_capture_bad.bin"
+
+#define NUM_FRAMES          (200U)
+#define NUM_SAMPLES         (128U * 32U * 3U)
+
+/* Frames are numbered 10, 12, 14, ... */
+#define SEQUENCE(i)         (10U + (2U * (i)))
+
+static const xensiv_bgt60trxx_frame_geometry_t geometry = { 128U, 32U, 3U };
+static xensiv_bgt60trxx_capture_index_t capture_index[NUM_FRAMES];
+static uint16_t samples[NUM_SAMPLES];
+
+
+static uint16_t sample(uint32_t frame, uint32_t i)
+{
+    return (uint16_t)(((frame * 7U) + i) & 0xFFFU);
+}
+
+
+static void write_capture(void)
+{
+    xensiv_bgt60trxx_capture_writer_t writer;
+    FILE* f = fopen(CAPTURE_FILE, "wb");
+    TEST_CHECK(f != NULL);
+    if (f == NULL)
+    {
+        return;
+    }
+
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK ==
+               xensiv_bgt60trxx_capture_writer_init(&writer, xensiv_bgt60trxx_capture_fwrite, f,
+                                                    XENSIV_DEVICE_BGT60TR13C, &geometry,
+                                                    test_register_list, (uint32_t)TEST_NUM_REGS,
+                                                    capture_index, NUM_FRAMES));
+
+    for (uint32_t i = 0U; i < NUM_FRAMES; ++i)
+    {
+        const xensiv_bgt60trxx_frame_info_t info = { SEQUENCE(i), 1000U * i, i, 0U, 0U };
+
+        for (uint32_t k = 0U; k < NUM_SAMPLES; ++k)
+        {
+            samples[k] = sample(i, k);
+        }
+        TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK ==
+                   xensiv_bgt60trxx_capture_write_frame(&writer, samples, &info));
+    }
+
+    /* index full */
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_BUFFER_FULL ==
+               xensiv_bgt60trxx_capture_write_frame(&writer, samples, NULL));
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK == xensiv_bgt60trxx_capture_writer_close(&writer));
+    (void)fclose(f);
+}
+
+
+static void check_frames(const xensiv_bgt60trxx_capture_reader_t* reader, uint32_t num_frames)
+{
+    uint32_t errors = 0U;
+
+    TEST_CHECK(num_frames == reader->num_frames);
+    for (uint32_t i = 0U; i < reader->num_frames; ++i)
+    {
+        const xensiv_bgt60trxx_capture_frame_t* frame =
+            xensiv_bgt60trxx_capture_get_frame(reader, i);
+        const uint16_t* data = xensiv_bgt60trxx_capture_get_samples(frame);
+
+        errors += (frame->info.sequence != SEQUENCE(i)) ? 1U : 0U;
+        errors += (frame->info.timestamp_us != (1000U * i)) ? 1U : 0U;
+        errors += (frame->info.num_dropped != i) ? 1U : 0U;
+        for (uint32_t k = 0U; k < NUM_SAMPLES; ++k)
+        {
+            errors += (data[k] != sample(i, k)) ? 1U : 0U;
+        }
+    }
+    TEST_CHECK(0U == errors);
+
+    TEST_CHECK(77U == xensiv_bgt60trxx_capture_find(reader, SEQUENCE(77U)));
+    TEST_CHECK((num_frames - 1U) ==
+               xensiv_bgt60trxx_capture_find(reader, SEQUENCE(num_frames - 1U)));
+    TEST_CHECK(reader->num_frames == xensiv_bgt60trxx_capture_find(reader, SEQUENCE(0U) + 1U));
+    TEST_CHECK(reader->num_frames == xensiv_bgt60trxx_capture_find(reader, 0U));
+    TEST_CHECK(reader->num_frames == xensiv_bgt60trxx_capture_find(reader, 0xFFFFFFFFU));
+}
+
+
+int main(void)
+{
+    xensiv_bgt60trxx_capture_file_t file;
+
+    write_capture();
+
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK ==
+               xensiv_bgt60trxx_capture_file_open(&file, CAPTURE_FILE));
+    size_t size = file.size;
+    const xensiv_bgt60trxx_capture_header_t* header = file.reader.header;
+    TEST_CHECK((uint32_t)XENSIV_DEVICE_BGT60TR13C == header->device);
+    TEST_CHECK(geometry.num_rx_antennas == header->num_rx_antennas);
+    TEST_CHECK(NUM_SAMPLES == header->num_samples);
+    TEST_CHECK(TEST_NUM_REGS == header->num_regs);
+    TEST_CHECK(test_register_list[TEST_NUM_REGS - 1U] == file.reader.regs[TEST_NUM_REGS - 1U]);
+    TEST_CHECK(file.reader.index != NULL);
+    check_frames(&file.reader, NUM_FRAMES);
+    xensiv_bgt60trxx_capture_file_close(&file);
+
+    /* cut off in the last frame: no index, the complete frames are still read */
+    size -= sizeof(xensiv_bgt60trxx_capture_trailer_t) + sizeof(capture_index) + NUM_SAMPLES;
+    TEST_CHECK(0 == truncate(CAPTURE_FILE, (off_t)size));
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK ==
+               xensiv_bgt60trxx_capture_file_open(&file, CAPTURE_FILE));
+    TEST_CHECK(NULL == file.reader.index);
+    check_frames(&file.reader, NUM_FRAMES - 1U);
+    xensiv_bgt60trxx_capture_file_close(&file);
+
+    /* not a capture */
+    FILE* f = fopen(BAD_FILE, "wb");
+    TEST_CHECK(f != NULL);
+    if (f != NULL)
+    {
+        TEST_CHECK(sizeof(test_register_list) ==
+                   fwrite(test_register_list, 1U, sizeof(test_register_list), f));
+        (void)fclose(f);
+    }
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_FORMAT_ERROR ==
+               xensiv_bgt60trxx_capture_file_open(&file, BAD_FILE));
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_COM_ERROR ==
+               xensiv_bgt60trxx_capture_file_open(&file, "test_capture_missing.bin"));
+
+    (void)remove(CAPTURE_FILE);
+    (void)remove(BAD_FILE);
+
+    return test_failures;
+}
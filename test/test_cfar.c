@@ -0,0 +1,284 @@
+/***********************************************************************************************//**
+ * \file test_cfar.c
+ *
+ * \brief
+ * Host test of the CFAR detection of the XENSIV(TM) BGT60TRxx 60GHz FMCW radar sensors library
+ * against a brute-force implementation: same detections and SNR for both CFAR types, linear and
+ * dB maps, with and without peak filtering, and the noise estimate of a linear map must not be
+ * disturbed by a strong target the training rectangle has passed.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2022 Infineon Technologies AG
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#include "test_common.h"
+
+#include <float.h>
+#include <math.h>
+#include <stdlib.h>
+
+#include "xensiv_bgt60trxx_cfar.h"
+
+#define MAX_CELLS           (128U * 64U)
+#define MAX_TRAIN           (64U)
+
+static float map[MAX_CELLS];
+static float map_db[MAX_CELLS];
+static float workspace[XENSIV_BGT60TRXX_CFAR_WORKSPACE_LEN(128U, MAX_TRAIN)];
+static xensiv_bgt60trxx_cfar_detection_t detections[MAX_CELLS];
+static xensiv_bgt60trxx_cfar_detection_t expected[MAX_CELLS];
+static uint32_t seed = 1U;
+
+
+/* Uniform in (0, 1] */
+static double uniform(void)
+{
+    seed = (seed * 1103515245U) + 12345U;
+    return ((double)((seed >> 8) & 0xFFFFFFU) + 1.0) / 16777216.0;
+}
+
+
+static int compare_float(const void* a, const void* b)
+{
+    float x = *(const float*)a;
+    float y = *(const float*)b;
+    return (x > y) - (x < y);
+}
+
+
+/* Reference: collects the training cells of every cell, noise in double precision */
+static uint32_t cfar_reference(const xensiv_bgt60trxx_cfar_config_t* config, const float* m,
+                               int32_t num_range_bins, int32_t num_doppler_bins,
+                               xensiv_bgt60trxx_cfar_detection_t* det)
+{
+    static float cells[MAX_CELLS];
+    bool ca = (XENSIV_BGT60TRXX_CFAR_CA == config->type);
+    int32_t train_r = (int32_t)config->num_train_range;
+    int32_t guard_r = (int32_t)config->num_guard_range;
+    int32_t train_d = ca ? (int32_t)config->num_train_doppler : 0;
+    int32_t guard_d = ca ? (int32_t)config->num_guard_doppler : 0;
+    uint32_t n = 0U;
+
+    for (int32_t d = 0; d < num_doppler_bins; ++d)
+    {
+        for (int32_t b = 0; b < num_range_bins; ++b)
+        {
+            uint32_t k = 0U;
+            double sum = 0.0;
+
+            for (int32_t i = -(train_d + guard_d); i <= (train_d + guard_d); ++i)
+            {
+                for (int32_t j = -(train_r + guard_r); j <= (train_r + guard_r); ++j)
+                {
+                    int32_t x = b + j;
+                    int32_t y = (d + i + num_doppler_bins) % num_doppler_bins;
+                    if (((abs(i) > guard_d) || (abs(j) > guard_r)) &&
+                        (x >= 0) && (x < num_range_bins))
+                    {
+                        cells[k] = m[(y * num_range_bins) + x];
+                        sum += (double)cells[k];
+                        ++k;
+                    }
+                }
+            }
+
+            if (k == 0U)
+            {
+                continue;
+            }
+
+            float noise;
+            if (ca)
+            {
+                noise = (float)(sum / (double)k);
+            }
+            else
+            {
+                qsort(cells, k, sizeof(float), compare_float);
+                noise = cells[(config->os_rank * k) / (2U * config->num_train_range)];
+            }
+
+            float cell = m[(d * num_range_bins) + b];
+            bool detected;
+            float snr;
+            if (config->log_scale)
+            {
+                detected = (cell > (noise + config->threshold));
+                snr = cell - noise;
+            }
+            else
+            {
+                noise = (noise > FLT_MIN) ? noise : FLT_MIN;
+                detected = (cell > (noise * config->threshold));
+                snr = cell / noise;
+            }
+
+            for (int32_t i = -1; (i <= 1) && detected && config->peaks_only; ++i)
+            {
+                for (int32_t j = -1; j <= 1; ++j)
+                {
+                    int32_t x = b + j;
+                    int32_t y = (d + i + num_doppler_bins) % num_doppler_bins;
+                    if ((x >= 0) && (x < num_range_bins) && (cell < m[(y * num_range_bins) + x]))
+                    {
+                        detected = false;
+                    }
+                }
+            }
+
+            if (detected)
+            {
+                det[n].range_bin = (uint16_t)b;
+                det[n].doppler_bin = (uint16_t)d;
+                det[n].snr = snr;
+                ++n;
+            }
+        }
+    }
+
+    return n;
+}
+
+
+/* Number of detections differing from the reference, SNR within a relative tolerance */
+static uint32_t cfar_compare(const xensiv_bgt60trxx_cfar_config_t* config, const float* m,
+                             uint32_t num_range_bins, uint32_t num_doppler_bins, float tolerance)
+{
+    uint32_t n = xensiv_bgt60trxx_cfar_detect(config, m, num_range_bins, num_doppler_bins,
+                                              workspace, detections, MAX_CELLS);
+    uint32_t n_ref = cfar_reference(config, m, (int32_t)num_range_bins,
+                                    (int32_t)num_doppler_bins, expected);
+    uint32_t diff = (n > n_ref) ? (n - n_ref) : (n_ref - n);
+
+    for (uint32_t i = 0U; (i < n) && (i < n_ref); ++i)
+    {
+        if ((detections[i].range_bin != expected[i].range_bin) ||
+            (detections[i].doppler_bin != expected[i].doppler_bin) ||
+            (fabsf(detections[i].snr - expected[i].snr) >
+             (tolerance * fmaxf(1.0f, fabsf(expected[i].snr)))))
+        {
+            ++diff;
+        }
+    }
+
+    return diff;
+}
+
+
+/* Exponentially distributed noise power with a few targets, in linear units and in dB */
+static void test_maps(void)
+{
+    static const uint32_t sizes[][2] = { { 128U, 64U }, { 64U, 1U }, { 37U, 5U } };
+
+    for (uint32_t s = 0U; s < (sizeof(sizes) / sizeof(sizes[0])); ++s)
+    {
+        uint32_t num_range_bins = sizes[s][0];
+        uint32_t num_doppler_bins = sizes[s][1];
+        uint32_t num_cells = num_range_bins * num_doppler_bins;
+
+        for (uint32_t i = 0U; i < num_cells; ++i)
+        {
+            map[i] = (float)-log(uniform());
+        }
+        for (uint32_t t = 0U; t < 10U; ++t)
+        {
+            uint32_t cell = (uint32_t)(uniform() * (double)(num_cells - 1U));
+            map[cell] += (float)(20.0 + (200.0 * uniform()));
+        }
+        for (uint32_t i = 0U; i < num_cells; ++i)
+        {
+            map_db[i] = 10.0f * log10f(map[i]);
+        }
+
+        for (uint32_t type = 0U; type <= (uint32_t)XENSIV_BGT60TRXX_CFAR_OS; ++type)
+        {
+            for (uint32_t log_scale = 0U; log_scale < 2U; ++log_scale)
+            {
+                for (uint32_t peaks = 0U; peaks < 2U; ++peaks)
+                {
+                    xensiv_bgt60trxx_cfar_config_t config =
+                    {
+                        .type = (xensiv_bgt60trxx_cfar_type_t)type,
+                        .num_train_range = 8U,
+                        .num_guard_range = 2U,
+                        .num_train_doppler = (num_doppler_bins >= 9U) ? 4U :
+                                             ((num_doppler_bins >= 3U) ? 1U : 0U),
+                        .num_guard_doppler = (num_doppler_bins >= 9U) ? 1U : 0U,
+                        .os_rank = 12U,
+                        .threshold = (log_scale != 0U) ? 12.0f : 15.0f,
+                        .log_scale = (log_scale != 0U),
+                        .peaks_only = (peaks != 0U)
+                    };
+
+                    TEST_CHECK(0U == cfar_compare(&config, (log_scale != 0U) ? map_db : map,
+                                                  num_range_bins, num_doppler_bins, 1e-4f));
+                }
+            }
+        }
+    }
+}
+
+
+/* 64x64 linear map of noise around 1 with one cell at 1e8: every cell is reported with a zero
+ * threshold, so the SNR checks the noise estimate of the whole map */
+static void test_strong_cell(void)
+{
+    const uint32_t num_bins = 64U;
+    const xensiv_bgt60trxx_cfar_config_t config =
+    {
+        .type = XENSIV_BGT60TRXX_CFAR_CA,
+        .num_train_range = 8U,
+        .num_guard_range = 2U,
+        .num_train_doppler = 4U,
+        .num_guard_doppler = 1U,
+        .threshold = 0.0f,
+        .log_scale = false,
+        .peaks_only = false
+    };
+
+    for (uint32_t i = 0U; i < (num_bins * num_bins); ++i)
+    {
+        map[i] = (float)(0.5 + uniform());
+    }
+    map[(5U * num_bins) + 20U] = 1e8f;
+
+    uint32_t n = xensiv_bgt60trxx_cfar_detect(&config, map, num_bins, num_bins, workspace,
+                                              detections, MAX_CELLS);
+    uint32_t n_ref = cfar_reference(&config, map, (int32_t)num_bins, (int32_t)num_bins,
+                                    expected);
+    double max_error = 0.0;
+
+    TEST_CHECK(n == n_ref);
+    for (uint32_t i = 0U; (i < n) && (i < n_ref); ++i)
+    {
+        double error = fabs((double)detections[i].snr - (double)expected[i].snr) /
+                       (double)expected[i].snr;
+        max_error = fmax(max_error, error);
+    }
+
+    (void)printf("strong cell: largest relative SNR error %.2g\n", max_error);
+    TEST_CHECK(max_error < 1e-5);
+}
+
+
+int main(void)
+{
+    test_maps();
+    test_strong_cell();
+
+    return test_failures;
+}
@@ -0,0 +1,213 @@
+/***********************************************************************************************//**
+ * \file test_codec.c
+ *
+ * \brief
+ * Host test of the frame codec and of the sample packing. Frames of the simulated sensor and
+ * random frames of odd geometries must decode to the samples encoded, never exceed the maximum
+ * size, and the delta coding must fall back to packing on uncorrelated data. Truncated and
+ * corrupted frames must be rejected or at least decoded without writing past the frame.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2022 Infineon Technologies AG
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#include "test_common.h"
+
+#include <string.h>
+
+#include "xensiv_bgt60trxx_codec.h"
+#include "xensiv_bgt60trxx_sim.h"
+#include "xensiv_bgt60trxx_unpack.h"
+
+#define NUM_SAMPLES         (128U * 32U * 3U)
+#define PACKED_SIZE(n)      (XENSIV_BGT60TRXX_CODEC_HEADER_SIZE + (((n) * 3U) / 2U))
+#define GUARD               (0xAAAAU)
+#define NUM_RANDOM          (300U)
+
+static const xensiv_bgt60trxx_frame_geometry_t geometry = { 128U, 32U, 3U };
+static xensiv_bgt60trxx_sim_t sim;
+static uint16_t frame[NUM_SAMPLES];
+static uint16_t decoded[NUM_SAMPLES + 1U];
+static uint8_t encoded[PACKED_SIZE(NUM_SAMPLES) + 64U];
+static uint32_t seed = 1U;
+
+
+static uint32_t random_u32(void)
+{
+    seed = (seed * 1103515245U) + 12345U;
+    return seed >> 8;
+}
+
+
+/* Reads one frame of the simulated sensor */
+static void sim_frame(xensiv_bgt60trxx_sim_data_t data)
+{
+    const xensiv_bgt60trxx_sim_config_t sim_cfg =
+    {
+        .device = XENSIV_DEVICE_BGT60TR13C,
+        .data = data,
+        .sample_rate_hz = 2000000U,
+        .num_samples_per_chirp = 128U,
+        .num_chirps_per_frame = 32U,
+        .num_rx_antennas = 3U,
+        .frame_period_us = 20000U,
+        .beat_freq_hz = 150000U,
+        .reset_polls = 1U
+    };
+    xensiv_bgt60trxx_t dev;
+
+    xensiv_bgt60trxx_sim_init(&sim, &sim_cfg);
+    int32_t status = xensiv_bgt60trxx_init(&dev, &sim, false);
+    status |= xensiv_bgt60trxx_start_frame(&dev, true);
+    while (sim.fifo_fill < NUM_SAMPLES)
+    {
+        xensiv_bgt60trxx_sim_advance(100U);
+        (void)xensiv_bgt60trxx_sim_irq(&sim);
+    }
+    status |= xensiv_bgt60trxx_get_fifo_data(&dev, frame, NUM_SAMPLES);
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK == status);
+}
+
+
+/* Encodes and decodes a frame, returns the encoded size */
+static uint32_t round_trip(const xensiv_bgt60trxx_frame_geometry_t* g,
+                           xensiv_bgt60trxx_codec_mode_t mode, const uint16_t* samples)
+{
+    uint32_t n = g->num_samples_per_chirp * g->num_chirps_per_frame * g->num_rx_antennas;
+    uint32_t errors = 0U;
+
+    uint32_t len = xensiv_bgt60trxx_codec_encode(g, mode, samples, encoded);
+    TEST_CHECK(len <= xensiv_bgt60trxx_codec_max_size(g));
+
+    for (uint32_t i = 0U; i <= n; ++i)
+    {
+        decoded[i] = GUARD;
+    }
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK ==
+               xensiv_bgt60trxx_codec_decode(g, encoded, len, decoded));
+    for (uint32_t i = 0U; i < n; ++i)
+    {
+        errors += (decoded[i] != (samples[i] & 0xFFFU)) ? 1U : 0U;
+    }
+    TEST_CHECK(0U == errors);
+    TEST_CHECK(GUARD == decoded[n]);
+
+    return len;
+}
+
+
+static void test_sim_frames(void)
+{
+    /* LFSR: packed, and no gain from the delta coding */
+    sim_frame(XENSIV_BGT60TRXX_SIM_DATA_LFSR);
+    TEST_CHECK(PACKED_SIZE(NUM_SAMPLES) ==
+               round_trip(&geometry, XENSIV_BGT60TRXX_CODEC_PACK12, frame));
+    TEST_CHECK(PACKED_SIZE(NUM_SAMPLES) ==
+               round_trip(&geometry, XENSIV_BGT60TRXX_CODEC_DELTA, frame));
+    TEST_CHECK((uint8_t)XENSIV_BGT60TRXX_CODEC_PACK12 == encoded[0]);
+
+    /* beat signal: chirps repeat */
+    sim_frame(XENSIV_BGT60TRXX_SIM_DATA_BEAT);
+    uint32_t len = round_trip(&geometry, XENSIV_BGT60TRXX_CODEC_DELTA, frame);
+    (void)printf("beat frame: %u bytes delta coded to %" PRIu32 "\n",
+                 NUM_SAMPLES * 2U, len);
+    TEST_CHECK((uint8_t)XENSIV_BGT60TRXX_CODEC_DELTA == encoded[0]);
+    TEST_CHECK((2U * len) < PACKED_SIZE(NUM_SAMPLES));
+}
+
+
+/* Random geometries with an even number of samples, random or slowly varying data */
+static void test_random_frames(void)
+{
+    for (uint32_t k = 0U; k < NUM_RANDOM; ++k)
+    {
+        xensiv_bgt60trxx_frame_geometry_t g =
+        {
+            1U + (random_u32() % 70U), 1U + (random_u32() % 9U), 1U + (random_u32() % 3U)
+        };
+        if (((g.num_samples_per_chirp * g.num_chirps_per_frame * g.num_rx_antennas) & 1U) != 0U)
+        {
+            g.num_rx_antennas = 2U;
+        }
+        uint32_t n = g.num_samples_per_chirp * g.num_chirps_per_frame * g.num_rx_antennas;
+        uint32_t chirp_len = g.num_samples_per_chirp * g.num_rx_antennas;
+        uint32_t amplitude = 1UL << (random_u32() % 13U);
+
+        for (uint32_t i = 0U; i < n; ++i)
+        {
+            frame[i] = ((k % 5U) == 0U) ? (uint16_t)random_u32() :
+                       (uint16_t)((2048U + ((i % chirp_len) * 7U) + (random_u32() % amplitude)) &
+                                  0xFFFU);
+        }
+
+        for (uint32_t mode = 1U; mode <= 2U; ++mode)
+        {
+            uint32_t len = round_trip(&g, (xensiv_bgt60trxx_codec_mode_t)mode, frame);
+
+            TEST_CHECK(XENSIV_BGT60TRXX_STATUS_FORMAT_ERROR ==
+                       xensiv_bgt60trxx_codec_decode(&g, encoded, len - 1U, decoded));
+            encoded[0] = 7U;
+            TEST_CHECK(XENSIV_BGT60TRXX_STATUS_FORMAT_ERROR ==
+                       xensiv_bgt60trxx_codec_decode(&g, encoded, len, decoded));
+        }
+
+        /* garbage: any result, but nothing written past the frame */
+        for (uint32_t j = 0U; j < 50U; ++j)
+        {
+            uint32_t len = 4U + (random_u32() % 200U);
+            for (uint32_t i = 0U; i < len; ++i)
+            {
+                encoded[i] = (uint8_t)random_u32();
+            }
+            encoded[0] = (uint8_t)XENSIV_BGT60TRXX_CODEC_DELTA;
+            decoded[n] = GUARD;
+            (void)xensiv_bgt60trxx_codec_decode(&g, encoded, len, decoded);
+            TEST_CHECK(GUARD == decoded[n]);
+        }
+    }
+}
+
+
+/* Packing is the inverse of the unpacking of the FIFO data */
+static void test_pack(void)
+{
+    static uint8_t packed[(NUM_SAMPLES * 3U) / 2U];
+    uint32_t errors = 0U;
+
+    for (uint32_t i = 0U; i < NUM_SAMPLES; ++i)
+    {
+        frame[i] = (uint16_t)(random_u32() & 0xFFFU);
+    }
+
+    for (uint32_t n = 2U; n <= NUM_SAMPLES; n = (n * 3U) + 2U)
+    {
+        xensiv_bgt60trxx_pack_samples(frame, packed, n);
+        xensiv_bgt60trxx_unpack_samples(packed, decoded, n);
+        errors += (0 == memcmp(frame, decoded, n * sizeof(uint16_t))) ? 0U : 1U;
+    }
+    TEST_CHECK(0U == errors);
+}
+
+
+int main(void)
+{
+    test_sim_frames();
+    test_random_frames();
+    test_pack();
+
+    return test_failures;
+}
@@ -0,0 +1,104 @@
+/***********************************************************************************************//**
+ * \file test_common.h
+ *
+ * \brief
+ * This file contains the helpers shared by the host tests and benchmarks of the
+ * XENSIV(TM) BGT60TRxx 60GHz FMCW radar sensors library. Include it before any other header.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2022 Infineon Technologies AG
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#ifndef TEST_COMMON_H_
+#define TEST_COMMON_H_
+
+#if !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "xensiv_bgt60trxx.h"
+
+/************************************** Macros *******************************************/
+
+/* Reports a failed check, the program returns the number of failed checks */
+#define TEST_CHECK(expr)                                                        \
+    do                                                                          \
+    {                                                                           \
+        if (!(expr))                                                            \
+        {                                                                       \
+            (void)fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #expr); \
+            ++test_failures;                                                    \
+        }                                                                       \
+    } while (false)
+
+/* Pi for the reference computations, M_PI is not part of C99 */
+#define TEST_PI                         (3.14159265358979323846)
+
+/* Number of entries of test_register_list */
+#define TEST_NUM_REGS                   (sizeof(test_register_list) / sizeof(test_register_list[0]))
+
+/******************************** Local variables ****************************************/
+
+static int test_failures = 0;
+
+/* BGT60TR13C register list as generated by the configurator, 128 samples x 32 chirps x 3 RX */
+static const uint32_t test_register_list[] =
+{
+    0x11e8270UL, 0x3088210UL, 0x9e967fdUL, 0xb0805b4UL, 0xd102fffUL, 0xf010700UL, 0x11000000UL,
+    0x13000000UL, 0x15000000UL, 0x17000be0UL, 0x19000000UL, 0x1b000000UL, 0x1d000000UL,
+    0x1f000b60UL, 0x21130c51UL, 0x234ff41fUL, 0x25006f7bUL, 0x2d000490UL, 0x3b000480UL,
+    0x49000480UL, 0x57000480UL, 0x5911be0eUL, 0x5b3ef40aUL, 0x5d00f000UL, 0x5f787e1eUL,
+    0x61f5208cUL, 0x630000a4UL, 0x65000252UL, 0x67000080UL, 0x69000000UL, 0x6b000000UL,
+    0x6d000000UL, 0x6f092910UL, 0x7f000100UL, 0x8f000100UL, 0x9f000100UL, 0xad000000UL,
+    0xb7000000UL
+};
+
+/********************************* Inline functions **************************************/
+
+/* Host monotonic clock in nanoseconds */
+static inline double test_now_ns(void)
+{
+    struct timespec ts;
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((double)ts.tv_sec * 1e9) + (double)ts.tv_nsec;
+}
+
+
+/* Checks a buffer against the LFSR test sequence, returns the number of wrong samples and
+   continues the sequence in *word */
+static inline uint32_t test_check_lfsr(const uint16_t* data, uint32_t num_samples, uint16_t* word)
+{
+    uint32_t errors = 0U;
+
+    for (uint32_t i = 0U; i < num_samples; ++i)
+    {
+        if (data[i] != *word)
+        {
+            ++errors;
+        }
+        *word = xensiv_bgt60trxx_get_next_test_word(*word);
+    }
+
+    return errors;
+}
+
+
+#endif // ifndef TEST_COMMON_H_
@@ -0,0 +1,161 @@
+/***********************************************************************************************//**
+ * \file test_config.c
+ *
+ * \brief
+ * Host test of the coalesced register writes of xensiv_bgt60trxx_config and
+ * xensiv_bgt60trxx_set_regs against the simulated sensor. The register file must match the one
+ * written one register per transaction, with the number of transactions and bytes given by the
+ * address runs of the list and XENSIV_BGT60TRXX_REG_BURST_BUF_SIZE.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2022 Infineon Technologies AG
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#include "test_common.h"
+
+#include <string.h>
+
+#include "xensiv_bgt60trxx_sim.h"
+
+#define REG_ADDR(reg)       ((reg) >> 25)
+#define REG_DATA(reg)       ((reg) & 0x00FFFFFFUL)
+
+static xensiv_bgt60trxx_sim_t sim;
+static xensiv_bgt60trxx_sim_t sim_ref;
+
+static const xensiv_bgt60trxx_sim_config_t sim_cfg =
+{
+    .device = XENSIV_DEVICE_BGT60TR13C,
+    .data = XENSIV_BGT60TRXX_SIM_DATA_LFSR,
+    .sample_rate_hz = 2000000U,
+    .num_samples_per_chirp = 128U,
+    .num_chirps_per_frame = 32U,
+    .num_rx_antennas = 3U,
+    .frame_period_us = 20000U,
+    .reset_polls = 1U
+};
+
+
+/* Bytes of the list written as burst commands for runs of consecutive addresses */
+static uint32_t coalesced_bytes(const uint32_t* regs, uint32_t len)
+{
+    uint32_t bytes = 0U;
+    uint32_t i = 0U;
+
+    while (i < len)
+    {
+        uint32_t run = 1U;
+        while (((i + run) < len) && (REG_ADDR(regs[i + run]) == (REG_ADDR(regs[i]) + run)))
+        {
+            ++run;
+        }
+
+        bytes += (run == 1U) ? 4U : (4U + (3U * run));
+        i += run;
+    }
+
+    return bytes;
+}
+
+
+static void test_set_regs(void)
+{
+    xensiv_bgt60trxx_t dev;
+    xensiv_bgt60trxx_t dev_ref;
+    uint32_t len = (uint32_t)TEST_NUM_REGS;
+
+    xensiv_bgt60trxx_sim_init(&sim, &sim_cfg);
+    xensiv_bgt60trxx_sim_init(&sim_ref, &sim_cfg);
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK == xensiv_bgt60trxx_init(&dev, &sim, false));
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK == xensiv_bgt60trxx_init(&dev_ref, &sim_ref, false));
+
+    xensiv_bgt60trxx_sim_stats_t start = sim.stats;
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK ==
+               xensiv_bgt60trxx_set_regs(&dev, test_register_list, len));
+
+    uint32_t cs = sim.stats.cs_assertions - start.cs_assertions;
+    uint64_t bytes = sim.stats.bytes - start.bytes;
+    uint32_t expected = coalesced_bytes(test_register_list, len);
+
+    if (XENSIV_BGT60TRXX_REG_BURST_BUF_SIZE >= expected)
+    {
+        /* the whole list in one transaction */
+        TEST_CHECK(1U == cs);
+        TEST_CHECK(expected == bytes);
+    }
+    else if (XENSIV_BGT60TRXX_REG_BURST_BUF_SIZE < 10U)
+    {
+        /* no room for a burst of two registers, one transaction per register */
+        TEST_CHECK(len == cs);
+        TEST_CHECK((4U * len) == bytes);
+    }
+    else
+    {
+        TEST_CHECK(cs > 1U);
+    }
+    TEST_CHECK(len == (sim.stats.reg_writes - start.reg_writes));
+
+    /* reference: one register per transaction */
+    for (uint32_t i = 0U; i < len; ++i)
+    {
+        TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK ==
+                   xensiv_bgt60trxx_set_reg(&dev_ref, REG_ADDR(test_register_list[i]),
+                                            REG_DATA(test_register_list[i])));
+    }
+    TEST_CHECK(0 == memcmp(sim.regs, sim_ref.regs, sizeof(sim.regs)));
+}
+
+
+static void test_config(void)
+{
+    xensiv_bgt60trxx_t dev;
+    uint32_t len = (uint32_t)TEST_NUM_REGS;
+
+    xensiv_bgt60trxx_sim_init(&sim, &sim_cfg);
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK == xensiv_bgt60trxx_init(&dev, &sim, true));
+
+    /* a previous FIFO limit is reset with the configuration */
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK == xensiv_bgt60trxx_set_fifo_limit(&dev, 1024U));
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK ==
+               xensiv_bgt60trxx_config(&dev, test_register_list, len));
+
+    for (uint32_t i = 0U; i < len; ++i)
+    {
+        uint32_t addr = REG_ADDR(test_register_list[i]);
+        uint32_t expected = REG_DATA(test_register_list[i]);
+
+        if (XENSIV_BGT60TRXX_REG_SFCTL == addr)
+        {
+            /* CREF is set by the user, MISO_HS_READ by the SPI speed mode */
+            expected &= (uint32_t) ~XENSIV_BGT60TRXX_REG_SFCTL_FIFO_CREF_MSK;
+            expected |= XENSIV_BGT60TRXX_REG_SFCTL_MISO_HS_READ_MSK;
+        }
+
+        uint32_t data;
+        TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK == xensiv_bgt60trxx_get_reg(&dev, addr, &data));
+        TEST_CHECK(expected == data);
+    }
+}
+
+
+int main(void)
+{
+    test_set_regs();
+    test_config();
+
+    return test_failures;
+}
@@ -0,0 +1,238 @@
+/***********************************************************************************************//**
+ * \file test_doppler.c
+ *
+ * \brief
+ * Host test of the range-Doppler map against a reference computed with a naive transpose of the
+ * range spectra and a DFT across the chirps, for odd numbers of chirps, zero padding and numbers
+ * of range bins that are not a multiple of the tile.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2022 Infineon Technologies AG
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#include "test_common.h"
+
+#include <math.h>
+
+#include "xensiv_bgt60trxx_doppler.h"
+
+#define MAX_RX              (3U)
+#define MAX_CHIRPS          (64U)
+#define MAX_FFT_SIZE        (64U)
+#define RANGE_SAMPLES       (100U)
+#define RANGE_FFT_SIZE      (128U)
+
+/* Largest errors accepted: magnitude relative to the peak of the map, power in dB for cells
+   within 60 dB of the peak */
+#define MAX_ERROR_MAG       (1e-5)
+#define MAX_ERROR_DB        (0.01)
+#define DB_RANGE            (60.0)
+
+typedef struct
+{
+    uint32_t num_rx_antennas;
+    uint32_t num_chirps;
+    uint32_t num_range_bins;
+    uint32_t fft_size;
+} test_case_t;
+
+static float range_table[XENSIV_BGT60TRXX_RANGE_TABLE_LEN(RANGE_SAMPLES, RANGE_FFT_SIZE)];
+static float workspace[XENSIV_BGT60TRXX_DOPPLER_WORKSPACE_LEN(MAX_FFT_SIZE)];
+static float spectrum[MAX_RX * MAX_CHIRPS * RANGE_FFT_SIZE];
+static float map[MAX_RX * MAX_FFT_SIZE * (RANGE_FFT_SIZE / 2U)];
+static double ref[MAX_RX * MAX_FFT_SIZE * (RANGE_FFT_SIZE / 2U)];
+
+
+/* A moving target per range bin on top of a static offset and noise */
+static void spectrum_fill(uint32_t num_rx_antennas, uint32_t num_chirps)
+{
+    uint32_t seed = num_rx_antennas + (num_chirps << 8U);
+
+    for (uint32_t rx = 0U; rx < num_rx_antennas; ++rx)
+    {
+        for (uint32_t c = 0U; c < num_chirps; ++c)
+        {
+            float* row = &spectrum[((rx * num_chirps) + c) * RANGE_FFT_SIZE];
+
+            for (uint32_t bin = 0U; bin < (RANGE_FFT_SIZE / 2U); ++bin)
+            {
+                double amp = 0.1 + (0.01 * (double)((bin * 7U) % 13U));
+                double phi = 2.0 * TEST_PI * ((0.05 * (double)(bin % 9U)) - 0.2) * (double)c;
+                seed = (seed * 1103515245U) + 12345U;
+                double noise_re = ((double)((seed >> 16) % 1024U) - 512.0) * 1e-5;
+                seed = (seed * 1103515245U) + 12345U;
+                double noise_im = ((double)((seed >> 16) % 1024U) - 512.0) * 1e-5;
+
+                row[2U * bin] = (float)((amp * cos(phi)) + 0.05 + noise_re);
+                row[(2U * bin) + 1U] = (float)((amp * sin(phi)) - 0.03 + noise_im);
+            }
+        }
+    }
+}
+
+
+/* Naive transpose of each range bin, DFT across the chirps */
+static void reference_map(const test_case_t* tc, xensiv_bgt60trxx_window_t window,
+                         xensiv_bgt60trxx_mti_t mti)
+{
+    double col_re[MAX_CHIRPS];
+    double col_im[MAX_CHIRPS];
+    uint32_t fft_size = tc->fft_size;
+
+    for (uint32_t rx = 0U; rx < tc->num_rx_antennas; ++rx)
+    {
+        for (uint32_t bin = 0U; bin < tc->num_range_bins; ++bin)
+        {
+            double mean_re = 0.0;
+            double mean_im = 0.0;
+
+            for (uint32_t c = 0U; c < tc->num_chirps; ++c)
+            {
+                const float* src =
+                    &spectrum[(((rx * tc->num_chirps) + c) * RANGE_FFT_SIZE) + (2U * bin)];
+                col_re[c] = (double)src[0];
+                col_im[c] = (double)src[1];
+                mean_re += col_re[c];
+                mean_im += col_im[c];
+            }
+
+            if (XENSIV_BGT60TRXX_MTI_MEAN == mti)
+            {
+                mean_re /= (double)tc->num_chirps;
+                mean_im /= (double)tc->num_chirps;
+                for (uint32_t c = 0U; c < tc->num_chirps; ++c)
+                {
+                    col_re[c] -= mean_re;
+                    col_im[c] -= mean_im;
+                }
+            }
+
+            for (uint32_t d = 0U; d < fft_size; ++d)
+            {
+                uint32_t k = (d + (fft_size / 2U)) % fft_size;
+                double re = 0.0;
+                double im = 0.0;
+
+                for (uint32_t c = 0U; c < tc->num_chirps; ++c)
+                {
+                    double w = xensiv_bgt60trxx_window_value(window, c, tc->num_chirps);
+                    double phi = (2.0 * TEST_PI * (double)k * (double)c) / (double)fft_size;
+                    re += w * ((col_re[c] * cos(phi)) + (col_im[c] * sin(phi)));
+                    im += w * ((col_im[c] * cos(phi)) - (col_re[c] * sin(phi)));
+                }
+                re /= (double)fft_size;
+                im /= (double)fft_size;
+
+                ref[(((rx * fft_size) + d) * tc->num_range_bins) + bin] = (re * re) + (im * im);
+            }
+        }
+    }
+}
+
+
+/* Largest deviation of the magnitude relative to the peak and of the power in dB */
+static void check_map(const test_case_t* tc, xensiv_bgt60trxx_doppler_output_t output,
+                      double* err_mag, double* err_db)
+{
+    uint32_t len = tc->num_rx_antennas * tc->fft_size * tc->num_range_bins;
+    double peak = 0.0;
+
+    for (uint32_t i = 0U; i < len; ++i)
+    {
+        peak = fmax(peak, ref[i]);
+    }
+
+    for (uint32_t i = 0U; i < len; ++i)
+    {
+        if (XENSIV_BGT60TRXX_DOPPLER_MAGNITUDE == output)
+        {
+            *err_mag = fmax(*err_mag, fabs(sqrt(ref[i]) - (double)map[i]) / sqrt(peak));
+        }
+        else if ((10.0 * log10(peak / ref[i])) < DB_RANGE)
+        {
+            *err_db = fmax(*err_db, fabs((10.0 * log10(ref[i])) - (double)map[i]));
+        }
+        else
+        {
+            /* below the range checked */
+        }
+    }
+}
+
+
+int main(void)
+{
+    /* odd chirps, zero padding, single bins and bins beyond a multiple of the tile */
+    static const test_case_t cases[] =
+    {
+        { 1U, 5U, 7U, 8U },
+        { 2U, 13U, 29U, 16U },
+        { 3U, 31U, 64U, 64U },
+        { 1U, 64U, 1U, 64U },
+        { 2U, 7U, 8U, 32U },
+        { 1U, 16U, 17U, 16U },
+        { 3U, 4U, 9U, 4U }
+    };
+    double err_mag = 0.0;
+    double err_db = 0.0;
+    xensiv_bgt60trxx_range_t range;
+
+    xensiv_bgt60trxx_range_init_f32(&range, RANGE_SAMPLES, RANGE_FFT_SIZE,
+                                    XENSIV_BGT60TRXX_WINDOW_HANN, range_table);
+
+    for (uint32_t i = 0U; i < (sizeof(cases) / sizeof(cases[0])); ++i)
+    {
+        const test_case_t* tc = &cases[i];
+        const xensiv_bgt60trxx_frame_geometry_t geometry =
+        {
+            RANGE_SAMPLES, tc->num_chirps, tc->num_rx_antennas
+        };
+
+        spectrum_fill(tc->num_rx_antennas, tc->num_chirps);
+
+        for (uint32_t w = 0U; w <= (uint32_t)XENSIV_BGT60TRXX_WINDOW_BLACKMAN_HARRIS; ++w)
+        {
+            xensiv_bgt60trxx_window_t window = (xensiv_bgt60trxx_window_t)w;
+
+            for (uint32_t m = 0U; m <= (uint32_t)XENSIV_BGT60TRXX_MTI_MEAN; ++m)
+            {
+                xensiv_bgt60trxx_mti_t mti = (xensiv_bgt60trxx_mti_t)m;
+                reference_map(tc, window, mti);
+
+                for (uint32_t o = 0U; o <= (uint32_t)XENSIV_BGT60TRXX_DOPPLER_POWER_DB; ++o)
+                {
+                    xensiv_bgt60trxx_doppler_output_t output =
+                        (xensiv_bgt60trxx_doppler_output_t)o;
+                    xensiv_bgt60trxx_doppler_t doppler;
+
+                    xensiv_bgt60trxx_doppler_init(&doppler, &range, &geometry,
+                                                  tc->num_range_bins, tc->fft_size, window, mti,
+                                                  output, workspace);
+                    xensiv_bgt60trxx_doppler_map(&doppler, spectrum, map);
+                    check_map(tc, output, &err_mag, &err_db);
+                }
+            }
+        }
+    }
+
+    (void)printf("largest error against the DFT: magnitude %.2g of the peak, power %.2g dB\n",
+                 err_mag, err_db);
+    TEST_CHECK(err_mag < MAX_ERROR_MAG);
+    TEST_CHECK(err_db < MAX_ERROR_DB);
+
+    return test_failures;
+}
@@ -0,0 +1,190 @@
+/***********************************************************************************************//**
+ * \file test_fifo_raw.c
+ *
+ * \brief
+ * Host test of the raw FIFO read mode (XENSIV_BGT60TRXX_FIFO_READ_RAW) against the simulated
+ * sensor. xensiv_bgt60trxx_unpack_samples is checked against a scalar reference, including in
+ * place, and reads of any even length must return the LFSR test sequence, also the short reads
+ * of the frame assembler at the end of its ring buffer.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2022 Infineon Technologies AG
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#include "test_common.h"
+
+#include <string.h>
+
+#include "xensiv_bgt60trxx_frame.h"
+#include "xensiv_bgt60trxx_sim.h"
+#include "xensiv_bgt60trxx_unpack.h"
+
+/* 64 samples x 32 chirps x 1 RX, read in chunks of a third of the FIFO */
+#define FRAME_SIZE          (2048U)
+#define RING_SIZE           (2U * FRAME_SIZE)
+#define CHUNK_SIZE          (1364U)
+#define NUM_FRAMES          (26U)
+
+#define MAX_UNPACK_SAMPLES  (256U)
+
+static xensiv_bgt60trxx_sim_t sim;
+static xensiv_bgt60trxx_t dev;
+static xensiv_bgt60trxx_frame_assembler_t fa;
+static uint16_t ring[RING_SIZE];
+
+static const xensiv_bgt60trxx_sim_config_t sim_cfg =
+{
+    .device = XENSIV_DEVICE_BGT60UTR11,
+    .data = XENSIV_BGT60TRXX_SIM_DATA_LFSR,
+    .sample_rate_hz = 2000000U,
+    .num_samples_per_chirp = 64U,
+    .num_chirps_per_frame = 32U,
+    .num_rx_antennas = 1U,
+    .frame_period_us = 5000U,
+    .reset_polls = 1U
+};
+
+
+/* Two 12-bit samples per three bytes, most significant bits first */
+static void unpack_reference(const uint8_t* src, uint16_t* dst, uint32_t num_samples)
+{
+    for (uint32_t i = 0U; i < (num_samples / 2U); ++i)
+    {
+        const uint8_t* word = &src[3U * i];
+        dst[2U * i] = (uint16_t)(((uint32_t)word[0] << 4) | ((uint32_t)word[1] >> 4));
+        dst[(2U * i) + 1U] = (uint16_t)((((uint32_t)word[1] & 0x0FU) << 8) | (uint32_t)word[2]);
+    }
+}
+
+
+/* Every even length up to the vector widths and beyond, to a separate buffer and in place */
+static void test_unpack(void)
+{
+    static uint8_t src[(MAX_UNPACK_SAMPLES / 2U) * 3U];
+    static uint16_t expected[MAX_UNPACK_SAMPLES];
+    static uint16_t data[MAX_UNPACK_SAMPLES];
+    uint32_t seed = 1U;
+
+    for (uint32_t i = 0U; i < sizeof(src); ++i)
+    {
+        seed = (seed * 1103515245U) + 12345U;
+        src[i] = (uint8_t)(seed >> 16);
+    }
+
+    for (uint32_t n = 0U; n <= MAX_UNPACK_SAMPLES; n += 2U)
+    {
+        unpack_reference(src, expected, n);
+
+        xensiv_bgt60trxx_unpack_samples(src, data, n);
+        TEST_CHECK(0 == memcmp(expected, data, n * sizeof(uint16_t)));
+
+        uint8_t* packed = (uint8_t*)&data[n] - ((n / 2U) * 3U);
+        (void)memcpy(packed, src, (n / 2U) * 3U);
+        xensiv_bgt60trxx_unpack_samples(packed, data, n);
+        TEST_CHECK(0 == memcmp(expected, data, n * sizeof(uint16_t)));
+    }
+}
+
+
+/* Reads of 2 to 16 samples, below 8 samples through the bounce buffer of the driver */
+static void test_short_reads(void)
+{
+    uint16_t data[16];
+    uint16_t word = XENSIV_BGT60TRXX_INITIAL_TEST_WORD;
+    uint32_t errors = 0U;
+    int32_t status = xensiv_bgt60trxx_soft_reset(&dev, XENSIV_BGT60TRXX_RESET_FIFO);
+
+    sim.lfsr = XENSIV_BGT60TRXX_INITIAL_TEST_WORD;
+    status |= xensiv_bgt60trxx_start_frame(&dev, true);
+
+    for (uint32_t n = 2U; n <= 16U; n += 2U)
+    {
+        while (sim.fifo_fill < n)
+        {
+            xensiv_bgt60trxx_sim_advance(10U);
+            (void)xensiv_bgt60trxx_sim_irq(&sim);
+        }
+
+        /* canaries behind the samples read must stay untouched */
+        (void)memset(data, 0xA5, sizeof(data));
+        status |= xensiv_bgt60trxx_get_fifo_data(&dev, data, n);
+        errors += test_check_lfsr(data, n, &word);
+        for (uint32_t i = n; i < 16U; ++i)
+        {
+            TEST_CHECK(0xA5A5U == data[i]);
+        }
+    }
+
+    status |= xensiv_bgt60trxx_start_frame(&dev, false);
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK == status);
+    TEST_CHECK(0U == errors);
+}
+
+
+/* The chunk is split at the end of the ring buffer, down to a read of 4 samples at 4092 */
+static void test_frame_assembler(void)
+{
+    const xensiv_bgt60trxx_frame_geometry_t geometry = { 64U, 32U, 1U };
+    uint16_t word = XENSIV_BGT60TRXX_INITIAL_TEST_WORD;
+    uint32_t errors = 0U;
+    uint32_t frames = 0U;
+
+    int32_t status = xensiv_bgt60trxx_soft_reset(&dev, XENSIV_BGT60TRXX_RESET_FIFO);
+    status |= xensiv_bgt60trxx_frame_assembler_init(&fa, &dev, &geometry, CHUNK_SIZE, ring,
+                                                    RING_SIZE);
+    sim.lfsr = XENSIV_BGT60TRXX_INITIAL_TEST_WORD;
+    status |= xensiv_bgt60trxx_start_frame(&dev, true);
+
+    while ((frames < NUM_FRAMES) && (XENSIV_BGT60TRXX_STATUS_OK == status))
+    {
+        while (!xensiv_bgt60trxx_sim_irq(&sim))
+        {
+            xensiv_bgt60trxx_sim_advance(10U);
+        }
+
+        status = xensiv_bgt60trxx_frame_assembler_read(&fa);
+
+        const uint16_t* frame;
+        while ((frame = xensiv_bgt60trxx_frame_assembler_get(&fa)) != NULL)
+        {
+            errors += test_check_lfsr(frame, FRAME_SIZE, &word);
+            xensiv_bgt60trxx_frame_assembler_release(&fa);
+            ++frames;
+        }
+    }
+
+    (void)printf("%" PRIu32 " frames of %u samples in chunks of %u, %" PRIu32 " wrong samples\n",
+                 frames, FRAME_SIZE, CHUNK_SIZE, errors);
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK == status);
+    TEST_CHECK(NUM_FRAMES == frames);
+    TEST_CHECK(0U == errors);
+    TEST_CHECK(0U == sim.stats.overflows);
+}
+
+
+int main(void)
+{
+    test_unpack();
+
+    xensiv_bgt60trxx_sim_init(&sim, &sim_cfg);
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK == xensiv_bgt60trxx_init(&dev, &sim, false));
+
+    test_short_reads();
+    test_frame_assembler();
+
+    return test_failures;
+}
@@ -0,0 +1,192 @@
+/***********************************************************************************************//**
+ * \file test_frame_info.c
+ *
+ * \brief
+ * Host test of the frame metadata of the frame assembler against the simulated sensor: sequence
+ * numbers, time stamps and drop counters when the reads keep up, when frames queue in the FIFO
+ * because of late reads, and when the FIFO overflows and is reset by the application.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2022 Infineon Technologies AG
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#include "test_common.h"
+
+#include "xensiv_bgt60trxx_frame.h"
+#include "xensiv_bgt60trxx_sim.h"
+
+#define FRAME_PERIOD_US     (5000U)
+#define NUM_FRAMES          (40U)
+#define NUM_RING_FRAMES     (4U)
+#define MAX_FRAME_SIZE      (128U * 32U)
+
+typedef enum
+{
+    SCENARIO_KEEP_UP,       /* each chunk is read at its interrupt */
+    SCENARIO_LATE,          /* every 7th read is 9 ms late, frames queue in the FIFO */
+    SCENARIO_OVERFLOW       /* a 30 ms stall overflows the FIFO, reset by the application */
+} scenario_t;
+
+typedef struct
+{
+    uint32_t frames;        /* frames delivered */
+    uint32_t gaps;          /* sequence numbers skipped */
+    uint32_t num_dropped;   /* of the last frame */
+    uint32_t reg_reads;     /* register reads while streaming */
+    uint32_t max_jitter_us; /* largest deviation of a time stamp difference from the period */
+} result_t;
+
+static xensiv_bgt60trxx_sim_t sim;
+static xensiv_bgt60trxx_t dev;
+static xensiv_bgt60trxx_frame_assembler_t fa;
+static uint16_t ring[NUM_RING_FRAMES * MAX_FRAME_SIZE];
+static xensiv_bgt60trxx_frame_info_t info[NUM_RING_FRAMES];
+
+
+static result_t run(scenario_t scenario, uint32_t num_samples_per_chirp,
+                    uint32_t num_chirps_per_frame, uint32_t chunk_size)
+{
+    const xensiv_bgt60trxx_sim_config_t sim_cfg =
+    {
+        .device = XENSIV_DEVICE_BGT60UTR11,
+        .data = XENSIV_BGT60TRXX_SIM_DATA_LFSR,
+        .sample_rate_hz = 2000000U,
+        .num_samples_per_chirp = num_samples_per_chirp,
+        .num_chirps_per_frame = num_chirps_per_frame,
+        .num_rx_antennas = 1U,
+        .frame_period_us = FRAME_PERIOD_US,
+        .reset_polls = 3U,
+        .ready_delay_us = 200U
+    };
+    const xensiv_bgt60trxx_frame_geometry_t geometry =
+    {
+        num_samples_per_chirp, num_chirps_per_frame, 1U
+    };
+    uint32_t frame_size = num_samples_per_chirp * num_chirps_per_frame;
+    result_t result = { 0U, 0U, 0U, 0U, 0U };
+    uint32_t sequence = 0U;
+    uint32_t timestamp = 0U;
+    uint32_t iter = 0U;
+
+    xensiv_bgt60trxx_sim_init(&sim, &sim_cfg);
+    int32_t status = xensiv_bgt60trxx_init(&dev, &sim, false);
+    status |= xensiv_bgt60trxx_frame_assembler_init(&fa, &dev, &geometry, chunk_size, ring,
+                                                    NUM_RING_FRAMES * frame_size);
+    status |= xensiv_bgt60trxx_frame_assembler_enable_info(&fa, info, NUM_RING_FRAMES);
+    status |= xensiv_bgt60trxx_start_frame(&dev, true);
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK == status);
+
+    uint32_t reg_reads = sim.stats.reg_reads;
+
+    while ((result.frames < NUM_FRAMES) && (XENSIV_BGT60TRXX_STATUS_OK == status))
+    {
+        while (!xensiv_bgt60trxx_sim_irq(&sim))
+        {
+            xensiv_bgt60trxx_sim_advance(10U);
+        }
+        ++iter;
+
+        if ((SCENARIO_LATE == scenario) && ((iter % 7U) == 0U))
+        {
+            xensiv_bgt60trxx_sim_advance(9000U);
+        }
+
+        if ((SCENARIO_OVERFLOW == scenario) && (iter == 20U))
+        {
+            xensiv_bgt60trxx_sim_advance(30000U);
+            TEST_CHECK(XENSIV_BGT60TRXX_STATUS_GSR0_ERROR ==
+                       xensiv_bgt60trxx_frame_assembler_read(&fa));
+
+            status = xensiv_bgt60trxx_soft_reset(&dev, XENSIV_BGT60TRXX_RESET_FIFO);
+            status |= xensiv_bgt60trxx_frame_assembler_reset(&fa);
+            status |= xensiv_bgt60trxx_start_frame(&dev, true);
+            continue;
+        }
+
+        status = xensiv_bgt60trxx_frame_assembler_read(&fa);
+
+        const uint16_t* frame;
+        while ((frame = xensiv_bgt60trxx_frame_assembler_get(&fa)) != NULL)
+        {
+            const xensiv_bgt60trxx_frame_info_t* frame_info =
+                xensiv_bgt60trxx_frame_assembler_get_info(&fa);
+
+            if ((sequence != 0U) && (frame_info->sequence != (sequence + 1U)))
+            {
+                ++result.gaps;
+            }
+            else if (sequence != 0U)
+            {
+                /* consecutive frames complete one period apart, at the interrupt resolution */
+                uint32_t delta = frame_info->timestamp_us - timestamp;
+                uint32_t jitter = (delta > FRAME_PERIOD_US) ? (delta - FRAME_PERIOD_US) :
+                                  (FRAME_PERIOD_US - delta);
+                if ((SCENARIO_KEEP_UP == scenario) && (jitter > result.max_jitter_us))
+                {
+                    result.max_jitter_us = jitter;
+                }
+            }
+            else
+            {
+                /* first frame */
+            }
+
+            sequence = frame_info->sequence;
+            timestamp = frame_info->timestamp_us;
+            result.num_dropped = frame_info->num_dropped;
+            xensiv_bgt60trxx_frame_assembler_release(&fa);
+            ++result.frames;
+        }
+    }
+
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK == status);
+    result.reg_reads = sim.stats.reg_reads - reg_reads;
+
+    (void)printf("scenario %u: %" PRIu32 " frames up to sequence %" PRIu32 ", %" PRIu32
+                 " gaps, %" PRIu32 " dropped, %" PRIu32 " generated, %.2f register reads per "
+                 "frame\n", (unsigned)scenario, result.frames, sequence, result.gaps,
+                 result.num_dropped, sim.stats.frames,
+                 (double)result.reg_reads / (double)result.frames);
+
+    /* every frame the sensor completed was delivered, reported dropped or is still queued */
+    TEST_CHECK((result.frames + result.num_dropped) <= sim.stats.frames);
+    TEST_CHECK((result.frames + result.num_dropped + 2U) >= sim.stats.frames);
+    TEST_CHECK(sequence == (result.frames + result.num_dropped));
+
+    return result;
+}
+
+
+int main(void)
+{
+    result_t result = run(SCENARIO_KEEP_UP, 128U, 32U, 1024U);
+    TEST_CHECK(0U == result.gaps);
+    TEST_CHECK(0U == result.num_dropped);
+    TEST_CHECK(0U == result.reg_reads);
+    TEST_CHECK(result.max_jitter_us <= 20U);
+
+    result = run(SCENARIO_LATE, 64U, 4U, 256U);
+    TEST_CHECK(0U == result.gaps);
+    TEST_CHECK(0U == result.num_dropped);
+    TEST_CHECK(0U == result.reg_reads);
+
+    result = run(SCENARIO_OVERFLOW, 128U, 16U, 512U);
+    TEST_CHECK(1U == result.gaps);
+    TEST_CHECK(result.num_dropped > 0U);
+
+    return test_failures;
+}
@@ -0,0 +1,143 @@
+/***********************************************************************************************//**
+ * \file test_frame_threads.c
+ *
+ * \brief
+ * Host test of the frame assembler with reading and getting/releasing frames in two threads, as
+ * the FIFO interrupt and the processing loop would. The reading thread only advances the
+ * simulated time while the ring buffer has room, so every frame must hold the LFSR test sequence
+ * continued from the previous one.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2022 Infineon Technologies AG
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#include "test_common.h"
+
+#include <pthread.h>
+#include <sched.h>
+
+#include "xensiv_bgt60trxx_frame.h"
+#include "xensiv_bgt60trxx_sim.h"
+
+#define NUM_SAMPLES_PER_CHIRP   (64U)
+#define NUM_CHIRPS_PER_FRAME    (4U)
+#define FRAME_SIZE              (NUM_SAMPLES_PER_CHIRP * NUM_CHIRPS_PER_FRAME)
+#define CHUNK_SIZE              (96U)
+#define RING_SIZE               (2U * FRAME_SIZE)
+#define NUM_FRAMES              (2000U)
+
+static xensiv_bgt60trxx_sim_t sim;
+static xensiv_bgt60trxx_t dev;
+static xensiv_bgt60trxx_frame_assembler_t fa;
+static uint16_t ring[RING_SIZE];
+
+/* set by the consuming thread once all frames were checked */
+static volatile bool done = false;
+static int32_t read_status = XENSIV_BGT60TRXX_STATUS_OK;
+static uint32_t num_full = 0U;
+
+static const xensiv_bgt60trxx_sim_config_t sim_cfg =
+{
+    .device = XENSIV_DEVICE_BGT60UTR11,
+    .data = XENSIV_BGT60TRXX_SIM_DATA_LFSR,
+    .sample_rate_hz = 2000000U,
+    .num_samples_per_chirp = NUM_SAMPLES_PER_CHIRP,
+    .num_chirps_per_frame = NUM_CHIRPS_PER_FRAME,
+    .num_rx_antennas = 1U,
+    .frame_period_us = 1000U,
+    .reset_polls = 1U
+};
+
+
+/* FIFO interrupt context: waits for a chunk and reads it, retries while the ring buffer is full */
+static void* read_thread(void* arg)
+{
+    (void)arg;
+    bool pending = false;
+
+    while (!done && (XENSIV_BGT60TRXX_STATUS_OK == read_status))
+    {
+        while (!pending)
+        {
+            xensiv_bgt60trxx_sim_advance(10U);
+            pending = xensiv_bgt60trxx_sim_irq(&sim);
+        }
+
+        int32_t status = xensiv_bgt60trxx_frame_assembler_read(&fa);
+        if (XENSIV_BGT60TRXX_STATUS_BUFFER_FULL == status)
+        {
+            ++num_full;
+            (void)sched_yield();
+        }
+        else
+        {
+            read_status = status;
+            pending = false;
+        }
+    }
+
+    return NULL;
+}
+
+
+int main(void)
+{
+    const xensiv_bgt60trxx_frame_geometry_t geometry = { NUM_SAMPLES_PER_CHIRP,
+                                                         NUM_CHIRPS_PER_FRAME, 1U };
+
+    xensiv_bgt60trxx_sim_init(&sim, &sim_cfg);
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK == xensiv_bgt60trxx_init(&dev, &sim, false));
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK ==
+               xensiv_bgt60trxx_frame_assembler_init(&fa, &dev, &geometry, CHUNK_SIZE, ring,
+                                                     RING_SIZE));
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK == xensiv_bgt60trxx_start_frame(&dev, true));
+
+    pthread_t reader;
+    TEST_CHECK(0 == pthread_create(&reader, NULL, read_thread, NULL));
+
+    /* processing loop context */
+    uint16_t word = XENSIV_BGT60TRXX_INITIAL_TEST_WORD;
+    uint32_t errors = 0U;
+    uint32_t frames = 0U;
+
+    while ((frames < NUM_FRAMES) && (XENSIV_BGT60TRXX_STATUS_OK == read_status))
+    {
+        const uint16_t* frame = xensiv_bgt60trxx_frame_assembler_get(&fa);
+        if (frame != NULL)
+        {
+            errors += test_check_lfsr(frame, FRAME_SIZE, &word);
+            xensiv_bgt60trxx_frame_assembler_release(&fa);
+            ++frames;
+        }
+        else
+        {
+            (void)sched_yield();
+        }
+    }
+
+    done = true;
+    TEST_CHECK(0 == pthread_join(reader, NULL));
+
+    (void)printf("%" PRIu32 " frames, %" PRIu32 " wrong samples, %" PRIu32 " reads on a full ring"
+                 " buffer\n", frames, errors, num_full);
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK == read_status);
+    TEST_CHECK(NUM_FRAMES == frames);
+    TEST_CHECK(0U == errors);
+    TEST_CHECK(0U == sim.stats.overflows);
+
+    return test_failures;
+}
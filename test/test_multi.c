@@ -0,0 +1,319 @@
+/***********************************************************************************************//**
+ * \file test_multi.c
+ *
+ * \brief
+ * Host test of the multi-sensor manager with several simulated sensors on one SPI bus. The
+ * manager must read the sensor closest to a FIFO overflow first, estimated from the FIFO compare
+ * reference when the interrupt is seen and from the FIFO filling level after a read. Under load
+ * no FIFO may overflow, and the bus time of the sensors must add up to the time spent on the bus.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2022 Infineon Technologies AG
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#include "test_common.h"
+
+#include "xensiv_bgt60trxx_multi.h"
+#include "xensiv_bgt60trxx_sim.h"
+
+#define NUM_DEVS            (4U)
+#define NUM_RING_FRAMES     (3U)
+#define MAX_FRAME_SIZE      (256U * 16U)
+#define MAX_POLLS           (32U)
+
+#define SAMPLE_RATE         (2000000U)
+#define SPI_CLOCK_HZ        (50000000U)
+#define LOAD_DURATION_US    (400000U)
+#define LOAD_STEP_US        (10U)
+
+static xensiv_bgt60trxx_sim_t sim[NUM_DEVS];
+static xensiv_bgt60trxx_t dev[NUM_DEVS];
+static xensiv_bgt60trxx_frame_assembler_t fa[NUM_DEVS];
+static uint16_t ring[NUM_DEVS][NUM_RING_FRAMES * MAX_FRAME_SIZE];
+static xensiv_bgt60trxx_multi_t multi;
+
+
+/* Sets up a sensor with LFSR data on the bus, the frame generation is not started */
+static void setup(uint32_t idx, const xensiv_bgt60trxx_sim_config_t* sim_cfg, uint32_t chunk_size)
+{
+    const xensiv_bgt60trxx_frame_geometry_t geometry =
+    {
+        sim_cfg->num_samples_per_chirp, sim_cfg->num_chirps_per_frame, sim_cfg->num_rx_antennas
+    };
+    uint32_t frame_size = sim_cfg->num_samples_per_chirp * sim_cfg->num_chirps_per_frame *
+                          sim_cfg->num_rx_antennas;
+
+    xensiv_bgt60trxx_sim_init(&sim[idx], sim_cfg);
+    int32_t status = xensiv_bgt60trxx_init(&dev[idx], &sim[idx], false);
+    status |= xensiv_bgt60trxx_frame_assembler_init(&fa[idx], &dev[idx], &geometry, chunk_size,
+                                                    ring[idx], NUM_RING_FRAMES * frame_size);
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK == status);
+    /* the simulator writes sample_rate_hz samples per second, for all antennas */
+    TEST_CHECK(idx == xensiv_bgt60trxx_multi_add(&multi, &fa[idx], sim_cfg->sample_rate_hz));
+}
+
+
+/* Polls until no sensor is pending, returns the number of chunks read */
+static uint32_t poll_all(uint32_t* order, uint32_t max_polls)
+{
+    uint32_t num_polls = 0U;
+    uint32_t idx;
+
+    do
+    {
+        TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK == xensiv_bgt60trxx_multi_poll(&multi, &idx));
+        if ((idx != XENSIV_BGT60TRXX_MULTI_IDLE) && (num_polls < max_polls))
+        {
+            order[num_polls] = idx;
+        }
+        num_polls += (idx != XENSIV_BGT60TRXX_MULTI_IDLE) ? 1U : 0U;
+    } while (idx != XENSIV_BGT60TRXX_MULTI_IDLE);
+
+    return num_polls;
+}
+
+
+static void check_order(const uint32_t* order, uint32_t num_polls, const uint32_t* expected,
+                        uint32_t num_expected)
+{
+    TEST_CHECK(num_expected == num_polls);
+    for (uint32_t i = 0U; (i < num_polls) && (i < num_expected); ++i)
+    {
+        TEST_CHECK(expected[i] == order[i]);
+    }
+}
+
+
+/* Interrupts seen at once: the time left is estimated from the FIFO compare reference and the
+   sample rate, then from the filling level read after each chunk. No bus time. */
+static void test_urgency_cref(void)
+{
+    xensiv_bgt60trxx_sim_config_t sim_cfg =
+    {
+        .device = XENSIV_DEVICE_BGT60UTR11,
+        .data = XENSIV_BGT60TRXX_SIM_DATA_LFSR,
+        .sample_rate_hz = SAMPLE_RATE,
+        .num_samples_per_chirp = 128U,
+        .num_chirps_per_frame = 16U,
+        .num_rx_antennas = 1U,
+        .reset_polls = 3U
+    };
+    uint32_t order[MAX_POLLS];
+
+    xensiv_bgt60trxx_multi_init(&multi);
+    setup(0U, &sim_cfg, 512U);
+    setup(1U, &sim_cfg, 1024U);
+    sim_cfg.sample_rate_hz = 2U * SAMPLE_RATE;
+    setup(2U, &sim_cfg, 512U);
+
+    int32_t status = XENSIV_BGT60TRXX_STATUS_OK;
+    for (uint32_t i = 0U; i < 3U; ++i)
+    {
+        status |= xensiv_bgt60trxx_start_frame(&dev[i], true);
+    }
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK == status);
+
+    /* 1200, 1200 and 2400 samples in the FIFOs of 4096 samples */
+    xensiv_bgt60trxx_sim_advance(600U);
+    for (uint32_t i = 0U; i < 3U; ++i)
+    {
+        TEST_CHECK(xensiv_bgt60trxx_sim_irq(&sim[i]));
+        xensiv_bgt60trxx_multi_irq(&multi, i);
+    }
+
+    /* overflow in 896 us (4 MS/s), 1536 us (chunk 1024) and 1792 us (chunk 512), sensor 2
+       stays most urgent until its FIFO is read below one chunk */
+    static const uint32_t expected[] = { 2U, 2U, 2U, 2U, 1U, 0U, 0U };
+    uint32_t num_polls = poll_all(order, MAX_POLLS);
+    check_order(order, num_polls, expected, sizeof(expected) / sizeof(expected[0]));
+    TEST_CHECK(352U == sim[2].fifo_fill);
+    TEST_CHECK(176U == sim[1].fifo_fill);
+    TEST_CHECK(176U == sim[0].fifo_fill);
+}
+
+
+/* A sensor left with a high filling level after a read goes before a sensor whose interrupt has
+   just been seen, although the latter has the larger FIFO compare reference. No bus time. */
+static void test_urgency_fill(void)
+{
+    const xensiv_bgt60trxx_sim_config_t sim_cfg =
+    {
+        .device = XENSIV_DEVICE_BGT60UTR11,
+        .data = XENSIV_BGT60TRXX_SIM_DATA_LFSR,
+        .sample_rate_hz = SAMPLE_RATE,
+        .num_samples_per_chirp = 128U,
+        .num_chirps_per_frame = 32U,
+        .num_rx_antennas = 1U,
+        .reset_polls = 3U
+    };
+    uint32_t order[MAX_POLLS];
+
+    xensiv_bgt60trxx_multi_init(&multi);
+    setup(0U, &sim_cfg, 500U);
+    setup(1U, &sim_cfg, 1024U);
+
+    /* sensor 0 holds 3000 samples when its interrupt is seen, one chunk is read */
+    int32_t status = xensiv_bgt60trxx_start_frame(&dev[0], true);
+    xensiv_bgt60trxx_sim_advance(1500U);
+    status |= xensiv_bgt60trxx_start_frame(&dev[1], true);
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK == status);
+
+    uint32_t idx;
+    xensiv_bgt60trxx_multi_irq(&multi, 0U);
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK == xensiv_bgt60trxx_multi_poll(&multi, &idx));
+    TEST_CHECK(0U == idx);
+    TEST_CHECK(2500U == sim[0].fifo_fill);
+
+    /* 600 us later: 3700 samples, overflow in 198 us, against 1200 samples with chunk 1024,
+       overflow in 1536 us. Sensor 0 goes first until its filling level is down to 700. */
+    xensiv_bgt60trxx_sim_advance(600U);
+    TEST_CHECK(xensiv_bgt60trxx_sim_irq(&sim[1]));
+    xensiv_bgt60trxx_multi_irq(&multi, 1U);
+
+    static const uint32_t expected[] = { 0U, 0U, 0U, 0U, 0U, 0U, 1U, 0U };
+    uint32_t num_polls = poll_all(order, MAX_POLLS);
+    check_order(order, num_polls, expected, sizeof(expected) / sizeof(expected[0]));
+    TEST_CHECK(200U == sim[0].fifo_fill);
+    TEST_CHECK(176U == sim[1].fifo_fill);
+}
+
+
+/* Four sensors with staggered frames on a 50 MHz bus, about 80 % utilized: no FIFO overflows,
+   every frame is delivered with its data, and the bus time of the sensors adds up to the time
+   the simulated bus was busy */
+static void test_load(void)
+{
+    const xensiv_bgt60trxx_sim_config_t sim_cfg =
+    {
+        .device = XENSIV_DEVICE_BGT60UTR11,
+        .data = XENSIV_BGT60TRXX_SIM_DATA_LFSR,
+        .sample_rate_hz = SAMPLE_RATE,
+        .num_samples_per_chirp = 256U,
+        .num_chirps_per_frame = 16U,
+        .num_rx_antennas = 1U,
+        .frame_period_us = 5000U,
+        .spi_clock_hz = SPI_CLOCK_HZ,
+        .reset_polls = 3U
+    };
+    static const uint32_t chunk_size[NUM_DEVS] = { 512U, 1024U, 768U, 1024U };
+    uint16_t word[NUM_DEVS];
+    uint32_t frames[NUM_DEVS];
+    uint32_t lfsr_errors = 0U;
+    uint64_t bytes[NUM_DEVS];
+    uint32_t order[MAX_POLLS];
+
+    xensiv_bgt60trxx_multi_init(&multi);
+    for (uint32_t i = 0U; i < NUM_DEVS; ++i)
+    {
+        setup(i, &sim_cfg, chunk_size[i]);
+        word[i] = XENSIV_BGT60TRXX_INITIAL_TEST_WORD;
+        frames[i] = 0U;
+    }
+
+    int32_t status = XENSIV_BGT60TRXX_STATUS_OK;
+    for (uint32_t i = 0U; i < NUM_DEVS; ++i)
+    {
+        status |= xensiv_bgt60trxx_start_frame(&dev[i], true);
+        xensiv_bgt60trxx_sim_advance(700U);
+    }
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK == status);
+
+    xensiv_bgt60trxx_multi_reset_stats(&multi);
+    uint64_t start_ns = xensiv_bgt60trxx_sim_get_time();
+    for (uint32_t i = 0U; i < NUM_DEVS; ++i)
+    {
+        bytes[i] = sim[i].stats.bytes;
+    }
+
+    while ((xensiv_bgt60trxx_sim_get_time() - start_ns) < (LOAD_DURATION_US * 1000ULL))
+    {
+        /* level-triggered interrupt, signalled while the filling level is above the reference */
+        for (uint32_t i = 0U; i < NUM_DEVS; ++i)
+        {
+            if (xensiv_bgt60trxx_sim_irq(&sim[i]))
+            {
+                xensiv_bgt60trxx_multi_irq(&multi, i);
+            }
+        }
+
+        (void)poll_all(order, MAX_POLLS);
+
+        for (uint32_t i = 0U; i < NUM_DEVS; ++i)
+        {
+            const uint16_t* frame;
+            while ((frame = xensiv_bgt60trxx_frame_assembler_get(&fa[i])) != NULL)
+            {
+                lfsr_errors += test_check_lfsr(frame, fa[i].frame_size, &word[i]);
+                xensiv_bgt60trxx_frame_assembler_release(&fa[i]);
+                ++frames[i];
+            }
+        }
+
+        xensiv_bgt60trxx_sim_advance(LOAD_STEP_US);
+    }
+
+    /* the only bus traffic is the polls: 20 ns per bit at 50 MHz */
+    xensiv_bgt60trxx_multi_stats_t stats[NUM_DEVS];
+    uint32_t busy_us = 0U;
+    uint32_t bus_us = 0U;
+    uint32_t num_reads = 0U;
+
+    for (uint32_t i = 0U; i < NUM_DEVS; ++i)
+    {
+        xensiv_bgt60trxx_multi_get_stats(&multi, i, &stats[i]);
+
+        uint32_t dev_bus_us = (uint32_t)(((sim[i].stats.bytes - bytes[i]) * 8U) /
+                                         (SPI_CLOCK_HZ / 1000000U));
+        (void)printf("sensor %" PRIu32 ": %" PRIu32 " frames, %" PRIu32 " reads, max fill %"
+                     PRIu32 ", bus %" PRIu32 " of %" PRIu32 " us\n", i, frames[i],
+                     stats[i].num_reads, stats[i].max_fill, stats[i].busy_us,
+                     stats[i].elapsed_us);
+
+        TEST_CHECK(0U == sim[i].stats.overflows);
+        TEST_CHECK(0U == stats[i].num_errors);
+        TEST_CHECK(0U == stats[i].num_stalled);
+        TEST_CHECK(stats[i].max_fill < ((uint32_t)xensiv_bgt60trxx_get_fifo_size(&dev[i]) *
+                                        XENSIV_BGT60TRXX_NUM_SAMPLES_FIFO_WORD));
+        TEST_CHECK(frames[i] >= ((LOAD_DURATION_US / sim_cfg.frame_period_us) - 1U));
+
+        /* measured in whole microseconds around each poll */
+        TEST_CHECK(stats[i].busy_us <= (dev_bus_us + stats[i].num_reads + 1U));
+        TEST_CHECK((stats[i].busy_us + stats[i].num_reads + 1U) >= dev_bus_us);
+        TEST_CHECK(stats[i].elapsed_us == stats[0].elapsed_us);
+
+        busy_us += stats[i].busy_us;
+        bus_us += dev_bus_us;
+        num_reads += stats[i].num_reads;
+    }
+
+    (void)printf("bus utilization %" PRIu32 " %%\n", (busy_us * 100U) / stats[0].elapsed_us);
+    TEST_CHECK(0U == lfsr_errors);
+    TEST_CHECK(stats[0].elapsed_us >= LOAD_DURATION_US);
+    TEST_CHECK(busy_us <= stats[0].elapsed_us);
+    TEST_CHECK(busy_us <= (bus_us + num_reads + NUM_DEVS));
+    TEST_CHECK((busy_us + num_reads + NUM_DEVS) >= bus_us);
+}
+
+
+int main(void)
+{
+    test_urgency_cref();
+    test_urgency_fill();
+    test_load();
+
+    return test_failures;
+}
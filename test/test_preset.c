@@ -0,0 +1,147 @@
+/***********************************************************************************************//**
+ * \file test_preset.c
+ *
+ * \brief
+ * Host test of the register presets against the simulated sensor. Switching between presets must
+ * leave the same registers as xensiv_bgt60trxx_config with the list of the preset, while writing
+ * only the registers that differ and stopping the frame generation only when the chirp
+ * configuration changes.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2022 Infineon Technologies AG
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#include "test_common.h"
+
+#include "xensiv_bgt60trxx_sim.h"
+
+#define REG_ADDR(reg)       ((reg) >> 25)
+
+/* Entries of test_register_list changed in preset B, all in the chirp and PLL configuration */
+#define NUM_CHANGED         (4U)
+
+static xensiv_bgt60trxx_sim_t sim;
+static xensiv_bgt60trxx_sim_t sim_ref;
+static xensiv_bgt60trxx_t dev;
+static xensiv_bgt60trxx_t dev_ref;
+static xensiv_bgt60trxx_shadow_t shadow;
+static xensiv_bgt60trxx_preset_t preset_a;
+static xensiv_bgt60trxx_preset_t preset_b;
+static xensiv_bgt60trxx_preset_t preset_c;
+static uint32_t list_b[TEST_NUM_REGS];
+static uint32_t list_c[TEST_NUM_REGS];
+
+static const uint32_t changed[NUM_CHANGED] = { 20U, 23U, 26U, 29U };
+
+static const xensiv_bgt60trxx_sim_config_t sim_cfg =
+{
+    .device = XENSIV_DEVICE_BGT60TR13C,
+    .data = XENSIV_BGT60TRXX_SIM_DATA_LFSR,
+    .sample_rate_hz = 2000000U,
+    .num_samples_per_chirp = 128U,
+    .num_chirps_per_frame = 32U,
+    .num_rx_antennas = 3U,
+    .frame_period_us = 20000U,
+    .spi_clock_hz = 25000000U,
+    .reset_polls = 1U
+};
+
+
+/* Compares the registers of the list with the reference sensor configured from the list */
+static void check_regs(const uint32_t* list)
+{
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK ==
+               xensiv_bgt60trxx_config(&dev_ref, list, (uint32_t)TEST_NUM_REGS));
+
+    for (uint32_t i = 0U; i < TEST_NUM_REGS; ++i)
+    {
+        uint32_t addr = REG_ADDR(list[i]);
+        if (XENSIV_BGT60TRXX_REG_MAIN != addr)
+        {
+            TEST_CHECK(sim.regs[addr] == sim_ref.regs[addr]);
+        }
+    }
+}
+
+
+/* Applies a preset while frames are generated, returns the number of SPI transactions */
+static uint32_t apply(const xensiv_bgt60trxx_preset_t* preset)
+{
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK == xensiv_bgt60trxx_start_frame(&dev, true));
+
+    uint32_t cs = sim.stats.cs_assertions;
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK == xensiv_bgt60trxx_preset_apply(&dev, preset));
+
+    return sim.stats.cs_assertions - cs;
+}
+
+
+int main(void)
+{
+    uint32_t diff[XENSIV_BGT60TRXX_SHADOW_NUM_REGS];
+
+    for (uint32_t i = 0U; i < TEST_NUM_REGS; ++i)
+    {
+        list_b[i] = test_register_list[i];
+        list_c[i] = test_register_list[i];
+        if (XENSIV_BGT60TRXX_REG_SFCTL == REG_ADDR(test_register_list[i]))
+        {
+            list_c[i] ^= XENSIV_BGT60TRXX_REG_SFCTL_FIFO_LP_MODE_MSK;
+        }
+    }
+    for (uint32_t i = 0U; i < NUM_CHANGED; ++i)
+    {
+        list_b[changed[i]] ^= 0x5A5A0UL;
+    }
+
+    xensiv_bgt60trxx_preset_init(&preset_a, test_register_list, (uint32_t)TEST_NUM_REGS);
+    xensiv_bgt60trxx_preset_init(&preset_b, list_b, (uint32_t)TEST_NUM_REGS);
+    xensiv_bgt60trxx_preset_init(&preset_c, list_c, (uint32_t)TEST_NUM_REGS);
+
+    xensiv_bgt60trxx_sim_init(&sim, &sim_cfg);
+    xensiv_bgt60trxx_sim_init(&sim_ref, &sim_cfg);
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK == xensiv_bgt60trxx_init(&dev, &sim, false));
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK == xensiv_bgt60trxx_init(&dev_ref, &sim_ref, false));
+    xensiv_bgt60trxx_set_shadow(&dev, &shadow);
+
+    uint32_t cs = sim.stats.cs_assertions;
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK ==
+               xensiv_bgt60trxx_config(&dev, test_register_list, (uint32_t)TEST_NUM_REGS));
+    uint32_t cs_config = sim.stats.cs_assertions - cs;
+
+    /* chirp configuration changed: delta written, frame generation stopped */
+    TEST_CHECK(NUM_CHANGED == xensiv_bgt60trxx_preset_diff(&dev, &preset_b, diff));
+    uint32_t cs_apply = apply(&preset_b);
+    (void)printf("config: %" PRIu32 ", apply B: %" PRIu32 " transactions\n", cs_config, cs_apply);
+    TEST_CHECK(cs_apply < cs_config);
+    TEST_CHECK(!sim.running);
+    check_regs(list_b);
+
+    (void)apply(&preset_a);
+    TEST_CHECK(!sim.running);
+    check_regs(test_register_list);
+
+    /* SFCTL only: one write, frame generation continues */
+    TEST_CHECK(1U == apply(&preset_c));
+    TEST_CHECK(sim.running);
+    check_regs(list_c);
+
+    /* the active preset again: no bus access */
+    TEST_CHECK(0U == apply(&preset_c));
+
+    return test_failures;
+}
@@ -0,0 +1,145 @@
+/***********************************************************************************************//**
+ * \file test_range.c
+ *
+ * \brief
+ * Host test of the range FFT stage of the XENSIV(TM) BGT60TRxx 60GHz FMCW radar sensors library.
+ * The float and fixed point spectra are checked against a double precision DFT of the mean-free,
+ * windowed chirp for odd and power of two chirp lengths, all windows and 1x to 4x zero padding.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2022 Infineon Technologies AG
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#include "test_common.h"
+
+#include <math.h>
+
+#include "xensiv_bgt60trxx_range.h"
+
+#define MAX_SAMPLES         (512U)
+#define MAX_FFT_SIZE        (4U * MAX_SAMPLES)
+
+/* Largest errors accepted: float relative to a full scale of 1.0, fixed point in Q13 LSB */
+#define MAX_ERROR_F32       (1e-6)
+#define MAX_ERROR_Q15       (4.0)
+
+static float table_f32[XENSIV_BGT60TRXX_RANGE_TABLE_LEN(MAX_SAMPLES, MAX_FFT_SIZE)];
+static int16_t table_q15[XENSIV_BGT60TRXX_RANGE_TABLE_LEN(MAX_SAMPLES, MAX_FFT_SIZE)];
+static float in_f32[MAX_SAMPLES];
+static int16_t in_q15[MAX_SAMPLES];
+static float out_f32[MAX_FFT_SIZE];
+static int16_t out_q15[MAX_FFT_SIZE];
+
+
+/* Two tones and an offset in 12-bit ADC codes, the float input scaled to 1.0 at 2048 */
+static void chirp_fill(uint32_t num_samples)
+{
+    uint32_t seed = num_samples;
+
+    for (uint32_t n = 0U; n < num_samples; ++n)
+    {
+        seed = (seed * 1103515245U) + 12345U;
+        double v = (1500.0 * sin(2.0 * TEST_PI * 0.123 * (double)n)) +
+                   (300.0 * cos(2.0 * TEST_PI * 0.31 * (double)n)) +
+                   (double)((seed >> 16) % 64U) + 68.0;
+        in_q15[n] = (int16_t)lrint(v);
+        in_f32[n] = (float)in_q15[n] / 2048.0f;
+    }
+}
+
+
+/* Largest deviation of both spectra from the DFT, the fixed point one in Q13 LSB */
+static void check_spectrum(uint32_t num_samples, uint32_t fft_size,
+                           xensiv_bgt60trxx_window_t window, double* err_f32, double* err_q15)
+{
+    double mean = 0.0;
+    for (uint32_t n = 0U; n < num_samples; ++n)
+    {
+        mean += (double)in_f32[n];
+    }
+    mean /= (double)num_samples;
+
+    for (uint32_t k = 0U; k < (fft_size / 2U); ++k)
+    {
+        double re = 0.0;
+        double im = 0.0;
+
+        for (uint32_t n = 0U; n < num_samples; ++n)
+        {
+            double v = ((double)in_f32[n] - mean) *
+                       xensiv_bgt60trxx_window_value(window, n, num_samples);
+            double phi = (2.0 * TEST_PI * (double)k * (double)n) /
+                         (double)fft_size;
+            re += v * cos(phi);
+            im -= v * sin(phi);
+        }
+        re /= (double)fft_size;
+        im /= (double)fft_size;
+
+        *err_f32 = fmax(*err_f32, fabs(re - (double)out_f32[2U * k]));
+        *err_f32 = fmax(*err_f32, fabs(im - (double)out_f32[(2U * k) + 1U]));
+        *err_q15 = fmax(*err_q15, fabs((re * 8192.0) - (double)out_q15[2U * k]));
+        *err_q15 = fmax(*err_q15, fabs((im * 8192.0) - (double)out_q15[(2U * k) + 1U]));
+    }
+}
+
+
+int main(void)
+{
+    static const uint32_t lengths[] = { 7U, 64U, 100U, 128U, 256U, 512U };
+    double err_f32 = 0.0;
+    double err_q15 = 0.0;
+
+    for (uint32_t i = 0U; i < (sizeof(lengths) / sizeof(lengths[0])); ++i)
+    {
+        uint32_t num_samples = lengths[i];
+        uint32_t min_size = XENSIV_BGT60TRXX_RANGE_FFT_SIZE_MIN;
+        while (min_size < num_samples)
+        {
+            min_size *= 2U;
+        }
+
+        chirp_fill(num_samples);
+
+        for (uint32_t w = 0U; w <= (uint32_t)XENSIV_BGT60TRXX_WINDOW_BLACKMAN_HARRIS; ++w)
+        {
+            xensiv_bgt60trxx_window_t window = (xensiv_bgt60trxx_window_t)w;
+
+            for (uint32_t fft_size = min_size; fft_size <= (4U * min_size); fft_size *= 2U)
+            {
+                xensiv_bgt60trxx_range_t range_f32;
+                xensiv_bgt60trxx_range_t range_q15;
+
+                xensiv_bgt60trxx_range_init_f32(&range_f32, num_samples, fft_size, window,
+                                                table_f32);
+                xensiv_bgt60trxx_range_init_q15(&range_q15, num_samples, fft_size, window,
+                                                table_q15);
+                xensiv_bgt60trxx_range_chirp_f32(&range_f32, in_f32, out_f32);
+                xensiv_bgt60trxx_range_chirp_q15(&range_q15, in_q15, out_q15);
+
+                check_spectrum(num_samples, fft_size, window, &err_f32, &err_q15);
+            }
+        }
+    }
+
+    (void)printf("largest error against the DFT: float %.2g, fixed point %.2f LSB\n",
+                 err_f32, err_q15);
+    TEST_CHECK(err_f32 < MAX_ERROR_F32);
+    TEST_CHECK(err_q15 < MAX_ERROR_Q15);
+
+    return test_failures;
+}
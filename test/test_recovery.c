@@ -0,0 +1,170 @@
+/***********************************************************************************************//**
+ * \file test_recovery.c
+ *
+ * \brief
+ * Host test of the FIFO overflow recovery against the simulated sensor: the number of SPI
+ * transactions of xensiv_bgt60trxx_recover_fifo with and without register shadow, and the frame
+ * assembler recovering on its own from repeated overflows while delivering valid frames only.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2022 Infineon Technologies AG
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#include "test_common.h"
+
+#include "xensiv_bgt60trxx_frame.h"
+#include "xensiv_bgt60trxx_sim.h"
+
+#define FRAME_SIZE          (128U * 16U)
+#define CHUNK_SIZE          (512U)
+#define NUM_RING_FRAMES     (2U)
+#define NUM_FRAMES          (60U)
+
+static xensiv_bgt60trxx_sim_t sim;
+static xensiv_bgt60trxx_t dev;
+static xensiv_bgt60trxx_shadow_t shadow;
+static xensiv_bgt60trxx_frame_assembler_t fa;
+static uint16_t ring[NUM_RING_FRAMES * FRAME_SIZE];
+static xensiv_bgt60trxx_frame_info_t info[NUM_RING_FRAMES];
+static uint16_t samples[CHUNK_SIZE];
+
+static const xensiv_bgt60trxx_sim_config_t sim_cfg =
+{
+    .device = XENSIV_DEVICE_BGT60UTR11,
+    .data = XENSIV_BGT60TRXX_SIM_DATA_LFSR,
+    .sample_rate_hz = 2000000U,
+    .num_samples_per_chirp = 128U,
+    .num_chirps_per_frame = 16U,
+    .num_rx_antennas = 1U,
+    .frame_period_us = 5000U,
+    .spi_clock_hz = 25000000U,
+    .reset_polls = 0U
+};
+
+
+/* Overflows the FIFO and counts the transactions of the recovery, the reset completes at the
+   first poll */
+static void test_recover_fifo(bool use_shadow)
+{
+    xensiv_bgt60trxx_sim_init(&sim, &sim_cfg);
+    int32_t status = xensiv_bgt60trxx_init(&dev, &sim, false);
+    if (use_shadow)
+    {
+        xensiv_bgt60trxx_set_shadow(&dev, &shadow);
+    }
+    status |= xensiv_bgt60trxx_config(&dev, test_register_list, (uint32_t)TEST_NUM_REGS);
+    status |= xensiv_bgt60trxx_set_fifo_limit(&dev, CHUNK_SIZE);
+    status |= xensiv_bgt60trxx_start_frame(&dev, true);
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK == status);
+
+    xensiv_bgt60trxx_sim_advance(30000U);
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_GSR0_ERROR ==
+               xensiv_bgt60trxx_get_fifo_data(&dev, samples, CHUNK_SIZE));
+
+    uint32_t sfctl = sim.regs[XENSIV_BGT60TRXX_REG_SFCTL];
+    xensiv_bgt60trxx_sim_stats_t start = sim.stats;
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK == xensiv_bgt60trxx_recover_fifo(&dev));
+    uint32_t transactions = sim.stats.cs_assertions - start.cs_assertions;
+
+    (void)printf("recovery %s shadow: %" PRIu32 " transactions\n", use_shadow ? "with" : "without",
+                 transactions);
+    TEST_CHECK(transactions == (use_shadow ? 3U : 4U));
+    TEST_CHECK(sfctl == sim.regs[XENSIV_BGT60TRXX_REG_SFCTL]);
+    TEST_CHECK(sim.running);
+
+    /* the next chunk is read without error */
+    while (!xensiv_bgt60trxx_sim_irq(&sim))
+    {
+        xensiv_bgt60trxx_sim_advance(10U);
+    }
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK ==
+               xensiv_bgt60trxx_get_fifo_data(&dev, samples, CHUNK_SIZE));
+}
+
+
+/* The frame assembler recovers from 12 ms stalls, every frame delivered is a test sequence */
+static void test_frame_assembler(void)
+{
+    const xensiv_bgt60trxx_frame_geometry_t geometry = { 128U, 16U, 1U };
+    uint32_t frames = 0U;
+    uint32_t invalid = 0U;
+    uint32_t iter = 0U;
+    const xensiv_bgt60trxx_frame_info_t* frame_info = NULL;
+    uint32_t sequence = 0U;
+
+    xensiv_bgt60trxx_sim_init(&sim, &sim_cfg);
+    int32_t status = xensiv_bgt60trxx_init(&dev, &sim, false);
+    status |= xensiv_bgt60trxx_frame_assembler_init(&fa, &dev, &geometry, CHUNK_SIZE, ring,
+                                                    NUM_RING_FRAMES * FRAME_SIZE);
+    status |= xensiv_bgt60trxx_frame_assembler_enable_info(&fa, info, NUM_RING_FRAMES);
+    xensiv_bgt60trxx_frame_assembler_enable_recovery(&fa, true);
+    status |= xensiv_bgt60trxx_start_frame(&dev, true);
+
+    while ((frames < NUM_FRAMES) && (XENSIV_BGT60TRXX_STATUS_OK == status))
+    {
+        while (!xensiv_bgt60trxx_sim_irq(&sim))
+        {
+            xensiv_bgt60trxx_sim_advance(10U);
+        }
+
+        if ((++iter % 25U) == 0U)
+        {
+            xensiv_bgt60trxx_sim_advance(12000U);
+        }
+
+        status = xensiv_bgt60trxx_frame_assembler_read(&fa);
+
+        const uint16_t* frame;
+        while ((frame = xensiv_bgt60trxx_frame_assembler_get(&fa)) != NULL)
+        {
+            /* samples dropped by the sensor break the sequence within a frame */
+            uint16_t word = frame[0];
+            if (test_check_lfsr(frame, FRAME_SIZE, &word) != 0U)
+            {
+                ++invalid;
+            }
+
+            frame_info = xensiv_bgt60trxx_frame_assembler_get_info(&fa);
+            sequence = frame_info->sequence;
+            xensiv_bgt60trxx_frame_assembler_release(&fa);
+            ++frames;
+        }
+    }
+
+    uint32_t num_dropped = (frame_info != NULL) ? frame_info->num_dropped : 0U;
+    uint32_t num_recoveries = (frame_info != NULL) ? frame_info->num_recoveries : 0U;
+
+    (void)printf("%" PRIu32 " frames delivered, %" PRIu32 " invalid, %" PRIu32 " dropped, %"
+                 PRIu32 " recoveries, %" PRIu32 " generated\n", frames, invalid, num_dropped,
+                 num_recoveries, sim.stats.frames);
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK == status);
+    TEST_CHECK(NUM_FRAMES == frames);
+    TEST_CHECK(0U == invalid);
+    TEST_CHECK(num_recoveries > 0U);
+    TEST_CHECK(num_dropped > 0U);
+    TEST_CHECK(sequence == (frames + num_dropped));
+}
+
+
+int main(void)
+{
+    test_recover_fifo(false);
+    test_recover_fifo(true);
+    test_frame_assembler();
+
+    return test_failures;
+}
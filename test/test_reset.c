@@ -0,0 +1,129 @@
+/***********************************************************************************************//**
+ * \file test_reset.c
+ *
+ * \brief
+ * Host test of xensiv_bgt60trxx_soft_reset against the simulated sensor. A software reset puts
+ * the sensor in deep sleep mode, where STAT0 never reports ready, and must still complete after
+ * the settling delay. FSM and FIFO resets return as soon as MAIN clears, and a reset that never
+ * completes times out after XENSIV_BGT60TRXX_RESET_TIMEOUT_US. Built with and without
+ * XENSIV_BGT60TRXX_PLATFORM_DELAY_US, which shortens the hard reset and the polls to microseconds.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2022 Infineon Technologies AG
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#include "test_common.h"
+
+#include "xensiv_bgt60trxx_sim.h"
+
+#define SOFT_RESET_DELAY_US     (10000U)
+#define READY_DELAY_US          (200U)
+
+/* Upper bound of the short waits: microseconds with the hook, else rounded up to milliseconds */
+#if defined(XENSIV_BGT60TRXX_PLATFORM_DELAY_US)
+#define HARD_RESET_MAX_US       (10U)
+#define POLL_MAX_US             (100U)
+#else
+#define HARD_RESET_MAX_US       (3100U)
+#define POLL_MAX_US             (SOFT_RESET_DELAY_US)
+#endif
+
+static xensiv_bgt60trxx_sim_t sim;
+static xensiv_bgt60trxx_t dev;
+
+static const xensiv_bgt60trxx_sim_config_t sim_cfg =
+{
+    .device = XENSIV_DEVICE_BGT60TR13C,
+    .data = XENSIV_BGT60TRXX_SIM_DATA_LFSR,
+    .sample_rate_hz = 2000000U,
+    .num_samples_per_chirp = 128U,
+    .num_chirps_per_frame = 16U,
+    .num_rx_antennas = 1U,
+    .frame_period_us = 5000U,
+    .spi_clock_hz = 25000000U,
+    .reset_polls = 2U,
+    .ready_delay_us = READY_DELAY_US
+};
+
+
+/* Runs a reset, returns its duration in virtual microseconds */
+static uint64_t timed_reset(xensiv_bgt60trxx_reset_t reset_type, int32_t expected)
+{
+    uint64_t t0 = xensiv_bgt60trxx_sim_get_time();
+    TEST_CHECK(expected == xensiv_bgt60trxx_soft_reset(&dev, reset_type));
+    return (xensiv_bgt60trxx_sim_get_time() - t0) / 1000U;
+}
+
+
+static bool stat0_ready(void)
+{
+    uint32_t data = 0U;
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK ==
+               xensiv_bgt60trxx_get_reg(&dev, XENSIV_BGT60TRXX_REG_STAT0, &data));
+    return (data & XENSIV_BGT60TRXX_REG_STAT0_LDO_RDY_MSK) != 0U;
+}
+
+
+int main(void)
+{
+    xensiv_bgt60trxx_sim_init(&sim, &sim_cfg);
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK == xensiv_bgt60trxx_init(&dev, &sim, false));
+
+    /* hard reset: setup time, RST low pulse of at least 1 us and hold time */
+    uint32_t resets = sim.stats.resets;
+    uint64_t t0 = xensiv_bgt60trxx_sim_get_time();
+    xensiv_bgt60trxx_hard_reset(&dev);
+    uint64_t us = (xensiv_bgt60trxx_sim_get_time() - t0) / 1000U;
+    (void)printf("hard reset: %" PRIu64 " us\n", us);
+    TEST_CHECK((resets + 1U) == sim.stats.resets);
+    TEST_CHECK(us >= 3U);
+    TEST_CHECK(us <= HARD_RESET_MAX_US);
+
+    /* software reset: deep sleep mode, the settling delay and no STAT0 wait */
+    us = timed_reset(XENSIV_BGT60TRXX_RESET_SW, XENSIV_BGT60TRXX_STATUS_OK);
+    (void)printf("software reset: %" PRIu64 " us\n", us);
+    TEST_CHECK(us >= SOFT_RESET_DELAY_US);
+    TEST_CHECK(us < (2U * SOFT_RESET_DELAY_US));
+    xensiv_bgt60trxx_sim_advance(SOFT_RESET_DELAY_US);
+    TEST_CHECK(!stat0_ready());
+
+    /* the frame start leaves deep sleep mode */
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK ==
+               xensiv_bgt60trxx_config(&dev, test_register_list, (uint32_t)TEST_NUM_REGS));
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK == xensiv_bgt60trxx_start_frame(&dev, true));
+    xensiv_bgt60trxx_sim_advance(READY_DELAY_US);
+    TEST_CHECK(stat0_ready());
+
+    /* FSM reset: back to deep sleep mode without settling delay */
+    us = timed_reset(XENSIV_BGT60TRXX_RESET_FSM, XENSIV_BGT60TRXX_STATUS_OK);
+    (void)printf("FSM reset: %" PRIu64 " us\n", us);
+    TEST_CHECK(us < POLL_MAX_US);
+    TEST_CHECK(!stat0_ready());
+
+    us = timed_reset(XENSIV_BGT60TRXX_RESET_FIFO, XENSIV_BGT60TRXX_STATUS_OK);
+    (void)printf("FIFO reset: %" PRIu64 " us\n", us);
+    TEST_CHECK(us < POLL_MAX_US);
+
+    /* a reset that never completes */
+    sim.cfg.reset_polls = UINT32_MAX;
+    us = timed_reset(XENSIV_BGT60TRXX_RESET_FIFO, XENSIV_BGT60TRXX_STATUS_TIMEOUT_ERROR);
+    (void)printf("timeout: %" PRIu64 " us\n", us);
+    TEST_CHECK(us >= XENSIV_BGT60TRXX_RESET_TIMEOUT_US);
+    TEST_CHECK(us < (2U * XENSIV_BGT60TRXX_RESET_TIMEOUT_US));
+
+    return test_failures;
+}
@@ -0,0 +1,114 @@
+/***********************************************************************************************//**
+ * \file test_shadow.c
+ *
+ * \brief
+ * Host test of the register shadow against the simulated sensor. The same calls are made on a
+ * sensor with and without shadow: the register files must stay identical, while the shadow saves
+ * the read of each read-modify-write. Resets must invalidate the shadow.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2022 Infineon Technologies AG
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#include "test_common.h"
+
+#include <string.h>
+
+#include "xensiv_bgt60trxx_sim.h"
+
+#define NUM_ROUNDS          (10U)
+
+/* sensor 0 without, sensor 1 with shadow */
+static xensiv_bgt60trxx_sim_t sim[2];
+static xensiv_bgt60trxx_t dev[2];
+static xensiv_bgt60trxx_shadow_t shadow;
+
+static const xensiv_bgt60trxx_sim_config_t sim_cfg =
+{
+    .device = XENSIV_DEVICE_BGT60UTR11,
+    .data = XENSIV_BGT60TRXX_SIM_DATA_LFSR,
+    .sample_rate_hz = 2000000U,
+    .num_samples_per_chirp = 64U,
+    .num_chirps_per_frame = 2U,
+    .num_rx_antennas = 1U,
+    .frame_period_us = 5000U,
+    .reset_polls = 2U
+};
+
+
+/* Set FIFO limit, enable the test mode, start and stop: four read-modify-writes per round */
+static uint32_t run_rounds(uint32_t idx)
+{
+    uint32_t reads = sim[idx].stats.reg_reads;
+    int32_t status = XENSIV_BGT60TRXX_STATUS_OK;
+
+    for (uint32_t i = 0U; i < NUM_ROUNDS; ++i)
+    {
+        status |= xensiv_bgt60trxx_set_fifo_limit(&dev[idx], 128U);
+        status |= xensiv_bgt60trxx_enable_data_test_mode(&dev[idx], true);
+        status |= xensiv_bgt60trxx_start_frame(&dev[idx], true);
+        status |= xensiv_bgt60trxx_start_frame(&dev[idx], false);
+    }
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK == status);
+
+    return sim[idx].stats.reg_reads - reads;
+}
+
+
+int main(void)
+{
+    for (uint32_t i = 0U; i < 2U; ++i)
+    {
+        xensiv_bgt60trxx_sim_init(&sim[i], &sim_cfg);
+        TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK == xensiv_bgt60trxx_init(&dev[i], &sim[i], false));
+    }
+    xensiv_bgt60trxx_set_shadow(&dev[1], &shadow);
+
+    for (uint32_t i = 0U; i < 2U; ++i)
+    {
+        TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK ==
+                   xensiv_bgt60trxx_config(&dev[i], test_register_list, (uint32_t)TEST_NUM_REGS));
+    }
+
+    uint32_t reads_plain = run_rounds(0U);
+    uint32_t reads_shadow = run_rounds(1U);
+
+    (void)printf("register reads in %u rounds: %" PRIu32 " without, %" PRIu32 " with shadow\n",
+                 NUM_ROUNDS, reads_plain, reads_shadow);
+    TEST_CHECK((reads_plain - reads_shadow) == (4U * NUM_ROUNDS));
+    TEST_CHECK(0 == memcmp(sim[0].regs, sim[1].regs, sizeof(sim[0].regs)));
+
+    /* a hard reset clears the registers, the next read-modify-write reads the sensor again */
+    for (uint32_t i = 0U; i < 2U; ++i)
+    {
+        xensiv_bgt60trxx_hard_reset(&dev[i]);
+    }
+
+    uint32_t reads = sim[1].stats.reg_reads;
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK == xensiv_bgt60trxx_set_fifo_limit(&dev[0], 256U));
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK == xensiv_bgt60trxx_set_fifo_limit(&dev[1], 256U));
+    TEST_CHECK((sim[1].stats.reg_reads - reads) == 1U);
+    TEST_CHECK(0 == memcmp(sim[0].regs, sim[1].regs, sizeof(sim[0].regs)));
+
+    /* the shadow is filled again, the next frame start needs one read of MAIN only */
+    reads = sim[1].stats.reg_reads;
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK == xensiv_bgt60trxx_start_frame(&dev[1], true));
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK == xensiv_bgt60trxx_start_frame(&dev[1], true));
+    TEST_CHECK((sim[1].stats.reg_reads - reads) == 1U);
+
+    return test_failures;
+}
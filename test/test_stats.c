@@ -0,0 +1,151 @@
+/***********************************************************************************************//**
+ * \file test_stats.c
+ *
+ * \brief
+ * Host test of the driver statistics against the simulated sensor. The SPI counters of the driver
+ * must equal the bus counters of the simulator, errors must be counted once by type and the
+ * latencies must land in the histogram bucket of their duration. Built for the split, burst, raw
+ * and lock FIFO read paths.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2022 Infineon Technologies AG
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#include "test_common.h"
+
+#include "xensiv_bgt60trxx_sim.h"
+
+#define NUM_SAMPLES         (512U)
+#define NUM_READS           (50U)
+
+/* 768 bytes at 25 MHz take 246 us: latency bucket [128, 256) us */
+#define FIFO_READ_BUCKET    (8U)
+
+static xensiv_bgt60trxx_sim_t sim;
+static xensiv_bgt60trxx_t dev;
+static xensiv_bgt60trxx_stats_t stats;
+static xensiv_bgt60trxx_stats_t copy;
+
+static uint16_t samples[NUM_SAMPLES];
+
+static const xensiv_bgt60trxx_sim_config_t sim_cfg =
+{
+    .device = XENSIV_DEVICE_BGT60TR13C,
+    .data = XENSIV_BGT60TRXX_SIM_DATA_LFSR,
+    .sample_rate_hz = 2000000U,
+    .num_samples_per_chirp = 128U,
+    .num_chirps_per_frame = 4U,
+    .num_rx_antennas = 1U,
+    .frame_period_us = 5000U,
+    .spi_clock_hz = 25000000U,
+    .reset_polls = 3U
+};
+
+
+static uint32_t bucket_sum(const xensiv_bgt60trxx_stats_hist_t* hist)
+{
+    uint32_t sum = 0U;
+
+    for (uint32_t i = 0U; i < XENSIV_BGT60TRXX_STATS_HIST_BUCKETS; ++i)
+    {
+        sum += hist->buckets[i];
+    }
+
+    return sum;
+}
+
+
+int main(void)
+{
+    xensiv_bgt60trxx_sim_init(&sim, &sim_cfg);
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK == xensiv_bgt60trxx_init(&dev, &sim, false));
+    xensiv_bgt60trxx_set_stats(&dev, &stats);
+    xensiv_bgt60trxx_sim_stats_t start = sim.stats;
+
+    int32_t status = xensiv_bgt60trxx_config(&dev, test_register_list, (uint32_t)TEST_NUM_REGS);
+    status |= xensiv_bgt60trxx_set_fifo_limit(&dev, NUM_SAMPLES);
+    status |= xensiv_bgt60trxx_start_frame(&dev, true);
+    for (uint32_t i = 0U; i < NUM_READS; ++i)
+    {
+        while (!xensiv_bgt60trxx_sim_irq(&sim))
+        {
+            xensiv_bgt60trxx_sim_advance(10U);
+        }
+        status |= xensiv_bgt60trxx_get_fifo_data(&dev, samples, NUM_SAMPLES);
+    }
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK == status);
+
+    /* overflow */
+    xensiv_bgt60trxx_sim_advance(1000000U);
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_GSR0_ERROR ==
+               xensiv_bgt60trxx_get_fifo_data(&dev, samples, NUM_SAMPLES));
+
+    /* reset that never completes */
+    sim.cfg.reset_polls = UINT32_MAX;
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_TIMEOUT_ERROR ==
+               xensiv_bgt60trxx_soft_reset(&dev, XENSIV_BGT60TRXX_RESET_FIFO));
+
+    xensiv_bgt60trxx_get_stats(&dev, &copy);
+    const xensiv_bgt60trxx_stats_hist_t* fifo_read =
+        &copy.latency[XENSIV_BGT60TRXX_STATS_FIFO_READ];
+    const xensiv_bgt60trxx_stats_hist_t* config = &copy.latency[XENSIV_BGT60TRXX_STATS_CONFIG];
+    const xensiv_bgt60trxx_stats_hist_t* reset = &copy.latency[XENSIV_BGT60TRXX_STATS_SOFT_RESET];
+
+    (void)printf("%" PRIu32 " transactions, %" PRIu32 " transfers, %" PRIu64 " bytes, %" PRIu32
+                 " polls, FIFO read max %" PRIu32 " us\n", copy.cs_assertions, copy.transfers,
+                 copy.bytes, copy.reset_polls, fifo_read->max_us);
+    TEST_CHECK(copy.cs_assertions == (sim.stats.cs_assertions - start.cs_assertions));
+#if defined(XENSIV_BGT60TRXX_PLATFORM_SPI_BURST_READ)
+    /* the simulator implements the burst read as two transfers */
+    TEST_CHECK((copy.transfers + NUM_READS + 1U) == (sim.stats.transfers - start.transfers));
+#else
+    TEST_CHECK(copy.transfers == (sim.stats.transfers - start.transfers));
+#endif
+    TEST_CHECK(copy.bytes == (sim.stats.bytes - start.bytes));
+    TEST_CHECK(0U == copy.com_errors);
+    TEST_CHECK(1U == copy.gsr0_errors);
+    TEST_CHECK(1U == copy.fifo_overflows);
+    TEST_CHECK(1U == copy.timeout_errors);
+    TEST_CHECK(copy.reset_polls > 0U);
+
+    TEST_CHECK((NUM_READS + 1U) == fifo_read->count);
+    TEST_CHECK(fifo_read->count == bucket_sum(fifo_read));
+    TEST_CHECK(NUM_READS <= fifo_read->buckets[FIFO_READ_BUCKET]);
+    TEST_CHECK(fifo_read->max_us < (1UL << FIFO_READ_BUCKET));
+    TEST_CHECK(1U == config->count);
+    TEST_CHECK(1U == bucket_sum(config));
+    TEST_CHECK(reset->count >= 2U);
+    TEST_CHECK(reset->max_us >= XENSIV_BGT60TRXX_RESET_TIMEOUT_US);
+    TEST_CHECK(reset->sum_us >= reset->max_us);
+#if defined(XENSIV_BGT60TRXX_PLATFORM_LOCK)
+    TEST_CHECK(sim.stats.locks > 0U);
+#endif
+
+    /* enabling again clears, disabling stops counting */
+    xensiv_bgt60trxx_set_stats(&dev, &stats);
+    xensiv_bgt60trxx_get_stats(&dev, &copy);
+    TEST_CHECK(0U == copy.cs_assertions);
+    TEST_CHECK(0U == copy.latency[XENSIV_BGT60TRXX_STATS_FIFO_READ].count);
+
+    uint32_t data;
+    xensiv_bgt60trxx_set_stats(&dev, NULL);
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_OK ==
+               xensiv_bgt60trxx_get_reg(&dev, XENSIV_BGT60TRXX_REG_MAIN, &data));
+    TEST_CHECK(0U == stats.cs_assertions);
+
+    return test_failures;
+}
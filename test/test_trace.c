@@ -0,0 +1,223 @@
+/***********************************************************************************************//**
+ * \file test_trace.c
+ *
+ * \brief
+ * Host test of the SPI trace recorder and the replay platform. Built twice: with
+ * TEST_TRACE_RECORD the scenario runs on the simulated sensor and its log and results are saved
+ * to the working directory; otherwise the scenario runs on the replay of that log and must get
+ * the same statuses and samples without mismatch, while recording the replay must reproduce the
+ * log byte for byte. A changed register value must be reported as one mismatch.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2022 Infineon Technologies AG
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#include "test_common.h"
+
+#include <string.h>
+
+#include "xensiv_bgt60trxx_trace.h"
+#if defined(TEST_TRACE_RECORD)
+#include "xensiv_bgt60trxx_sim.h"
+#else
+#include "xensiv_bgt60trxx_replay.h"
+#endif
+
+#define LOG_FILE            "test_trace.log"
+#define RESULTS_FILE        "test_trace.res"
+
+#define NUM_SAMPLES         (512U)
+#define NUM_READS           (40U)
+#define MAX_LOG_SIZE        (128U * 1024U)
+
+/* Status and sample checksum per FIFO read, then the init, config, overflow and recovery */
+#define NUM_RESULTS         ((2U * NUM_READS) + 4U)
+
+static xensiv_bgt60trxx_t dev;
+static xensiv_bgt60trxx_trace_t trace;
+static uint8_t ring[4096];
+static uint8_t log_buf[MAX_LOG_SIZE];
+static uint32_t log_len;
+static uint16_t samples[NUM_SAMPLES];
+static uint32_t results[NUM_RESULTS];
+static uint32_t regs[TEST_NUM_REGS];
+
+#if defined(TEST_TRACE_RECORD)
+static xensiv_bgt60trxx_sim_t sim;
+
+static const xensiv_bgt60trxx_sim_config_t sim_cfg =
+{
+    .device = XENSIV_DEVICE_BGT60TR13C,
+    .data = XENSIV_BGT60TRXX_SIM_DATA_LFSR,
+    .sample_rate_hz = 2000000U,
+    .num_samples_per_chirp = 128U,
+    .num_chirps_per_frame = 16U,
+    .num_rx_antennas = 1U,
+    .frame_period_us = 5000U,
+    .spi_clock_hz = 25000000U,
+    .reset_polls = 2U
+};
+#else
+static xensiv_bgt60trxx_replay_t replay;
+static uint8_t ref_log[MAX_LOG_SIZE];
+static uint32_t ref_results[NUM_RESULTS];
+#endif
+
+
+/* Moves the recorded bytes from the ring buffer to the log */
+static void drain(void)
+{
+    log_len += xensiv_bgt60trxx_trace_read(&trace, &log_buf[log_len], MAX_LOG_SIZE - log_len);
+}
+
+
+/* Lets the sensor fill the FIFO, or overflow it; the replay has the data in the log */
+static void wait_fifo(bool overflow)
+{
+#if defined(TEST_TRACE_RECORD)
+    if (overflow)
+    {
+        xensiv_bgt60trxx_sim_advance(1000000U);
+    }
+    while (!xensiv_bgt60trxx_sim_irq(&sim))
+    {
+        xensiv_bgt60trxx_sim_advance(10U);
+    }
+#else
+    (void)overflow;
+#endif
+}
+
+
+static uint32_t checksum(const uint16_t* data, uint32_t len)
+{
+    uint32_t sum = 2166136261UL;
+
+    for (uint32_t i = 0U; i < len; ++i)
+    {
+        sum = (sum ^ data[i]) * 16777619UL;
+    }
+
+    return sum;
+}
+
+
+static void scenario(void* iface)
+{
+    uint32_t n = 0U;
+
+    xensiv_bgt60trxx_trace_init(&trace, ring, sizeof(ring));
+    xensiv_bgt60trxx_trace_start(&trace);
+    log_len = 0U;
+
+    results[n++] = (uint32_t)xensiv_bgt60trxx_init(&dev, iface, false);
+    drain();
+    results[n++] = (uint32_t)xensiv_bgt60trxx_config(&dev, regs, (uint32_t)TEST_NUM_REGS);
+    drain();
+    (void)xensiv_bgt60trxx_set_fifo_limit(&dev, NUM_SAMPLES);
+    (void)xensiv_bgt60trxx_start_frame(&dev, true);
+    drain();
+
+    for (uint32_t i = 0U; i < NUM_READS; ++i)
+    {
+        wait_fifo(false);
+        (void)memset(samples, 0, sizeof(samples));
+        results[n++] = (uint32_t)xensiv_bgt60trxx_get_fifo_data(&dev, samples, NUM_SAMPLES);
+        results[n++] = checksum(samples, NUM_SAMPLES);
+        drain();
+    }
+
+    wait_fifo(true);
+    results[n++] = (uint32_t)xensiv_bgt60trxx_get_fifo_data(&dev, samples, NUM_SAMPLES);
+    results[n++] = (uint32_t)xensiv_bgt60trxx_recover_fifo(&dev);
+    drain();
+
+    xensiv_bgt60trxx_trace_start(NULL);
+    TEST_CHECK(0U == xensiv_bgt60trxx_trace_get_dropped(&trace));
+}
+
+
+#if defined(TEST_TRACE_RECORD)
+static void save(const char* name, const void* data, size_t len)
+{
+    FILE* f = fopen(name, "wb");
+    TEST_CHECK(f != NULL);
+    if (f != NULL)
+    {
+        TEST_CHECK(len == fwrite(data, 1U, len, f));
+        (void)fclose(f);
+    }
+}
+
+
+#else // if defined(TEST_TRACE_RECORD)
+static size_t load(const char* name, void* data, size_t max_len)
+{
+    size_t len = 0U;
+    FILE* f = fopen(name, "rb");
+    TEST_CHECK(f != NULL);
+    if (f != NULL)
+    {
+        len = fread(data, 1U, max_len, f);
+        (void)fclose(f);
+    }
+
+    return len;
+}
+
+
+#endif // if defined(TEST_TRACE_RECORD)
+
+
+int main(void)
+{
+    (void)memcpy(regs, test_register_list, sizeof(regs));
+
+#if defined(TEST_TRACE_RECORD)
+    xensiv_bgt60trxx_sim_init(&sim, &sim_cfg);
+    scenario(&sim);
+    (void)printf("recorded %" PRIu32 " bytes\n", log_len);
+    TEST_CHECK(XENSIV_BGT60TRXX_STATUS_GSR0_ERROR == (int32_t)results[NUM_RESULTS - 2U]);
+    save(LOG_FILE, log_buf, log_len);
+    save(RESULTS_FILE, results, sizeof(results));
+#else
+    uint32_t ref_len = (uint32_t)load(LOG_FILE, ref_log, sizeof(ref_log));
+    TEST_CHECK(sizeof(ref_results) == load(RESULTS_FILE, ref_results, sizeof(ref_results)));
+
+    /* same accesses: same data, and the same log when recorded again */
+    xensiv_bgt60trxx_replay_init(&replay, ref_log, ref_len);
+    scenario(&replay);
+    (void)printf("replayed %" PRIu32 " records, %" PRIu32 " mismatches, %" PRIu32
+                 " divergences\n", replay.stats.records, replay.stats.mismatches,
+                 replay.stats.divergences);
+    TEST_CHECK(xensiv_bgt60trxx_replay_finished(&replay));
+    TEST_CHECK(0U == replay.stats.mismatches);
+    TEST_CHECK(0U == replay.stats.divergences);
+    TEST_CHECK(0 == memcmp(results, ref_results, sizeof(results)));
+    TEST_CHECK(ref_len == log_len);
+    TEST_CHECK(0 == memcmp(log_buf, ref_log, log_len));
+
+    /* one register configured differently */
+    regs[TEST_NUM_REGS / 2U] ^= 1U;
+    xensiv_bgt60trxx_replay_init(&replay, ref_log, ref_len);
+    scenario(&replay);
+    TEST_CHECK(1U == replay.stats.mismatches);
+    TEST_CHECK(0U == replay.stats.divergences);
+#endif // if defined(TEST_TRACE_RECORD)
+
+    return test_failures;
+}
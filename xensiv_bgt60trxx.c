@@ -24,11 +24,45 @@
  **************************************************************************************************/
 
 #include <stddef.h>
+#include <string.h>
 
 #include "xensiv_bgt60trxx.h"
 #include "xensiv_bgt60trxx_platform.h"
+#if defined(XENSIV_BGT60TRXX_FIFO_READ_RAW)
+#include "xensiv_bgt60trxx_unpack.h"
+#endif
+#if defined(XENSIV_BGT60TRXX_TRACE)
+#include "xensiv_bgt60trxx_trace.h"
+#endif
+
+/* FIFO read as burst command followed by a separate 12-bit payload read */
+#if !defined(XENSIV_BGT60TRXX_FIFO_READ_RAW) && !defined(XENSIV_BGT60TRXX_PLATFORM_SPI_BURST_READ)
+#define XENSIV_BGT60TRXX_FIFO_READ_SPLIT
+#endif
+
+/* Smallest raw FIFO read unpacked in place: the burst header needs the room of 8 samples */
+#if defined(XENSIV_BGT60TRXX_FIFO_READ_RAW)
+#define XENSIV_BGT60TRXX_FIFO_RAW_MIN_SAMPLES           \
+    (2U * XENSIV_BGT60TRXX_SPI_BURST_HEADER_SIZE_BYTES)
+#endif
+
+/* Bus accesses go through the trace recorder */
+#if defined(XENSIV_BGT60TRXX_TRACE)
+#define xensiv_bgt60trxx_platform_rst_set               xensiv_bgt60trxx_trace_rst_set
+#define xensiv_bgt60trxx_platform_spi_cs_set            xensiv_bgt60trxx_trace_spi_cs_set
+#define xensiv_bgt60trxx_platform_spi_transfer          xensiv_bgt60trxx_trace_spi_transfer
+#define xensiv_bgt60trxx_platform_spi_fifo_read         xensiv_bgt60trxx_trace_spi_fifo_read
+#define xensiv_bgt60trxx_platform_spi_burst_read        xensiv_bgt60trxx_trace_spi_burst_read
+#define xensiv_bgt60trxx_platform_spi_fifo_read_async   xensiv_bgt60trxx_trace_spi_fifo_read_async
+#define xensiv_bgt60trxx_platform_delay                 xensiv_bgt60trxx_trace_delay
+#define xensiv_bgt60trxx_platform_delay_us              xensiv_bgt60trxx_trace_delay_us
+#endif
 
 #define XENSIV_BGT60TRXX_SPI_REG_XFER_LEN_BYTES         (4U)
+/* RST low for at least 1000 ns, same setup and hold time around the pulse */
+#define XENSIV_BGT60TRXX_HARD_RESET_DELAY_US            (1U)
+#define XENSIV_BGT60TRXX_POLL_DELAY_MIN_US              (10U)
+#define XENSIV_BGT60TRXX_POLL_DELAY_MAX_US              (640U)
 #define XENSIV_BGT60TRXX_SOFT_RESET_DELAY_MS            (10U)
 
 #define XENSIV_BGT60TRXX_SPI_WR_OP_MSK                  (0x01000000UL)
@@ -46,6 +80,24 @@
 #define XENSIV_BGT60TRXX_SPI_BURST_MODE_RWB_POS         (16U)
 #define XENSIV_BGT60TRXX_SPI_BURST_MODE_LEN_MSK         (0x0000FE00UL)
 #define XENSIV_BGT60TRXX_SPI_BURST_MODE_LEN_POS         (9U)
+#define XENSIV_BGT60TRXX_SPI_BURST_MODE_LEN_MAX         (127U)
+#define XENSIV_BGT60TRXX_SPI_BURST_WORD_SIZE_BYTES      (3U)
+
+/* The register write buffer holds at least a command and the first word of a burst */
+#if (XENSIV_BGT60TRXX_REG_BURST_BUF_SIZE < \
+     (XENSIV_BGT60TRXX_SPI_REG_XFER_LEN_BYTES + XENSIV_BGT60TRXX_SPI_BURST_WORD_SIZE_BYTES))
+#error "XENSIV_BGT60TRXX_REG_BURST_BUF_SIZE must be at least 7"
+#endif
+
+/* Longest run of registers written with one burst command */
+#if (((XENSIV_BGT60TRXX_REG_BURST_BUF_SIZE - XENSIV_BGT60TRXX_SPI_REG_XFER_LEN_BYTES) / \
+      XENSIV_BGT60TRXX_SPI_BURST_WORD_SIZE_BYTES) < XENSIV_BGT60TRXX_SPI_BURST_MODE_LEN_MAX)
+#define XENSIV_BGT60TRXX_REG_BURST_MAX_RUN              \
+    ((XENSIV_BGT60TRXX_REG_BURST_BUF_SIZE - XENSIV_BGT60TRXX_SPI_REG_XFER_LEN_BYTES) / \
+     XENSIV_BGT60TRXX_SPI_BURST_WORD_SIZE_BYTES)
+#else
+#define XENSIV_BGT60TRXX_REG_BURST_MAX_RUN              (XENSIV_BGT60TRXX_SPI_BURST_MODE_LEN_MAX)
+#endif
 
 
 struct xensiv_bgt60trxx_type
@@ -74,6 +126,84 @@ static const struct xensiv_bgt60trxx_type bgt60trxx_types[] =
     }
 };
 
+/* Register writes coalesced into one SPI transaction */
+typedef struct
+{
+    uint8_t buf[XENSIV_BGT60TRXX_REG_BURST_BUF_SIZE];
+    uint32_t len;
+} reg_burst_t;
+
+static int32_t burst_flush(const xensiv_bgt60trxx_t* dev, reg_burst_t* burst);
+
+static int32_t burst_begin(const xensiv_bgt60trxx_t* dev, reg_burst_t* burst, uint32_t reg_addr,
+                           uint32_t run);
+
+static void burst_put(const xensiv_bgt60trxx_t* dev, reg_burst_t* burst, uint32_t reg_addr,
+                      uint32_t reg_data, uint32_t run);
+
+static int32_t write_regs(const xensiv_bgt60trxx_t* dev,
+                          const uint32_t* regs,
+                          uint32_t len,
+                          bool config);
+
+static bool preset_differs(const xensiv_bgt60trxx_t* dev, const xensiv_bgt60trxx_preset_t* preset,
+                           uint32_t reg_addr, uint32_t* reg_data);
+
+static int32_t write_preset(const xensiv_bgt60trxx_t* dev, const xensiv_bgt60trxx_preset_t* preset);
+
+static uint32_t config_reg_data(const xensiv_bgt60trxx_t* dev,
+                                uint32_t reg_addr,
+                                uint32_t reg_data);
+
+static uint32_t put_be(uint8_t* buf, uint32_t val, uint32_t num_bytes);
+
+static int32_t reg_write(const xensiv_bgt60trxx_t* dev, uint32_t reg_addr, uint32_t data);
+
+static int32_t reg_read(const xensiv_bgt60trxx_t* dev, uint32_t reg_addr, uint32_t* data);
+
+static int32_t get_reg_cached(const xensiv_bgt60trxx_t* dev, uint32_t reg_addr, uint32_t* data);
+
+static int32_t poll_reg(const xensiv_bgt60trxx_t* dev, uint32_t reg_addr, uint32_t msk,
+                        uint32_t value);
+
+static uint32_t wait_us(uint32_t us);
+
+static inline void dev_lock(const xensiv_bgt60trxx_t* dev);
+
+static inline void dev_unlock(const xensiv_bgt60trxx_t* dev);
+
+static int32_t check_gsr0(const xensiv_bgt60trxx_t* dev, uint32_t gsr0);
+
+static inline uint32_t stats_time(void);
+
+static inline void stats_xfer(const xensiv_bgt60trxx_t* dev, uint32_t cs_assertions,
+                              uint32_t bytes, int32_t status);
+
+static inline void stats_polls(const xensiv_bgt60trxx_t* dev, uint32_t polls, int32_t status);
+
+static inline void stats_latency(const xensiv_bgt60trxx_t* dev, xensiv_bgt60trxx_stats_op_t op,
+                                 uint32_t start);
+
+static inline bool shadow_cacheable(uint32_t reg_addr);
+
+static inline uint32_t shadow_value(uint32_t reg_addr, uint32_t data);
+
+static inline bool shadow_valid(const xensiv_bgt60trxx_shadow_t* shadow, uint32_t reg_addr);
+
+static void shadow_store(const xensiv_bgt60trxx_t* dev, uint32_t reg_addr, uint32_t data);
+
+static void shadow_invalidate(const xensiv_bgt60trxx_t* dev, uint32_t reg_addr);
+
+static void shadow_invalidate_all(const xensiv_bgt60trxx_t* dev);
+
+#if defined(XENSIV_BGT60TRXX_FIFO_READ_SPLIT)
+static int32_t fifo_burst_start(const xensiv_bgt60trxx_t* dev);
+
+#if defined(XENSIV_BGT60TRXX_PLATFORM_SPI_FIFO_READ_ASYNC)
+static void fifo_read_done(void* arg, int32_t status);
+#endif
+#endif
+
 static xensiv_bgt60trxx_device_t detect_device_type(uint32_t chipid)
 {
     uint32_t chip_id_digital = (chipid & XENSIV_BGT60TRXX_REG_CHIP_ID_DIGITAL_ID_MSK) >>
@@ -117,6 +247,10 @@ int32_t xensiv_bgt60trxx_init(xensiv_bgt60trxx_t* dev,
 
     dev->iface = iface;
     dev->high_speed = high_speed;
+    dev->shadow = NULL;
+#if defined(XENSIV_BGT60TRXX_STATS)
+    dev->stats = NULL;
+#endif
 
     //xensiv_bgt60trxx_hard_reset(dev);
 
@@ -163,42 +297,34 @@ int32_t xensiv_bgt60trxx_config(xensiv_bgt60trxx_t* dev,
     xensiv_bgt60trxx_platform_assert(dev != NULL);
     xensiv_bgt60trxx_platform_assert(regs != NULL);
 
+    uint32_t start = stats_time();
     int32_t status = xensiv_bgt60trxx_soft_reset(dev,
                                                  XENSIV_BGT60TRXX_RESET_SW);
 
     if (XENSIV_BGT60TRXX_STATUS_OK == status)
     {
         /* Apply register configuration */
-        for (uint32_t reg_idx = 0; reg_idx < len; ++reg_idx)
-        {
-            uint32_t val = regs[reg_idx];
-            uint32_t reg_addr = ((val & XENSIV_BGT60TRXX_SPI_REGADR_MSK) >>
-                                 XENSIV_BGT60TRXX_SPI_REGADR_POS);
-            uint32_t reg_data = ((val & XENSIV_BGT60TRXX_SPI_DATA_MSK) >>
-                                 XENSIV_BGT60TRXX_SPI_DATA_POS);
+        dev_lock(dev);
+        status = write_regs(dev, regs, len, true);
+        dev_unlock(dev);
+    }
 
-            if (reg_addr == XENSIV_BGT60TRXX_REG_SFCTL)
-            {
-                /* FIFO limit set by user */
-                reg_data &= (uint32_t) ~XENSIV_BGT60TRXX_REG_SFCTL_FIFO_CREF_MSK;
-                if (dev->high_speed)
-                {
-                    reg_data |= (uint32_t)XENSIV_BGT60TRXX_REG_SFCTL_MISO_HS_READ_MSK;
-                }
-                else
-                {
-                    reg_data &= (uint32_t) ~XENSIV_BGT60TRXX_REG_SFCTL_MISO_HS_READ_MSK;
-                }
-            }
+    stats_latency(dev, XENSIV_BGT60TRXX_STATS_CONFIG, start);
 
-            status = xensiv_bgt60trxx_set_reg(dev, reg_addr, reg_data);
+    return status;
+}
 
-            if (status != XENSIV_BGT60TRXX_STATUS_OK)
-            {
-                break;
-            }
-        }
-    }
+
+int32_t xensiv_bgt60trxx_set_regs(const xensiv_bgt60trxx_t* dev,
+                                  const uint32_t* regs,
+                                  uint32_t len)
+{
+    xensiv_bgt60trxx_platform_assert(dev != NULL);
+    xensiv_bgt60trxx_platform_assert(regs != NULL);
+
+    dev_lock(dev);
+    int32_t status = write_regs(dev, regs, len, false);
+    dev_unlock(dev);
 
     return status;
 }
@@ -208,19 +334,9 @@ int32_t xensiv_bgt60trxx_set_reg(const xensiv_bgt60trxx_t* dev, uint32_t reg_add
 {
     xensiv_bgt60trxx_platform_assert(dev != NULL);
 
-    uint32_t temp;
-    temp = (reg_addr << XENSIV_BGT60TRXX_SPI_REGADR_POS) & XENSIV_BGT60TRXX_SPI_REGADR_MSK;
-    temp |= XENSIV_BGT60TRXX_SPI_WR_OP_MSK;
-    temp |= (data << XENSIV_BGT60TRXX_SPI_DATA_POS) & XENSIV_BGT60TRXX_SPI_DATA_MSK;
-
-    temp = xensiv_bgt60trxx_platform_word_reverse(temp);
-
-    xensiv_bgt60trxx_platform_spi_cs_set(dev->iface, 0);
-    int32_t status = xensiv_bgt60trxx_platform_spi_transfer(dev->iface,
-                                                            (uint8_t*)&temp,
-                                                            NULL,
-                                                            XENSIV_BGT60TRXX_SPI_REG_XFER_LEN_BYTES);
-    xensiv_bgt60trxx_platform_spi_cs_set(dev->iface, 1);
+    dev_lock(dev);
+    int32_t status = reg_write(dev, reg_addr, data);
+    dev_unlock(dev);
 
     return status;
 }
@@ -231,22 +347,160 @@ int32_t xensiv_bgt60trxx_get_reg(const xensiv_bgt60trxx_t* dev, uint32_t reg_add
     xensiv_bgt60trxx_platform_assert(dev != NULL);
     xensiv_bgt60trxx_platform_assert(data != NULL);
 
-    uint32_t temp;
-    temp = (reg_addr << XENSIV_BGT60TRXX_SPI_REGADR_POS) & XENSIV_BGT60TRXX_SPI_REGADR_MSK;
+    dev_lock(dev);
+    int32_t status = reg_read(dev, reg_addr, data);
+    dev_unlock(dev);
 
-    temp = xensiv_bgt60trxx_platform_word_reverse(temp);
+    return status;
+}
 
-    xensiv_bgt60trxx_platform_spi_cs_set(dev->iface, 0);
-    int32_t status = xensiv_bgt60trxx_platform_spi_transfer(dev->iface,
-                                                            (uint8_t*)&temp,
-                                                            (uint8_t*)data,
-                                                            XENSIV_BGT60TRXX_SPI_REG_XFER_LEN_BYTES);
-    xensiv_bgt60trxx_platform_spi_cs_set(dev->iface, 1);
 
-    if (XENSIV_BGT60TRXX_STATUS_OK == status)
+void xensiv_bgt60trxx_set_shadow(xensiv_bgt60trxx_t* dev,
+                                 xensiv_bgt60trxx_shadow_t* shadow)
+{
+    xensiv_bgt60trxx_platform_assert(dev != NULL);
+
+    dev->shadow = shadow;
+    shadow_invalidate_all(dev);
+}
+
+
+#if defined(XENSIV_BGT60TRXX_STATS)
+void xensiv_bgt60trxx_set_stats(xensiv_bgt60trxx_t* dev,
+                                xensiv_bgt60trxx_stats_t* stats)
+{
+    xensiv_bgt60trxx_platform_assert(dev != NULL);
+
+    dev_lock(dev);
+    dev->stats = stats;
+    if (stats != NULL)
     {
-        *data = xensiv_bgt60trxx_platform_word_reverse(*data);
-        *data &= XENSIV_BGT60TRXX_SPI_DATA_MSK;
+        (void)memset(stats, 0, sizeof(*stats));
+    }
+    dev_unlock(dev);
+}
+
+
+void xensiv_bgt60trxx_get_stats(const xensiv_bgt60trxx_t* dev,
+                                xensiv_bgt60trxx_stats_t* stats)
+{
+    xensiv_bgt60trxx_platform_assert(dev != NULL);
+    xensiv_bgt60trxx_platform_assert(dev->stats != NULL);
+    xensiv_bgt60trxx_platform_assert(stats != NULL);
+
+    dev_lock(dev);
+    *stats = *dev->stats;
+    dev_unlock(dev);
+}
+
+
+#endif // defined(XENSIV_BGT60TRXX_STATS)
+
+void xensiv_bgt60trxx_preset_init(xensiv_bgt60trxx_preset_t* preset,
+                                  const uint32_t* regs,
+                                  uint32_t len)
+{
+    xensiv_bgt60trxx_platform_assert(preset != NULL);
+    xensiv_bgt60trxx_platform_assert(regs != NULL);
+
+    (void)memset(preset->valid, 0, sizeof(preset->valid));
+
+    for (uint32_t i = 0U; i < len; ++i)
+    {
+        uint32_t reg_addr = (regs[i] & XENSIV_BGT60TRXX_SPI_REGADR_MSK) >>
+                            XENSIV_BGT60TRXX_SPI_REGADR_POS;
+        xensiv_bgt60trxx_platform_assert(shadow_cacheable(reg_addr));
+
+        preset->regs[reg_addr] = shadow_value(reg_addr, regs[i]);
+        preset->valid[reg_addr / 32U] |= (1UL << (reg_addr % 32U));
+    }
+}
+
+
+void xensiv_bgt60trxx_preset_save(const xensiv_bgt60trxx_t* dev,
+                                  xensiv_bgt60trxx_preset_t* preset)
+{
+    xensiv_bgt60trxx_platform_assert(dev != NULL);
+    xensiv_bgt60trxx_platform_assert(dev->shadow != NULL);
+    xensiv_bgt60trxx_platform_assert(preset != NULL);
+
+    dev_lock(dev);
+    *preset = *dev->shadow;
+    dev_unlock(dev);
+}
+
+
+uint32_t xensiv_bgt60trxx_preset_diff(const xensiv_bgt60trxx_t* dev,
+                                      const xensiv_bgt60trxx_preset_t* preset,
+                                      uint32_t* regs)
+{
+    xensiv_bgt60trxx_platform_assert(dev != NULL);
+    xensiv_bgt60trxx_platform_assert(preset != NULL);
+    xensiv_bgt60trxx_platform_assert(regs != NULL);
+
+    uint32_t len = 0U;
+    uint32_t reg_data;
+
+    dev_lock(dev);
+
+    for (uint32_t reg_addr = 0U; reg_addr < XENSIV_BGT60TRXX_SHADOW_NUM_REGS; ++reg_addr)
+    {
+        if (preset_differs(dev, preset, reg_addr, &reg_data))
+        {
+            regs[len] = ((reg_addr << XENSIV_BGT60TRXX_SPI_REGADR_POS) &
+                         XENSIV_BGT60TRXX_SPI_REGADR_MSK) |
+                        ((reg_data << XENSIV_BGT60TRXX_SPI_DATA_POS) &
+                         XENSIV_BGT60TRXX_SPI_DATA_MSK);
+            ++len;
+        }
+    }
+
+    dev_unlock(dev);
+
+    return len;
+}
+
+
+int32_t xensiv_bgt60trxx_preset_apply(const xensiv_bgt60trxx_t* dev,
+                                      const xensiv_bgt60trxx_preset_t* preset)
+{
+    xensiv_bgt60trxx_platform_assert(dev != NULL);
+    xensiv_bgt60trxx_platform_assert(preset != NULL);
+
+    bool differs = false;
+    bool fifo_reset = false;
+    uint32_t reg_data;
+    int32_t status = XENSIV_BGT60TRXX_STATUS_OK;
+
+    /* The FSM latches the chirp, PLL and channel set configuration; only the FIFO and SPI
+     * control and the sensor ADC can change while frames are generated. The FIFO reset also
+     * resets the FSM and drops samples with the geometry of the previous configuration. */
+    dev_lock(dev);
+    for (uint32_t reg_addr = 0U; reg_addr < XENSIV_BGT60TRXX_SHADOW_NUM_REGS; ++reg_addr)
+    {
+        if (preset_differs(dev, preset, reg_addr, &reg_data))
+        {
+            differs = true;
+            if ((reg_addr != XENSIV_BGT60TRXX_REG_SFCTL) &&
+                (reg_addr != XENSIV_BGT60TRXX_REG_SADC_CTRL))
+            {
+                fifo_reset = true;
+            }
+        }
+    }
+    dev_unlock(dev);
+
+    if (fifo_reset)
+    {
+        status = xensiv_bgt60trxx_soft_reset(dev, XENSIV_BGT60TRXX_RESET_FIFO);
+    }
+
+    /* The difference is written straight into the burst buffer */
+    if ((XENSIV_BGT60TRXX_STATUS_OK == status) && differs)
+    {
+        dev_lock(dev);
+        status = write_preset(dev, preset);
+        dev_unlock(dev);
     }
 
     return status;
@@ -272,15 +526,18 @@ int32_t xensiv_bgt60trxx_set_fifo_limit(const xensiv_bgt60trxx_t* dev, uint32_t
     xensiv_bgt60trxx_platform_assert((num_samples / 2U) <= dev->type->fifo_size);
 
     uint32_t tmp;
-    int32_t retval = xensiv_bgt60trxx_get_reg(dev, XENSIV_BGT60TRXX_REG_SFCTL, &tmp);
+
+    dev_lock(dev);
+    int32_t retval = get_reg_cached(dev, XENSIV_BGT60TRXX_REG_SFCTL, &tmp);
 
     if (XENSIV_BGT60TRXX_STATUS_OK == retval)
     {
         tmp &= (uint32_t) ~XENSIV_BGT60TRXX_REG_SFCTL_FIFO_CREF_MSK;
         tmp |= (((num_samples / 2U) - 1U) << XENSIV_BGT60TRXX_REG_SFCTL_FIFO_CREF_POS) &
                XENSIV_BGT60TRXX_REG_SFCTL_FIFO_CREF_MSK;
-        retval = xensiv_bgt60trxx_set_reg(dev, XENSIV_BGT60TRXX_REG_SFCTL, tmp);
+        retval = reg_write(dev, XENSIV_BGT60TRXX_REG_SFCTL, tmp);
     }
+    dev_unlock(dev);
 
     return retval;
 }
@@ -294,37 +551,164 @@ int32_t xensiv_bgt60trxx_get_fifo_data(const xensiv_bgt60trxx_t* dev, uint16_t*
     xensiv_bgt60trxx_platform_assert((num_samples % 2U) == 0U);
     xensiv_bgt60trxx_platform_assert((num_samples / 2U) <= dev->type->fifo_size);
 
+    uint32_t start = stats_time();
+
+#if defined(XENSIV_BGT60TRXX_FIFO_READ_RAW)
+    /* Packed FIFO words are read into the end of the buffer and unpacked in place. Below 8
+     * samples the header does not fit in front of the packed words, these reads (e.g. the rest
+     * of a frame assembler chunk at the end of the ring buffer) go through a bounce buffer. */
+    uint8_t bounce[XENSIV_BGT60TRXX_FIFO_RAW_BUF_SIZE(XENSIV_BGT60TRXX_FIFO_RAW_MIN_SAMPLES)];
+    uint8_t* raw = bounce;
+
+    if (num_samples >= XENSIV_BGT60TRXX_FIFO_RAW_MIN_SAMPLES)
+    {
+        raw = (uint8_t*)&data[num_samples] - XENSIV_BGT60TRXX_FIFO_RAW_BUF_SIZE(num_samples);
+    }
+
+    int32_t retval = xensiv_bgt60trxx_get_fifo_data_raw(dev, raw, num_samples);
+
+    if (XENSIV_BGT60TRXX_STATUS_OK == retval)
+    {
+        xensiv_bgt60trxx_unpack_samples(&raw[XENSIV_BGT60TRXX_SPI_BURST_HEADER_SIZE_BYTES],
+                                        data, num_samples);
+    }
+#elif defined(XENSIV_BGT60TRXX_PLATFORM_SPI_BURST_READ)
     uint32_t gsr0;
     uint32_t reg_addr = XENSIV_BGT60TRXX_SPI_BURST_MODE_CMD |
                         (dev->type->fifo_addr << XENSIV_BGT60TRXX_SPI_BURST_MODE_SADR_POS);
 
     reg_addr = xensiv_bgt60trxx_platform_word_reverse(reg_addr);
 
-    /* SPI read burst mode command */
+    /* Burst command and FIFO payload issued by the platform as one transaction */
+    dev_lock(dev);
+    int32_t retval = xensiv_bgt60trxx_platform_spi_burst_read(dev->iface,
+                                                              (uint8_t*)&reg_addr,
+                                                              (uint8_t*)&gsr0,
+                                                              data,
+                                                              num_samples);
+    stats_xfer(dev, 1U, XENSIV_BGT60TRXX_SPI_REG_XFER_LEN_BYTES + ((num_samples / 2U) * 3U),
+               retval);
+
+    if (XENSIV_BGT60TRXX_STATUS_OK == retval)
+    {
+        retval = check_gsr0(dev, gsr0);
+    }
+    dev_unlock(dev);
+#else
+    dev_lock(dev);
+    int32_t retval = fifo_burst_start(dev);
+
+    if (XENSIV_BGT60TRXX_STATUS_OK == retval)
+    {
+        retval = xensiv_bgt60trxx_platform_spi_fifo_read(dev->iface,
+                                                         data,
+                                                         num_samples);
+        stats_xfer(dev, 0U, (num_samples / 2U) * 3U, retval);
+
+        xensiv_bgt60trxx_platform_spi_cs_set(dev->iface, true);
+    }
+    dev_unlock(dev);
+#endif // defined(XENSIV_BGT60TRXX_FIFO_READ_RAW)
+
+    stats_latency(dev, XENSIV_BGT60TRXX_STATS_FIFO_READ, start);
+
+    return retval;
+}
+
+
+int32_t xensiv_bgt60trxx_get_fifo_data_raw(const xensiv_bgt60trxx_t* dev, uint8_t* buf,
+                                           uint32_t num_samples)
+{
+    xensiv_bgt60trxx_platform_assert(dev != NULL);
+    xensiv_bgt60trxx_platform_assert(buf != NULL);
+    xensiv_bgt60trxx_platform_assert((num_samples % 2U) == 0U);
+    xensiv_bgt60trxx_platform_assert((num_samples / 2U) <= dev->type->fifo_size);
+
+    uint32_t len = XENSIV_BGT60TRXX_FIFO_RAW_BUF_SIZE(num_samples);
+
+    /* Burst command and FIFO payload in a single 8-bit transfer, done in place.
+     * TX is driven high while the payload is read. */
+    (void)put_be(buf,
+                 XENSIV_BGT60TRXX_SPI_BURST_MODE_CMD |
+                 (dev->type->fifo_addr << XENSIV_BGT60TRXX_SPI_BURST_MODE_SADR_POS),
+                 XENSIV_BGT60TRXX_SPI_BURST_HEADER_SIZE_BYTES);
+
+    for (uint32_t i = XENSIV_BGT60TRXX_SPI_BURST_HEADER_SIZE_BYTES; i < len; ++i)
+    {
+        buf[i] = 0xFFU;
+    }
+
+    dev_lock(dev);
     xensiv_bgt60trxx_platform_spi_cs_set(dev->iface, false);
 
-    int32_t retval = xensiv_bgt60trxx_platform_spi_transfer(dev->iface,
-                                                            (uint8_t*)&reg_addr,
-                                                            (uint8_t*)&gsr0,
-                                                            XENSIV_BGT60TRXX_SPI_REG_XFER_LEN_BYTES);
+    int32_t retval = xensiv_bgt60trxx_platform_spi_transfer(dev->iface, buf, buf, len);
+
+    xensiv_bgt60trxx_platform_spi_cs_set(dev->iface, true);
+    stats_xfer(dev, 1U, len, retval);
 
     if (XENSIV_BGT60TRXX_STATUS_OK == retval)
     {
-        if ((gsr0 & (XENSIV_BGT60TRXX_REG_GSR0_FOU_ERR_MSK |
-                     XENSIV_BGT60TRXX_REG_GSR0_SPI_BURST_ERR_MSK |
-                     XENSIV_BGT60TRXX_REG_GSR0_CLK_NUM_ERR_MSK)) == 0U)
-        {
-            retval = xensiv_bgt60trxx_platform_spi_fifo_read(dev->iface,
-                                                             data,
-                                                             num_samples);
-        }
-        else
+        retval = check_gsr0(dev, buf[0]);
+    }
+    dev_unlock(dev);
+
+    return retval;
+}
+
+
+int32_t xensiv_bgt60trxx_get_fifo_data_async(const xensiv_bgt60trxx_t* dev,
+                                             xensiv_bgt60trxx_fifo_xfer_t* xfer)
+{
+    xensiv_bgt60trxx_platform_assert(dev != NULL);
+    xensiv_bgt60trxx_platform_assert(xfer != NULL);
+    xensiv_bgt60trxx_platform_assert(xfer->data != NULL);
+    xensiv_bgt60trxx_platform_assert(xfer->callback != NULL);
+    xensiv_bgt60trxx_platform_assert((xfer->num_samples % 2U) == 0U);
+    xensiv_bgt60trxx_platform_assert((xfer->num_samples / 2U) <= dev->type->fifo_size);
+
+    xfer->iface = dev->iface;
+
+#if defined(XENSIV_BGT60TRXX_PLATFORM_SPI_FIFO_READ_ASYNC) && \
+    defined(XENSIV_BGT60TRXX_FIFO_READ_SPLIT)
+    dev_lock(dev);
+    int32_t retval = fifo_burst_start(dev);
+
+    if (XENSIV_BGT60TRXX_STATUS_OK == retval)
+    {
+        /* CS and the lock are released by fifo_read_done */
+        retval = xensiv_bgt60trxx_platform_spi_fifo_read_async(dev->iface,
+                                                               xfer->data,
+                                                               xfer->num_samples,
+                                                               fifo_read_done,
+                                                               xfer);
+        stats_xfer(dev, 0U, (xfer->num_samples / 2U) * 3U, retval);
+        if (XENSIV_BGT60TRXX_STATUS_OK != retval)
         {
-            retval = XENSIV_BGT60TRXX_STATUS_GSR0_ERROR;
+            xensiv_bgt60trxx_platform_spi_cs_set(dev->iface, true);
         }
     }
 
-    xensiv_bgt60trxx_platform_spi_cs_set(dev->iface, true);
+    if (XENSIV_BGT60TRXX_STATUS_OK != retval)
+    {
+        dev_unlock(dev);
+    }
+#else
+    int32_t retval = xensiv_bgt60trxx_get_fifo_data(dev, xfer->data, xfer->num_samples);
+
+    if (XENSIV_BGT60TRXX_STATUS_OK == retval)
+    {
+        xfer->status = retval;
+        xfer->callback(xfer);
+    }
+#endif
+
+    /* The FIFO error reported by GSR0 is delivered through the callback like the data */
+    if (XENSIV_BGT60TRXX_STATUS_GSR0_ERROR == retval)
+    {
+        xfer->status = retval;
+        xfer->callback(xfer);
+        retval = XENSIV_BGT60TRXX_STATUS_OK;
+    }
 
     return retval;
 }
@@ -341,6 +725,41 @@ int32_t xensiv_bgt60trxx_get_fifo_status(const xensiv_bgt60trxx_t* dev, uint32_t
 }
 
 
+int32_t xensiv_bgt60trxx_get_fifo_fill(const xensiv_bgt60trxx_t* dev, uint32_t* num_samples)
+{
+    xensiv_bgt60trxx_platform_assert(dev != NULL);
+    xensiv_bgt60trxx_platform_assert(num_samples != NULL);
+
+    uint32_t tmp;
+    int32_t retval = xensiv_bgt60trxx_get_reg(dev, dev->type->fifo_addr - 1U, &tmp);
+    if (XENSIV_BGT60TRXX_STATUS_OK == retval)
+    {
+        *num_samples = ((tmp & XENSIV_BGT60TRXX_REG_FSTAT_FILL_STATUS_MSK) >>
+                        XENSIV_BGT60TRXX_REG_FSTAT_FILL_STATUS_POS) *
+                       XENSIV_BGT60TRXX_NUM_SAMPLES_FIFO_WORD;
+    }
+
+    return retval;
+}
+
+
+int32_t xensiv_bgt60trxx_get_frame_count(const xensiv_bgt60trxx_t* dev, uint32_t* frame_cnt)
+{
+    xensiv_bgt60trxx_platform_assert(dev != NULL);
+    xensiv_bgt60trxx_platform_assert(frame_cnt != NULL);
+
+    uint32_t tmp;
+    int32_t retval = xensiv_bgt60trxx_get_reg(dev, XENSIV_BGT60TRXX_REG_STAT1, &tmp);
+    if (XENSIV_BGT60TRXX_STATUS_OK == retval)
+    {
+        *frame_cnt = (tmp & XENSIV_BGT60TRXX_REG_STAT1_FRAME_CNT_MSK) >>
+                     XENSIV_BGT60TRXX_REG_STAT1_FRAME_CNT_POS;
+    }
+
+    return retval;
+}
+
+
 int32_t xensiv_bgt60trxx_start_frame(const xensiv_bgt60trxx_t* dev, bool start)
 {
     xensiv_bgt60trxx_platform_assert(dev != NULL);
@@ -350,12 +769,14 @@ int32_t xensiv_bgt60trxx_start_frame(const xensiv_bgt60trxx_t* dev, bool start)
 
     if (start)
     {
-        status = xensiv_bgt60trxx_get_reg(dev, XENSIV_BGT60TRXX_REG_MAIN, &tmp);
+        dev_lock(dev);
+        status = get_reg_cached(dev, XENSIV_BGT60TRXX_REG_MAIN, &tmp);
         if (status == XENSIV_BGT60TRXX_STATUS_OK)
         {
             tmp |= XENSIV_BGT60TRXX_REG_MAIN_FRAME_START_MSK;
-            status = xensiv_bgt60trxx_set_reg(dev, XENSIV_BGT60TRXX_REG_MAIN, tmp);
+            status = reg_write(dev, XENSIV_BGT60TRXX_REG_MAIN, tmp);
         }
+        dev_unlock(dev);
     }
     else
     {
@@ -373,69 +794,107 @@ int32_t xensiv_bgt60trxx_soft_reset(const xensiv_bgt60trxx_t* dev,
 {
     xensiv_bgt60trxx_platform_assert(dev != NULL);
 
+    uint32_t start = stats_time();
     uint32_t tmp;
     int32_t status;
 
-    status = xensiv_bgt60trxx_get_reg(dev, XENSIV_BGT60TRXX_REG_MAIN, &tmp);
+    dev_lock(dev);
+    status = get_reg_cached(dev, XENSIV_BGT60TRXX_REG_MAIN, &tmp);
     if (XENSIV_BGT60TRXX_STATUS_OK == status)
     {
         tmp |= (uint32_t)reset_type;
-        status = xensiv_bgt60trxx_set_reg(dev, XENSIV_BGT60TRXX_REG_MAIN, tmp);
+        status = reg_write(dev, XENSIV_BGT60TRXX_REG_MAIN, tmp);
     }
 
-    uint32_t timeout = XENSIV_BGT60TRXX_RESET_WAIT_TIMEOUT;
-    if (XENSIV_BGT60TRXX_STATUS_OK == status)
+    if (((uint32_t)reset_type & (uint32_t)XENSIV_BGT60TRXX_RESET_SW) != 0U)
     {
-        while (timeout > 0U)
-        {
-            status = xensiv_bgt60trxx_get_reg(dev, XENSIV_BGT60TRXX_REG_MAIN, &tmp);
-            if ((XENSIV_BGT60TRXX_STATUS_OK == status) && ((tmp & (uint32_t)reset_type) == 0U))
-            {
-                break;
-            }
-            --timeout;
-        }
+        /* All registers are back to their default values */
+        shadow_invalidate_all(dev);
     }
+    dev_unlock(dev);
 
     if (XENSIV_BGT60TRXX_STATUS_OK == status)
     {
-        if (timeout == 0U)
-        {
-            status = XENSIV_BGT60TRXX_STATUS_TIMEOUT_ERROR;
-        }
-        else
-        {
-            xensiv_bgt60trxx_platform_delay(XENSIV_BGT60TRXX_SOFT_RESET_DELAY_MS);
-        }
+        status = poll_reg(dev, XENSIV_BGT60TRXX_REG_MAIN, (uint32_t)reset_type, 0U);
+    }
+
+    /* A software reset puts the sensor in deep sleep mode, where STAT0 does not report the LDO
+     * and the MADC ready until the next frame start, so it cannot be polled here. Settle for the
+     * fixed delay instead. The FSM and FIFO resets leave the configuration untouched. */
+    if ((XENSIV_BGT60TRXX_STATUS_OK == status) &&
+        (((uint32_t)reset_type & (uint32_t)XENSIV_BGT60TRXX_RESET_SW) != 0U))
+    {
+        xensiv_bgt60trxx_platform_delay(XENSIV_BGT60TRXX_SOFT_RESET_DELAY_MS);
     }
 
+    stats_latency(dev, XENSIV_BGT60TRXX_STATS_SOFT_RESET, start);
+
     return status;
 }
 
 
-int32_t xensiv_bgt60trxx_enable_data_test_mode(const xensiv_bgt60trxx_t* dev, bool enable)
+int32_t xensiv_bgt60trxx_recover_fifo(const xensiv_bgt60trxx_t* dev)
 {
     xensiv_bgt60trxx_platform_assert(dev != NULL);
 
     uint32_t tmp;
     int32_t status;
 
-    status = xensiv_bgt60trxx_get_reg(dev, XENSIV_BGT60TRXX_REG_SFCTL, &tmp);
+    /* The FIFO reset only clears the FIFO pointers and error flags and resets the FSM; the
+     * register configuration, including the FIFO compare reference, is kept and the settling
+     * delay of a software reset is not needed */
+    dev_lock(dev);
+    status = get_reg_cached(dev, XENSIV_BGT60TRXX_REG_MAIN, &tmp);
     if (XENSIV_BGT60TRXX_STATUS_OK == status)
     {
-        if (enable)
-        {
-            tmp |= XENSIV_BGT60TRXX_REG_SFCTL_LFSR_EN_MSK;
-        }
-        else
-        {
-            tmp &= (uint32_t) ~XENSIV_BGT60TRXX_REG_SFCTL_LFSR_EN_MSK;
-        }
+        tmp &= (uint32_t) ~(XENSIV_BGT60TRXX_REG_MAIN_RESET_MSK |
+                            XENSIV_BGT60TRXX_REG_MAIN_FRAME_START_MSK);
+        status = reg_write(dev, XENSIV_BGT60TRXX_REG_MAIN,
+                           tmp | (uint32_t)XENSIV_BGT60TRXX_RESET_FIFO);
+    }
+    dev_unlock(dev);
 
-        status = xensiv_bgt60trxx_set_reg(dev, XENSIV_BGT60TRXX_REG_SFCTL, tmp);
+    if (XENSIV_BGT60TRXX_STATUS_OK == status)
+    {
+        status = poll_reg(dev, XENSIV_BGT60TRXX_REG_MAIN, (uint32_t)XENSIV_BGT60TRXX_RESET_FIFO,
+                          0U);
     }
 
-    return status;
+    if (XENSIV_BGT60TRXX_STATUS_OK == status)
+    {
+        status = xensiv_bgt60trxx_set_reg(dev, XENSIV_BGT60TRXX_REG_MAIN,
+                                          tmp | XENSIV_BGT60TRXX_REG_MAIN_FRAME_START_MSK);
+    }
+
+    return status;
+}
+
+
+int32_t xensiv_bgt60trxx_enable_data_test_mode(const xensiv_bgt60trxx_t* dev, bool enable)
+{
+    xensiv_bgt60trxx_platform_assert(dev != NULL);
+
+    uint32_t tmp;
+    int32_t status;
+
+    dev_lock(dev);
+    status = get_reg_cached(dev, XENSIV_BGT60TRXX_REG_SFCTL, &tmp);
+    if (XENSIV_BGT60TRXX_STATUS_OK == status)
+    {
+        if (enable)
+        {
+            tmp |= XENSIV_BGT60TRXX_REG_SFCTL_LFSR_EN_MSK;
+        }
+        else
+        {
+            tmp &= (uint32_t) ~XENSIV_BGT60TRXX_REG_SFCTL_LFSR_EN_MSK;
+        }
+
+        status = reg_write(dev, XENSIV_BGT60TRXX_REG_SFCTL, tmp);
+    }
+    dev_unlock(dev);
+
+    return status;
 }
 
 
@@ -450,18 +909,22 @@ void xensiv_bgt60trxx_hard_reset(const xensiv_bgt60trxx_t* dev)
     xensiv_bgt60trxx_platform_assert(dev != NULL);
     xensiv_bgt60trxx_platform_assert(dev->iface != NULL);
 
+    dev_lock(dev);
     xensiv_bgt60trxx_platform_rst_set(dev->iface, true);
     xensiv_bgt60trxx_platform_spi_cs_set(dev->iface, true);
 
-    xensiv_bgt60trxx_platform_delay(1U);
+    (void)wait_us(XENSIV_BGT60TRXX_HARD_RESET_DELAY_US);
 
     xensiv_bgt60trxx_platform_rst_set(dev->iface, false);
 
-    xensiv_bgt60trxx_platform_delay(1U);
+    (void)wait_us(XENSIV_BGT60TRXX_HARD_RESET_DELAY_US);
 
     xensiv_bgt60trxx_platform_rst_set(dev->iface, true);
 
-    xensiv_bgt60trxx_platform_delay(1U);
+    (void)wait_us(XENSIV_BGT60TRXX_HARD_RESET_DELAY_US);
+
+    shadow_invalidate_all(dev);
+    dev_unlock(dev);
 }
 
 
@@ -475,3 +938,650 @@ uint16_t xensiv_bgt60trxx_get_next_test_word(uint16_t cur_test_word)
 
     return next_value;
 }
+
+
+/* Sends the register writes collected in the burst buffer in one SPI transaction */
+static int32_t burst_flush(const xensiv_bgt60trxx_t* dev, reg_burst_t* burst)
+{
+    int32_t status = XENSIV_BGT60TRXX_STATUS_OK;
+
+    if (burst->len > 0U)
+    {
+        xensiv_bgt60trxx_platform_spi_cs_set(dev->iface, false);
+        status = xensiv_bgt60trxx_platform_spi_transfer(dev->iface, burst->buf, NULL, burst->len);
+        xensiv_bgt60trxx_platform_spi_cs_set(dev->iface, true);
+        stats_xfer(dev, 1U, burst->len, status);
+        burst->len = 0U;
+    }
+
+    return status;
+}
+
+
+/* Makes room for the write of run consecutive registers from reg_addr, sending the buffer if
+   they do not fit, and adds the burst write command (with LEN set) of a run of two or more
+   registers. The run must not exceed XENSIV_BGT60TRXX_REG_BURST_MAX_RUN. */
+static int32_t burst_begin(const xensiv_bgt60trxx_t* dev, reg_burst_t* burst, uint32_t reg_addr,
+                           uint32_t run)
+{
+    uint32_t size = (run == 1U) ?
+                    XENSIV_BGT60TRXX_SPI_REG_XFER_LEN_BYTES :
+                    (XENSIV_BGT60TRXX_SPI_REG_XFER_LEN_BYTES +
+                     (run * XENSIV_BGT60TRXX_SPI_BURST_WORD_SIZE_BYTES));
+    int32_t status = XENSIV_BGT60TRXX_STATUS_OK;
+
+    if ((burst->len + size) > XENSIV_BGT60TRXX_REG_BURST_BUF_SIZE)
+    {
+        status = burst_flush(dev, burst);
+    }
+
+    if (run > 1U)
+    {
+        uint32_t temp = XENSIV_BGT60TRXX_SPI_BURST_MODE_CMD;
+        temp |= (reg_addr << XENSIV_BGT60TRXX_SPI_BURST_MODE_SADR_POS) &
+                XENSIV_BGT60TRXX_SPI_BURST_MODE_SADR_MSK;
+        temp |= XENSIV_BGT60TRXX_SPI_BURST_MODE_RWB_MSK;
+        temp |= (run << XENSIV_BGT60TRXX_SPI_BURST_MODE_LEN_POS) &
+                XENSIV_BGT60TRXX_SPI_BURST_MODE_LEN_MSK;
+        burst->len += put_be(&burst->buf[burst->len], temp,
+                             XENSIV_BGT60TRXX_SPI_REG_XFER_LEN_BYTES);
+    }
+
+    return status;
+}
+
+
+/* Adds the value of a register of the run begun with burst_begin: a regular write command for a
+   single register, else one 24-bit data word */
+static void burst_put(const xensiv_bgt60trxx_t* dev, reg_burst_t* burst, uint32_t reg_addr,
+                      uint32_t reg_data, uint32_t run)
+{
+    if (run == 1U)
+    {
+        uint32_t temp;
+        temp = (reg_addr << XENSIV_BGT60TRXX_SPI_REGADR_POS) & XENSIV_BGT60TRXX_SPI_REGADR_MSK;
+        temp |= XENSIV_BGT60TRXX_SPI_WR_OP_MSK;
+        temp |= (reg_data << XENSIV_BGT60TRXX_SPI_DATA_POS) & XENSIV_BGT60TRXX_SPI_DATA_MSK;
+        burst->len += put_be(&burst->buf[burst->len], temp,
+                             XENSIV_BGT60TRXX_SPI_REG_XFER_LEN_BYTES);
+    }
+    else
+    {
+        burst->len += put_be(&burst->buf[burst->len], reg_data,
+                             XENSIV_BGT60TRXX_SPI_BURST_WORD_SIZE_BYTES);
+    }
+    shadow_store(dev, reg_addr, reg_data);
+}
+
+
+/* Coalesces the register list into as few SPI transactions as the buffer allows.
+   Runs of consecutive addresses are sent as a burst write command followed by one 24-bit data
+   word per register, isolated registers as regular write commands. */
+static int32_t write_regs(const xensiv_bgt60trxx_t* dev,
+                          const uint32_t* regs,
+                          uint32_t len,
+                          bool config)
+{
+    reg_burst_t burst;
+    uint32_t reg_idx = 0U;
+    int32_t status = XENSIV_BGT60TRXX_STATUS_OK;
+
+    burst.len = 0U;
+
+    while ((reg_idx < len) && (XENSIV_BGT60TRXX_STATUS_OK == status))
+    {
+        uint32_t reg_addr = ((regs[reg_idx] & XENSIV_BGT60TRXX_SPI_REGADR_MSK) >>
+                             XENSIV_BGT60TRXX_SPI_REGADR_POS);
+
+        /* Find the run of consecutive register addresses */
+        uint32_t run = 1U;
+        while (((reg_idx + run) < len) &&
+               (run < XENSIV_BGT60TRXX_REG_BURST_MAX_RUN) &&
+               (((regs[reg_idx + run] & XENSIV_BGT60TRXX_SPI_REGADR_MSK) >>
+                 XENSIV_BGT60TRXX_SPI_REGADR_POS) == (reg_addr + run)))
+        {
+            ++run;
+        }
+
+        status = burst_begin(dev, &burst, reg_addr, run);
+
+        for (uint32_t i = 0U; i < run; ++i)
+        {
+            uint32_t reg_data = (regs[reg_idx + i] & XENSIV_BGT60TRXX_SPI_DATA_MSK) >>
+                                XENSIV_BGT60TRXX_SPI_DATA_POS;
+            if (config)
+            {
+                reg_data = config_reg_data(dev, reg_addr + i, reg_data);
+            }
+            burst_put(dev, &burst, reg_addr + i, reg_data, run);
+        }
+
+        reg_idx += run;
+    }
+
+    if (XENSIV_BGT60TRXX_STATUS_OK == status)
+    {
+        status = burst_flush(dev, &burst);
+    }
+
+    if (status != XENSIV_BGT60TRXX_STATUS_OK)
+    {
+        /* Unknown which registers were written */
+        shadow_invalidate_all(dev);
+    }
+
+    return status;
+}
+
+
+/* Returns true if a register of the preset is part of the difference to the register shadow and
+   sets *reg_data to the value to write, the lock must be held */
+static bool preset_differs(const xensiv_bgt60trxx_t* dev, const xensiv_bgt60trxx_preset_t* preset,
+                           uint32_t reg_addr, uint32_t* reg_data)
+{
+    const xensiv_bgt60trxx_shadow_t* shadow = dev->shadow;
+    bool differs = false;
+
+    if (shadow_valid(preset, reg_addr))
+    {
+        *reg_data = config_reg_data(dev, reg_addr, preset->regs[reg_addr]);
+        differs = ((shadow == NULL) || !shadow_valid(shadow, reg_addr) ||
+                   (shadow->regs[reg_addr] != shadow_value(reg_addr, *reg_data)));
+    }
+
+    return differs;
+}
+
+
+/* Writes the difference of the preset to the register shadow like write_regs, the lock must be
+   held */
+static int32_t write_preset(const xensiv_bgt60trxx_t* dev, const xensiv_bgt60trxx_preset_t* preset)
+{
+    reg_burst_t burst;
+    uint32_t reg_addr = 0U;
+    uint32_t reg_data;
+    int32_t status = XENSIV_BGT60TRXX_STATUS_OK;
+
+    burst.len = 0U;
+
+    while ((reg_addr < XENSIV_BGT60TRXX_SHADOW_NUM_REGS) &&
+           (XENSIV_BGT60TRXX_STATUS_OK == status))
+    {
+        if (preset_differs(dev, preset, reg_addr, &reg_data))
+        {
+            /* Find the run of consecutive registers that differ */
+            uint32_t run = 1U;
+            while (((reg_addr + run) < XENSIV_BGT60TRXX_SHADOW_NUM_REGS) &&
+                   (run < XENSIV_BGT60TRXX_REG_BURST_MAX_RUN) &&
+                   preset_differs(dev, preset, reg_addr + run, &reg_data))
+            {
+                ++run;
+            }
+
+            status = burst_begin(dev, &burst, reg_addr, run);
+
+            for (uint32_t i = 0U; i < run; ++i)
+            {
+                reg_data = config_reg_data(dev, reg_addr + i, preset->regs[reg_addr + i]);
+                burst_put(dev, &burst, reg_addr + i, reg_data, run);
+            }
+
+            reg_addr += run;
+        }
+        else
+        {
+            ++reg_addr;
+        }
+    }
+
+    if (XENSIV_BGT60TRXX_STATUS_OK == status)
+    {
+        status = burst_flush(dev, &burst);
+    }
+
+    if (status != XENSIV_BGT60TRXX_STATUS_OK)
+    {
+        shadow_invalidate_all(dev);
+    }
+
+    return status;
+}
+
+
+static uint32_t config_reg_data(const xensiv_bgt60trxx_t* dev,
+                                uint32_t reg_addr,
+                                uint32_t reg_data)
+{
+    if (reg_addr == XENSIV_BGT60TRXX_REG_SFCTL)
+    {
+        /* FIFO limit set by user */
+        reg_data &= (uint32_t) ~XENSIV_BGT60TRXX_REG_SFCTL_FIFO_CREF_MSK;
+        if (dev->high_speed)
+        {
+            reg_data |= (uint32_t)XENSIV_BGT60TRXX_REG_SFCTL_MISO_HS_READ_MSK;
+        }
+        else
+        {
+            reg_data &= (uint32_t) ~XENSIV_BGT60TRXX_REG_SFCTL_MISO_HS_READ_MSK;
+        }
+    }
+
+    return reg_data;
+}
+
+
+/* Stores the given number of least significant bytes of val MSB first */
+static uint32_t put_be(uint8_t* buf, uint32_t val, uint32_t num_bytes)
+{
+    for (uint32_t i = 0U; i < num_bytes; ++i)
+    {
+        buf[i] = (uint8_t)(val >> (8U * (num_bytes - 1U - i)));
+    }
+
+    return num_bytes;
+}
+
+
+/* Registers that change without being written or whose bits trigger actions are not held in
+   the shadow. For MAIN only the non-volatile bits are held. */
+static inline bool shadow_cacheable(uint32_t reg_addr)
+{
+    return ((reg_addr < XENSIV_BGT60TRXX_SHADOW_NUM_REGS) &&
+            (reg_addr != XENSIV_BGT60TRXX_REG_CHIP_ID) &&
+            (reg_addr != XENSIV_BGT60TRXX_REG_STAT1));
+}
+
+
+/* Value held in the shadow for a register value */
+static inline uint32_t shadow_value(uint32_t reg_addr, uint32_t data)
+{
+    if (reg_addr == XENSIV_BGT60TRXX_REG_MAIN)
+    {
+        data &= (uint32_t) ~(XENSIV_BGT60TRXX_REG_MAIN_RESET_MSK |
+                             XENSIV_BGT60TRXX_REG_MAIN_FRAME_START_MSK);
+    }
+
+    return data & XENSIV_BGT60TRXX_SPI_DATA_MSK;
+}
+
+
+static inline bool shadow_valid(const xensiv_bgt60trxx_shadow_t* shadow, uint32_t reg_addr)
+{
+    return ((shadow->valid[reg_addr / 32U] & (1UL << (reg_addr % 32U))) != 0U);
+}
+
+
+/* Writes a register, the lock must be held */
+static int32_t reg_write(const xensiv_bgt60trxx_t* dev, uint32_t reg_addr, uint32_t data)
+{
+    uint32_t temp;
+    temp = (reg_addr << XENSIV_BGT60TRXX_SPI_REGADR_POS) & XENSIV_BGT60TRXX_SPI_REGADR_MSK;
+    temp |= XENSIV_BGT60TRXX_SPI_WR_OP_MSK;
+    temp |= (data << XENSIV_BGT60TRXX_SPI_DATA_POS) & XENSIV_BGT60TRXX_SPI_DATA_MSK;
+
+    temp = xensiv_bgt60trxx_platform_word_reverse(temp);
+
+    xensiv_bgt60trxx_platform_spi_cs_set(dev->iface, 0);
+    int32_t status = xensiv_bgt60trxx_platform_spi_transfer(dev->iface,
+                                                            (uint8_t*)&temp,
+                                                            NULL,
+                                                            XENSIV_BGT60TRXX_SPI_REG_XFER_LEN_BYTES);
+    xensiv_bgt60trxx_platform_spi_cs_set(dev->iface, 1);
+    stats_xfer(dev, 1U, XENSIV_BGT60TRXX_SPI_REG_XFER_LEN_BYTES, status);
+
+    if (XENSIV_BGT60TRXX_STATUS_OK == status)
+    {
+        shadow_store(dev, reg_addr, data);
+    }
+    else
+    {
+        shadow_invalidate(dev, reg_addr);
+    }
+
+    return status;
+}
+
+
+/* Reads a register, the lock must be held */
+static int32_t reg_read(const xensiv_bgt60trxx_t* dev, uint32_t reg_addr, uint32_t* data)
+{
+    uint32_t temp;
+    temp = (reg_addr << XENSIV_BGT60TRXX_SPI_REGADR_POS) & XENSIV_BGT60TRXX_SPI_REGADR_MSK;
+
+    temp = xensiv_bgt60trxx_platform_word_reverse(temp);
+
+    xensiv_bgt60trxx_platform_spi_cs_set(dev->iface, 0);
+    int32_t status = xensiv_bgt60trxx_platform_spi_transfer(dev->iface,
+                                                            (uint8_t*)&temp,
+                                                            (uint8_t*)data,
+                                                            XENSIV_BGT60TRXX_SPI_REG_XFER_LEN_BYTES);
+    xensiv_bgt60trxx_platform_spi_cs_set(dev->iface, 1);
+    stats_xfer(dev, 1U, XENSIV_BGT60TRXX_SPI_REG_XFER_LEN_BYTES, status);
+
+    if (XENSIV_BGT60TRXX_STATUS_OK == status)
+    {
+        *data = xensiv_bgt60trxx_platform_word_reverse(*data);
+        *data &= XENSIV_BGT60TRXX_SPI_DATA_MSK;
+        shadow_store(dev, reg_addr, *data);
+    }
+
+    return status;
+}
+
+
+/* Reads a register from the shadow if held there, the lock must be held */
+static int32_t get_reg_cached(const xensiv_bgt60trxx_t* dev, uint32_t reg_addr, uint32_t* data)
+{
+    int32_t status = XENSIV_BGT60TRXX_STATUS_OK;
+    xensiv_bgt60trxx_shadow_t* shadow = dev->shadow;
+
+    if ((shadow != NULL) && shadow_cacheable(reg_addr) && shadow_valid(shadow, reg_addr))
+    {
+        *data = shadow->regs[reg_addr];
+    }
+    else
+    {
+        status = reg_read(dev, reg_addr, data);
+    }
+
+    return status;
+}
+
+
+/* Polls a register until the masked bits equal value, doubling the delay between polls, for
+   up to XENSIV_BGT60TRXX_RESET_TIMEOUT_US */
+static int32_t poll_reg(const xensiv_bgt60trxx_t* dev, uint32_t reg_addr, uint32_t msk,
+                        uint32_t value)
+{
+    uint32_t tmp;
+    uint32_t delay = XENSIV_BGT60TRXX_POLL_DELAY_MIN_US;
+    uint32_t elapsed = 0U;
+    uint32_t polls = 1U;
+#if defined(XENSIV_BGT60TRXX_PLATFORM_GET_TIME)
+    uint32_t start = xensiv_bgt60trxx_platform_get_time_us();
+#endif
+
+    int32_t status = xensiv_bgt60trxx_get_reg(dev, reg_addr, &tmp);
+
+    while ((XENSIV_BGT60TRXX_STATUS_OK == status) && ((tmp & msk) != value))
+    {
+        if (elapsed >= XENSIV_BGT60TRXX_RESET_TIMEOUT_US)
+        {
+            status = XENSIV_BGT60TRXX_STATUS_TIMEOUT_ERROR;
+        }
+        else
+        {
+#if defined(XENSIV_BGT60TRXX_PLATFORM_GET_TIME)
+            (void)wait_us(delay);
+            elapsed = xensiv_bgt60trxx_platform_get_time_us() - start;
+#else
+            elapsed += wait_us(delay);
+#endif
+            if (delay < XENSIV_BGT60TRXX_POLL_DELAY_MAX_US)
+            {
+                delay *= 2U;
+            }
+
+            status = xensiv_bgt60trxx_get_reg(dev, reg_addr, &tmp);
+            ++polls;
+        }
+    }
+
+    stats_polls(dev, polls, status);
+
+    return status;
+}
+
+
+/* Waits for at least the given time, returns the time waited */
+static uint32_t wait_us(uint32_t us)
+{
+#if defined(XENSIV_BGT60TRXX_PLATFORM_DELAY_US)
+    xensiv_bgt60trxx_platform_delay_us(us);
+
+    return us;
+#else
+    uint32_t ms = (us + 999U) / 1000U;
+    xensiv_bgt60trxx_platform_delay(ms);
+
+    return ms * 1000U;
+#endif
+}
+
+
+static inline void dev_lock(const xensiv_bgt60trxx_t* dev)
+{
+#if defined(XENSIV_BGT60TRXX_PLATFORM_LOCK)
+    xensiv_bgt60trxx_platform_lock(dev->iface);
+#else
+    (void)dev;
+#endif
+}
+
+
+static inline void dev_unlock(const xensiv_bgt60trxx_t* dev)
+{
+#if defined(XENSIV_BGT60TRXX_PLATFORM_LOCK)
+    xensiv_bgt60trxx_platform_unlock(dev->iface);
+#else
+    (void)dev;
+#endif
+}
+
+
+/* Checks the GSR0 status returned by a FIFO read, the lock must be held */
+static int32_t check_gsr0(const xensiv_bgt60trxx_t* dev, uint32_t gsr0)
+{
+    int32_t retval = XENSIV_BGT60TRXX_STATUS_OK;
+
+    if ((gsr0 & (XENSIV_BGT60TRXX_REG_GSR0_FOU_ERR_MSK |
+                 XENSIV_BGT60TRXX_REG_GSR0_SPI_BURST_ERR_MSK |
+                 XENSIV_BGT60TRXX_REG_GSR0_CLK_NUM_ERR_MSK)) != 0U)
+    {
+        retval = XENSIV_BGT60TRXX_STATUS_GSR0_ERROR;
+
+#if defined(XENSIV_BGT60TRXX_STATS)
+        if (dev->stats != NULL)
+        {
+            ++dev->stats->gsr0_errors;
+            if ((gsr0 & XENSIV_BGT60TRXX_REG_GSR0_FOU_ERR_MSK) != 0U)
+            {
+                ++dev->stats->fifo_overflows;
+            }
+        }
+#endif
+    }
+
+#if !defined(XENSIV_BGT60TRXX_STATS)
+    (void)dev;
+#endif
+
+    return retval;
+}
+
+
+/* Timestamp of the latency statistics */
+static inline uint32_t stats_time(void)
+{
+#if defined(XENSIV_BGT60TRXX_STATS) && defined(XENSIV_BGT60TRXX_PLATFORM_GET_TIME)
+    return xensiv_bgt60trxx_platform_get_time_us();
+#else
+    return 0U;
+#endif
+}
+
+
+/* Counts an SPI transfer, the lock must be held */
+static inline void stats_xfer(const xensiv_bgt60trxx_t* dev, uint32_t cs_assertions,
+                              uint32_t bytes, int32_t status)
+{
+#if defined(XENSIV_BGT60TRXX_STATS)
+    xensiv_bgt60trxx_stats_t* stats = dev->stats;
+
+    if (stats != NULL)
+    {
+        stats->cs_assertions += cs_assertions;
+        ++stats->transfers;
+        stats->bytes += bytes;
+        if (XENSIV_BGT60TRXX_STATUS_OK != status)
+        {
+            ++stats->com_errors;
+        }
+    }
+#else
+    (void)dev;
+    (void)cs_assertions;
+    (void)bytes;
+    (void)status;
+#endif
+}
+
+
+/* Counts the register reads of a wait for the sensor */
+static inline void stats_polls(const xensiv_bgt60trxx_t* dev, uint32_t polls, int32_t status)
+{
+#if defined(XENSIV_BGT60TRXX_STATS)
+    dev_lock(dev);
+    xensiv_bgt60trxx_stats_t* stats = dev->stats;
+
+    if (stats != NULL)
+    {
+        stats->reset_polls += polls;
+        if (XENSIV_BGT60TRXX_STATUS_TIMEOUT_ERROR == status)
+        {
+            ++stats->timeout_errors;
+        }
+    }
+    dev_unlock(dev);
+#else
+    (void)dev;
+    (void)polls;
+    (void)status;
+#endif
+}
+
+
+/* Adds the latency of an operation started at start to its histogram */
+static inline void stats_latency(const xensiv_bgt60trxx_t* dev, xensiv_bgt60trxx_stats_op_t op,
+                                 uint32_t start)
+{
+#if defined(XENSIV_BGT60TRXX_STATS) && defined(XENSIV_BGT60TRXX_PLATFORM_GET_TIME)
+    uint32_t latency = xensiv_bgt60trxx_platform_get_time_us() - start;
+    uint32_t bucket = 0U;
+
+    while (((latency >> bucket) != 0U) && (bucket < (XENSIV_BGT60TRXX_STATS_HIST_BUCKETS - 1U)))
+    {
+        ++bucket;
+    }
+
+    dev_lock(dev);
+    xensiv_bgt60trxx_stats_t* stats = dev->stats;
+
+    if (stats != NULL)
+    {
+        xensiv_bgt60trxx_stats_hist_t* hist = &stats->latency[op];
+
+        ++hist->count;
+        hist->sum_us += latency;
+        if (latency > hist->max_us)
+        {
+            hist->max_us = latency;
+        }
+        ++hist->buckets[bucket];
+    }
+    dev_unlock(dev);
+#else
+    (void)dev;
+    (void)op;
+    (void)start;
+#endif
+}
+
+
+static void shadow_store(const xensiv_bgt60trxx_t* dev, uint32_t reg_addr, uint32_t data)
+{
+    xensiv_bgt60trxx_shadow_t* shadow = dev->shadow;
+
+    if ((shadow != NULL) && shadow_cacheable(reg_addr))
+    {
+        shadow->regs[reg_addr] = shadow_value(reg_addr, data);
+        shadow->valid[reg_addr / 32U] |= (1UL << (reg_addr % 32U));
+    }
+}
+
+
+static void shadow_invalidate(const xensiv_bgt60trxx_t* dev, uint32_t reg_addr)
+{
+    xensiv_bgt60trxx_shadow_t* shadow = dev->shadow;
+
+    if ((shadow != NULL) && shadow_cacheable(reg_addr))
+    {
+        shadow->valid[reg_addr / 32U] &= (uint32_t) ~(1UL << (reg_addr % 32U));
+    }
+}
+
+
+static void shadow_invalidate_all(const xensiv_bgt60trxx_t* dev)
+{
+    xensiv_bgt60trxx_shadow_t* shadow = dev->shadow;
+
+    if (shadow != NULL)
+    {
+        for (uint32_t i = 0U; i < (sizeof(shadow->valid) / sizeof(shadow->valid[0])); ++i)
+        {
+            shadow->valid[i] = 0U;
+        }
+    }
+}
+
+
+#if defined(XENSIV_BGT60TRXX_FIFO_READ_SPLIT)
+/* Asserts CS and sends the FIFO burst read command. CS is left asserted on success. */
+static int32_t fifo_burst_start(const xensiv_bgt60trxx_t* dev)
+{
+    uint32_t gsr0;
+    uint32_t reg_addr = XENSIV_BGT60TRXX_SPI_BURST_MODE_CMD |
+                        (dev->type->fifo_addr << XENSIV_BGT60TRXX_SPI_BURST_MODE_SADR_POS);
+
+    reg_addr = xensiv_bgt60trxx_platform_word_reverse(reg_addr);
+
+    /* SPI read burst mode command */
+    xensiv_bgt60trxx_platform_spi_cs_set(dev->iface, false);
+
+    int32_t retval = xensiv_bgt60trxx_platform_spi_transfer(dev->iface,
+                                                            (uint8_t*)&reg_addr,
+                                                            (uint8_t*)&gsr0,
+                                                            XENSIV_BGT60TRXX_SPI_REG_XFER_LEN_BYTES);
+    stats_xfer(dev, 1U, XENSIV_BGT60TRXX_SPI_REG_XFER_LEN_BYTES, retval);
+
+    if (XENSIV_BGT60TRXX_STATUS_OK == retval)
+    {
+        retval = check_gsr0(dev, gsr0);
+    }
+
+    if (XENSIV_BGT60TRXX_STATUS_OK != retval)
+    {
+        xensiv_bgt60trxx_platform_spi_cs_set(dev->iface, true);
+    }
+
+    return retval;
+}
+
+
+#if defined(XENSIV_BGT60TRXX_PLATFORM_SPI_FIFO_READ_ASYNC)
+static void fifo_read_done(void* arg, int32_t status)
+{
+    xensiv_bgt60trxx_fifo_xfer_t* xfer = arg;
+
+    xensiv_bgt60trxx_platform_spi_cs_set(xfer->iface, true);
+#if defined(XENSIV_BGT60TRXX_PLATFORM_LOCK)
+    xensiv_bgt60trxx_platform_unlock(xfer->iface);
+#endif
+
+    xfer->status = status;
+    xfer->callback(xfer);
+}
+
+
+#endif // defined(XENSIV_BGT60TRXX_PLATFORM_SPI_FIFO_READ_ASYNC)
+#endif // defined(XENSIV_BGT60TRXX_FIFO_READ_SPLIT)
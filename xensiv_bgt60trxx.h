@@ -38,6 +38,9 @@
  * - set the FIFO level-filling threshold
  * - enable/disable the data test mode
  * - software reset the sensor
+ * - switch between register presets writing only the registers that differ
+ * - access the sensor from several threads, with optional lock platform functions
+ * - collect optional statistics of the SPI transactions, errors and latencies
  *
  * More information about the XENSIV(TM) BGT60TRxx 60GHz FMCW radar sensors is available at:
  * https://www.infineon.com/cms/de/product/sensor/radar-sensors/radar-sensors-for-iot/60ghz-radar/
@@ -61,6 +64,10 @@
 #define XENSIV_BGT60TRXX_STATUS_TIMEOUT_ERROR           (3)
 /** Result code indicating that an error occurred while reading from FIFO. */
 #define XENSIV_BGT60TRXX_STATUS_GSR0_ERROR              (4)
+/** Result code indicating that a caller-provided buffer cannot hold the data. */
+#define XENSIV_BGT60TRXX_STATUS_BUFFER_FULL             (5)
+/** Result code indicating that data does not have the expected format. */
+#define XENSIV_BGT60TRXX_STATUS_FORMAT_ERROR            (6)
 
 /** Initial value of the LFSR test sequence generator. */
 #define XENSIV_BGT60TRXX_INITIAL_TEST_WORD              (0x0001U)
@@ -74,9 +81,44 @@
 /** Size of the header in the SPI burst transfer. */
 #define XENSIV_BGT60TRXX_SPI_BURST_HEADER_SIZE_BYTES    (4U)
 
-/** Timeout for wait on software reset done. */
-#ifndef XENSIV_BGT60TRXX_RESET_WAIT_TIMEOUT
-#define XENSIV_BGT60TRXX_RESET_WAIT_TIMEOUT             (0xFFFFFFFFU)
+/** Largest value of the frame counter, see \ref xensiv_bgt60trxx_get_frame_count. */
+#define XENSIV_BGT60TRXX_FRAME_CNT_MAX                  \
+    (XENSIV_BGT60TRXX_REG_STAT1_FRAME_CNT_MSK >> XENSIV_BGT60TRXX_REG_STAT1_FRAME_CNT_POS)
+
+/** Size in bytes of the buffer passed to \ref xensiv_bgt60trxx_get_fifo_data_raw. */
+#define XENSIV_BGT60TRXX_FIFO_RAW_BUF_SIZE(num_samples) \
+    (XENSIV_BGT60TRXX_SPI_BURST_HEADER_SIZE_BYTES +     \
+     (((num_samples) / XENSIV_BGT60TRXX_NUM_SAMPLES_FIFO_WORD) * \
+      XENSIV_BGT60TRXX_FIFO_WORD_SIZE_BYTES))
+
+/** Timeout in microseconds for the reset bits of MAIN to clear in \ref xensiv_bgt60trxx_soft_reset
+ * and \ref xensiv_bgt60trxx_recover_fifo. Measured with xensiv_bgt60trxx_platform_get_time_us if
+ * XENSIV_BGT60TRXX_PLATFORM_GET_TIME is defined, else as the sum of the delays between polls. */
+#ifndef XENSIV_BGT60TRXX_RESET_TIMEOUT_US
+#if defined(XENSIV_BGT60TRXX_RESET_WAIT_TIMEOUT)
+/* Deprecated: the previous poll count is taken as the timeout in microseconds */
+#define XENSIV_BGT60TRXX_RESET_TIMEOUT_US               (XENSIV_BGT60TRXX_RESET_WAIT_TIMEOUT)
+#else
+#define XENSIV_BGT60TRXX_RESET_TIMEOUT_US               (100000U)
+#endif
+#endif
+
+/** Size of the buffer used to coalesce register writes into a single SPI transaction.
+ * Runs of consecutive register addresses are written using the SPI burst mode.
+ * The smallest value, 7, disables the coalescing, every register is written in its own
+ * transaction. */
+#ifndef XENSIV_BGT60TRXX_REG_BURST_BUF_SIZE
+#define XENSIV_BGT60TRXX_REG_BURST_BUF_SIZE             (256U)
+#endif
+
+/** Number of registers held by the register shadow, all registers below STAT0 */
+#define XENSIV_BGT60TRXX_SHADOW_NUM_REGS                (XENSIV_BGT60TRXX_REG_STAT0)
+
+/** Number of buckets of the latency histograms of the driver statistics. Bucket 0 counts the
+ * latencies below 1 us, bucket i the latencies from 2^(i-1) to 2^i - 1 us and the last bucket
+ * all longer latencies. */
+#ifndef XENSIV_BGT60TRXX_STATS_HIST_BUCKETS
+#define XENSIV_BGT60TRXX_STATS_HIST_BUCKETS             (20U)
 #endif
 
 /********************************* Type definitions **************************************/
@@ -113,6 +155,106 @@ typedef enum
 struct xensiv_bgt60trxx_type;
 /** \endcond */
 
+/** Write-through shadow of the writable sensor registers.
+ * Enabled using \ref xensiv_bgt60trxx_set_shadow. The content is populated by register writes
+ * and reads, and invalidated by a software or hardware reset.
+ *
+ * Application code should not rely on the specific content of this struct.
+ */
+typedef struct
+{
+    uint32_t regs[XENSIV_BGT60TRXX_SHADOW_NUM_REGS]; /**< Last value written or read */
+    uint32_t valid[(XENSIV_BGT60TRXX_SHADOW_NUM_REGS + 31U) / 32U]; /**< Valid flag per register */
+} xensiv_bgt60trxx_shadow_t;
+
+/** Register preset, an image of the writable registers of one sensor configuration.
+ * Built from a configurator list with \ref xensiv_bgt60trxx_preset_init or saved from the register
+ * shadow with \ref xensiv_bgt60trxx_preset_save, and applied with
+ * \ref xensiv_bgt60trxx_preset_apply. Uses the layout of the register shadow, the valid flags
+ * mark the registers held by the preset.
+ */
+typedef xensiv_bgt60trxx_shadow_t xensiv_bgt60trxx_preset_t;
+
+/** Operations timed by the driver statistics, index of the latency histograms */
+typedef enum
+{
+    XENSIV_BGT60TRXX_STATS_FIFO_READ = 0,   /**< \ref xensiv_bgt60trxx_get_fifo_data */
+    XENSIV_BGT60TRXX_STATS_CONFIG = 1,      /**< \ref xensiv_bgt60trxx_config */
+    XENSIV_BGT60TRXX_STATS_SOFT_RESET = 2,  /**< \ref xensiv_bgt60trxx_soft_reset */
+    XENSIV_BGT60TRXX_STATS_NUM_OPS = 3      /**< Number of timed operations */
+} xensiv_bgt60trxx_stats_op_t;
+
+/** Latency histogram of an operation, see \ref XENSIV_BGT60TRXX_STATS_HIST_BUCKETS */
+typedef struct
+{
+    uint32_t count;                         /**< Number of calls */
+    uint32_t max_us;                        /**< Longest latency */
+    uint64_t sum_us;                        /**< Sum of the latencies */
+    uint32_t buckets[XENSIV_BGT60TRXX_STATS_HIST_BUCKETS]; /**< Calls per latency bucket */
+} xensiv_bgt60trxx_stats_hist_t;
+
+/** Driver statistics of a sensor.
+ * Available if XENSIV_BGT60TRXX_STATS is defined, enabled using \ref xensiv_bgt60trxx_set_stats.
+ * The latency histograms require XENSIV_BGT60TRXX_PLATFORM_GET_TIME, otherwise they stay empty.
+ */
+typedef struct
+{
+    uint32_t cs_assertions;     /**< SPI transactions framed by the SPI CS */
+    uint32_t transfers;         /**< Platform SPI transfers, the FIFO burst command and the FIFO
+                                     payload count as two if read separately */
+    uint64_t bytes;             /**< Bytes transferred, FIFO samples count 1.5 bytes */
+    uint32_t com_errors;        /**< Transfers failed with XENSIV_BGT60TRXX_STATUS_COM_ERROR */
+    uint32_t timeout_errors;    /**< Waits for the sensor failed with
+                                     XENSIV_BGT60TRXX_STATUS_TIMEOUT_ERROR */
+    uint32_t gsr0_errors;       /**< FIFO reads failed with XENSIV_BGT60TRXX_STATUS_GSR0_ERROR */
+    uint32_t fifo_overflows;    /**< FIFO reads reporting a FIFO overflow or underflow in GSR0 */
+    uint32_t reset_polls;       /**< Register reads while waiting for a reset or the sensor */
+    xensiv_bgt60trxx_stats_hist_t latency[XENSIV_BGT60TRXX_STATS_NUM_OPS]; /**< Latency per
+                                                                               operation */
+} xensiv_bgt60trxx_stats_t;
+
+/** Frame geometry, use the values of the register configuration, e.g.
+ * \code
+ * xensiv_bgt60trxx_frame_geometry_t geometry =
+ * {
+ *     .num_samples_per_chirp = XENSIV_BGT60TRXX_CONF_NUM_SAMPLES_PER_CHIRP,
+ *     .num_chirps_per_frame = XENSIV_BGT60TRXX_CONF_NUM_CHIRPS_PER_FRAME,
+ *     .num_rx_antennas = XENSIV_BGT60TRXX_CONF_NUM_RX_ANTENNAS
+ * };
+ * \endcode
+ */
+typedef struct
+{
+    uint32_t num_samples_per_chirp; /**< Samples per chirp and RX antenna */
+    uint32_t num_chirps_per_frame; /**< Chirps per frame */
+    uint32_t num_rx_antennas; /**< Active RX antennas, samples are interleaved per chirp */
+} xensiv_bgt60trxx_frame_geometry_t;
+
+/** Asynchronous FIFO read request, see \ref xensiv_bgt60trxx_get_fifo_data_async */
+typedef struct xensiv_bgt60trxx_fifo_xfer xensiv_bgt60trxx_fifo_xfer_t;
+
+/** Completion callback of an asynchronous FIFO read.
+ * Called once the FIFO payload has been received and the SPI CS released, typically from
+ * interrupt context. The result is available in the status member of the request.
+ */
+typedef void (* xensiv_bgt60trxx_fifo_callback_t)(xensiv_bgt60trxx_fifo_xfer_t* xfer);
+
+/** Asynchronous FIFO read request.
+ * The request and the data buffer are owned by the driver from the call to
+ * \ref xensiv_bgt60trxx_get_fifo_data_async until the callback is invoked.
+ */
+struct xensiv_bgt60trxx_fifo_xfer
+{
+    uint16_t* data; /**< Buffer receiving the samples */
+    uint32_t num_samples; /**< Number of samples to read */
+    xensiv_bgt60trxx_fifo_callback_t callback; /**< Completion callback */
+    void* callback_arg; /**< User argument, not used by the driver */
+    volatile int32_t status; /**< Result of the read, valid when the callback is invoked */
+    /** \cond INTERNAL */
+    void* iface;
+    /** \endcond */
+};
+
 /** XENSIV(TM) BGT60TRxx sensor device object.
  *
  * Application code should not rely on the specific content of this struct.
@@ -125,6 +267,10 @@ typedef struct
                       xensiv_bgt60trxx_platform_spi_transfer function */
     const struct xensiv_bgt60trxx_type* type; /**< Device type detected during initialization */
     bool high_speed; /**< SPI speed mode */
+    xensiv_bgt60trxx_shadow_t* shadow; /**< Register shadow, NULL if disabled */
+#if defined(XENSIV_BGT60TRXX_STATS)
+    xensiv_bgt60trxx_stats_t* stats; /**< Driver statistics, NULL if disabled */
+#endif
 } xensiv_bgt60trxx_t;
 
 /******************************* Function prototypes *************************************/
@@ -189,6 +335,23 @@ int32_t xensiv_bgt60trxx_set_reg(const xensiv_bgt60trxx_t* dev,
                                  uint32_t reg_addr,
                                  uint32_t data);
 
+/**
+ * @brief Writes a list of registers into the sensor device.
+ * The list uses the format of the configuration registers list generated by the BGT60TRxx
+ * configurator tool, i.e. each entry holds the register address and the register data.
+ * Runs of consecutive register addresses are written using the SPI burst mode and the whole
+ * list is coalesced into as few SPI transactions as XENSIV_BGT60TRXX_REG_BURST_BUF_SIZE allows.
+ *
+ * @param[in] dev Pointer to the XENSIV(TM) BGT60TRxx sensor device object.
+ * @param[in] regs Pointer to the registers list.
+ * @param[in] len Length of the registers list.
+ * @return XENSIV_BGT60TRXX_STATUS_OK if writing to the sensor registers was successful; else an
+ * error indicating what went wrong.
+ */
+int32_t xensiv_bgt60trxx_set_regs(const xensiv_bgt60trxx_t* dev,
+                                  const uint32_t* regs,
+                                  uint32_t len);
+
 /**
  * @brief Reads from the sensor device into the given data buffer.
  * Reads from the sensor register map sensor starting at register address into the given data
@@ -204,6 +367,119 @@ int32_t xensiv_bgt60trxx_get_reg(const xensiv_bgt60trxx_t* dev,
                                  uint32_t reg_addr,
                                  uint32_t* data);
 
+/**
+ * @brief Enables/disables the register shadow.
+ * With the shadow enabled, the read-modify-write sequences of
+ * \ref xensiv_bgt60trxx_set_fifo_limit, \ref xensiv_bgt60trxx_start_frame,
+ * \ref xensiv_bgt60trxx_enable_data_test_mode and \ref xensiv_bgt60trxx_soft_reset take the
+ * current register value from the shadow instead of reading it from the sensor. Volatile
+ * registers (STAT0, STAT1, FSTAT, FIFO and the reset and frame start bits of MAIN) are always
+ * accessed on the sensor.
+ * The shadow is populated by \ref xensiv_bgt60trxx_config and by every register access done
+ * through the driver, so registers must not be modified bypassing the driver.
+ * @note Call after \ref xensiv_bgt60trxx_init
+ *
+ * @param[inout] dev Pointer to the XENSIV(TM) BGT60TRxx sensor device object.
+ * @param[in] shadow Pointer to the shadow storage, allocated by the caller. Pass NULL to disable.
+ */
+void xensiv_bgt60trxx_set_shadow(xensiv_bgt60trxx_t* dev,
+                                 xensiv_bgt60trxx_shadow_t* shadow);
+
+#if defined(XENSIV_BGT60TRXX_STATS)
+/**
+ * @brief Enables/disables the driver statistics and clears them.
+ * The driver counts the SPI transactions and the errors of the sensor and measures the latency
+ * of \ref xensiv_bgt60trxx_get_fifo_data, \ref xensiv_bgt60trxx_config and
+ * \ref xensiv_bgt60trxx_soft_reset. Only available if XENSIV_BGT60TRXX_STATS is defined; without
+ * it the driver does not contain any statistics code.
+ * @note Call after \ref xensiv_bgt60trxx_init. Call again with the same storage to clear the
+ * statistics.
+ *
+ * @param[inout] dev Pointer to the XENSIV(TM) BGT60TRxx sensor device object.
+ * @param[in] stats Pointer to the statistics storage, allocated by the caller. Pass NULL to
+ * disable.
+ */
+void xensiv_bgt60trxx_set_stats(xensiv_bgt60trxx_t* dev,
+                                xensiv_bgt60trxx_stats_t* stats);
+
+/**
+ * @brief Obtains a consistent copy of the driver statistics.
+ * Safe to call from another thread if XENSIV_BGT60TRXX_PLATFORM_LOCK is defined.
+ *
+ * @param[in] dev Pointer to the XENSIV(TM) BGT60TRxx sensor device object, with the statistics
+ * enabled.
+ * @param[out] stats Pointer to the copy of the statistics.
+ */
+void xensiv_bgt60trxx_get_stats(const xensiv_bgt60trxx_t* dev,
+                                xensiv_bgt60trxx_stats_t* stats);
+
+#endif // defined(XENSIV_BGT60TRXX_STATS)
+
+/**
+ * @brief Builds a register preset from a configurator list.
+ * Precomputes the register image once, e.g. at startup for each configuration the application
+ * switches between. The list uses the format of \ref xensiv_bgt60trxx_config, in any order.
+ *
+ * @param[out] preset Pointer to the preset, allocated by the caller.
+ * @param[in] regs Pointer to the configuration registers list. All addresses must be below
+ * \ref XENSIV_BGT60TRXX_SHADOW_NUM_REGS.
+ * @param[in] len Length of the configuration registers list.
+ */
+void xensiv_bgt60trxx_preset_init(xensiv_bgt60trxx_preset_t* preset,
+                                  const uint32_t* regs,
+                                  uint32_t len);
+
+/**
+ * @brief Saves the current register configuration held by the register shadow as a preset.
+ * Registers the shadow does not hold (not written or read since the last reset) are not part of
+ * the preset.
+ *
+ * @param[in] dev Pointer to the XENSIV(TM) BGT60TRxx sensor device object, with the register
+ * shadow enabled.
+ * @param[out] preset Pointer to the preset, allocated by the caller.
+ */
+void xensiv_bgt60trxx_preset_save(const xensiv_bgt60trxx_t* dev,
+                                  xensiv_bgt60trxx_preset_t* preset);
+
+/**
+ * @brief Computes the registers to write to switch the sensor to a preset.
+ * A register is part of the difference if its value in the preset differs from the register
+ * shadow or the shadow does not hold it. Without the register shadow all registers of the preset
+ * are returned. SFCTL is adjusted like in \ref xensiv_bgt60trxx_config.
+ *
+ * @param[in] dev Pointer to the XENSIV(TM) BGT60TRxx sensor device object.
+ * @param[in] preset Pointer to the preset.
+ * @param[out] regs Pointer to a list of \ref XENSIV_BGT60TRXX_SHADOW_NUM_REGS elements
+ * receiving the registers in the format of \ref xensiv_bgt60trxx_set_regs, in address order.
+ * @return Number of registers written to the list.
+ */
+uint32_t xensiv_bgt60trxx_preset_diff(const xensiv_bgt60trxx_t* dev,
+                                      const xensiv_bgt60trxx_preset_t* preset,
+                                      uint32_t* regs);
+
+/**
+ * @brief Switches the sensor to a preset, writing only the registers that differ.
+ * Unlike \ref xensiv_bgt60trxx_config, no software reset is done: the registers in the
+ * difference (see \ref xensiv_bgt60trxx_preset_diff) are written in address order, so that runs
+ * of consecutive registers use the SPI burst mode. If any of them is not SFCTL or SADC_CTRL,
+ * i.e. the chirp, PLL or channel set configuration changes, the FIFO is reset first: this stops
+ * the frame generation and discards the samples of the previous configuration. Restart the frame
+ * generation with \ref xensiv_bgt60trxx_start_frame then. If only SFCTL or SADC_CTRL differ, the
+ * frame generation is not interrupted.
+ * Registers not held by the preset keep their value, so all presets the application switches
+ * between should hold the same registers, as the configurator lists of a device do. As after
+ * \ref xensiv_bgt60trxx_config, the FIFO limit must be set again if SFCTL was written.
+ * @note Enable the register shadow (see \ref xensiv_bgt60trxx_set_shadow) before configuring the
+ * sensor, otherwise all registers of the preset are written.
+ *
+ * @param[in] dev Pointer to the XENSIV(TM) BGT60TRxx sensor device object.
+ * @param[in] preset Pointer to the preset.
+ * @return XENSIV_BGT60TRXX_STATUS_OK if the preset was applied; else an error indicating what
+ * went wrong.
+ */
+int32_t xensiv_bgt60trxx_preset_apply(const xensiv_bgt60trxx_t* dev,
+                                      const xensiv_bgt60trxx_preset_t* preset);
+
 /**
  * @brief Obtains the sensor device FIFO size.
  *
@@ -247,6 +523,11 @@ int32_t xensiv_bgt60trxx_set_fifo_limit(const xensiv_bgt60trxx_t* dev,
  * The beat signal is sampled, digitized, and stored into the sensor FIFO.
  * This function reads out the sensor FIFO contents and places it in the given buffer.
  *
+ * If XENSIV_BGT60TRXX_FIFO_READ_RAW is defined, the FIFO is read using 8-bit SPI words with
+ * \ref xensiv_bgt60trxx_get_fifo_data_raw into the end of \p data and unpacked in place,
+ * for SPI controllers that do not support 12-bit words. Reads of less than 8 samples are unpacked
+ * from a small buffer on the stack.
+ *
  * @param[in] dev Pointer to the XENSIV(TM) BGT60TRxx sensor device object.
  * @param[out] data Pointer to a data buffer.
  * @param[in] num_samples Number of samples to read from the sensor.
@@ -257,6 +538,74 @@ int32_t xensiv_bgt60trxx_get_fifo_data(const xensiv_bgt60trxx_t* dev,
                                        uint16_t* data,
                                        uint32_t num_samples);
 
+/**
+ * @brief Reads from the sensor device FIFO the packed FIFO words, without unpacking the
+ * 12-bit samples.
+ * The burst mode command and the FIFO payload are exchanged in a single
+ * xensiv_bgt60trxx_platform_spi_transfer using 8-bit SPI words, in place in \p buf. Use
+ * \ref xensiv_bgt60trxx_unpack_samples to obtain the samples.
+ *
+ * @param[in] dev Pointer to the XENSIV(TM) BGT60TRxx sensor device object.
+ * @param[out] buf Pointer to a buffer of \ref XENSIV_BGT60TRXX_FIFO_RAW_BUF_SIZE(num_samples)
+ * bytes. The FIFO words start at offset \ref XENSIV_BGT60TRXX_SPI_BURST_HEADER_SIZE_BYTES.
+ * @param[in] num_samples Number of samples to read from the sensor.
+ * @return XENSIV_BGT60TRXX_STATUS_OK if reading from the FIFO was successful; else
+ * an error indicating what went wrong.
+ */
+int32_t xensiv_bgt60trxx_get_fifo_data_raw(const xensiv_bgt60trxx_t* dev,
+                                           uint8_t* buf,
+                                           uint32_t num_samples);
+
+/**
+ * @brief Starts reading from the sensor device FIFO and returns without waiting for the FIFO
+ * payload to be received.
+ * The burst mode command is sent and the GSR0 status checked before the function returns. The
+ * payload is then received by the platform in the background, and xfer->callback is invoked
+ * with xfer->status set once it is complete, e.g. to process the previous frame meanwhile or to
+ * release a semaphore an RTOS task waits on. A FIFO overflow or underflow reported by GSR0 is
+ * delivered the same way, with xfer->status set to XENSIV_BGT60TRXX_STATUS_GSR0_ERROR before the
+ * function returns and no payload read.
+ * The platform must implement xensiv_bgt60trxx_platform_spi_fifo_read_async and
+ * XENSIV_BGT60TRXX_PLATFORM_SPI_FIFO_READ_ASYNC must be defined. Otherwise, and if
+ * XENSIV_BGT60TRXX_PLATFORM_SPI_BURST_READ or XENSIV_BGT60TRXX_FIFO_READ_RAW is defined, the
+ * read is done synchronously and the callback is invoked before the function returns.
+ * @note No other function accessing the sensor may be called until the callback is invoked.
+ * If XENSIV_BGT60TRXX_PLATFORM_LOCK is defined, calls from other threads wait until the payload
+ * is received; the lock is released before the callback is invoked.
+ *
+ * @param[in] dev Pointer to the XENSIV(TM) BGT60TRxx sensor device object.
+ * @param[inout] xfer Pointer to the read request with data, num_samples and callback set.
+ * @return XENSIV_BGT60TRXX_STATUS_OK if the read was started or GSR0 reported an error, the
+ * callback will be invoked; else an error indicating what went wrong, e.g. of the SPI transfer,
+ * the callback is not invoked.
+ */
+int32_t xensiv_bgt60trxx_get_fifo_data_async(const xensiv_bgt60trxx_t* dev,
+                                             xensiv_bgt60trxx_fifo_xfer_t* xfer);
+
+/**
+ * @brief Reads the filling level of the sensor device FIFO.
+ *
+ * @param[in] dev Pointer to the XENSIV(TM) BGT60TRxx sensor device object.
+ * @param[out] num_samples Number of samples stored in the FIFO.
+ * @return XENSIV_BGT60TRXX_STATUS_OK if the FIFO status was read successfully;
+ * else an error indicating what went wrong.
+ */
+int32_t xensiv_bgt60trxx_get_fifo_fill(const xensiv_bgt60trxx_t* dev,
+                                       uint32_t* num_samples);
+
+/**
+ * @brief Reads the frame counter of the sensor device.
+ * The counter is incremented each time a frame is completed, wraps around after
+ * \ref XENSIV_BGT60TRXX_FRAME_CNT_MAX and is cleared by a software reset only.
+ *
+ * @param[in] dev Pointer to the XENSIV(TM) BGT60TRxx sensor device object.
+ * @param[out] frame_cnt Frame counter, STAT1 FRAME_CNT.
+ * @return XENSIV_BGT60TRXX_STATUS_OK if the frame counter was read successfully;
+ * else an error indicating what went wrong.
+ */
+int32_t xensiv_bgt60trxx_get_frame_count(const xensiv_bgt60trxx_t* dev,
+                                         uint32_t* frame_cnt);
+
 /**
  * @brief Starts/stops radar frame generation.
  *
@@ -270,16 +619,35 @@ int32_t xensiv_bgt60trxx_start_frame(const xensiv_bgt60trxx_t* dev,
 
 /**
  * @brief Triggers a soft reset of the sensor device.
- * Triggers reset and waits for reset done.
+ * Triggers reset and waits for reset done, polling MAIN with an increasing delay between polls.
+ * A software reset puts the sensor in deep sleep mode, where STAT0 does not report ready, so it
+ * is followed by a fixed settling delay of 10 ms; FSM and FIFO resets return when done.
  * @param[in] dev Pointer to the XENSIV(TM) BGT60TRxx sensor device object.
  * @param[in] reset_type Reset type, combination of .
  * @return XENSIV_BGT60TRXX_STATUS_OK if the soft reset was successful,
- * XENSIV_BGT60TRXX_STATUS_TIMEOUT_ERROR if a timeout occurs while waiting reset to finish;
+ * XENSIV_BGT60TRXX_STATUS_TIMEOUT_ERROR if a timeout occurs while waiting reset to finish,
+ * see \ref XENSIV_BGT60TRXX_RESET_TIMEOUT_US;
  * else an error indicating what went wrong.
  */
 int32_t xensiv_bgt60trxx_soft_reset(const xensiv_bgt60trxx_t* dev,
                                     xensiv_bgt60trxx_reset_t reset_type);
 
+/**
+ * @brief Recovers from a FIFO overflow or underflow while keeping the configuration.
+ * Resets the FIFO, which also stops the frame generation, waits for the reset to complete and
+ * restarts the frame generation. Typically called when a FIFO read returns
+ * XENSIV_BGT60TRXX_STATUS_GSR0_ERROR. The data of the interrupted frame is lost, the FIFO
+ * compare reference is kept. Takes three SPI transactions if the reset completes at the first
+ * poll and the register shadow is enabled (see \ref xensiv_bgt60trxx_set_shadow), one more
+ * without the shadow.
+ *
+ * @param[in] dev Pointer to the XENSIV(TM) BGT60TRxx sensor device object.
+ * @return XENSIV_BGT60TRXX_STATUS_OK if the frame generation was restarted,
+ * XENSIV_BGT60TRXX_STATUS_TIMEOUT_ERROR if a timeout occurs while waiting for the reset to finish;
+ * else an error indicating what went wrong.
+ */
+int32_t xensiv_bgt60trxx_recover_fifo(const xensiv_bgt60trxx_t* dev);
+
 /**
  * @brief Enables/disables generation of a test sequence out of FIFO.
  * Enables/disables the output of test sequence data instead of the ADC data for the first ADC
@@ -0,0 +1,348 @@
+/***********************************************************************************************//**
+ * \file xensiv_bgt60trxx_capture.c
+ *
+ * \brief
+ * This file contains the implementation of the capture file writer and reader for the
+ * frames of the XENSIV(TM) BGT60TRxx 60GHz FMCW radar sensors.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2022 Infineon Technologies AG
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#include <stddef.h>
+#include <string.h>
+
+#include "xensiv_bgt60trxx_capture.h"
+#include "xensiv_bgt60trxx_platform.h"
+
+/************************************** Macros *******************************************/
+
+/* Alignment of the parts of a capture in bytes */
+#define CAPTURE_ALIGN                                   (8U)
+
+/*******************************************************************************
+ * Function Prototypes
+ ********************************************************************************/
+static uint64_t capture_align(uint64_t size);
+static uint64_t capture_frame_size(uint64_t num_samples);
+static int32_t capture_write(xensiv_bgt60trxx_capture_writer_t* writer, const void* data,
+                             uint32_t len);
+static int32_t capture_pad(xensiv_bgt60trxx_capture_writer_t* writer);
+static uint32_t capture_sequence(const xensiv_bgt60trxx_capture_reader_t* reader, uint32_t idx);
+
+/*******************************************************************************
+ * Public interface implementation
+ ********************************************************************************/
+int32_t xensiv_bgt60trxx_capture_writer_init(xensiv_bgt60trxx_capture_writer_t* writer,
+                                             xensiv_bgt60trxx_capture_write_t write,
+                                             void* ctx,
+                                             xensiv_bgt60trxx_device_t device,
+                                             const xensiv_bgt60trxx_frame_geometry_t* geometry,
+                                             const uint32_t* regs,
+                                             uint32_t num_regs,
+                                             xensiv_bgt60trxx_capture_index_t* index,
+                                             uint32_t max_frames)
+{
+    xensiv_bgt60trxx_platform_assert(writer != NULL);
+    xensiv_bgt60trxx_platform_assert(write != NULL);
+    xensiv_bgt60trxx_platform_assert(geometry != NULL);
+    xensiv_bgt60trxx_platform_assert((regs != NULL) || (num_regs == 0U));
+    xensiv_bgt60trxx_platform_assert((index != NULL) || (max_frames == 0U));
+
+    uint32_t num_samples = geometry->num_samples_per_chirp *
+                           geometry->num_chirps_per_frame *
+                           geometry->num_rx_antennas;
+    uint64_t header_size = capture_align(sizeof(xensiv_bgt60trxx_capture_header_t) +
+                                         ((uint64_t)num_regs * sizeof(uint32_t)));
+
+    xensiv_bgt60trxx_platform_assert(num_samples > 0U);
+    xensiv_bgt60trxx_platform_assert(header_size <= UINT16_MAX);
+
+    writer->write = write;
+    writer->ctx = ctx;
+    writer->num_samples = num_samples;
+    writer->frame_size = (uint32_t)capture_frame_size(num_samples);
+    writer->offset = 0U;
+    writer->num_frames = 0U;
+    writer->index = index;
+    writer->max_frames = max_frames;
+
+    xensiv_bgt60trxx_capture_header_t header =
+    {
+        .magic = XENSIV_BGT60TRXX_CAPTURE_MAGIC,
+        .version = XENSIV_BGT60TRXX_CAPTURE_VERSION,
+        .header_size = (uint16_t)header_size,
+        .device = (uint32_t)device,
+        .num_samples_per_chirp = geometry->num_samples_per_chirp,
+        .num_chirps_per_frame = geometry->num_chirps_per_frame,
+        .num_rx_antennas = geometry->num_rx_antennas,
+        .num_samples = num_samples,
+        .frame_size = writer->frame_size,
+        .num_regs = num_regs,
+        .reserved = 0U
+    };
+
+    int32_t status = capture_write(writer, &header, sizeof(header));
+
+    if ((status == XENSIV_BGT60TRXX_STATUS_OK) && (num_regs > 0U))
+    {
+        status = capture_write(writer, regs, num_regs * sizeof(uint32_t));
+    }
+
+    if (status == XENSIV_BGT60TRXX_STATUS_OK)
+    {
+        status = capture_pad(writer);
+    }
+
+    return status;
+}
+
+
+int32_t xensiv_bgt60trxx_capture_write_frame(xensiv_bgt60trxx_capture_writer_t* writer,
+                                             const uint16_t* samples,
+                                             const xensiv_bgt60trxx_frame_info_t* info)
+{
+    xensiv_bgt60trxx_platform_assert(writer != NULL);
+    xensiv_bgt60trxx_platform_assert(samples != NULL);
+
+    if (writer->num_frames >= writer->max_frames)
+    {
+        return XENSIV_BGT60TRXX_STATUS_BUFFER_FULL;
+    }
+
+    xensiv_bgt60trxx_capture_frame_t frame;
+    if (info != NULL)
+    {
+        frame.info = *info;
+    }
+    else
+    {
+        (void)memset(&frame.info, 0, sizeof(frame.info));
+        frame.info.sequence = writer->num_frames;
+    }
+    frame.reserved = 0U;
+
+    int32_t status = capture_write(writer, &frame, sizeof(frame));
+
+    if (status == XENSIV_BGT60TRXX_STATUS_OK)
+    {
+        status = capture_write(writer, samples, writer->num_samples * sizeof(uint16_t));
+    }
+
+    if (status == XENSIV_BGT60TRXX_STATUS_OK)
+    {
+        status = capture_pad(writer);
+    }
+
+    if (status == XENSIV_BGT60TRXX_STATUS_OK)
+    {
+        xensiv_bgt60trxx_capture_index_t* entry = &writer->index[writer->num_frames];
+        entry->sequence = frame.info.sequence;
+        entry->timestamp_us = frame.info.timestamp_us;
+        ++writer->num_frames;
+    }
+
+    return status;
+}
+
+
+int32_t xensiv_bgt60trxx_capture_writer_close(xensiv_bgt60trxx_capture_writer_t* writer)
+{
+    xensiv_bgt60trxx_platform_assert(writer != NULL);
+
+    xensiv_bgt60trxx_capture_trailer_t trailer =
+    {
+        .index_offset = writer->offset,
+        .num_frames = writer->num_frames,
+        .magic = XENSIV_BGT60TRXX_CAPTURE_TRAILER_MAGIC
+    };
+
+    /* no more frames */
+    writer->max_frames = writer->num_frames;
+
+    int32_t status = XENSIV_BGT60TRXX_STATUS_OK;
+
+    if (writer->num_frames > 0U)
+    {
+        status = capture_write(writer, writer->index,
+                               writer->num_frames * sizeof(xensiv_bgt60trxx_capture_index_t));
+    }
+
+    if (status == XENSIV_BGT60TRXX_STATUS_OK)
+    {
+        status = capture_write(writer, &trailer, sizeof(trailer));
+    }
+
+    return status;
+}
+
+
+int32_t xensiv_bgt60trxx_capture_reader_init(xensiv_bgt60trxx_capture_reader_t* reader,
+                                             const void* data,
+                                             size_t size)
+{
+    xensiv_bgt60trxx_platform_assert(reader != NULL);
+    xensiv_bgt60trxx_platform_assert(data != NULL);
+    xensiv_bgt60trxx_platform_assert(((uintptr_t)data % CAPTURE_ALIGN) == 0U);
+
+    const uint8_t* bytes = (const uint8_t*)data;
+    const xensiv_bgt60trxx_capture_header_t* header =
+        (const xensiv_bgt60trxx_capture_header_t*)data;
+
+    if ((size < sizeof(*header)) ||
+        (header->magic != XENSIV_BGT60TRXX_CAPTURE_MAGIC) ||
+        (header->version != XENSIV_BGT60TRXX_CAPTURE_VERSION))
+    {
+        return XENSIV_BGT60TRXX_STATUS_FORMAT_ERROR;
+    }
+
+    uint64_t num_samples = (uint64_t)header->num_samples_per_chirp *
+                           header->num_chirps_per_frame *
+                           header->num_rx_antennas;
+    uint64_t regs_end = sizeof(*header) + ((uint64_t)header->num_regs * sizeof(uint32_t));
+
+    if ((num_samples == 0U) ||
+        (num_samples != header->num_samples) ||
+        (header->frame_size != capture_frame_size(num_samples)) ||
+        ((header->header_size % CAPTURE_ALIGN) != 0U) ||
+        (header->header_size < regs_end) ||
+        (header->header_size > size))
+    {
+        return XENSIV_BGT60TRXX_STATUS_FORMAT_ERROR;
+    }
+
+    uint64_t body_size = (uint64_t)size - header->header_size;
+
+    reader->header = header;
+    reader->regs = (const uint32_t*)(bytes + sizeof(*header));
+    reader->frames = bytes + header->header_size;
+    reader->index = NULL;
+
+    if (body_size >= sizeof(xensiv_bgt60trxx_capture_trailer_t))
+    {
+        const xensiv_bgt60trxx_capture_trailer_t* trailer =
+            (const xensiv_bgt60trxx_capture_trailer_t*)(bytes + size - sizeof(*trailer));
+        uint64_t index_size = (uint64_t)trailer->num_frames *
+                              sizeof(xensiv_bgt60trxx_capture_index_t);
+
+        if ((trailer->magic == XENSIV_BGT60TRXX_CAPTURE_TRAILER_MAGIC) &&
+            (trailer->index_offset ==
+             header->header_size + ((uint64_t)trailer->num_frames * header->frame_size)) &&
+            ((trailer->index_offset + index_size + sizeof(*trailer)) == size))
+        {
+            reader->num_frames = trailer->num_frames;
+            reader->index =
+                (const xensiv_bgt60trxx_capture_index_t*)(bytes + trailer->index_offset);
+            return XENSIV_BGT60TRXX_STATUS_OK;
+        }
+    }
+
+    /* not closed, use the complete frame records */
+    body_size /= header->frame_size;
+    reader->num_frames = (body_size > UINT32_MAX) ? UINT32_MAX : (uint32_t)body_size;
+
+    return XENSIV_BGT60TRXX_STATUS_OK;
+}
+
+
+const xensiv_bgt60trxx_capture_frame_t* xensiv_bgt60trxx_capture_get_frame(
+    const xensiv_bgt60trxx_capture_reader_t* reader, uint32_t idx)
+{
+    xensiv_bgt60trxx_platform_assert(reader != NULL);
+    xensiv_bgt60trxx_platform_assert(idx < reader->num_frames);
+
+    return (const xensiv_bgt60trxx_capture_frame_t*)
+           (reader->frames + ((size_t)idx * reader->header->frame_size));
+}
+
+
+uint32_t xensiv_bgt60trxx_capture_find(const xensiv_bgt60trxx_capture_reader_t* reader,
+                                       uint32_t sequence)
+{
+    xensiv_bgt60trxx_platform_assert(reader != NULL);
+
+    uint32_t lo = 0U;
+    uint32_t hi = reader->num_frames;
+
+    /* first frame with a sequence number not less than the one searched */
+    while (lo < hi)
+    {
+        uint32_t mid = lo + ((hi - lo) / 2U);
+        if (capture_sequence(reader, mid) < sequence)
+        {
+            lo = mid + 1U;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+
+    if ((lo < reader->num_frames) && (capture_sequence(reader, lo) != sequence))
+    {
+        lo = reader->num_frames;
+    }
+
+    return lo;
+}
+
+
+/*******************************************************************************
+ * Static functions implementation
+ ********************************************************************************/
+static uint64_t capture_align(uint64_t size)
+{
+    return (size + (CAPTURE_ALIGN - 1U)) & ~(uint64_t)(CAPTURE_ALIGN - 1U);
+}
+
+
+static uint64_t capture_frame_size(uint64_t num_samples)
+{
+    return capture_align(sizeof(xensiv_bgt60trxx_capture_frame_t) +
+                         (num_samples * sizeof(uint16_t)));
+}
+
+
+static int32_t capture_write(xensiv_bgt60trxx_capture_writer_t* writer, const void* data,
+                             uint32_t len)
+{
+    int32_t status = writer->write(writer->ctx, data, len);
+
+    if (status == XENSIV_BGT60TRXX_STATUS_OK)
+    {
+        writer->offset += len;
+    }
+
+    return status;
+}
+
+
+static int32_t capture_pad(xensiv_bgt60trxx_capture_writer_t* writer)
+{
+    static const uint8_t zeros[CAPTURE_ALIGN] = { 0U };
+    uint32_t len = (uint32_t)(capture_align(writer->offset) - writer->offset);
+
+    return (len > 0U) ? capture_write(writer, zeros, len) : XENSIV_BGT60TRXX_STATUS_OK;
+}
+
+
+static uint32_t capture_sequence(const xensiv_bgt60trxx_capture_reader_t* reader, uint32_t idx)
+{
+    return (reader->index != NULL)
+        ? reader->index[idx].sequence
+        : xensiv_bgt60trxx_capture_get_frame(reader, idx)->info.sequence;
+}
@@ -0,0 +1,274 @@
+/***********************************************************************************************//**
+ * \file xensiv_bgt60trxx_capture.h
+ *
+ * \brief
+ * This file contains the declarations of the capture file format, writer and reader for the
+ * frames of the XENSIV(TM) BGT60TRxx 60GHz FMCW radar sensors.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2022 Infineon Technologies AG
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#ifndef XENSIV_BGT60TRXX_CAPTURE_H_
+#define XENSIV_BGT60TRXX_CAPTURE_H_
+
+#include <stddef.h>
+
+#include "xensiv_bgt60trxx_frame.h"
+
+/**
+ * \addtogroup group_board_libs_capture XENSIV(TM) BGT60TRxx Capture File
+ * \{
+ * Stores raw frames together with the configuration they were acquired with, for offline
+ * processing. A capture consists of, in this order:
+ * - A \ref xensiv_bgt60trxx_capture_header_t with the device type, the frame geometry and the
+ *   size of the frame records, followed by the register list passed to
+ *   \ref xensiv_bgt60trxx_config, padded to header_size bytes.
+ * - The frame records, each frame_size bytes: a \ref xensiv_bgt60trxx_capture_frame_t with the
+ *   frame metadata, followed by the samples (uint16_t) of the frame, padded to a multiple of
+ *   eight bytes. Frame n starts at header_size + n * frame_size.
+ * - The index, one \ref xensiv_bgt60trxx_capture_index_t per frame record.
+ * - A \ref xensiv_bgt60trxx_capture_trailer_t at the end of the file, locating the index.
+ *
+ * All fields are in the byte order of the writing CPU, a reader with the other byte order
+ * rejects the capture. Every part starts at a multiple of eight bytes, so the samples and the
+ * metadata of a capture mapped to memory are accessed in place.
+ *
+ * \ref xensiv_bgt60trxx_capture_writer_init and \ref xensiv_bgt60trxx_capture_write_frame
+ * stream the capture through a caller-provided write function, e.g. to a file, a socket or an
+ * SD card, without seeking. The index is kept in caller-provided memory until
+ * \ref xensiv_bgt60trxx_capture_writer_close appends it with the trailer. A capture without
+ * trailer, e.g. because the writer was not closed, is still read: the number of frames is
+ * derived from the size and the records are accessed without index.
+ *
+ * \ref xensiv_bgt60trxx_capture_reader_init checks a capture held in memory and
+ * \ref xensiv_bgt60trxx_capture_get_frame returns a pointer into it for any frame in constant
+ * time. On hosts, xensiv_bgt60trxx_capture_posix.h maps a capture file to memory, so that only
+ * the frames accessed are read from the disk.
+ */
+
+/************************************** Macros *******************************************/
+
+/** Magic number of the header, "XBGC" in a little-endian capture */
+#define XENSIV_BGT60TRXX_CAPTURE_MAGIC                  (0x43474258UL)
+
+/** Magic number of the trailer, "XBGI" in a little-endian capture */
+#define XENSIV_BGT60TRXX_CAPTURE_TRAILER_MAGIC          (0x49474258UL)
+
+/** Version of the capture format */
+#define XENSIV_BGT60TRXX_CAPTURE_VERSION                (1U)
+
+/******************************** Type definitions ****************************************/
+
+/** Header of a capture, followed by the register list */
+typedef struct
+{
+    uint32_t magic;                 /**< \ref XENSIV_BGT60TRXX_CAPTURE_MAGIC */
+    uint16_t version;               /**< \ref XENSIV_BGT60TRXX_CAPTURE_VERSION */
+    uint16_t header_size;           /**< Offset of the first frame record in bytes */
+    uint32_t device;                /**< \ref xensiv_bgt60trxx_device_t */
+    uint32_t num_samples_per_chirp; /**< Frame geometry, see xensiv_bgt60trxx_frame_geometry_t */
+    uint32_t num_chirps_per_frame;  /**< Frame geometry */
+    uint32_t num_rx_antennas;       /**< Frame geometry */
+    uint32_t num_samples;           /**< Samples per frame */
+    uint32_t frame_size;            /**< Size of a frame record in bytes */
+    uint32_t num_regs;              /**< Length of the register list */
+    uint32_t reserved;              /**< Zero */
+} xensiv_bgt60trxx_capture_header_t;
+
+/** Frame record, followed by the samples of the frame */
+typedef struct
+{
+    xensiv_bgt60trxx_frame_info_t info; /**< Frame metadata */
+    uint32_t reserved;                  /**< Zero */
+} xensiv_bgt60trxx_capture_frame_t;
+
+/** Index entry of a frame record */
+typedef struct
+{
+    uint32_t sequence;              /**< Sequence number of the frame */
+    uint32_t timestamp_us;          /**< Time stamp of the frame */
+} xensiv_bgt60trxx_capture_index_t;
+
+/** Trailer at the end of a closed capture */
+typedef struct
+{
+    uint64_t index_offset;          /**< Offset of the index in bytes */
+    uint32_t num_frames;            /**< Number of frame records and index entries */
+    uint32_t magic;                 /**< \ref XENSIV_BGT60TRXX_CAPTURE_TRAILER_MAGIC */
+} xensiv_bgt60trxx_capture_trailer_t;
+
+/**
+ * Function writing the next bytes of a capture.
+ *
+ * @param[in] ctx Context passed to \ref xensiv_bgt60trxx_capture_writer_init.
+ * @param[in] data Pointer to the bytes.
+ * @param[in] len Number of bytes.
+ * @return XENSIV_BGT60TRXX_STATUS_OK if all bytes were written; else an error.
+ */
+typedef int32_t (* xensiv_bgt60trxx_capture_write_t)(void* ctx, const void* data, uint32_t len);
+
+/**
+ * Structure holding the capture writer.
+ *
+ * Application code should not rely on the specific content of this struct.
+ * They are considered an implementation detail which is subject to change
+ * between platforms and/or library releases.
+ */
+typedef struct
+{
+    xensiv_bgt60trxx_capture_write_t write;
+    void* ctx;
+    uint32_t num_samples;
+    uint32_t frame_size;               /* in bytes */
+    uint64_t offset;                   /* bytes written */
+    uint32_t num_frames;
+    xensiv_bgt60trxx_capture_index_t* index;
+    uint32_t max_frames;               /* entries of the index */
+} xensiv_bgt60trxx_capture_writer_t;
+
+/**
+ * Structure holding the capture reader.
+ *
+ * Application code should not rely on the specific content of this struct, except the
+ * header, the register list and the number of frames. They are considered an implementation
+ * detail which is subject to change between platforms and/or library releases.
+ */
+typedef struct
+{
+    const xensiv_bgt60trxx_capture_header_t* header; /**< Header of the capture */
+    const uint32_t* regs;              /**< Register list, header->num_regs entries */
+    uint32_t num_frames;               /**< Number of frame records */
+    const uint8_t* frames;
+    const xensiv_bgt60trxx_capture_index_t* index; /* NULL without trailer */
+} xensiv_bgt60trxx_capture_reader_t;
+
+/******************************* Function prototypes *************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Initializes the capture writer and writes the header with the register list.
+ *
+ * @param[out] writer Pointer to the capture writer object.
+ * @param[in] write Function writing the capture.
+ * @param[in] ctx Context passed to \p write.
+ * @param[in] device Device type, from \ref xensiv_bgt60trxx_get_device.
+ * @param[in] geometry Pointer to the frame geometry.
+ * @param[in] regs Pointer to the register list passed to \ref xensiv_bgt60trxx_config.
+ * @param[in] num_regs Length of the register list.
+ * @param[in] index Pointer to the memory holding the index until the writer is closed.
+ * @param[in] max_frames Number of entries of \p index, the maximum number of frames.
+ * @return XENSIV_BGT60TRXX_STATUS_OK if the header was written; else the error of \p write.
+ */
+int32_t xensiv_bgt60trxx_capture_writer_init(xensiv_bgt60trxx_capture_writer_t* writer,
+                                             xensiv_bgt60trxx_capture_write_t write,
+                                             void* ctx,
+                                             xensiv_bgt60trxx_device_t device,
+                                             const xensiv_bgt60trxx_frame_geometry_t* geometry,
+                                             const uint32_t* regs,
+                                             uint32_t num_regs,
+                                             xensiv_bgt60trxx_capture_index_t* index,
+                                             uint32_t max_frames);
+
+/**
+ * @brief Appends a frame record to the capture.
+ *
+ * @param[inout] writer Pointer to the capture writer object.
+ * @param[in] samples Pointer to the samples of the frame, e.g. from
+ * \ref xensiv_bgt60trxx_frame_assembler_get.
+ * @param[in] info Pointer to the frame metadata, e.g. from
+ * \ref xensiv_bgt60trxx_frame_assembler_get_info. If NULL, the frames are numbered in the order
+ * written and the other fields are zero.
+ * @return XENSIV_BGT60TRXX_STATUS_OK if the frame was written;
+ * XENSIV_BGT60TRXX_STATUS_BUFFER_FULL if the index is full, nothing is written; else the error
+ * of the write function, the capture is incomplete.
+ */
+int32_t xensiv_bgt60trxx_capture_write_frame(xensiv_bgt60trxx_capture_writer_t* writer,
+                                             const uint16_t* samples,
+                                             const xensiv_bgt60trxx_frame_info_t* info);
+
+/**
+ * @brief Appends the index and the trailer to the capture.
+ * No frame can be written afterwards.
+ *
+ * @param[inout] writer Pointer to the capture writer object.
+ * @return XENSIV_BGT60TRXX_STATUS_OK if the index and the trailer were written; else the error
+ * of the write function.
+ */
+int32_t xensiv_bgt60trxx_capture_writer_close(xensiv_bgt60trxx_capture_writer_t* writer);
+
+/**
+ * @brief Initializes the capture reader for a capture held in memory.
+ * The capture is not copied and must stay valid while the reader is used.
+ *
+ * @param[out] reader Pointer to the capture reader object.
+ * @param[in] data Pointer to the capture, aligned to eight bytes.
+ * @param[in] size Size of the capture in bytes.
+ * @return XENSIV_BGT60TRXX_STATUS_OK if the capture is valid;
+ * XENSIV_BGT60TRXX_STATUS_FORMAT_ERROR if it is not a capture, has another version or byte
+ * order, or its header is inconsistent.
+ */
+int32_t xensiv_bgt60trxx_capture_reader_init(xensiv_bgt60trxx_capture_reader_t* reader,
+                                             const void* data,
+                                             size_t size);
+
+/**
+ * @brief Obtains a frame record of the capture.
+ *
+ * @param[in] reader Pointer to the capture reader object.
+ * @param[in] idx Index of the frame record, less than reader->num_frames.
+ * @return Pointer to the frame record in the capture. The samples follow the record, see
+ * \ref xensiv_bgt60trxx_capture_get_samples.
+ */
+const xensiv_bgt60trxx_capture_frame_t* xensiv_bgt60trxx_capture_get_frame(
+    const xensiv_bgt60trxx_capture_reader_t* reader, uint32_t idx);
+
+/**
+ * @brief Obtains the samples of a frame record.
+ *
+ * @param[in] frame Pointer to the frame record, from \ref xensiv_bgt60trxx_capture_get_frame.
+ * @return Pointer to the header->num_samples samples of the frame in the capture.
+ */
+static inline const uint16_t* xensiv_bgt60trxx_capture_get_samples(
+    const xensiv_bgt60trxx_capture_frame_t* frame)
+{
+    return (const uint16_t*)(frame + 1);
+}
+
+
+/**
+ * @brief Searches the frame record with a sequence number.
+ * The sequence numbers of the frame assembler increase, so the index is searched with a binary
+ * search, or the frame records if the capture has no index.
+ *
+ * @param[in] reader Pointer to the capture reader object.
+ * @param[in] sequence Sequence number of the frame.
+ * @return Index of the frame record, reader->num_frames if no frame has the sequence number.
+ */
+uint32_t xensiv_bgt60trxx_capture_find(const xensiv_bgt60trxx_capture_reader_t* reader,
+                                       uint32_t sequence);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** \} group_board_libs_capture */
+
+#endif // ifndef XENSIV_BGT60TRXX_CAPTURE_H_
@@ -0,0 +1,111 @@
+/***********************************************************************************************//**
+ * \file xensiv_bgt60trxx_capture_posix.c
+ *
+ * \brief
+ * This file contains the POSIX file functions for the capture files of the
+ * XENSIV(TM) BGT60TRxx 60GHz FMCW radar sensors.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2022 Infineon Technologies AG
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#if defined(__unix__) || defined(__APPLE__)
+
+#if !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <assert.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "xensiv_bgt60trxx_capture_posix.h"
+
+/*******************************************************************************
+ * Public interface implementation
+ ********************************************************************************/
+int32_t xensiv_bgt60trxx_capture_fwrite(void* ctx, const void* data, uint32_t len)
+{
+    assert(ctx != NULL);
+
+    return (fwrite(data, 1U, len, (FILE*)ctx) == len)
+        ? XENSIV_BGT60TRXX_STATUS_OK
+        : XENSIV_BGT60TRXX_STATUS_COM_ERROR;
+}
+
+
+int32_t xensiv_bgt60trxx_capture_file_open(xensiv_bgt60trxx_capture_file_t* file,
+                                           const char* path)
+{
+    assert(file != NULL);
+    assert(path != NULL);
+
+    file->addr = NULL;
+    file->size = 0U;
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        return XENSIV_BGT60TRXX_STATUS_COM_ERROR;
+    }
+
+    struct stat st;
+    int32_t status = XENSIV_BGT60TRXX_STATUS_COM_ERROR;
+
+    if ((fstat(fd, &st) == 0) && (st.st_size > 0) && ((uintmax_t)st.st_size <= SIZE_MAX))
+    {
+        /* the mapping stays valid after closing the file */
+        void* addr = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (addr != MAP_FAILED)
+        {
+            status = xensiv_bgt60trxx_capture_reader_init(&file->reader, addr,
+                                                          (size_t)st.st_size);
+            if (status == XENSIV_BGT60TRXX_STATUS_OK)
+            {
+                file->addr = addr;
+                file->size = (size_t)st.st_size;
+            }
+            else
+            {
+                (void)munmap(addr, (size_t)st.st_size);
+            }
+        }
+    }
+
+    (void)close(fd);
+
+    return status;
+}
+
+
+void xensiv_bgt60trxx_capture_file_close(xensiv_bgt60trxx_capture_file_t* file)
+{
+    assert(file != NULL);
+
+    if (file->addr != NULL)
+    {
+        (void)munmap(file->addr, file->size);
+        file->addr = NULL;
+        file->size = 0U;
+    }
+}
+
+
+#endif // if defined(__unix__) || defined(__APPLE__)
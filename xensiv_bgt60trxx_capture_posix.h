@@ -0,0 +1,103 @@
+/***********************************************************************************************//**
+ * \file xensiv_bgt60trxx_capture_posix.h
+ *
+ * \brief
+ * This file contains the declarations of the POSIX file functions for the capture files of the
+ * XENSIV(TM) BGT60TRxx 60GHz FMCW radar sensors.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2022 Infineon Technologies AG
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#ifndef XENSIV_BGT60TRXX_CAPTURE_POSIX_H_
+#define XENSIV_BGT60TRXX_CAPTURE_POSIX_H_
+
+#include "xensiv_bgt60trxx_capture.h"
+
+/**
+ * \addtogroup group_board_libs_capture_posix XENSIV(TM) BGT60TRxx Capture File POSIX Interface
+ * \{
+ * Host functions to write a capture (see \ref group_board_libs_capture) to a stdio stream and
+ * to read a capture file mapped to memory with mmap. The pages of a mapped capture are read
+ * from the disk when first accessed and shared with the page cache, so opening a capture of
+ * several gigabytes is immediate and the frames are not copied.
+ */
+
+#if defined(__unix__) || defined(__APPLE__)
+
+/******************************** Type definitions ****************************************/
+
+/**
+ * Structure holding a capture file mapped to memory.
+ * Content initialized using \ref xensiv_bgt60trxx_capture_file_open
+ *
+ */
+typedef struct
+{
+    xensiv_bgt60trxx_capture_reader_t reader; /**< reader of the mapped capture */
+    void* addr;
+    size_t size;
+} xensiv_bgt60trxx_capture_file_t;
+
+/******************************* Function prototypes *************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Writes the next bytes of a capture to a stdio stream.
+ * Pass as the write function of \ref xensiv_bgt60trxx_capture_writer_init with the FILE
+ * pointer, opened in binary mode, as the context.
+ *
+ * @param[in] ctx FILE pointer.
+ * @param[in] data Pointer to the bytes.
+ * @param[in] len Number of bytes.
+ * @return XENSIV_BGT60TRXX_STATUS_OK if all bytes were written; else
+ * XENSIV_BGT60TRXX_STATUS_COM_ERROR.
+ */
+int32_t xensiv_bgt60trxx_capture_fwrite(void* ctx, const void* data, uint32_t len);
+
+/**
+ * @brief Maps a capture file to memory and initializes its reader.
+ *
+ * @param[out] file Pointer to the capture file object.
+ * @param[in] path Path of the capture file.
+ * @return XENSIV_BGT60TRXX_STATUS_OK if the capture was mapped;
+ * XENSIV_BGT60TRXX_STATUS_COM_ERROR if the file cannot be opened or mapped; else the error of
+ * \ref xensiv_bgt60trxx_capture_reader_init, the file is not mapped.
+ */
+int32_t xensiv_bgt60trxx_capture_file_open(xensiv_bgt60trxx_capture_file_t* file,
+                                           const char* path);
+
+/**
+ * @brief Unmaps a capture file opened with \ref xensiv_bgt60trxx_capture_file_open.
+ * The pointers obtained from its reader become invalid.
+ *
+ * @param[in] file Pointer to the capture file object.
+ */
+void xensiv_bgt60trxx_capture_file_close(xensiv_bgt60trxx_capture_file_t* file);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // if defined(__unix__) || defined(__APPLE__)
+
+/** \} group_board_libs_capture_posix */
+
+#endif // ifndef XENSIV_BGT60TRXX_CAPTURE_POSIX_H_
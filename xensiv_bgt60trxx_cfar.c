@@ -0,0 +1,366 @@
+/***********************************************************************************************//**
+ * \file xensiv_bgt60trxx_cfar.c
+ *
+ * \brief
+ * This file contains the implementation of the CFAR target detection functions
+ * for the XENSIV(TM) BGT60TRxx 60GHz FMCW radar sensors.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2022 Infineon Technologies AG
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#include <float.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "xensiv_bgt60trxx_cfar.h"
+#include "xensiv_bgt60trxx_platform.h"
+
+/*******************************************************************************
+ * Function Prototypes
+ ********************************************************************************/
+static void column_sums(const float* map, uint32_t num_range_bins, uint32_t num_doppler_bins,
+                        uint32_t d, uint32_t outer, uint32_t guard, float* col_outer,
+                        float* col_train);
+
+static double box_start(const float* col, uint32_t num_bins, uint32_t half);
+
+static inline void box_slide(double* sum, const float* col, uint32_t b, uint32_t num_bins,
+                             uint32_t half);
+
+static inline uint32_t box_count(uint32_t b, uint32_t num_bins, uint32_t half);
+
+static void os_noise(const xensiv_bgt60trxx_cfar_config_t* config, const float* row,
+                     uint32_t num_bins, float* sorted, float* noise);
+
+static void sorted_insert(float* sorted, uint32_t* n, float value);
+
+static void sorted_remove(float* sorted, uint32_t* n, float value);
+
+static bool is_peak(const float* map, uint32_t num_range_bins, uint32_t num_doppler_bins,
+                    uint32_t d, uint32_t b);
+
+/*******************************************************************************
+ * Public interface implementation
+ ********************************************************************************/
+uint32_t xensiv_bgt60trxx_cfar_detect(const xensiv_bgt60trxx_cfar_config_t* config,
+                                      const float* map,
+                                      uint32_t num_range_bins,
+                                      uint32_t num_doppler_bins,
+                                      float* workspace,
+                                      xensiv_bgt60trxx_cfar_detection_t* detections,
+                                      uint32_t max_detections)
+{
+    xensiv_bgt60trxx_platform_assert(config != NULL);
+    xensiv_bgt60trxx_platform_assert(map != NULL);
+    xensiv_bgt60trxx_platform_assert(workspace != NULL);
+    xensiv_bgt60trxx_platform_assert((detections != NULL) || (max_detections == 0U));
+    xensiv_bgt60trxx_platform_assert((num_range_bins > 0U) && (num_doppler_bins > 0U));
+
+    bool ca = (config->type == XENSIV_BGT60TRXX_CFAR_CA);
+    uint32_t outer_range = (uint32_t)config->num_train_range + config->num_guard_range;
+    uint32_t guard_range = config->num_guard_range;
+    uint32_t outer_doppler = ca ? ((uint32_t)config->num_train_doppler +
+                                   config->num_guard_doppler) : 0U;
+    uint32_t guard_doppler = ca ? config->num_guard_doppler : 0U;
+
+    xensiv_bgt60trxx_platform_assert(ca ? ((config->num_train_range + config->num_train_doppler) >
+                                           0U) :
+                                     ((config->num_train_range > 0U) &&
+                                      (config->os_rank < (2U * config->num_train_range))));
+    xensiv_bgt60trxx_platform_assert(((2U * outer_doppler) + 1U) <= num_doppler_bins);
+
+    /* CA: column sums of the outer rectangle and of its Doppler training rows of the current
+     * Doppler bin. OS: noise of each cell of the current Doppler bin, sorted training cells */
+    float* col_outer = workspace;
+    float* col_train = &workspace[num_range_bins];
+    float* sorted = &workspace[2U * num_range_bins];
+    uint32_t num_detections = 0U;
+
+    for (uint32_t d = 0U; d < num_doppler_bins; ++d)
+    {
+        const float* row = &map[d * num_range_bins];
+
+        /* CA: sliding sums in range over the outer rectangle and over the guard columns, in
+         * double so that a strong cell entering and leaving them leaves no rounding error */
+        double sum_outer = 0.0;
+        double sum_guard = 0.0;
+        double sum_train = 0.0;
+
+        if (ca)
+        {
+            column_sums(map, num_range_bins, num_doppler_bins, d, outer_doppler, guard_doppler,
+                        col_outer, col_train);
+            sum_outer = box_start(col_outer, num_range_bins, outer_range);
+            sum_guard = box_start(col_outer, num_range_bins, guard_range);
+            sum_train = box_start(col_train, num_range_bins, guard_range);
+        }
+        else
+        {
+            os_noise(config, row, num_range_bins, sorted, col_outer);
+        }
+
+        for (uint32_t b = 0U; b < num_range_bins; ++b)
+        {
+            float noise;
+
+            if (ca)
+            {
+                /* training cells: the outer rectangle without the guard columns, plus the
+                 * Doppler training rows of the guard columns */
+                uint32_t count =
+                    (box_count(b, num_range_bins, outer_range) * ((2U * outer_doppler) + 1U)) -
+                    (box_count(b, num_range_bins, guard_range) * ((2U * guard_doppler) + 1U));
+                double sum = (sum_outer - sum_guard) + sum_train;
+
+                box_slide(&sum_outer, col_outer, b, num_range_bins, outer_range);
+                box_slide(&sum_guard, col_outer, b, num_range_bins, guard_range);
+                box_slide(&sum_train, col_train, b, num_range_bins, guard_range);
+
+                if (count == 0U)
+                {
+                    continue;
+                }
+                noise = (float)(sum / (double)count);
+            }
+            else
+            {
+                noise = col_outer[b];
+            }
+
+            float cell = row[b];
+            bool detected;
+            float snr;
+
+            if (config->log_scale)
+            {
+                detected = (cell > (noise + config->threshold));
+                snr = cell - noise;
+            }
+            else
+            {
+                noise = (noise > FLT_MIN) ? noise : FLT_MIN;
+                detected = (cell > (noise * config->threshold));
+                snr = cell / noise;
+            }
+
+            if (detected && config->peaks_only)
+            {
+                detected = is_peak(map, num_range_bins, num_doppler_bins, d, b);
+            }
+
+            if (detected && (num_detections < max_detections))
+            {
+                detections[num_detections].range_bin = (uint16_t)b;
+                detections[num_detections].doppler_bin = (uint16_t)d;
+                detections[num_detections].snr = snr;
+                ++num_detections;
+            }
+        }
+    }
+
+    return num_detections;
+}
+
+
+/*******************************************************************************
+ * Static functions implementation
+ ********************************************************************************/
+/* Sums each range bin over the Doppler bins d - outer .. d + outer into col_outer, and over
+ * the Doppler bins of these outside d - guard .. d + guard into col_train. Recomputed for each
+ * Doppler bin, no row is ever subtracted. */
+static void column_sums(const float* map, uint32_t num_range_bins, uint32_t num_doppler_bins,
+                        uint32_t d, uint32_t outer, uint32_t guard, float* col_outer,
+                        float* col_train)
+{
+    (void)memset(col_outer, 0, num_range_bins * sizeof(float));
+    (void)memset(col_train, 0, num_range_bins * sizeof(float));
+
+    for (uint32_t j = 0U; j <= (2U * outer); ++j)
+    {
+        const float* row = &map[((num_doppler_bins + d + j - outer) % num_doppler_bins) *
+                                num_range_bins];
+        bool train = ((j + guard) < outer) || (j > (outer + guard));
+
+        for (uint32_t b = 0U; b < num_range_bins; ++b)
+        {
+            col_outer[b] += row[b];
+        }
+
+        if (train)
+        {
+            for (uint32_t b = 0U; b < num_range_bins; ++b)
+            {
+                col_train[b] += row[b];
+            }
+        }
+    }
+}
+
+
+/* Sum of col[0 .. half], the box of bin 0 */
+static double box_start(const float* col, uint32_t num_bins, uint32_t half)
+{
+    double sum = 0.0;
+    for (uint32_t b = 0U; (b <= half) && (b < num_bins); ++b)
+    {
+        sum += (double)col[b];
+    }
+
+    return sum;
+}
+
+
+/* Moves the box sum of col[b - half .. b + half] to bin b + 1 */
+static inline void box_slide(double* sum, const float* col, uint32_t b, uint32_t num_bins,
+                             uint32_t half)
+{
+    if ((b + half + 1U) < num_bins)
+    {
+        *sum += (double)col[b + half + 1U];
+    }
+    if (b >= half)
+    {
+        *sum -= (double)col[b - half];
+    }
+}
+
+
+/* Number of bins of b - half .. b + half inside the map */
+static inline uint32_t box_count(uint32_t b, uint32_t num_bins, uint32_t half)
+{
+    uint32_t first = (b > half) ? (b - half) : 0U;
+    uint32_t last = ((b + half) < num_bins) ? (b + half) : (num_bins - 1U);
+
+    return last - first + 1U;
+}
+
+
+/* Computes the noise of each cell of a row from its sorted training cells in range:
+ * left b - outer .. b - guard - 1 and right b + guard + 1 .. b + outer */
+static void os_noise(const xensiv_bgt60trxx_cfar_config_t* config, const float* row,
+                     uint32_t num_bins, float* sorted, float* noise)
+{
+    int32_t outer = (int32_t)config->num_train_range + (int32_t)config->num_guard_range;
+    int32_t guard = (int32_t)config->num_guard_range;
+    int32_t num = (int32_t)num_bins;
+    uint32_t n = 0U;
+
+    for (int32_t i = guard + 1; (i <= outer) && (i < num); ++i)
+    {
+        sorted_insert(sorted, &n, row[i]);
+    }
+
+    for (int32_t b = 0; b < num; ++b)
+    {
+        /* the rank is scaled down where the training cells are truncated at the edges */
+        noise[b] = (n > 0U) ?
+                   sorted[(config->os_rank * n) / (2U * config->num_train_range)] :
+                   FLT_MAX;
+
+        if ((b - outer) >= 0)
+        {
+            sorted_remove(sorted, &n, row[b - outer]);
+        }
+        if ((b - guard) >= 0)
+        {
+            sorted_insert(sorted, &n, row[b - guard]);
+        }
+        if ((b + guard + 1) < num)
+        {
+            sorted_remove(sorted, &n, row[b + guard + 1]);
+        }
+        if ((b + outer + 1) < num)
+        {
+            sorted_insert(sorted, &n, row[b + outer + 1]);
+        }
+    }
+}
+
+
+static void sorted_insert(float* sorted, uint32_t* n, float value)
+{
+    uint32_t lo = 0U;
+    uint32_t hi = *n;
+
+    while (lo < hi)
+    {
+        uint32_t mid = (lo + hi) / 2U;
+        if (sorted[mid] <= value)
+        {
+            lo = mid + 1U;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+
+    (void)memmove(&sorted[lo + 1U], &sorted[lo], (*n - lo) * sizeof(float));
+    sorted[lo] = value;
+    ++(*n);
+}
+
+
+static void sorted_remove(float* sorted, uint32_t* n, float value)
+{
+    uint32_t lo = 0U;
+    uint32_t hi = *n;
+
+    while (lo < hi)
+    {
+        uint32_t mid = (lo + hi) / 2U;
+        if (sorted[mid] < value)
+        {
+            lo = mid + 1U;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+
+    xensiv_bgt60trxx_platform_assert((lo < *n) && (sorted[lo] == value));
+
+    --(*n);
+    (void)memmove(&sorted[lo], &sorted[lo + 1U], (*n - lo) * sizeof(float));
+}
+
+
+/* Checks that a cell is not smaller than its 8 neighbors; Doppler wraps around */
+static bool is_peak(const float* map, uint32_t num_range_bins, uint32_t num_doppler_bins,
+                    uint32_t d, uint32_t b)
+{
+    float cell = map[(d * num_range_bins) + b];
+    bool peak = true;
+
+    for (uint32_t i = 0U; (i < 3U) && peak; ++i)
+    {
+        uint32_t dn = (d + num_doppler_bins + i - 1U) % num_doppler_bins;
+
+        for (uint32_t j = 0U; (j < 3U) && peak; ++j)
+        {
+            uint32_t bn = b + j;
+            if ((bn >= 1U) && (bn <= num_range_bins))
+            {
+                peak = (cell >= map[(dn * num_range_bins) + bn - 1U]);
+            }
+        }
+    }
+
+    return peak;
+}
@@ -0,0 +1,127 @@
+/***********************************************************************************************//**
+ * \file xensiv_bgt60trxx_cfar.h
+ *
+ * \brief
+ * This file contains the declarations of the CFAR target detection functions
+ * for the XENSIV(TM) BGT60TRxx 60GHz FMCW radar sensors.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2022 Infineon Technologies AG
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#ifndef XENSIV_BGT60TRXX_CFAR_H_
+#define XENSIV_BGT60TRXX_CFAR_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * \addtogroup group_board_libs_cfar XENSIV(TM) BGT60TRxx CFAR Detection
+ * \{
+ * Constant false alarm rate (CFAR) detection on a range profile or a range-Doppler map (see
+ * \ref group_board_libs_doppler), stored as map[doppler_bin * num_range_bins + range_bin].
+ * A range profile is a map with a single Doppler bin.
+ *
+ * The noise level of each cell is estimated from the training cells around it, excluding the
+ * guard cells next to the cell under test. The Doppler dimension wraps around, the training
+ * cells in range are truncated at the edges of the map.
+ * - Cell averaging (CA): the noise is the mean of the training cells in a rectangle around the
+ *   cell. The column sums across Doppler are computed once per Doppler bin and the box sums in
+ *   range are updated incrementally in double precision, so the cost per cell grows with the
+ *   Doppler extent of the rectangle only.
+ * - Ordered statistic (OS): the noise is the training cell of the configured rank, using the
+ *   training cells in range only. The training cells are kept sorted while sliding, at a cost
+ *   per cell proportional to the number of training cells.
+ *
+ * For maps in linear units the cell must exceed noise * threshold; for maps in dB it must exceed
+ * noise + threshold.
+ */
+
+/************************************** Macros *******************************************/
+
+/** Number of float elements of the workspace */
+#define XENSIV_BGT60TRXX_CFAR_WORKSPACE_LEN(num_range_bins, num_train_range) \
+    ((2U * (num_range_bins)) + (2U * (num_train_range)))
+
+/******************************** Type definitions ****************************************/
+
+/** CFAR noise estimation */
+typedef enum
+{
+    XENSIV_BGT60TRXX_CFAR_CA = 0,       /**< Cell averaging */
+    XENSIV_BGT60TRXX_CFAR_OS = 1        /**< Ordered statistic, in range */
+} xensiv_bgt60trxx_cfar_type_t;
+
+/** CFAR configuration */
+typedef struct
+{
+    xensiv_bgt60trxx_cfar_type_t type;  /**< Noise estimation */
+    uint16_t num_train_range;           /**< Training cells on each side in range */
+    uint16_t num_guard_range;           /**< Guard cells on each side in range */
+    uint16_t num_train_doppler;         /**< Training cells on each side in Doppler, CA only */
+    uint16_t num_guard_doppler;         /**< Guard cells on each side in Doppler, CA only */
+    uint16_t os_rank;                   /**< OS only: rank, from 0 (smallest) to
+                                             2 * num_train_range - 1 */
+    float threshold;                    /**< Scale (linear map) or offset (dB map) */
+    bool log_scale;                     /**< The map is in dB */
+    bool peaks_only;                    /**< Report local maxima among the 8 neighbors only */
+} xensiv_bgt60trxx_cfar_config_t;
+
+/** Detected target */
+typedef struct
+{
+    uint16_t range_bin;                 /**< Range bin */
+    uint16_t doppler_bin;               /**< Doppler bin, 0 for a range profile */
+    float snr;                          /**< Cell / noise (linear map), cell - noise (dB map) */
+} xensiv_bgt60trxx_cfar_detection_t;
+
+/******************************* Function prototypes *************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Detects the targets of a range profile or range-Doppler map.
+ * Detections are reported in map order, Doppler bin by Doppler bin.
+ *
+ * @param[in] config Pointer to the CFAR configuration.
+ * @param[in] map Pointer to the map.
+ * @param[in] num_range_bins Number of range bins.
+ * @param[in] num_doppler_bins Number of Doppler bins, 1 for a range profile.
+ * Must be larger than 2 * (num_train_doppler + num_guard_doppler).
+ * @param[out] workspace Pointer to
+ * \ref XENSIV_BGT60TRXX_CFAR_WORKSPACE_LEN (\p num_range_bins, num_train_range) elements.
+ * @param[out] detections Pointer to the detection list.
+ * @param[in] max_detections Size of the detection list, further detections are dropped.
+ * @return Number of detections written to the list.
+ */
+uint32_t xensiv_bgt60trxx_cfar_detect(const xensiv_bgt60trxx_cfar_config_t* config,
+                                      const float* map,
+                                      uint32_t num_range_bins,
+                                      uint32_t num_doppler_bins,
+                                      float* workspace,
+                                      xensiv_bgt60trxx_cfar_detection_t* detections,
+                                      uint32_t max_detections);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** \} group_board_libs_cfar */
+
+#endif // ifndef XENSIV_BGT60TRXX_CFAR_H_
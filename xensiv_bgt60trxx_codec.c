@@ -0,0 +1,348 @@
+/***********************************************************************************************//**
+ * \file xensiv_bgt60trxx_codec.c
+ *
+ * \brief
+ * This file contains the implementation of the lossless frame codec
+ * for the XENSIV(TM) BGT60TRxx 60GHz FMCW radar sensors.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2022 Infineon Technologies AG
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#include <stddef.h>
+#include <string.h>
+
+#include "xensiv_bgt60trxx_codec.h"
+#include "xensiv_bgt60trxx_unpack.h"
+#include "xensiv_bgt60trxx_platform.h"
+
+/************************************** Macros *******************************************/
+
+#define XENSIV_BGT60TRXX_CODEC_SAMPLE_BITS          (12U)
+#define XENSIV_BGT60TRXX_CODEC_SAMPLE_MSK           (0x0FFFU)
+#define XENSIV_BGT60TRXX_CODEC_ADC_MID              (2048U)
+
+/*******************************************************************************
+ * Function Prototypes
+ ********************************************************************************/
+static uint32_t codec_num_samples(const xensiv_bgt60trxx_frame_geometry_t* geometry);
+static uint32_t codec_delta(const uint16_t* cur, const uint16_t* prev, uint32_t cnt,
+                            uint16_t* z);
+static void codec_undelta(const uint16_t* z, const uint16_t* prev, uint32_t cnt,
+                          uint16_t* cur);
+static inline uint16_t codec_zigzag(uint32_t d);
+static inline uint16_t codec_unzigzag(uint32_t v, uint32_t ref);
+static uint32_t codec_width(uint32_t any);
+static uint8_t* codec_put_bits(const uint16_t* z, uint32_t cnt, uint32_t width, uint8_t* dst);
+static const uint8_t* codec_get_bits(const uint8_t* src, uint32_t cnt, uint32_t width,
+                                     uint16_t* z);
+
+/*******************************************************************************
+ * Public interface implementation
+ ********************************************************************************/
+uint32_t xensiv_bgt60trxx_codec_max_size(const xensiv_bgt60trxx_frame_geometry_t* geometry)
+{
+    xensiv_bgt60trxx_platform_assert(geometry != NULL);
+
+    return XENSIV_BGT60TRXX_CODEC_HEADER_SIZE +
+           ((codec_num_samples(geometry) / XENSIV_BGT60TRXX_NUM_SAMPLES_FIFO_WORD) *
+            XENSIV_BGT60TRXX_FIFO_WORD_SIZE_BYTES);
+}
+
+
+uint32_t xensiv_bgt60trxx_codec_encode(const xensiv_bgt60trxx_frame_geometry_t* geometry,
+                                       xensiv_bgt60trxx_codec_mode_t mode,
+                                       const uint16_t* samples,
+                                       uint8_t* dst)
+{
+    xensiv_bgt60trxx_platform_assert(geometry != NULL);
+    xensiv_bgt60trxx_platform_assert(samples != NULL);
+    xensiv_bgt60trxx_platform_assert(dst != NULL);
+
+    uint32_t num_samples = codec_num_samples(geometry);
+    uint32_t max_size = xensiv_bgt60trxx_codec_max_size(geometry);
+
+    xensiv_bgt60trxx_platform_assert(num_samples > 0U);
+    xensiv_bgt60trxx_platform_assert((num_samples % XENSIV_BGT60TRXX_NUM_SAMPLES_FIFO_WORD) == 0U);
+
+    (void)memset(dst, 0, XENSIV_BGT60TRXX_CODEC_HEADER_SIZE);
+
+    if (mode == XENSIV_BGT60TRXX_CODEC_DELTA)
+    {
+        uint32_t chirp_len = geometry->num_samples_per_chirp * geometry->num_rx_antennas;
+        const uint8_t* end = dst + max_size;
+        uint8_t* p = dst + XENSIV_BGT60TRXX_CODEC_HEADER_SIZE;
+        const uint16_t* prev = NULL;
+        uint16_t z[XENSIV_BGT60TRXX_CODEC_BLOCK_SIZE];
+
+        for (uint32_t chirp = 0U; (chirp < geometry->num_chirps_per_frame) && (p != NULL);
+             ++chirp)
+        {
+            const uint16_t* cur = &samples[chirp * chirp_len];
+
+            for (uint32_t i = 0U; i < chirp_len; i += XENSIV_BGT60TRXX_CODEC_BLOCK_SIZE)
+            {
+                uint32_t cnt = chirp_len - i;
+                if (cnt > XENSIV_BGT60TRXX_CODEC_BLOCK_SIZE)
+                {
+                    cnt = XENSIV_BGT60TRXX_CODEC_BLOCK_SIZE;
+                }
+
+                uint32_t width =
+                    codec_width(codec_delta(&cur[i], (prev != NULL) ? &prev[i] : NULL, cnt, z));
+
+                if ((size_t)(end - p) <= ((cnt * width) + 7U) / 8U)
+                {
+                    /* not smaller than packed */
+                    p = NULL;
+                    break;
+                }
+
+                *p = (uint8_t)width;
+                p = codec_put_bits(z, cnt, width, p + 1);
+            }
+
+            prev = cur;
+        }
+
+        if (p != NULL)
+        {
+            dst[0] = (uint8_t)XENSIV_BGT60TRXX_CODEC_DELTA;
+            return (uint32_t)(p - dst);
+        }
+    }
+
+    dst[0] = (uint8_t)XENSIV_BGT60TRXX_CODEC_PACK12;
+    xensiv_bgt60trxx_pack_samples(samples, dst + XENSIV_BGT60TRXX_CODEC_HEADER_SIZE, num_samples);
+
+    return max_size;
+}
+
+
+int32_t xensiv_bgt60trxx_codec_decode(const xensiv_bgt60trxx_frame_geometry_t* geometry,
+                                      const uint8_t* src,
+                                      uint32_t len,
+                                      uint16_t* samples)
+{
+    xensiv_bgt60trxx_platform_assert(geometry != NULL);
+    xensiv_bgt60trxx_platform_assert(src != NULL);
+    xensiv_bgt60trxx_platform_assert(samples != NULL);
+
+    uint32_t num_samples = codec_num_samples(geometry);
+
+    if ((len < XENSIV_BGT60TRXX_CODEC_HEADER_SIZE) ||
+        ((num_samples % XENSIV_BGT60TRXX_NUM_SAMPLES_FIFO_WORD) != 0U))
+    {
+        return XENSIV_BGT60TRXX_STATUS_FORMAT_ERROR;
+    }
+
+    if (src[0] == (uint8_t)XENSIV_BGT60TRXX_CODEC_PACK12)
+    {
+        if (len != xensiv_bgt60trxx_codec_max_size(geometry))
+        {
+            return XENSIV_BGT60TRXX_STATUS_FORMAT_ERROR;
+        }
+
+        xensiv_bgt60trxx_unpack_samples(src + XENSIV_BGT60TRXX_CODEC_HEADER_SIZE, samples,
+                                        num_samples);
+        return XENSIV_BGT60TRXX_STATUS_OK;
+    }
+
+    if (src[0] != (uint8_t)XENSIV_BGT60TRXX_CODEC_DELTA)
+    {
+        return XENSIV_BGT60TRXX_STATUS_FORMAT_ERROR;
+    }
+
+    uint32_t chirp_len = geometry->num_samples_per_chirp * geometry->num_rx_antennas;
+    const uint8_t* end = src + len;
+    const uint8_t* p = src + XENSIV_BGT60TRXX_CODEC_HEADER_SIZE;
+    const uint16_t* prev = NULL;
+    uint16_t z[XENSIV_BGT60TRXX_CODEC_BLOCK_SIZE];
+
+    for (uint32_t chirp = 0U; chirp < geometry->num_chirps_per_frame; ++chirp)
+    {
+        uint16_t* cur = &samples[chirp * chirp_len];
+
+        for (uint32_t i = 0U; i < chirp_len; i += XENSIV_BGT60TRXX_CODEC_BLOCK_SIZE)
+        {
+            uint32_t cnt = chirp_len - i;
+            if (cnt > XENSIV_BGT60TRXX_CODEC_BLOCK_SIZE)
+            {
+                cnt = XENSIV_BGT60TRXX_CODEC_BLOCK_SIZE;
+            }
+
+            if (p == end)
+            {
+                return XENSIV_BGT60TRXX_STATUS_FORMAT_ERROR;
+            }
+
+            uint32_t width = *p;
+            if ((width > XENSIV_BGT60TRXX_CODEC_SAMPLE_BITS) ||
+                ((size_t)(end - p) <= (((cnt * width) + 7U) / 8U)))
+            {
+                return XENSIV_BGT60TRXX_STATUS_FORMAT_ERROR;
+            }
+
+            p = codec_get_bits(p + 1, cnt, width, z);
+            codec_undelta(z, (prev != NULL) ? &prev[i] : NULL, cnt, &cur[i]);
+        }
+
+        prev = cur;
+    }
+
+    return (p == end) ? XENSIV_BGT60TRXX_STATUS_OK : XENSIV_BGT60TRXX_STATUS_FORMAT_ERROR;
+}
+
+
+/*******************************************************************************
+ * Static functions implementation
+ ********************************************************************************/
+static uint32_t codec_num_samples(const xensiv_bgt60trxx_frame_geometry_t* geometry)
+{
+    return geometry->num_samples_per_chirp *
+           geometry->num_chirps_per_frame *
+           geometry->num_rx_antennas;
+}
+
+
+/* Zigzag mapped prediction errors, wrapped to 12 bits, returns the OR of all of them.
+ * The loops are split on prev so that each of them vectorizes. */
+static uint32_t codec_delta(const uint16_t* cur, const uint16_t* prev, uint32_t cnt,
+                            uint16_t* z)
+{
+    uint32_t any = 0U;
+
+    if (prev == NULL)
+    {
+        for (uint32_t j = 0U; j < cnt; ++j)
+        {
+            z[j] = codec_zigzag((uint32_t)cur[j] - XENSIV_BGT60TRXX_CODEC_ADC_MID);
+            any |= z[j];
+        }
+    }
+    else
+    {
+        for (uint32_t j = 0U; j < cnt; ++j)
+        {
+            z[j] = codec_zigzag((uint32_t)cur[j] - prev[j]);
+            any |= z[j];
+        }
+    }
+
+    return any;
+}
+
+
+static void codec_undelta(const uint16_t* z, const uint16_t* prev, uint32_t cnt,
+                          uint16_t* cur)
+{
+    if (prev == NULL)
+    {
+        for (uint32_t j = 0U; j < cnt; ++j)
+        {
+            cur[j] = codec_unzigzag(z[j], XENSIV_BGT60TRXX_CODEC_ADC_MID);
+        }
+    }
+    else
+    {
+        for (uint32_t j = 0U; j < cnt; ++j)
+        {
+            cur[j] = codec_unzigzag(z[j], prev[j]);
+        }
+    }
+}
+
+
+/* Maps the 12-bit two's complement d to 0, -1, 1, -2, ... -> 0, 1, 2, 3, ... */
+static inline uint16_t codec_zigzag(uint32_t d)
+{
+    d &= XENSIV_BGT60TRXX_CODEC_SAMPLE_MSK;
+    return (uint16_t)(((d << 1) ^ (0U - (d >> (XENSIV_BGT60TRXX_CODEC_SAMPLE_BITS - 1U)))) &
+                      XENSIV_BGT60TRXX_CODEC_SAMPLE_MSK);
+}
+
+
+static inline uint16_t codec_unzigzag(uint32_t v, uint32_t ref)
+{
+    return (uint16_t)((ref + ((v >> 1) ^ (0U - (v & 1U)))) & XENSIV_BGT60TRXX_CODEC_SAMPLE_MSK);
+}
+
+
+/* Number of bits of the largest value */
+static uint32_t codec_width(uint32_t any)
+{
+    uint32_t width = 0U;
+
+    while ((any >> width) != 0U)
+    {
+        ++width;
+    }
+
+    return width;
+}
+
+
+/* Least significant bit first */
+static uint8_t* codec_put_bits(const uint16_t* z, uint32_t cnt, uint32_t width, uint8_t* dst)
+{
+    uint32_t acc = 0U;
+    uint32_t bits = 0U;
+
+    for (uint32_t j = 0U; j < cnt; ++j)
+    {
+        acc |= (uint32_t)z[j] << bits;
+        bits += width;
+
+        while (bits >= 8U)
+        {
+            *dst++ = (uint8_t)acc;
+            acc >>= 8;
+            bits -= 8U;
+        }
+    }
+
+    if (bits > 0U)
+    {
+        *dst++ = (uint8_t)acc;
+    }
+
+    return dst;
+}
+
+
+static const uint8_t* codec_get_bits(const uint8_t* src, uint32_t cnt, uint32_t width,
+                                     uint16_t* z)
+{
+    uint32_t msk = (1U << width) - 1U;
+    uint32_t acc = 0U;
+    uint32_t bits = 0U;
+
+    for (uint32_t j = 0U; j < cnt; ++j)
+    {
+        while (bits < width)
+        {
+            acc |= (uint32_t)*src++ << bits;
+            bits += 8U;
+        }
+
+        z[j] = (uint16_t)(acc & msk);
+        acc >>= width;
+        bits -= width;
+    }
+
+    return src;
+}
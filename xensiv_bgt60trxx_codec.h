@@ -0,0 +1,128 @@
+/***********************************************************************************************//**
+ * \file xensiv_bgt60trxx_codec.h
+ *
+ * \brief
+ * This file contains the declarations of the lossless frame codec
+ * for the XENSIV(TM) BGT60TRxx 60GHz FMCW radar sensors.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2022 Infineon Technologies AG
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#ifndef XENSIV_BGT60TRXX_CODEC_H_
+#define XENSIV_BGT60TRXX_CODEC_H_
+
+#include "xensiv_bgt60trxx.h"
+
+/**
+ * \addtogroup group_board_libs_codec XENSIV(TM) BGT60TRxx Frame Codec
+ * \{
+ * Lossless compression of frames of 12-bit samples, e.g. before logging them or sending them
+ * over a slow link. An encoded frame starts with a header of
+ * \ref XENSIV_BGT60TRXX_CODEC_HEADER_SIZE bytes, the first holding the
+ * \ref xensiv_bgt60trxx_codec_mode_t of the payload:
+ * - \ref XENSIV_BGT60TRXX_CODEC_PACK12: the samples packed like the FIFO words, two samples in
+ *   three bytes (see \ref xensiv_bgt60trxx_pack_samples), 75% of the frame size.
+ * - \ref XENSIV_BGT60TRXX_CODEC_DELTA: each chirp is predicted by the previous chirp of the
+ *   frame, the first chirp by the ADC mid-scale. The prediction errors are wrapped to 12 bits,
+ *   zigzag mapped to small unsigned values and coded in blocks of
+ *   \ref XENSIV_BGT60TRXX_CODEC_BLOCK_SIZE samples of a chirp: one byte with the bit width of
+ *   the largest value of the block, followed by all values of the block with that width. For a
+ *   mostly static scene the chirps of a frame differ by little more than the noise, which then
+ *   sets the size of the frame.
+ *
+ * The chirp delta is computed and undone with fixed-length, branch-free loops over contiguous
+ * samples that the compiler vectorizes, and the block width is the OR of the values of the
+ * block, so that no table or per-sample decision is needed on the MCU. The packing of
+ * \ref XENSIV_BGT60TRXX_CODEC_PACK12 uses the packing kernels of xensiv_bgt60trxx_unpack.c,
+ * which must be part of the build.
+ *
+ * A frame that the delta coding would not make smaller than the packing, e.g. noise or a
+ * moving scene, is stored packed, so that an encoded frame never exceeds
+ * \ref xensiv_bgt60trxx_codec_max_size.
+ */
+
+/************************************** Macros *******************************************/
+
+/** Size of the header of an encoded frame in bytes */
+#define XENSIV_BGT60TRXX_CODEC_HEADER_SIZE              (4U)
+
+/** Number of samples of a block of the delta coding */
+#define XENSIV_BGT60TRXX_CODEC_BLOCK_SIZE               (32U)
+
+/******************************** Type definitions ****************************************/
+
+/** Coding of a frame */
+typedef enum
+{
+    XENSIV_BGT60TRXX_CODEC_PACK12 = 1,  /**< Samples packed to 12 bits */
+    XENSIV_BGT60TRXX_CODEC_DELTA = 2    /**< Chirp-to-chirp delta with per-block bit width */
+} xensiv_bgt60trxx_codec_mode_t;
+
+/******************************* Function prototypes *************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Obtains the largest size of an encoded frame.
+ *
+ * @param[in] geometry Pointer to the frame geometry.
+ * @return Size in bytes of the buffer passed to \ref xensiv_bgt60trxx_codec_encode.
+ */
+uint32_t xensiv_bgt60trxx_codec_max_size(const xensiv_bgt60trxx_frame_geometry_t* geometry);
+
+/**
+ * @brief Encodes a frame.
+ *
+ * @param[in] geometry Pointer to the frame geometry, the number of samples must be even.
+ * @param[in] mode Coding to use. \ref XENSIV_BGT60TRXX_CODEC_DELTA falls back to
+ * \ref XENSIV_BGT60TRXX_CODEC_PACK12 if it does not reduce the size.
+ * @param[in] samples Pointer to the samples of the frame. The upper four bits of the samples
+ * are ignored.
+ * @param[out] dst Pointer to the encoded frame, \ref xensiv_bgt60trxx_codec_max_size bytes.
+ * @return Size of the encoded frame in bytes.
+ */
+uint32_t xensiv_bgt60trxx_codec_encode(const xensiv_bgt60trxx_frame_geometry_t* geometry,
+                                       xensiv_bgt60trxx_codec_mode_t mode,
+                                       const uint16_t* samples,
+                                       uint8_t* dst);
+
+/**
+ * @brief Decodes a frame.
+ *
+ * @param[in] geometry Pointer to the frame geometry used to encode the frame.
+ * @param[in] src Pointer to the encoded frame.
+ * @param[in] len Size of the encoded frame in bytes.
+ * @param[out] samples Pointer to the samples of the frame.
+ * @return XENSIV_BGT60TRXX_STATUS_OK if the frame was decoded;
+ * XENSIV_BGT60TRXX_STATUS_FORMAT_ERROR if \p src is not an encoded frame of the given geometry,
+ * the samples are undefined.
+ */
+int32_t xensiv_bgt60trxx_codec_decode(const xensiv_bgt60trxx_frame_geometry_t* geometry,
+                                      const uint8_t* src,
+                                      uint32_t len,
+                                      uint16_t* samples);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** \} group_board_libs_codec */
+
+#endif // ifndef XENSIV_BGT60TRXX_CODEC_H_
@@ -0,0 +1,364 @@
+/***********************************************************************************************//**
+ * \file xensiv_bgt60trxx_cube.c
+ *
+ * \brief
+ * This file contains the implementation of the radar cube layout functions
+ * for the XENSIV(TM) BGT60TRxx 60GHz FMCW radar sensors.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2022 Infineon Technologies AG
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#include <stddef.h>
+
+#include "xensiv_bgt60trxx_cube.h"
+#include "xensiv_bgt60trxx_platform.h"
+
+#if !defined(XENSIV_BGT60TRXX_CUBE_PORTABLE)
+#if defined(__SSSE3__)
+#define XENSIV_BGT60TRXX_CUBE_SSSE3
+#include <tmmintrin.h>
+#elif (defined(__ARM_NEON) || defined(__ARM_NEON__)) && defined(XENSIV_BGT60TRXX_ENABLE_NEON)
+#define XENSIV_BGT60TRXX_CUBE_NEON
+#include <arm_neon.h>
+#endif
+#endif // !defined(XENSIV_BGT60TRXX_CUBE_PORTABLE)
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define XENSIV_BGT60TRXX_CUBE_ADC_MID               (2048)
+#define XENSIV_BGT60TRXX_CUBE_SCALE                 (1.0f / 2048.0f)
+
+/* Number of RX antennas handled by the vector kernels */
+#define XENSIV_BGT60TRXX_CUBE_VEC_MAX_RX            (3U)
+
+/* Samples per antenna processed by one iteration of the vector kernels */
+#define XENSIV_BGT60TRXX_CUBE_VEC_SAMPLES           (8U)
+
+
+/*******************************************************************************
+ * Function Prototypes
+ ********************************************************************************/
+static void cube_from_frame(const xensiv_bgt60trxx_frame_geometry_t* geometry,
+                            const uint16_t* frame,
+                            int16_t* cube_i16,
+                            float* cube_f32);
+
+static uint32_t deinterleave_vec(const uint16_t* src,
+                                 int16_t* const* dst_i16,
+                                 float* const* dst_f32,
+                                 uint32_t num_samples,
+                                 uint32_t num_rx);
+
+/*******************************************************************************
+ * Public interface implementation
+ ********************************************************************************/
+uint32_t xensiv_bgt60trxx_cube_stride(const xensiv_bgt60trxx_frame_geometry_t* geometry,
+                                      uint32_t elem_size)
+{
+    xensiv_bgt60trxx_platform_assert(geometry != NULL);
+    xensiv_bgt60trxx_platform_assert((elem_size > 0U) &&
+                                     ((XENSIV_BGT60TRXX_CUBE_ALIGN % elem_size) == 0U));
+
+    uint32_t elems_per_line = XENSIV_BGT60TRXX_CUBE_ALIGN / elem_size;
+
+    return ((geometry->num_samples_per_chirp + elems_per_line - 1U) / elems_per_line) *
+           elems_per_line;
+}
+
+
+uint32_t xensiv_bgt60trxx_cube_size(const xensiv_bgt60trxx_frame_geometry_t* geometry,
+                                    uint32_t elem_size)
+{
+    return geometry->num_rx_antennas * geometry->num_chirps_per_frame *
+           xensiv_bgt60trxx_cube_stride(geometry, elem_size) * elem_size;
+}
+
+
+void xensiv_bgt60trxx_cube_from_frame_i16(const xensiv_bgt60trxx_frame_geometry_t* geometry,
+                                          const uint16_t* frame,
+                                          int16_t* cube)
+{
+    cube_from_frame(geometry, frame, cube, NULL);
+}
+
+
+void xensiv_bgt60trxx_cube_from_frame_f32(const xensiv_bgt60trxx_frame_geometry_t* geometry,
+                                          const uint16_t* frame,
+                                          float* cube)
+{
+    cube_from_frame(geometry, frame, NULL, cube);
+}
+
+
+/*******************************************************************************
+ * Static functions implementation
+ ********************************************************************************/
+static void cube_from_frame(const xensiv_bgt60trxx_frame_geometry_t* geometry,
+                            const uint16_t* frame,
+                            int16_t* cube_i16,
+                            float* cube_f32)
+{
+    xensiv_bgt60trxx_platform_assert(geometry != NULL);
+    xensiv_bgt60trxx_platform_assert(frame != NULL);
+    xensiv_bgt60trxx_platform_assert((cube_i16 != NULL) || (cube_f32 != NULL));
+
+    uint32_t num_samples = geometry->num_samples_per_chirp;
+    uint32_t num_chirps = geometry->num_chirps_per_frame;
+    uint32_t num_rx = geometry->num_rx_antennas;
+    uint32_t stride = xensiv_bgt60trxx_cube_stride(geometry, (cube_i16 != NULL) ?
+                                                   (uint32_t)sizeof(int16_t) :
+                                                   (uint32_t)sizeof(float));
+
+    xensiv_bgt60trxx_platform_assert(num_rx > 0U);
+    xensiv_bgt60trxx_platform_assert(
+        ((uintptr_t)((cube_i16 != NULL) ? (void*)cube_i16 : (void*)cube_f32) %
+         XENSIV_BGT60TRXX_CUBE_ALIGN) == 0U);
+
+    for (uint32_t chirp = 0U; chirp < num_chirps; ++chirp)
+    {
+        const uint16_t* src = &frame[chirp * num_samples * num_rx];
+        int16_t* dst_i16[XENSIV_BGT60TRXX_CUBE_VEC_MAX_RX] = { NULL, NULL, NULL };
+        float* dst_f32[XENSIV_BGT60TRXX_CUBE_VEC_MAX_RX] = { NULL, NULL, NULL };
+
+        uint32_t done = 0U;
+        if (num_rx <= XENSIV_BGT60TRXX_CUBE_VEC_MAX_RX)
+        {
+            for (uint32_t rx = 0U; rx < num_rx; ++rx)
+            {
+                uint32_t row = ((rx * num_chirps) + chirp) * stride;
+                dst_i16[rx] = (cube_i16 != NULL) ? &cube_i16[row] : NULL;
+                dst_f32[rx] = (cube_f32 != NULL) ? &cube_f32[row] : NULL;
+            }
+
+            done = deinterleave_vec(src, dst_i16, dst_f32, num_samples, num_rx);
+        }
+
+        /* remaining samples, or all of them if the vector kernels do not apply */
+        for (uint32_t rx = 0U; rx < num_rx; ++rx)
+        {
+            uint32_t row = ((rx * num_chirps) + chirp) * stride;
+
+            for (uint32_t sample = done; sample < num_samples; ++sample)
+            {
+                int32_t val = (int32_t)src[(sample * num_rx) + rx] - XENSIV_BGT60TRXX_CUBE_ADC_MID;
+
+                if (cube_i16 != NULL)
+                {
+                    cube_i16[row + sample] = (int16_t)val;
+                }
+                else
+                {
+                    cube_f32[row + sample] = (float)val * XENSIV_BGT60TRXX_CUBE_SCALE;
+                }
+            }
+        }
+    }
+}
+
+
+#if defined(XENSIV_BGT60TRXX_CUBE_SSSE3)
+static inline void store_vec(__m128i v, int16_t* dst_i16, float* dst_f32)
+{
+    if (dst_i16 != NULL)
+    {
+        _mm_store_si128((__m128i*)dst_i16, v);
+    }
+    else
+    {
+        /* sign extend to 32 bits by shifting the sample into the upper half */
+        const __m128 scale = _mm_set1_ps(XENSIV_BGT60TRXX_CUBE_SCALE);
+        __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+        __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+        _mm_store_ps(dst_f32, _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+        _mm_store_ps(&dst_f32[4], _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+    }
+}
+
+
+static inline uint32_t deinterleave_ssse3(const uint16_t* src,
+                                          int16_t* const* dst_i16,
+                                          float* const* dst_f32,
+                                          uint32_t num_samples,
+                                          uint32_t num_rx)
+{
+    /* masks[rx][j] moves the samples of antenna rx found in input vector j to their output
+     * position, all other lanes are zeroed (0x80) */
+    __m128i masks[XENSIV_BGT60TRXX_CUBE_VEC_MAX_RX][XENSIV_BGT60TRXX_CUBE_VEC_MAX_RX];
+
+    for (uint32_t rx = 0U; rx < num_rx; ++rx)
+    {
+        for (uint32_t j = 0U; j < num_rx; ++j)
+        {
+            uint8_t m[16];
+            for (uint32_t b = 0U; b < 16U; ++b)
+            {
+                uint32_t i = ((b / 2U) * num_rx) + rx;
+                m[b] = ((i / XENSIV_BGT60TRXX_CUBE_VEC_SAMPLES) == j) ?
+                       (uint8_t)((2U * (i % XENSIV_BGT60TRXX_CUBE_VEC_SAMPLES)) + (b & 1U)) :
+                       0x80U;
+            }
+            masks[rx][j] = _mm_loadu_si128((const __m128i*)m);
+        }
+    }
+
+    const __m128i mid = _mm_set1_epi16(XENSIV_BGT60TRXX_CUBE_ADC_MID);
+    uint32_t sample = 0U;
+
+    for (; (sample + XENSIV_BGT60TRXX_CUBE_VEC_SAMPLES) <= num_samples;
+         sample += XENSIV_BGT60TRXX_CUBE_VEC_SAMPLES)
+    {
+        const __m128i* in = (const __m128i*)&src[sample * num_rx];
+        __m128i v[XENSIV_BGT60TRXX_CUBE_VEC_MAX_RX];
+
+        for (uint32_t j = 0U; j < num_rx; ++j)
+        {
+            v[j] = _mm_loadu_si128(&in[j]);
+        }
+
+        for (uint32_t rx = 0U; rx < num_rx; ++rx)
+        {
+            __m128i out = v[0];
+            if (num_rx > 1U)
+            {
+                out = _mm_shuffle_epi8(v[0], masks[rx][0]);
+                for (uint32_t j = 1U; j < num_rx; ++j)
+                {
+                    out = _mm_or_si128(out, _mm_shuffle_epi8(v[j], masks[rx][j]));
+                }
+            }
+
+            store_vec(_mm_sub_epi16(out, mid),
+                      (dst_i16[rx] != NULL) ? &dst_i16[rx][sample] : NULL,
+                      (dst_f32[rx] != NULL) ? &dst_f32[rx][sample] : NULL);
+        }
+    }
+
+    return sample;
+}
+
+
+static uint32_t deinterleave_vec(const uint16_t* src,
+                                 int16_t* const* dst_i16,
+                                 float* const* dst_f32,
+                                 uint32_t num_samples,
+                                 uint32_t num_rx)
+{
+    /* constant antenna counts let the compiler unroll the per-antenna loops */
+    uint32_t done;
+
+    switch (num_rx)
+    {
+        case 1U:
+            done = deinterleave_ssse3(src, dst_i16, dst_f32, num_samples, 1U);
+            break;
+
+        case 2U:
+            done = deinterleave_ssse3(src, dst_i16, dst_f32, num_samples, 2U);
+            break;
+
+        default:
+            done = deinterleave_ssse3(src, dst_i16, dst_f32, num_samples, 3U);
+            break;
+    }
+
+    return done;
+}
+
+
+#elif defined(XENSIV_BGT60TRXX_CUBE_NEON)
+static inline void store_vec(uint16x8_t v, int16_t* dst_i16, float* dst_f32)
+{
+    int16x8_t s = vreinterpretq_s16_u16(vsubq_u16(v, vdupq_n_u16(XENSIV_BGT60TRXX_CUBE_ADC_MID)));
+
+    if (dst_i16 != NULL)
+    {
+        vst1q_s16(dst_i16, s);
+    }
+    else
+    {
+        vst1q_f32(dst_f32, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(s))),
+                                       XENSIV_BGT60TRXX_CUBE_SCALE));
+        vst1q_f32(&dst_f32[4], vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(s))),
+                                           XENSIV_BGT60TRXX_CUBE_SCALE));
+    }
+}
+
+
+static uint32_t deinterleave_vec(const uint16_t* src,
+                                 int16_t* const* dst_i16,
+                                 float* const* dst_f32,
+                                 uint32_t num_samples,
+                                 uint32_t num_rx)
+{
+    uint32_t sample = 0U;
+
+    for (; (sample + XENSIV_BGT60TRXX_CUBE_VEC_SAMPLES) <= num_samples;
+         sample += XENSIV_BGT60TRXX_CUBE_VEC_SAMPLES)
+    {
+        const uint16_t* in = &src[sample * num_rx];
+        uint16x8_t v[XENSIV_BGT60TRXX_CUBE_VEC_MAX_RX];
+
+        if (num_rx == 1U)
+        {
+            v[0] = vld1q_u16(in);
+        }
+        else if (num_rx == 2U)
+        {
+            uint16x8x2_t d = vld2q_u16(in);
+            v[0] = d.val[0];
+            v[1] = d.val[1];
+        }
+        else
+        {
+            uint16x8x3_t d = vld3q_u16(in);
+            v[0] = d.val[0];
+            v[1] = d.val[1];
+            v[2] = d.val[2];
+        }
+
+        for (uint32_t rx = 0U; rx < num_rx; ++rx)
+        {
+            store_vec(v[rx],
+                      (dst_i16[rx] != NULL) ? &dst_i16[rx][sample] : NULL,
+                      (dst_f32[rx] != NULL) ? &dst_f32[rx][sample] : NULL);
+        }
+    }
+
+    return sample;
+}
+
+
+#else // portable
+static uint32_t deinterleave_vec(const uint16_t* src,
+                                 int16_t* const* dst_i16,
+                                 float* const* dst_f32,
+                                 uint32_t num_samples,
+                                 uint32_t num_rx)
+{
+    (void)src;
+    (void)dst_i16;
+    (void)dst_f32;
+    (void)num_samples;
+    (void)num_rx;
+
+    return 0U;
+}
+
+
+#endif // defined(XENSIV_BGT60TRXX_CUBE_SSSE3)
@@ -0,0 +1,111 @@
+/***********************************************************************************************//**
+ * \file xensiv_bgt60trxx_cube.h
+ *
+ * \brief
+ * This file contains the declarations of the radar cube layout functions
+ * for the XENSIV(TM) BGT60TRxx 60GHz FMCW radar sensors.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2022 Infineon Technologies AG
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#ifndef XENSIV_BGT60TRXX_CUBE_H_
+#define XENSIV_BGT60TRXX_CUBE_H_
+
+#include "xensiv_bgt60trxx.h"
+
+/**
+ * \addtogroup group_board_libs_cube XENSIV(TM) BGT60TRxx Radar Cube
+ * \{
+ * Rearranges a frame, as read from the FIFO with the samples of the active RX antennas
+ * interleaved, into a radar cube holding one contiguous row of samples per RX antenna and chirp:
+ * \code
+ * cube[(rx * num_chirps_per_frame + chirp) * stride + sample]
+ * \endcode
+ * Each row starts at a multiple of \ref XENSIV_BGT60TRXX_CUBE_ALIGN bytes, the stride in
+ * elements is returned by \ref xensiv_bgt60trxx_cube_stride. The samples are converted to signed
+ * values centered around zero: sample - 2048 for int16_t, (sample - 2048) / 2048 for float.
+ *
+ * The de-interleaving uses SSSE3 (__SSSE3__) if the compiler targets it, or NEON (__ARM_NEON)
+ * if XENSIV_BGT60TRXX_ENABLE_NEON is defined as well, for up to 3 RX antennas, portable C
+ * otherwise. Define XENSIV_BGT60TRXX_CUBE_PORTABLE to force the portable implementation.
+ */
+
+/************************************** Macros *******************************************/
+
+/** Alignment in bytes of the cube buffer and of each of its rows (cache line size) */
+#ifndef XENSIV_BGT60TRXX_CUBE_ALIGN
+#define XENSIV_BGT60TRXX_CUBE_ALIGN                     (64U)
+#endif
+
+/******************************* Function prototypes *************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Obtains the number of elements between the start of two consecutive cube rows.
+ *
+ * @param[in] geometry Pointer to the frame geometry.
+ * @param[in] elem_size Size of a cube element in bytes, sizeof(int16_t) or sizeof(float).
+ * @return Row stride in elements.
+ */
+uint32_t xensiv_bgt60trxx_cube_stride(const xensiv_bgt60trxx_frame_geometry_t* geometry,
+                                      uint32_t elem_size);
+
+/**
+ * @brief Obtains the size of the cube buffer.
+ *
+ * @param[in] geometry Pointer to the frame geometry.
+ * @param[in] elem_size Size of a cube element in bytes, sizeof(int16_t) or sizeof(float).
+ * @return Size of the cube in bytes.
+ */
+uint32_t xensiv_bgt60trxx_cube_size(const xensiv_bgt60trxx_frame_geometry_t* geometry,
+                                    uint32_t elem_size);
+
+/**
+ * @brief Writes a frame into an int16_t radar cube.
+ *
+ * @param[in] geometry Pointer to the frame geometry.
+ * @param[in] frame Pointer to the frame as read from the FIFO.
+ * @param[out] cube Pointer to the cube buffer, aligned to \ref XENSIV_BGT60TRXX_CUBE_ALIGN
+ * bytes, of \ref xensiv_bgt60trxx_cube_size bytes.
+ */
+void xensiv_bgt60trxx_cube_from_frame_i16(const xensiv_bgt60trxx_frame_geometry_t* geometry,
+                                          const uint16_t* frame,
+                                          int16_t* cube);
+
+/**
+ * @brief Writes a frame into a float radar cube.
+ *
+ * @param[in] geometry Pointer to the frame geometry.
+ * @param[in] frame Pointer to the frame as read from the FIFO.
+ * @param[out] cube Pointer to the cube buffer, aligned to \ref XENSIV_BGT60TRXX_CUBE_ALIGN
+ * bytes, of \ref xensiv_bgt60trxx_cube_size bytes.
+ */
+void xensiv_bgt60trxx_cube_from_frame_f32(const xensiv_bgt60trxx_frame_geometry_t* geometry,
+                                          const uint16_t* frame,
+                                          float* cube);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** \} group_board_libs_cube */
+
+#endif // ifndef XENSIV_BGT60TRXX_CUBE_H_
@@ -0,0 +1,279 @@
+/***********************************************************************************************//**
+ * \file xensiv_bgt60trxx_doppler.c
+ *
+ * \brief
+ * This file contains the implementation of the range-Doppler processing functions
+ * for the XENSIV(TM) BGT60TRxx 60GHz FMCW radar sensors.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2022 Infineon Technologies AG
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#include <math.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "xensiv_bgt60trxx_doppler.h"
+#include "xensiv_bgt60trxx_platform.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+/* Power added before taking the logarithm, limits the map to -200 dB */
+#define XENSIV_BGT60TRXX_DOPPLER_POWER_FLOOR        (1e-20f)
+
+/* 10 * log10(2) */
+#define XENSIV_BGT60TRXX_DOPPLER_DB_PER_OCTAVE      (3.01029996f)
+
+/* 2 / ln(2) */
+#define XENSIV_BGT60TRXX_DOPPLER_ATANH_TO_LOG2      (2.88539008f)
+
+#define XENSIV_BGT60TRXX_FLOAT_EXP_SHIFT            (23U)
+#define XENSIV_BGT60TRXX_FLOAT_EXP_MSK              (0xFFU)
+#define XENSIV_BGT60TRXX_FLOAT_EXP_BIAS             (127)
+#define XENSIV_BGT60TRXX_FLOAT_MANT_MSK             (0x007FFFFFU)
+#define XENSIV_BGT60TRXX_FLOAT_ONE                  (0x3F800000U)
+
+
+/*******************************************************************************
+ * Function Prototypes
+ ********************************************************************************/
+static void doppler_tile(const xensiv_bgt60trxx_doppler_t* doppler,
+                         const float* spectrum,
+                         float* map,
+                         uint32_t num_bins);
+
+static inline float power_db(float power);
+
+/*******************************************************************************
+ * Public interface implementation
+ ********************************************************************************/
+void xensiv_bgt60trxx_doppler_init(xensiv_bgt60trxx_doppler_t* doppler,
+                                   const xensiv_bgt60trxx_range_t* range,
+                                   const xensiv_bgt60trxx_frame_geometry_t* geometry,
+                                   uint32_t num_range_bins,
+                                   uint32_t fft_size,
+                                   xensiv_bgt60trxx_window_t window,
+                                   xensiv_bgt60trxx_mti_t mti,
+                                   xensiv_bgt60trxx_doppler_output_t output,
+                                   float* workspace)
+{
+    xensiv_bgt60trxx_platform_assert(doppler != NULL);
+    xensiv_bgt60trxx_platform_assert(range != NULL);
+    xensiv_bgt60trxx_platform_assert(geometry != NULL);
+    xensiv_bgt60trxx_platform_assert(workspace != NULL);
+    xensiv_bgt60trxx_platform_assert((num_range_bins > 0U) &&
+                                     (num_range_bins <= (range->fft_size / 2U)));
+    xensiv_bgt60trxx_platform_assert((fft_size >= XENSIV_BGT60TRXX_DOPPLER_FFT_SIZE_MIN) &&
+                                     (fft_size <= XENSIV_BGT60TRXX_DOPPLER_FFT_SIZE_MAX) &&
+                                     ((fft_size & (fft_size - 1U)) == 0U));
+    xensiv_bgt60trxx_platform_assert((geometry->num_chirps_per_frame > 0U) &&
+                                     (geometry->num_chirps_per_frame <= fft_size));
+
+    uint32_t num_chirps = geometry->num_chirps_per_frame;
+
+    doppler->num_rx_antennas = geometry->num_rx_antennas;
+    doppler->num_chirps = num_chirps;
+    doppler->range_stride = range->fft_size;
+    doppler->num_range_bins = num_range_bins;
+    doppler->fft_size = fft_size;
+    doppler->mti = mti;
+    doppler->output = output;
+    doppler->window = workspace;
+    doppler->window_spectrum = &workspace[fft_size];
+    doppler->twiddle = &workspace[3U * fft_size];
+    doppler->tile = &workspace[(3U * fft_size) + XENSIV_BGT60TRXX_FFT_TWIDDLE_LEN(fft_size)];
+
+    for (uint32_t c = 0U; c < num_chirps; ++c)
+    {
+        doppler->window[c] = (float)(xensiv_bgt60trxx_window_value(window, c, num_chirps) /
+                                     (double)fft_size);
+    }
+
+    xensiv_bgt60trxx_fft_init_f32(doppler->twiddle, fft_size);
+
+    /* the MTI filter subtracts mean * FFT(window) from the spectrum, which equals removing the
+     * mean before windowing and saves a pass over the tile */
+    float* spec = doppler->window_spectrum;
+    uint32_t r = 0U;
+    for (uint32_t c = 0U; c < fft_size; ++c)
+    {
+        spec[2U * r] = (c < num_chirps) ? doppler->window[c] : 0.0f;
+        spec[(2U * r) + 1U] = 0.0f;
+        r = xensiv_bgt60trxx_fft_bitrev_next(r, fft_size);
+    }
+    xensiv_bgt60trxx_fft_f32(spec, doppler->twiddle, fft_size);
+}
+
+
+void xensiv_bgt60trxx_doppler_map(const xensiv_bgt60trxx_doppler_t* doppler,
+                                  const float* spectrum,
+                                  float* map)
+{
+    xensiv_bgt60trxx_platform_assert(doppler != NULL);
+    xensiv_bgt60trxx_platform_assert(spectrum != NULL);
+    xensiv_bgt60trxx_platform_assert(map != NULL);
+
+    uint32_t num_range_bins = doppler->num_range_bins;
+
+    for (uint32_t rx = 0U; rx < doppler->num_rx_antennas; ++rx)
+    {
+        const float* rx_spectrum =
+            &spectrum[rx * doppler->num_chirps * doppler->range_stride];
+        float* rx_map = &map[rx * doppler->fft_size * num_range_bins];
+
+        for (uint32_t bin = 0U; bin < num_range_bins; bin += XENSIV_BGT60TRXX_DOPPLER_TILE_BINS)
+        {
+            uint32_t num_bins = num_range_bins - bin;
+            if (num_bins > XENSIV_BGT60TRXX_DOPPLER_TILE_BINS)
+            {
+                num_bins = XENSIV_BGT60TRXX_DOPPLER_TILE_BINS;
+            }
+
+            doppler_tile(doppler, &rx_spectrum[2U * bin], &rx_map[bin], num_bins);
+        }
+    }
+}
+
+
+/*******************************************************************************
+ * Static functions implementation
+ ********************************************************************************/
+/* Transforms num_bins consecutive range bins of one RX antenna */
+static void doppler_tile(const xensiv_bgt60trxx_doppler_t* doppler,
+                         const float* spectrum,
+                         float* map,
+                         uint32_t num_bins)
+{
+    uint32_t num_chirps = doppler->num_chirps;
+    uint32_t fft_size = doppler->fft_size;
+    uint32_t row_len = 2U * fft_size;
+    float* tile = doppler->tile;
+    float sum[2U * XENSIV_BGT60TRXX_DOPPLER_TILE_BINS] = { 0.0f };
+
+    /* corner turn: one contiguous read of num_bins complex values per chirp, windowed and
+     * written in bit reversed order to the tile rows */
+    uint32_t r = 0U;
+    for (uint32_t c = 0U; c < fft_size; ++c)
+    {
+        float* dst = &tile[2U * r];
+
+        if (c < num_chirps)
+        {
+            const float* src = &spectrum[c * doppler->range_stride];
+            float w = doppler->window[c];
+
+            for (uint32_t t = 0U; t < num_bins; ++t)
+            {
+                float re = src[2U * t];
+                float im = src[(2U * t) + 1U];
+
+                dst[t * row_len] = re * w;
+                dst[(t * row_len) + 1U] = im * w;
+                sum[2U * t] += re;
+                sum[(2U * t) + 1U] += im;
+            }
+        }
+        else
+        {
+            for (uint32_t t = 0U; t < num_bins; ++t)
+            {
+                dst[t * row_len] = 0.0f;
+                dst[(t * row_len) + 1U] = 0.0f;
+            }
+        }
+
+        r = xensiv_bgt60trxx_fft_bitrev_next(r, fft_size);
+    }
+
+    for (uint32_t t = 0U; t < num_bins; ++t)
+    {
+        xensiv_bgt60trxx_fft_f32(&tile[t * row_len], doppler->twiddle, fft_size);
+
+        if (doppler->mti == XENSIV_BGT60TRXX_MTI_MEAN)
+        {
+            sum[2U * t] /= (float)num_chirps;
+            sum[(2U * t) + 1U] /= (float)num_chirps;
+        }
+        else
+        {
+            sum[2U * t] = 0.0f;
+            sum[(2U * t) + 1U] = 0.0f;
+        }
+    }
+
+    /* map rows are Doppler bins, shifted to have zero velocity in the middle; each row receives
+     * num_bins contiguous values */
+    const float* spec = doppler->window_spectrum;
+    for (uint32_t d = 0U; d < fft_size; ++d)
+    {
+        uint32_t k = (d + (fft_size / 2U)) & (fft_size - 1U);
+        float* dst = &map[d * doppler->num_range_bins];
+        float wr = spec[2U * k];
+        float wi = spec[(2U * k) + 1U];
+
+        for (uint32_t t = 0U; t < num_bins; ++t)
+        {
+            float mean_re = sum[2U * t];
+            float mean_im = sum[(2U * t) + 1U];
+            float re = tile[(t * row_len) + (2U * k)] - ((mean_re * wr) - (mean_im * wi));
+            float im = tile[(t * row_len) + (2U * k) + 1U] - ((mean_re * wi) + (mean_im * wr));
+            dst[t] = (re * re) + (im * im);
+        }
+
+        /* separate loops keep the conversion free of branches */
+        if (doppler->output == XENSIV_BGT60TRXX_DOPPLER_MAGNITUDE)
+        {
+            for (uint32_t t = 0U; t < num_bins; ++t)
+            {
+                dst[t] = sqrtf(dst[t]);
+            }
+        }
+        else
+        {
+            for (uint32_t t = 0U; t < num_bins; ++t)
+            {
+                dst[t] = power_db(dst[t]);
+            }
+        }
+    }
+}
+
+
+/* 10 * log10(power), within 0.001 dB. Cheaper than log10f() and vectorizable: the exponent
+ * gives the integer part of log2, the mantissa m in [1, 2) the fractional part with the series
+ * log2(m) = 2 / ln(2) * (s + s^3 / 3 + s^5 / 5 + s^7 / 7), s = (m - 1) / (m + 1) */
+static inline float power_db(float power)
+{
+    float x = power + XENSIV_BGT60TRXX_DOPPLER_POWER_FLOOR;
+    uint32_t bits;
+    (void)memcpy(&bits, &x, sizeof(bits));
+
+    float exponent = (float)((int32_t)((bits >> XENSIV_BGT60TRXX_FLOAT_EXP_SHIFT) &
+                                       XENSIV_BGT60TRXX_FLOAT_EXP_MSK) -
+                             XENSIV_BGT60TRXX_FLOAT_EXP_BIAS);
+    bits = (bits & XENSIV_BGT60TRXX_FLOAT_MANT_MSK) | XENSIV_BGT60TRXX_FLOAT_ONE;
+    float m;
+    (void)memcpy(&m, &bits, sizeof(m));
+
+    float s = (m - 1.0f) / (m + 1.0f);
+    float s2 = s * s;
+    float log2_m = XENSIV_BGT60TRXX_DOPPLER_ATANH_TO_LOG2 * s *
+                   (1.0f + (s2 * ((1.0f / 3.0f) + (s2 * ((1.0f / 5.0f) + (s2 * (1.0f / 7.0f)))))));
+
+    return XENSIV_BGT60TRXX_DOPPLER_DB_PER_OCTAVE * (exponent + log2_m);
+}
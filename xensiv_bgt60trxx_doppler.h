@@ -0,0 +1,160 @@
+/***********************************************************************************************//**
+ * \file xensiv_bgt60trxx_doppler.h
+ *
+ * \brief
+ * This file contains the declarations of the range-Doppler processing functions
+ * for the XENSIV(TM) BGT60TRxx 60GHz FMCW radar sensors.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2022 Infineon Technologies AG
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#ifndef XENSIV_BGT60TRXX_DOPPLER_H_
+#define XENSIV_BGT60TRXX_DOPPLER_H_
+
+#include "xensiv_bgt60trxx.h"
+#include "xensiv_bgt60trxx_fft.h"
+#include "xensiv_bgt60trxx_range.h"
+
+/**
+ * \addtogroup group_board_libs_doppler XENSIV(TM) BGT60TRxx Range-Doppler Processing
+ * \{
+ * Computes a range-Doppler map per RX antenna from the range spectra of a frame (see
+ * \ref xensiv_bgt60trxx_range_cube_f32) with an FFT across the chirps of each range bin.
+ *
+ * The range spectra are stored chirp by chirp, so the range bins are transposed in tiles of
+ * \ref XENSIV_BGT60TRXX_DOPPLER_TILE_BINS bins: each chirp contributes one contiguous read and
+ * the Doppler FFTs of the tile run in a small workspace that stays in the data cache.
+ * Optionally the mean over the chirps is removed from each range bin (MTI filter), which
+ * suppresses static targets. The map holds the magnitude or the power in dB:
+ * \code
+ * map[(rx * fft_size + d) * num_range_bins + bin]
+ * \endcode
+ * with zero velocity at d = fft_size / 2. The spectrum is scaled by 1 / fft_size.
+ *
+ * All tables and the tile buffer live in a caller-provided workspace set up once by
+ * \ref xensiv_bgt60trxx_doppler_init and reused for every frame.
+ */
+
+/************************************** Macros *******************************************/
+
+/** Number of range bins transposed and transformed together */
+#ifndef XENSIV_BGT60TRXX_DOPPLER_TILE_BINS
+#define XENSIV_BGT60TRXX_DOPPLER_TILE_BINS              (8U)
+#endif
+
+/** Minimum Doppler FFT size */
+#define XENSIV_BGT60TRXX_DOPPLER_FFT_SIZE_MIN           (4U)
+
+/** Maximum Doppler FFT size */
+#define XENSIV_BGT60TRXX_DOPPLER_FFT_SIZE_MAX           (4096U)
+
+/** Number of float elements of the workspace */
+#define XENSIV_BGT60TRXX_DOPPLER_WORKSPACE_LEN(fft_size)                   \
+    ((3U * (fft_size)) + XENSIV_BGT60TRXX_FFT_TWIDDLE_LEN(fft_size) +     \
+     (2U * XENSIV_BGT60TRXX_DOPPLER_TILE_BINS * (fft_size)))
+
+/******************************** Type definitions ****************************************/
+
+/** Clutter filter applied across the chirps of each range bin */
+typedef enum
+{
+    XENSIV_BGT60TRXX_MTI_NONE = 0,          /**< No filter */
+    XENSIV_BGT60TRXX_MTI_MEAN = 1           /**< Removes the mean over the chirps */
+} xensiv_bgt60trxx_mti_t;
+
+/** Values written to the range-Doppler map */
+typedef enum
+{
+    XENSIV_BGT60TRXX_DOPPLER_MAGNITUDE = 0, /**< Magnitude */
+    XENSIV_BGT60TRXX_DOPPLER_POWER_DB = 1   /**< Power in dB, 10 * log10(magnitude^2) */
+} xensiv_bgt60trxx_doppler_output_t;
+
+/**
+ * Structure holding the range-Doppler processing configuration.
+ *
+ * Application code should not rely on the specific content of this struct.
+ * They are considered an implementation detail which is subject to change
+ * between platforms and/or library releases.
+ */
+typedef struct
+{
+    uint32_t num_rx_antennas;
+    uint32_t num_chirps;
+    uint32_t range_stride;             /* elements between two chirps of the range spectra */
+    uint32_t num_range_bins;
+    uint32_t fft_size;
+    xensiv_bgt60trxx_mti_t mti;
+    xensiv_bgt60trxx_doppler_output_t output;
+    float* window;                     /* num_chirps, includes the 1 / fft_size scaling */
+    float* window_spectrum;            /* fft_size complex values, FFT of the window */
+    float* twiddle;
+    float* tile;                       /* TILE_BINS rows of fft_size complex values */
+} xensiv_bgt60trxx_doppler_t;
+
+/******************************* Function prototypes *************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Initializes the range-Doppler processing and its workspace.
+ *
+ * @param[out] doppler Pointer to the range-Doppler processing object.
+ * @param[in] range Pointer to the float range processing object producing the range spectra.
+ * @param[in] geometry Pointer to the frame geometry.
+ * @param[in] num_range_bins Number of range bins to process, starting from DC. At most
+ * fft_size / 2 of the range processing.
+ * @param[in] fft_size Doppler FFT size, a power of two from
+ * \ref XENSIV_BGT60TRXX_DOPPLER_FFT_SIZE_MIN to \ref XENSIV_BGT60TRXX_DOPPLER_FFT_SIZE_MAX, not
+ * less than the number of chirps per frame. Chirps are zero-padded.
+ * @param[in] window Window applied across the chirps.
+ * @param[in] mti Clutter filter.
+ * @param[in] output Values written to the map.
+ * @param[out] workspace Pointer to \ref XENSIV_BGT60TRXX_DOPPLER_WORKSPACE_LEN (\p fft_size)
+ * elements. Must stay valid while the range-Doppler processing object is used.
+ */
+void xensiv_bgt60trxx_doppler_init(xensiv_bgt60trxx_doppler_t* doppler,
+                                   const xensiv_bgt60trxx_range_t* range,
+                                   const xensiv_bgt60trxx_frame_geometry_t* geometry,
+                                   uint32_t num_range_bins,
+                                   uint32_t fft_size,
+                                   xensiv_bgt60trxx_window_t window,
+                                   xensiv_bgt60trxx_mti_t mti,
+                                   xensiv_bgt60trxx_doppler_output_t output,
+                                   float* workspace);
+
+/**
+ * @brief Computes the range-Doppler maps of a frame.
+ *
+ * @param[in] doppler Pointer to the range-Doppler processing object.
+ * @param[in] spectrum Pointer to the range spectra written by
+ * \ref xensiv_bgt60trxx_range_cube_f32.
+ * @param[out] map Pointer to num_rx_antennas * fft_size * num_range_bins elements.
+ */
+void xensiv_bgt60trxx_doppler_map(const xensiv_bgt60trxx_doppler_t* doppler,
+                                  const float* spectrum,
+                                  float* map);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** \} group_board_libs_doppler */
+
+#endif // ifndef XENSIV_BGT60TRXX_DOPPLER_H_
@@ -0,0 +1,300 @@
+/***********************************************************************************************//**
+ * \file xensiv_bgt60trxx_range.c
+ *
+ * This file contains the implementation of the FFT and window functions shared by the range and
+ * Doppler processing of the XENSIV(TM) BGT60TRxx 60GHz FMCW radar sensors.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2022 Infineon Technologies AG
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#include <math.h>
+#include <stddef.h>
+
+#include "xensiv_bgt60trxx_fft.h"
+#include "xensiv_bgt60trxx_platform.h"
+
+#if !defined(XENSIV_BGT60TRXX_FFT_PORTABLE)
+#if defined(__AVX__)
+#define XENSIV_BGT60TRXX_FFT_AVX
+#define XENSIV_BGT60TRXX_FFT_SSE2
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#define XENSIV_BGT60TRXX_FFT_SSE2
+#include <emmintrin.h>
+#elif (defined(__ARM_NEON) || defined(__ARM_NEON__)) && defined(XENSIV_BGT60TRXX_ENABLE_NEON)
+#define XENSIV_BGT60TRXX_FFT_NEON
+#include <arm_neon.h>
+#endif
+#endif // !defined(XENSIV_BGT60TRXX_FFT_PORTABLE)
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define XENSIV_BGT60TRXX_FFT_PI                     (3.14159265358979323846)
+
+#define XENSIV_BGT60TRXX_FFT_Q15_ONE                (32767)
+#define XENSIV_BGT60TRXX_FFT_Q15_ROUND              (0x4000)
+#define XENSIV_BGT60TRXX_FFT_Q15_SHIFT              (15)
+
+
+/*******************************************************************************
+ * Function Prototypes
+ ********************************************************************************/
+static inline void butterflies_f32(float* a, float* b, const float* w, uint32_t n);
+
+static inline int32_t mul_q15(int32_t a, int32_t b);
+
+/*******************************************************************************
+ * Public interface implementation
+ ********************************************************************************/
+double xensiv_bgt60trxx_window_value(xensiv_bgt60trxx_window_t window, uint32_t n,
+                                     uint32_t length)
+{
+    xensiv_bgt60trxx_platform_assert(n < length);
+
+    double x = (length > 1U) ?
+               ((2.0 * XENSIV_BGT60TRXX_FFT_PI * (double)n) / (double)(length - 1U)) :
+               0.0;
+    double w;
+
+    switch (window)
+    {
+        case XENSIV_BGT60TRXX_WINDOW_HANN:
+            w = 0.5 - (0.5 * cos(x));
+            break;
+
+        case XENSIV_BGT60TRXX_WINDOW_HAMMING:
+            w = 0.54 - (0.46 * cos(x));
+            break;
+
+        case XENSIV_BGT60TRXX_WINDOW_BLACKMAN_HARRIS:
+            w = 0.35875 - (0.48829 * cos(x)) + (0.14128 * cos(2.0 * x)) - (0.01168 * cos(3.0 * x));
+            break;
+
+        default:
+            w = 1.0;
+            break;
+    }
+
+    return (length > 1U) ? w : 1.0;
+}
+
+
+void xensiv_bgt60trxx_fft_twiddles_f32(float* table, uint32_t count, uint32_t len)
+{
+    xensiv_bgt60trxx_platform_assert(table != NULL);
+
+    for (uint32_t j = 0U; j < count; ++j)
+    {
+        double phi = (-2.0 * XENSIV_BGT60TRXX_FFT_PI * (double)j) / (double)len;
+
+        table[2U * j] = (float)cos(phi);
+        table[(2U * j) + 1U] = (float)sin(phi);
+    }
+}
+
+
+void xensiv_bgt60trxx_fft_twiddles_q15(int16_t* table, uint32_t count, uint32_t len)
+{
+    xensiv_bgt60trxx_platform_assert(table != NULL);
+
+    for (uint32_t j = 0U; j < count; ++j)
+    {
+        double phi = (-2.0 * XENSIV_BGT60TRXX_FFT_PI * (double)j) / (double)len;
+
+        table[2U * j] = (int16_t)lround(cos(phi) * XENSIV_BGT60TRXX_FFT_Q15_ONE);
+        table[(2U * j) + 1U] = (int16_t)lround(sin(phi) * XENSIV_BGT60TRXX_FFT_Q15_ONE);
+    }
+}
+
+
+void xensiv_bgt60trxx_fft_init_f32(float* twiddle, uint32_t m)
+{
+    xensiv_bgt60trxx_platform_assert((m >= 2U) && ((m & (m - 1U)) == 0U));
+
+    /* twiddles of each stage of length L = 4 .. m, the first stage does not need any */
+    for (uint32_t len = 4U; len <= m; len *= 2U)
+    {
+        xensiv_bgt60trxx_fft_twiddles_f32(twiddle, len / 2U, len);
+        twiddle += len;
+    }
+}
+
+
+void xensiv_bgt60trxx_fft_init_q15(int16_t* twiddle, uint32_t m)
+{
+    xensiv_bgt60trxx_platform_assert((m >= 2U) && ((m & (m - 1U)) == 0U));
+
+    for (uint32_t len = 4U; len <= m; len *= 2U)
+    {
+        xensiv_bgt60trxx_fft_twiddles_q15(twiddle, len / 2U, len);
+        twiddle += len;
+    }
+}
+
+
+void xensiv_bgt60trxx_fft_f32(float* data, const float* twiddle, uint32_t m)
+{
+    /* first stage, twiddle factor 1 */
+    for (uint32_t i = 0U; i < (2U * m); i += 4U)
+    {
+        float ar = data[i];
+        float ai = data[i + 1U];
+        float br = data[i + 2U];
+        float bi = data[i + 3U];
+
+        data[i] = ar + br;
+        data[i + 1U] = ai + bi;
+        data[i + 2U] = ar - br;
+        data[i + 3U] = ai - bi;
+    }
+
+    for (uint32_t half = 2U; half < m; half *= 2U)
+    {
+        for (uint32_t start = 0U; start < m; start += 2U * half)
+        {
+            butterflies_f32(&data[2U * start], &data[2U * (start + half)], twiddle, half);
+        }
+        twiddle += 2U * half;
+    }
+}
+
+
+void xensiv_bgt60trxx_fft_q15(int16_t* data, const int16_t* twiddle, uint32_t m)
+{
+    for (uint32_t i = 0U; i < (2U * m); i += 4U)
+    {
+        int32_t ar = data[i];
+        int32_t ai = data[i + 1U];
+        int32_t br = data[i + 2U];
+        int32_t bi = data[i + 3U];
+
+        data[i] = (int16_t)((ar + br) >> 1);
+        data[i + 1U] = (int16_t)((ai + bi) >> 1);
+        data[i + 2U] = (int16_t)((ar - br) >> 1);
+        data[i + 3U] = (int16_t)((ai - bi) >> 1);
+    }
+
+    for (uint32_t half = 2U; half < m; half *= 2U)
+    {
+        for (uint32_t start = 0U; start < m; start += 2U * half)
+        {
+            int16_t* a = &data[2U * start];
+            int16_t* b = &data[2U * (start + half)];
+
+            for (uint32_t j = 0U; j < half; ++j)
+            {
+                int32_t br = b[2U * j];
+                int32_t bi = b[(2U * j) + 1U];
+                int32_t wr = twiddle[2U * j];
+                int32_t wi = twiddle[(2U * j) + 1U];
+                int32_t tr = mul_q15(br, wr) - mul_q15(bi, wi);
+                int32_t ti = mul_q15(bi, wr) + mul_q15(br, wi);
+                int32_t ar = a[2U * j];
+                int32_t ai = a[(2U * j) + 1U];
+
+                a[2U * j] = (int16_t)((ar + tr) >> 1);
+                a[(2U * j) + 1U] = (int16_t)((ai + ti) >> 1);
+                b[2U * j] = (int16_t)((ar - tr) >> 1);
+                b[(2U * j) + 1U] = (int16_t)((ai - ti) >> 1);
+            }
+        }
+        twiddle += 2U * half;
+    }
+}
+
+
+/*******************************************************************************
+ * Static functions implementation
+ ********************************************************************************/
+/* Radix-2 butterflies a' = a + w * b, b' = a - w * b over n consecutive complex values */
+static inline void butterflies_f32(float* a, float* b, const float* w, uint32_t n)
+{
+    uint32_t j = 0U;
+
+#if defined(XENSIV_BGT60TRXX_FFT_AVX)
+    for (; (j + 4U) <= n; j += 4U)
+    {
+        __m256 va = _mm256_loadu_ps(&a[2U * j]);
+        __m256 vb = _mm256_loadu_ps(&b[2U * j]);
+        __m256 vw = _mm256_loadu_ps(&w[2U * j]);
+        __m256 t = _mm256_addsub_ps(_mm256_mul_ps(vb, _mm256_moveldup_ps(vw)),
+                                    _mm256_mul_ps(_mm256_permute_ps(vb, 0xB1),
+                                                  _mm256_movehdup_ps(vw)));
+        _mm256_storeu_ps(&a[2U * j], _mm256_add_ps(va, t));
+        _mm256_storeu_ps(&b[2U * j], _mm256_sub_ps(va, t));
+    }
+#endif // defined(XENSIV_BGT60TRXX_FFT_AVX)
+
+#if defined(XENSIV_BGT60TRXX_FFT_SSE2)
+    const __m128 neg_re = _mm_setr_ps(-0.0f, 0.0f, -0.0f, 0.0f);
+
+    for (; (j + 2U) <= n; j += 2U)
+    {
+        __m128 va = _mm_loadu_ps(&a[2U * j]);
+        __m128 vb = _mm_loadu_ps(&b[2U * j]);
+        __m128 vw = _mm_loadu_ps(&w[2U * j]);
+        __m128 wr = _mm_shuffle_ps(vw, vw, _MM_SHUFFLE(2, 2, 0, 0));
+        __m128 wi = _mm_shuffle_ps(vw, vw, _MM_SHUFFLE(3, 3, 1, 1));
+        __m128 bs = _mm_shuffle_ps(vb, vb, _MM_SHUFFLE(2, 3, 0, 1));
+        __m128 t = _mm_add_ps(_mm_mul_ps(vb, wr), _mm_xor_ps(_mm_mul_ps(bs, wi), neg_re));
+        _mm_storeu_ps(&a[2U * j], _mm_add_ps(va, t));
+        _mm_storeu_ps(&b[2U * j], _mm_sub_ps(va, t));
+    }
+#endif // defined(XENSIV_BGT60TRXX_FFT_SSE2)
+
+#if defined(XENSIV_BGT60TRXX_FFT_NEON)
+    for (; (j + 4U) <= n; j += 4U)
+    {
+        float32x4x2_t va = vld2q_f32(&a[2U * j]);
+        float32x4x2_t vb = vld2q_f32(&b[2U * j]);
+        float32x4x2_t vw = vld2q_f32(&w[2U * j]);
+        float32x4_t tr = vmlsq_f32(vmulq_f32(vb.val[0], vw.val[0]), vb.val[1], vw.val[1]);
+        float32x4_t ti = vmlaq_f32(vmulq_f32(vb.val[1], vw.val[0]), vb.val[0], vw.val[1]);
+        float32x4x2_t ra = { { vaddq_f32(va.val[0], tr), vaddq_f32(va.val[1], ti) } };
+        float32x4x2_t rb = { { vsubq_f32(va.val[0], tr), vsubq_f32(va.val[1], ti) } };
+        vst2q_f32(&a[2U * j], ra);
+        vst2q_f32(&b[2U * j], rb);
+    }
+#endif // defined(XENSIV_BGT60TRXX_FFT_NEON)
+
+    for (; j < n; ++j)
+    {
+        float br = b[2U * j];
+        float bi = b[(2U * j) + 1U];
+        float wr = w[2U * j];
+        float wi = w[(2U * j) + 1U];
+        float tr = (br * wr) - (bi * wi);
+        float ti = (bi * wr) + (br * wi);
+        float ar = a[2U * j];
+        float ai = a[(2U * j) + 1U];
+
+        a[2U * j] = ar + tr;
+        a[(2U * j) + 1U] = ai + ti;
+        b[2U * j] = ar - tr;
+        b[(2U * j) + 1U] = ai - ti;
+    }
+}
+
+
+
+/* Q15 product of a value and a twiddle factor component, rounded */
+static inline int32_t mul_q15(int32_t a, int32_t b)
+{
+    return ((a * b) + XENSIV_BGT60TRXX_FFT_Q15_ROUND) >> XENSIV_BGT60TRXX_FFT_Q15_SHIFT;
+}
@@ -0,0 +1,159 @@
+/***********************************************************************************************//**
+ * \file xensiv_bgt60trxx_fft.h
+ *
+ * \brief
+ * This file contains the declarations of the FFT and window functions shared by the range and
+ * Doppler processing of the XENSIV(TM) BGT60TRxx 60GHz FMCW radar sensors.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2022 Infineon Technologies AG
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#ifndef XENSIV_BGT60TRXX_FFT_H_
+#define XENSIV_BGT60TRXX_FFT_H_
+
+#include <stdint.h>
+
+/**
+ * \addtogroup group_board_libs_fft XENSIV(TM) BGT60TRxx FFT
+ * \{
+ * In place radix-2 complex FFT on interleaved real and imaginary parts, used by the range
+ * (\ref group_board_libs_range) and Doppler (\ref group_board_libs_doppler) processing.
+ * The input is expected in bit reversed order, see \ref xensiv_bgt60trxx_fft_bitrev_next, so
+ * that reordering can be merged with copying the data into the FFT buffer.
+ *
+ * The float butterflies use AVX (__AVX__) or SSE2 (__SSE2__) if the compiler targets these
+ * instruction sets, or NEON (__ARM_NEON) if XENSIV_BGT60TRXX_ENABLE_NEON is defined as well,
+ * portable C otherwise. Define XENSIV_BGT60TRXX_FFT_PORTABLE to force the portable
+ * implementation. The fixed point FFT scales each stage by 1/2 to avoid overflows.
+ */
+
+/************************************** Macros *******************************************/
+
+/** Number of elements of the twiddle table of an m point FFT, m >= 2 */
+#define XENSIV_BGT60TRXX_FFT_TWIDDLE_LEN(m)             ((2U * (m)) - 4U)
+
+/******************************** Type definitions ****************************************/
+
+/** Window applied before an FFT */
+typedef enum
+{
+    XENSIV_BGT60TRXX_WINDOW_RECTANGULAR = 0,  /**< No window */
+    XENSIV_BGT60TRXX_WINDOW_HANN = 1,         /**< Hann window */
+    XENSIV_BGT60TRXX_WINDOW_HAMMING = 2,      /**< Hamming window */
+    XENSIV_BGT60TRXX_WINDOW_BLACKMAN_HARRIS = 3 /**< 4-term Blackman-Harris window */
+} xensiv_bgt60trxx_window_t;
+
+/******************************* Function prototypes *************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Increments a bit reversed index.
+ *
+ * @param[in] r Index with its log2(\p m) bits reversed.
+ * @param[in] m FFT size, a power of two.
+ * @return Bit reversed index following \p r.
+ */
+static inline uint32_t xensiv_bgt60trxx_fft_bitrev_next(uint32_t r, uint32_t m)
+{
+    uint32_t bit = m >> 1U;
+
+    while ((r & bit) != 0U)
+    {
+        r ^= bit;
+        bit >>= 1U;
+    }
+
+    return r | bit;
+}
+
+
+/**
+ * @brief Obtains a coefficient of a symmetric window.
+ *
+ * @param[in] window Window type.
+ * @param[in] n Index of the coefficient, less than \p length.
+ * @param[in] length Window length.
+ * @return Window coefficient, 1.0 at most.
+ */
+double xensiv_bgt60trxx_window_value(xensiv_bgt60trxx_window_t window, uint32_t n,
+                                     uint32_t length);
+
+/**
+ * @brief Computes twiddle factors W_len^j = exp(-2 * pi * i * j / len), j < count.
+ *
+ * @param[out] table Pointer to 2 * \p count elements, real and imaginary parts interleaved.
+ * @param[in] count Number of twiddle factors.
+ * @param[in] len Period.
+ */
+void xensiv_bgt60trxx_fft_twiddles_f32(float* table, uint32_t count, uint32_t len);
+
+/**
+ * @brief Computes twiddle factors in Q15, see \ref xensiv_bgt60trxx_fft_twiddles_f32.
+ *
+ * @param[out] table Pointer to 2 * \p count elements, real and imaginary parts interleaved.
+ * @param[in] count Number of twiddle factors.
+ * @param[in] len Period.
+ */
+void xensiv_bgt60trxx_fft_twiddles_q15(int16_t* table, uint32_t count, uint32_t len);
+
+/**
+ * @brief Computes the twiddle table of an m point FFT.
+ *
+ * @param[out] twiddle Pointer to \ref XENSIV_BGT60TRXX_FFT_TWIDDLE_LEN (\p m) elements.
+ * @param[in] m FFT size, a power of two, at least 2.
+ */
+void xensiv_bgt60trxx_fft_init_f32(float* twiddle, uint32_t m);
+
+/**
+ * @brief Computes the Q15 twiddle table of an m point FFT.
+ *
+ * @param[out] twiddle Pointer to \ref XENSIV_BGT60TRXX_FFT_TWIDDLE_LEN (\p m) elements.
+ * @param[in] m FFT size, a power of two, at least 2.
+ */
+void xensiv_bgt60trxx_fft_init_q15(int16_t* twiddle, uint32_t m);
+
+/**
+ * @brief Computes an m point complex FFT in place.
+ *
+ * @param[inout] data Pointer to 2 * \p m elements in bit reversed order, real and imaginary
+ * parts interleaved. Receives the spectrum in natural order.
+ * @param[in] twiddle Pointer to the table computed by \ref xensiv_bgt60trxx_fft_init_f32.
+ * @param[in] m FFT size.
+ */
+void xensiv_bgt60trxx_fft_f32(float* data, const float* twiddle, uint32_t m);
+
+/**
+ * @brief Computes an m point complex FFT in place in fixed point, scaled by 1 / m.
+ *
+ * @param[inout] data Pointer to 2 * \p m elements in bit reversed order, real and imaginary
+ * parts interleaved. Receives the spectrum in natural order.
+ * @param[in] twiddle Pointer to the table computed by \ref xensiv_bgt60trxx_fft_init_q15.
+ * @param[in] m FFT size.
+ */
+void xensiv_bgt60trxx_fft_q15(int16_t* data, const int16_t* twiddle, uint32_t m);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** \} group_board_libs_fft */
+
+#endif // ifndef XENSIV_BGT60TRXX_FFT_H_
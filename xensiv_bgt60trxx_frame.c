@@ -0,0 +1,297 @@
+/***********************************************************************************************//**
+ * \file xensiv_bgt60trxx_frame.c
+ *
+ * \brief
+ * This file contains the implementation of the frame assembler
+ * for the XENSIV(TM) BGT60TRxx 60GHz FMCW radar sensors.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2022 Infineon Technologies AG
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#include <stddef.h>
+#include <string.h>
+
+#include "xensiv_bgt60trxx_frame.h"
+#include "xensiv_bgt60trxx_platform.h"
+
+/*******************************************************************************
+ * Function Prototypes
+ ********************************************************************************/
+static void frame_info_update(xensiv_bgt60trxx_frame_assembler_t* fa, uint32_t num_frames,
+                              uint32_t timestamp);
+
+/*******************************************************************************
+ * Public interface implementation
+ ********************************************************************************/
+int32_t xensiv_bgt60trxx_frame_assembler_init(xensiv_bgt60trxx_frame_assembler_t* fa,
+                                              const xensiv_bgt60trxx_t* dev,
+                                              const xensiv_bgt60trxx_frame_geometry_t* geometry,
+                                              uint32_t chunk_size,
+                                              uint16_t* ring,
+                                              uint32_t ring_size)
+{
+    xensiv_bgt60trxx_platform_assert(fa != NULL);
+    xensiv_bgt60trxx_platform_assert(dev != NULL);
+    xensiv_bgt60trxx_platform_assert(geometry != NULL);
+    xensiv_bgt60trxx_platform_assert(ring != NULL);
+
+    uint32_t frame_size = geometry->num_samples_per_chirp *
+                          geometry->num_chirps_per_frame *
+                          geometry->num_rx_antennas;
+
+    xensiv_bgt60trxx_platform_assert(frame_size > 0U);
+    xensiv_bgt60trxx_platform_assert((frame_size % XENSIV_BGT60TRXX_NUM_SAMPLES_FIFO_WORD) == 0U);
+    xensiv_bgt60trxx_platform_assert(chunk_size > 0U);
+    xensiv_bgt60trxx_platform_assert((ring_size % frame_size) == 0U);
+    xensiv_bgt60trxx_platform_assert(ring_size >= (frame_size + chunk_size));
+
+    fa->dev = dev;
+    fa->ring = ring;
+    fa->ring_size = ring_size;
+    fa->frame_size = frame_size;
+    fa->chunk_size = chunk_size;
+    fa->wr_idx = 0U;
+    fa->frame_pos = 0U;
+    fa->frames_done = 0U;
+    fa->rd_idx = 0U;
+    fa->frames_released = 0U;
+    fa->info = NULL;
+    fa->num_recoveries = 0U;
+    fa->recover = false;
+
+    return xensiv_bgt60trxx_set_fifo_limit(dev, chunk_size);
+}
+
+
+int32_t xensiv_bgt60trxx_frame_assembler_enable_info(xensiv_bgt60trxx_frame_assembler_t* fa,
+                                                     xensiv_bgt60trxx_frame_info_t* info,
+                                                     uint32_t num_info)
+{
+    xensiv_bgt60trxx_platform_assert(fa != NULL);
+    xensiv_bgt60trxx_platform_assert(info != NULL);
+    xensiv_bgt60trxx_platform_assert(num_info == (fa->ring_size / fa->frame_size));
+
+    uint32_t frame_cnt;
+    int32_t status = xensiv_bgt60trxx_get_frame_count(fa->dev, &frame_cnt);
+
+    if (XENSIV_BGT60TRXX_STATUS_OK == status)
+    {
+        (void)memset(info, 0, num_info * sizeof(*info));
+        fa->sequence = frame_cnt;
+        fa->num_dropped = 0U;
+        fa->num_stalled = 0U;
+        fa->num_recoveries = 0U;
+        fa->info = info;
+    }
+
+    return status;
+}
+
+
+void xensiv_bgt60trxx_frame_assembler_enable_recovery(xensiv_bgt60trxx_frame_assembler_t* fa,
+                                                      bool enable)
+{
+    xensiv_bgt60trxx_platform_assert(fa != NULL);
+
+    fa->recover = enable;
+}
+
+
+int32_t xensiv_bgt60trxx_frame_assembler_read(xensiv_bgt60trxx_frame_assembler_t* fa)
+{
+    xensiv_bgt60trxx_platform_assert(fa != NULL);
+
+#if defined(XENSIV_BGT60TRXX_PLATFORM_GET_TIME)
+    uint32_t timestamp = xensiv_bgt60trxx_platform_get_time_us();
+#else
+    uint32_t timestamp = 0U;
+#endif
+
+    /* the frames released were no longer accessed by the consuming context */
+    uint32_t frames_released = fa->frames_released;
+    xensiv_bgt60trxx_platform_memory_barrier();
+
+    /* samples held by complete frames not yet released and by the partial frame */
+    uint32_t used = ((fa->frames_done - frames_released) * fa->frame_size) + fa->frame_pos;
+    if ((fa->ring_size - used) < fa->chunk_size)
+    {
+        ++fa->num_stalled;
+        return XENSIV_BGT60TRXX_STATUS_BUFFER_FULL;
+    }
+
+    int32_t retval = XENSIV_BGT60TRXX_STATUS_OK;
+    uint32_t remaining = fa->chunk_size;
+    uint32_t num_frames = 0U;
+
+    while ((remaining > 0U) && (XENSIV_BGT60TRXX_STATUS_OK == retval))
+    {
+        /* a chunk crossing the end of the ring buffer is read in two bursts */
+        uint32_t len = fa->ring_size - fa->wr_idx;
+        if (len > remaining)
+        {
+            len = remaining;
+        }
+
+        retval = xensiv_bgt60trxx_get_fifo_data(fa->dev, &fa->ring[fa->wr_idx], len);
+
+        if (XENSIV_BGT60TRXX_STATUS_OK == retval)
+        {
+            fa->wr_idx += len;
+            if (fa->wr_idx == fa->ring_size)
+            {
+                fa->wr_idx = 0U;
+            }
+
+            remaining -= len;
+            fa->frame_pos += len;
+            while (fa->frame_pos >= fa->frame_size)
+            {
+                fa->frame_pos -= fa->frame_size;
+                ++num_frames;
+            }
+        }
+    }
+
+    /* the metadata is complete before the frames are published to the consuming context;
+     * the frames completed before a FIFO error precede the frames it lost */
+    if ((num_frames > 0U) && (fa->info != NULL))
+    {
+        frame_info_update(fa, num_frames, timestamp);
+    }
+
+    /* the data read since the FIFO error is invalid, restart with the next frame */
+    if ((XENSIV_BGT60TRXX_STATUS_GSR0_ERROR == retval) && fa->recover)
+    {
+        retval = xensiv_bgt60trxx_recover_fifo(fa->dev);
+        if (XENSIV_BGT60TRXX_STATUS_OK == retval)
+        {
+            retval = xensiv_bgt60trxx_frame_assembler_reset(fa);
+        }
+        ++fa->num_recoveries;
+    }
+
+    /* the samples and the metadata are written before the frames are published */
+    xensiv_bgt60trxx_platform_memory_barrier();
+    fa->frames_done += num_frames;
+
+    return retval;
+}
+
+
+const uint16_t* xensiv_bgt60trxx_frame_assembler_get(xensiv_bgt60trxx_frame_assembler_t* fa)
+{
+    xensiv_bgt60trxx_platform_assert(fa != NULL);
+
+    bool available = (fa->frames_done != fa->frames_released);
+
+    /* the frame is read after it was published */
+    xensiv_bgt60trxx_platform_memory_barrier();
+
+    return available ? &fa->ring[fa->rd_idx] : NULL;
+}
+
+
+const xensiv_bgt60trxx_frame_info_t* xensiv_bgt60trxx_frame_assembler_get_info(
+    const xensiv_bgt60trxx_frame_assembler_t* fa)
+{
+    xensiv_bgt60trxx_platform_assert(fa != NULL);
+
+    bool available = (fa->frames_done != fa->frames_released);
+
+    /* the metadata is read after it was published */
+    xensiv_bgt60trxx_platform_memory_barrier();
+
+    return ((fa->info != NULL) && available) ? &fa->info[fa->rd_idx / fa->frame_size] : NULL;
+}
+
+
+void xensiv_bgt60trxx_frame_assembler_release(xensiv_bgt60trxx_frame_assembler_t* fa)
+{
+    xensiv_bgt60trxx_platform_assert(fa != NULL);
+    xensiv_bgt60trxx_platform_assert(fa->frames_done != fa->frames_released);
+
+    fa->rd_idx += fa->frame_size;
+    if (fa->rd_idx == fa->ring_size)
+    {
+        fa->rd_idx = 0U;
+    }
+
+    /* the frame is no longer accessed once its space is handed back to the reading context */
+    xensiv_bgt60trxx_platform_memory_barrier();
+    ++fa->frames_released;
+}
+
+
+int32_t xensiv_bgt60trxx_frame_assembler_reset(xensiv_bgt60trxx_frame_assembler_t* fa)
+{
+    xensiv_bgt60trxx_platform_assert(fa != NULL);
+
+    int32_t status = XENSIV_BGT60TRXX_STATUS_OK;
+
+    /* the partial frame never wraps, it starts at a multiple of the frame size */
+    fa->wr_idx -= fa->frame_pos;
+    fa->frame_pos = 0U;
+
+    /* the FIFO is empty, the frames counted by the sensor and not delivered were lost */
+    if (fa->info != NULL)
+    {
+        uint32_t frame_cnt;
+        status = xensiv_bgt60trxx_get_frame_count(fa->dev, &frame_cnt);
+        if (XENSIV_BGT60TRXX_STATUS_OK == status)
+        {
+            uint32_t lost = (frame_cnt - fa->sequence) & XENSIV_BGT60TRXX_FRAME_CNT_MAX;
+            fa->sequence += lost;
+            fa->num_dropped += lost;
+        }
+    }
+
+    return status;
+}
+
+
+/*******************************************************************************
+ * Static functions implementation
+ ********************************************************************************/
+/* Assigns the metadata of the num_frames frames completed by the last read. Frames are only
+   lost when the FIFO overflows, which is resolved with a FIFO reset and
+   xensiv_bgt60trxx_frame_assembler_reset, so the frames are numbered consecutively here. The
+   FIFO burst returns GSR0 only, which holds no filling level, so frames waiting in the FIFO could
+   not be told from lost frames by the frame counter without another SPI transaction. */
+static void frame_info_update(xensiv_bgt60trxx_frame_assembler_t* fa, uint32_t num_frames,
+                              uint32_t timestamp)
+{
+    uint32_t sequence = fa->sequence + num_frames;
+
+    /* the newest frame ends where the partial frame starts */
+    uint32_t num_info = fa->ring_size / fa->frame_size;
+    uint32_t slot = (fa->wr_idx - fa->frame_pos) / fa->frame_size;
+
+    for (uint32_t i = 0U; i < num_frames; ++i)
+    {
+        slot = (slot == 0U) ? (num_info - 1U) : (slot - 1U);
+
+        xensiv_bgt60trxx_frame_info_t* info = &fa->info[slot];
+        info->sequence = sequence - i;
+        info->timestamp_us = timestamp;
+        info->num_dropped = fa->num_dropped;
+        info->num_stalled = fa->num_stalled;
+        info->num_recoveries = fa->num_recoveries;
+    }
+
+    fa->sequence = sequence;
+}
@@ -0,0 +1,234 @@
+/***********************************************************************************************//**
+ * \file xensiv_bgt60trxx_frame.h
+ *
+ * \brief
+ * This file contains the declarations of the frame assembler
+ * for the XENSIV(TM) BGT60TRxx 60GHz FMCW radar sensors.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2022 Infineon Technologies AG
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#ifndef XENSIV_BGT60TRXX_FRAME_H_
+#define XENSIV_BGT60TRXX_FRAME_H_
+
+#include "xensiv_bgt60trxx.h"
+
+/**
+ * \addtogroup group_board_libs_frame XENSIV(TM) BGT60TRxx Frame Assembler
+ * \{
+ * Assembles complete frames from FIFO reads of a fixed chunk size, so that a frame is not
+ * limited by the size of the sensor FIFO and the FIFO interrupt does not need to be aligned to
+ * frame boundaries.
+ *
+ * \ref xensiv_bgt60trxx_frame_assembler_init sets the FIFO compare reference (CREF) to the
+ * chunk size. Each time the FIFO interrupt signals a chunk, call
+ * \ref xensiv_bgt60trxx_frame_assembler_read to append it to a caller-provided ring buffer.
+ * Complete frames are obtained in order with \ref xensiv_bgt60trxx_frame_assembler_get and
+ * returned with \ref xensiv_bgt60trxx_frame_assembler_release. Frames never wrap around the end
+ * of the ring buffer.
+ *
+ * Reading (e.g. from the FIFO interrupt) and getting/releasing frames (e.g. from the main loop)
+ * may run in different contexts, as long as each of them is done by a single context. Frames are
+ * handed over through two counters, ordered against the ring buffer and metadata accesses with
+ * xensiv_bgt60trxx_platform_memory_barrier.
+ *
+ * Optionally, \ref xensiv_bgt60trxx_frame_assembler_enable_info attaches a
+ * \ref xensiv_bgt60trxx_frame_info_t to every frame, obtained with
+ * \ref xensiv_bgt60trxx_frame_assembler_get_info:
+ * - The sequence number is the STAT1 frame counter of the sensor, extended to 32 bits. Frames are
+ *   lost only when the FIFO overflows, so the counter is read when the metadata is enabled and
+ *   by \ref xensiv_bgt60trxx_frame_assembler_reset after the FIFO was reset, when no frame waits
+ *   in the FIFO; the frames in between are numbered consecutively without SPI transactions.
+ *   Reading it along with the FIFO is not possible: the FIFO burst returns GSR0 only, without the
+ *   FIFO filling level needed to tell frames waiting in the FIFO from lost frames.
+ * - The time stamp is taken when \ref xensiv_bgt60trxx_frame_assembler_read is called for the
+ *   chunk completing the frame, i.e. at data-ready if called from the FIFO interrupt. It requires
+ *   XENSIV_BGT60TRXX_PLATFORM_GET_TIME, see xensiv_bgt60trxx_platform_get_time_us, and is zero
+ *   otherwise.
+ * - The number of frames dropped and the number of chunks not read because the ring buffer was
+ *   full, both counted since the metadata was enabled. Frames dropped while the number of stalled
+ *   reads increases mean that the application does not release the frames fast enough. Frames
+ *   dropped without stalled reads mean that the FIFO is not read fast enough, e.g. because of the
+ *   interrupt latency or the SPI clock.
+ *
+ * With \ref xensiv_bgt60trxx_frame_assembler_enable_recovery, a FIFO overflow or underflow
+ * reported by a read is recovered from within \ref xensiv_bgt60trxx_frame_assembler_read using
+ * \ref xensiv_bgt60trxx_recover_fifo: the partial frame is discarded and the frame generation
+ * restarts with an empty FIFO, keeping the configuration. The frames lost are reported by the
+ * metadata.
+ *
+ * The frame counter is cleared by a software reset only: call
+ * \ref xensiv_bgt60trxx_frame_assembler_enable_info again after \ref xensiv_bgt60trxx_config.
+ * It must be read at least every \ref XENSIV_BGT60TRXX_FRAME_CNT_MAX frames, i.e. the FIFO must
+ * not overflow for longer than that.
+ */
+
+/******************************** Type definitions ****************************************/
+
+/** Metadata of an assembled frame */
+typedef struct
+{
+    uint32_t sequence;              /**< Frame counter of the sensor, extended to 32 bits */
+    uint32_t timestamp_us;          /**< Time at data-ready of the chunk completing the frame */
+    uint32_t num_dropped;           /**< Frames lost before this frame */
+    uint32_t num_stalled;           /**< Chunks not read before this frame, ring buffer full */
+    uint32_t num_recoveries;        /**< FIFO errors recovered from before this frame */
+} xensiv_bgt60trxx_frame_info_t;
+
+/**
+ * Structure holding the frame assembler.
+ *
+ * Application code should not rely on the specific content of this struct.
+ * They are considered an implementation detail which is subject to change
+ * between platforms and/or library releases.
+ */
+typedef struct
+{
+    const xensiv_bgt60trxx_t* dev;
+    uint16_t* ring;
+    uint32_t ring_size;                /* in samples, multiple of frame_size */
+    uint32_t frame_size;               /* in samples */
+    uint32_t chunk_size;               /* in samples */
+    uint32_t wr_idx;                   /* owned by the reading context */
+    uint32_t frame_pos;
+    volatile uint32_t frames_done;
+    uint32_t rd_idx;                   /* owned by the consuming context */
+    volatile uint32_t frames_released;
+    xensiv_bgt60trxx_frame_info_t* info; /* one per frame of the ring buffer, NULL if disabled */
+    uint32_t sequence;                 /* sequence number of the last complete frame */
+    uint32_t num_dropped;
+    uint32_t num_stalled;
+    uint32_t num_recoveries;
+    bool recover;                      /* recover from FIFO errors */
+} xensiv_bgt60trxx_frame_assembler_t;
+
+/******************************* Function prototypes *************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Initializes the frame assembler and sets the FIFO compare reference to the chunk size.
+ * @note Call before starting the frame generation.
+ *
+ * @param[out] fa Pointer to the frame assembler object.
+ * @param[in] dev Pointer to the XENSIV(TM) BGT60TRxx sensor device object.
+ * @param[in] geometry Pointer to the frame geometry.
+ * @param[in] chunk_size Number of samples read per FIFO interrupt. Must be even and fit in
+ * the sensor FIFO. Does not need to divide the frame size.
+ * @param[in] ring Pointer to the ring buffer.
+ * @param[in] ring_size Size of the ring buffer in samples. Must be a multiple of the frame size
+ * and hold at least one frame plus one chunk to read while the application owns a frame.
+ * @return XENSIV_BGT60TRXX_STATUS_OK if the FIFO compare reference was set; else an error
+ * indicating what went wrong.
+ */
+int32_t xensiv_bgt60trxx_frame_assembler_init(xensiv_bgt60trxx_frame_assembler_t* fa,
+                                              const xensiv_bgt60trxx_t* dev,
+                                              const xensiv_bgt60trxx_frame_geometry_t* geometry,
+                                              uint32_t chunk_size,
+                                              uint16_t* ring,
+                                              uint32_t ring_size);
+
+/**
+ * @brief Enables the frame metadata and reads the current frame counter of the sensor.
+ * @note Call after \ref xensiv_bgt60trxx_frame_assembler_init and before starting the frame
+ * generation. Frames completed before are not assigned metadata.
+ *
+ * @param[inout] fa Pointer to the frame assembler object.
+ * @param[out] info Pointer to one metadata entry per frame of the ring buffer.
+ * @param[in] num_info Number of entries, ring_size / frame size.
+ * @return XENSIV_BGT60TRXX_STATUS_OK if the frame counter was read; else an error indicating
+ * what went wrong.
+ */
+int32_t xensiv_bgt60trxx_frame_assembler_enable_info(xensiv_bgt60trxx_frame_assembler_t* fa,
+                                                     xensiv_bgt60trxx_frame_info_t* info,
+                                                     uint32_t num_info);
+
+/**
+ * @brief Enables/disables the recovery from FIFO errors.
+ * Disabled by default.
+ *
+ * @param[inout] fa Pointer to the frame assembler object.
+ * @param[in] enable Enable/disable the recovery.
+ */
+void xensiv_bgt60trxx_frame_assembler_enable_recovery(xensiv_bgt60trxx_frame_assembler_t* fa,
+                                                      bool enable);
+
+/**
+ * @brief Reads one chunk from the sensor FIFO and appends it to the ring buffer.
+ * Typically called when the FIFO interrupt signals that the FIFO filling level reached the
+ * chunk size.
+ *
+ * @param[inout] fa Pointer to the frame assembler object.
+ * @return XENSIV_BGT60TRXX_STATUS_OK if the chunk was read;
+ * XENSIV_BGT60TRXX_STATUS_BUFFER_FULL if the ring buffer cannot hold the chunk, nothing is read
+ * from the FIFO; else an error indicating what went wrong, see
+ * \ref xensiv_bgt60trxx_frame_assembler_reset. If the recovery is enabled, a FIFO error is
+ * recovered from and only an error during the recovery is returned.
+ */
+int32_t xensiv_bgt60trxx_frame_assembler_read(xensiv_bgt60trxx_frame_assembler_t* fa);
+
+/**
+ * @brief Obtains the oldest complete frame.
+ * The frame stays valid until it is returned with
+ * \ref xensiv_bgt60trxx_frame_assembler_release.
+ *
+ * @param[inout] fa Pointer to the frame assembler object.
+ * @return Pointer to the frame samples, NULL if no complete frame is available.
+ */
+const uint16_t* xensiv_bgt60trxx_frame_assembler_get(xensiv_bgt60trxx_frame_assembler_t* fa);
+
+/**
+ * @brief Obtains the metadata of the frame returned by \ref xensiv_bgt60trxx_frame_assembler_get.
+ *
+ * @param[in] fa Pointer to the frame assembler object.
+ * @return Pointer to the frame metadata, valid until the frame is released. NULL if no complete
+ * frame is available or the metadata is not enabled.
+ */
+const xensiv_bgt60trxx_frame_info_t* xensiv_bgt60trxx_frame_assembler_get_info(
+    const xensiv_bgt60trxx_frame_assembler_t* fa);
+
+/**
+ * @brief Returns the frame obtained with \ref xensiv_bgt60trxx_frame_assembler_get.
+ *
+ * @param[inout] fa Pointer to the frame assembler object.
+ */
+void xensiv_bgt60trxx_frame_assembler_release(xensiv_bgt60trxx_frame_assembler_t* fa);
+
+/**
+ * @brief Discards the partially received frame.
+ * Call from the reading context after the FIFO was reset, e.g. after a read error caused by a
+ * FIFO overflow, so that the next chunk starts a new frame. Complete frames are kept.
+ * If the metadata is enabled, the frame counter is read and the frames the sensor completed but
+ * that were not delivered are counted as dropped. Call it before the frame generation is
+ * restarted, or right after: the first frame takes longer than one register read.
+ *
+ * @param[inout] fa Pointer to the frame assembler object.
+ * @return XENSIV_BGT60TRXX_STATUS_OK if the partial frame was discarded and the frame counter
+ * was read; else an error indicating what went wrong.
+ */
+int32_t xensiv_bgt60trxx_frame_assembler_reset(xensiv_bgt60trxx_frame_assembler_t* fa);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** \} group_board_libs_frame */
+
+#endif // ifndef XENSIV_BGT60TRXX_FRAME_H_
@@ -0,0 +1,494 @@
+/***********************************************************************************************//**
+ * \file xensiv_bgt60trxx_linux.c
+ *
+ * \brief
+ * This file contains the Linux platform functions implementation
+ * for interacting with the XENSIV(TM) BGT60TRxx 60GHz FMCW radar sensors.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2022 Infineon Technologies AG
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#if defined(__linux__)
+
+#if !defined(XENSIV_BGT60TRXX_PLATFORM_SPI_BURST_READ) && !defined(XENSIV_BGT60TRXX_FIFO_READ_RAW)
+#error "Define XENSIV_BGT60TRXX_PLATFORM_SPI_BURST_READ or XENSIV_BGT60TRXX_FIFO_READ_RAW"
+#endif
+
+#if !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/gpio.h>
+#include <linux/spi/spidev.h>
+
+#include "xensiv_bgt60trxx_linux.h"
+#include "xensiv_bgt60trxx_platform.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define XENSIV_BGT60TRXX_LINUX_SPIDEV_BUFSIZ_PATH   "/sys/module/spidev/parameters/bufsiz"
+#define XENSIV_BGT60TRXX_LINUX_SPIDEV_BUFSIZ_DEF    (4096U)
+#define XENSIV_BGT60TRXX_LINUX_MAX_XFERS            (32U)
+#define XENSIV_BGT60TRXX_LINUX_CONSUMER             "xensiv_bgt60trxx"
+
+
+/*******************************************************************************
+ * Function Prototypes
+ ********************************************************************************/
+static uint32_t get_spidev_bufsiz(void);
+
+static int32_t rst_init(xensiv_bgt60trxx_linux_iface_t* iface,
+                        const char* gpiochip,
+                        uint32_t rst_line);
+
+static void set_xfer(struct spi_ioc_transfer* xfer,
+                     const void* tx_data,
+                     void* rx_data,
+                     uint32_t len,
+                     uint32_t speed_hz,
+                     uint8_t bits_per_word);
+
+/*******************************************************************************
+ * Public interface implementation
+ ********************************************************************************/
+int32_t xensiv_bgt60trxx_linux_init(xensiv_bgt60trxx_linux_t* obj,
+                                    const char* spidev,
+                                    const char* gpiochip,
+                                    uint32_t rst_line,
+                                    uint32_t speed_hz,
+                                    const uint32_t* regs,
+                                    size_t len)
+{
+    assert(obj != NULL);
+    assert(spidev != NULL);
+    assert(regs != NULL);
+
+    xensiv_bgt60trxx_linux_iface_t* iface = &obj->iface;
+
+    iface->rst_fd = -1;
+    iface->speed_hz = speed_hz;
+    #if defined(XENSIV_BGT60TRXX_PLATFORM_LOCK)
+    (void)pthread_mutex_init(&iface->lock, NULL);
+    #endif
+    iface->msg_max_bytes = get_spidev_bufsiz();
+    (void)memset(iface->fifo_tx, 0xFF, sizeof(iface->fifo_tx));
+
+    int32_t status = XENSIV_BGT60TRXX_STATUS_OK;
+
+    iface->spi_fd = open(spidev, O_RDWR);
+    if (iface->spi_fd < 0)
+    {
+        status = XENSIV_BGT60TRXX_STATUS_COM_ERROR;
+    }
+
+    if (XENSIV_BGT60TRXX_STATUS_OK == status)
+    {
+        uint8_t mode = SPI_MODE_0;
+        uint8_t bits = 8U;
+        if ((ioctl(iface->spi_fd, SPI_IOC_WR_MODE, &mode) < 0) ||
+            (ioctl(iface->spi_fd, SPI_IOC_WR_BITS_PER_WORD, &bits) < 0) ||
+            (ioctl(iface->spi_fd, SPI_IOC_WR_MAX_SPEED_HZ, &speed_hz) < 0))
+        {
+            status = XENSIV_BGT60TRXX_STATUS_COM_ERROR;
+        }
+    }
+
+    if ((XENSIV_BGT60TRXX_STATUS_OK == status) && (gpiochip != NULL))
+    {
+        status = rst_init(iface, gpiochip, rst_line);
+    }
+
+    xensiv_bgt60trxx_t* dev = &obj->dev;
+
+    if ((XENSIV_BGT60TRXX_STATUS_OK == status) && (iface->rst_fd >= 0))
+    {
+        /* perform device hard reset before beginning init via SPI */
+        dev->iface = iface;
+        dev->shadow = NULL;
+        xensiv_bgt60trxx_hard_reset(dev);
+    }
+
+    if (XENSIV_BGT60TRXX_STATUS_OK == status)
+    {
+        status = xensiv_bgt60trxx_init(dev, iface, false);
+    }
+
+    if (XENSIV_BGT60TRXX_STATUS_OK == status)
+    {
+        status = xensiv_bgt60trxx_config(dev, regs, (uint32_t)len);
+    }
+
+    return status;
+}
+
+
+void xensiv_bgt60trxx_linux_free(xensiv_bgt60trxx_linux_t* obj)
+{
+    assert(obj != NULL);
+
+    xensiv_bgt60trxx_linux_iface_t* iface = &obj->iface;
+
+    if (iface->spi_fd >= 0)
+    {
+        (void)close(iface->spi_fd);
+        iface->spi_fd = -1;
+    }
+
+    if (iface->rst_fd >= 0)
+    {
+        (void)close(iface->rst_fd);
+        iface->rst_fd = -1;
+    }
+
+    #if defined(XENSIV_BGT60TRXX_PLATFORM_LOCK)
+    (void)pthread_mutex_destroy(&iface->lock);
+    #endif
+}
+
+
+/*******************************************************************************
+ * Platform functions implementation
+ ********************************************************************************/
+int32_t xensiv_bgt60trxx_platform_spi_transfer(void* iface,
+                                               uint8_t* tx_data,
+                                               uint8_t* rx_data,
+                                               uint32_t len)
+{
+    assert(iface != NULL);
+    assert((tx_data != NULL) || (rx_data != NULL));
+
+    const xensiv_bgt60trxx_linux_iface_t* linux_iface = iface;
+    int32_t status = XENSIV_BGT60TRXX_STATUS_OK;
+
+    /* Transfers larger than a message (e.g. raw FIFO reads) are split keeping CS asserted */
+    while ((len > 0U) && (XENSIV_BGT60TRXX_STATUS_OK == status))
+    {
+        uint32_t chunk = (len > linux_iface->msg_max_bytes) ? linux_iface->msg_max_bytes : len;
+
+        struct spi_ioc_transfer xfer;
+        set_xfer(&xfer, tx_data, rx_data, chunk, linux_iface->speed_hz, 8U);
+        xfer.cs_change = (chunk < len) ? 1U : 0U;
+
+        if (ioctl(linux_iface->spi_fd, SPI_IOC_MESSAGE(1), &xfer) < 0)
+        {
+            status = XENSIV_BGT60TRXX_STATUS_COM_ERROR;
+        }
+
+        tx_data = (tx_data != NULL) ? &tx_data[chunk] : NULL;
+        rx_data = (rx_data != NULL) ? &rx_data[chunk] : NULL;
+        len -= chunk;
+    }
+
+    return status;
+}
+
+
+int32_t xensiv_bgt60trxx_platform_spi_fifo_read(void* iface,
+                                                uint16_t* rx_data,
+                                                uint32_t len)
+{
+    (void)iface;
+    (void)rx_data;
+    (void)len;
+
+    /* The driver reads the FIFO with xensiv_bgt60trxx_platform_spi_burst_read or, with
+     * XENSIV_BGT60TRXX_FIFO_READ_RAW, with xensiv_bgt60trxx_platform_spi_transfer. A payload
+     * read without the burst command in the same message would return garbage. */
+    xensiv_bgt60trxx_platform_assert(false);
+
+    return XENSIV_BGT60TRXX_STATUS_COM_ERROR;
+}
+
+
+int32_t xensiv_bgt60trxx_platform_spi_burst_read(void* iface,
+                                                 uint8_t* tx_header,
+                                                 uint8_t* rx_header,
+                                                 uint16_t* rx_data,
+                                                 uint32_t len)
+{
+    assert(iface != NULL);
+    assert(rx_data != NULL);
+
+    const xensiv_bgt60trxx_linux_iface_t* linux_iface = iface;
+
+    struct spi_ioc_transfer xfers[XENSIV_BGT60TRXX_LINUX_MAX_XFERS];
+    uint32_t num_xfers = 0U;
+    uint32_t msg_bytes = 0U;
+    int32_t status = XENSIV_BGT60TRXX_STATUS_OK;
+
+    if (tx_header != NULL)
+    {
+        set_xfer(&xfers[0], tx_header, rx_header,
+                 XENSIV_BGT60TRXX_SPI_BURST_HEADER_SIZE_BYTES, linux_iface->speed_hz, 8U);
+        num_xfers = 1U;
+        msg_bytes = XENSIV_BGT60TRXX_SPI_BURST_HEADER_SIZE_BYTES;
+    }
+
+    /* 12-bit words are transferred in 16-bit containers */
+    uint8_t* rx_ptr = (uint8_t*)rx_data;
+    uint32_t remaining = len * sizeof(uint16_t);
+
+    while ((remaining > 0U) && (XENSIV_BGT60TRXX_STATUS_OK == status))
+    {
+        /* The first chunk shares the message with the header */
+        uint32_t room = (linux_iface->msg_max_bytes - msg_bytes) & ~1U;
+
+        if ((num_xfers == XENSIV_BGT60TRXX_LINUX_MAX_XFERS) || (room == 0U))
+        {
+            /* Message full, submit it keeping CS asserted for the rest of the burst */
+            xfers[num_xfers - 1U].cs_change = 1U;
+            if (ioctl(linux_iface->spi_fd, SPI_IOC_MESSAGE(num_xfers), xfers) < 0)
+            {
+                status = XENSIV_BGT60TRXX_STATUS_COM_ERROR;
+                break;
+            }
+            num_xfers = 0U;
+            msg_bytes = 0U;
+            room = linux_iface->msg_max_bytes & ~1U;
+        }
+
+        uint32_t chunk = remaining;
+        if (chunk > sizeof(linux_iface->fifo_tx))
+        {
+            chunk = sizeof(linux_iface->fifo_tx);
+        }
+        if (chunk > room)
+        {
+            chunk = room;
+        }
+
+        set_xfer(&xfers[num_xfers], linux_iface->fifo_tx, rx_ptr, chunk,
+                 linux_iface->speed_hz, 12U);
+        ++num_xfers;
+        msg_bytes += chunk;
+        rx_ptr += chunk;
+        remaining -= chunk;
+    }
+
+    if ((XENSIV_BGT60TRXX_STATUS_OK == status) && (num_xfers > 0U))
+    {
+        if (ioctl(linux_iface->spi_fd, SPI_IOC_MESSAGE(num_xfers), xfers) < 0)
+        {
+            status = XENSIV_BGT60TRXX_STATUS_COM_ERROR;
+        }
+    }
+
+    return status;
+}
+
+
+void xensiv_bgt60trxx_platform_rst_set(const void* iface, bool val)
+{
+    assert(iface != NULL);
+
+    const xensiv_bgt60trxx_linux_iface_t* linux_iface = iface;
+
+    assert(linux_iface->rst_fd >= 0);
+
+    struct gpiohandle_data data;
+    (void)memset(&data, 0, sizeof(data));
+    data.values[0] = val ? 1U : 0U;
+    (void)ioctl(linux_iface->rst_fd, GPIOHANDLE_SET_LINE_VALUES_IOCTL, &data);
+}
+
+
+#if !defined(XENSIV_BGT60TRXX_PLATFORM_INLINE)
+void xensiv_bgt60trxx_platform_spi_cs_set(const void* iface, bool val)
+{
+    /* The chip select is driven by the SPI controller for each SPI_IOC_MESSAGE */
+    (void)iface;
+    (void)val;
+}
+
+
+#endif // !defined(XENSIV_BGT60TRXX_PLATFORM_INLINE)
+
+
+void xensiv_bgt60trxx_platform_delay(uint32_t ms)
+{
+    struct timespec ts =
+    {
+        .tv_sec  = (time_t)(ms / 1000U),
+        .tv_nsec = (long)(ms % 1000U) * 1000000L
+    };
+
+    while ((nanosleep(&ts, &ts) != 0) && (errno == EINTR))
+    {
+    }
+}
+
+
+void xensiv_bgt60trxx_platform_delay_us(uint32_t us)
+{
+    struct timespec ts =
+    {
+        .tv_sec  = (time_t)(us / 1000000U),
+        .tv_nsec = (long)(us % 1000000U) * 1000L
+    };
+
+    while ((nanosleep(&ts, &ts) != 0) && (errno == EINTR))
+    {
+    }
+}
+
+
+uint32_t xensiv_bgt60trxx_platform_get_time_us(void)
+{
+    struct timespec ts;
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint32_t)(((uint64_t)ts.tv_sec * 1000000U) + ((uint64_t)ts.tv_nsec / 1000U));
+}
+
+
+void xensiv_bgt60trxx_platform_memory_barrier(void)
+{
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+
+#if defined(XENSIV_BGT60TRXX_PLATFORM_LOCK)
+void xensiv_bgt60trxx_platform_lock(void* iface)
+{
+    assert(iface != NULL);
+
+    xensiv_bgt60trxx_linux_iface_t* linux_iface = iface;
+
+    (void)pthread_mutex_lock(&linux_iface->lock);
+}
+
+
+void xensiv_bgt60trxx_platform_unlock(void* iface)
+{
+    assert(iface != NULL);
+
+    xensiv_bgt60trxx_linux_iface_t* linux_iface = iface;
+
+    (void)pthread_mutex_unlock(&linux_iface->lock);
+}
+
+
+#endif // defined(XENSIV_BGT60TRXX_PLATFORM_LOCK)
+
+
+#if !defined(XENSIV_BGT60TRXX_PLATFORM_INLINE)
+uint32_t xensiv_bgt60trxx_platform_word_reverse(uint32_t x)
+{
+    return (((x & 0x000000ffUL) << 24) |
+            ((x & 0x0000ff00UL) <<  8) |
+            ((x & 0x00ff0000UL) >>  8) |
+            ((x & 0xff000000UL) >> 24));
+}
+
+
+void xensiv_bgt60trxx_platform_assert(bool expr)
+{
+    assert(expr);
+    (void)expr; /* make release build */
+}
+
+
+#endif // !defined(XENSIV_BGT60TRXX_PLATFORM_INLINE)
+
+
+/*******************************************************************************
+ * Static functions implementation
+ ********************************************************************************/
+static uint32_t get_spidev_bufsiz(void)
+{
+    uint32_t bufsiz = XENSIV_BGT60TRXX_LINUX_SPIDEV_BUFSIZ_DEF;
+
+    FILE* file = fopen(XENSIV_BGT60TRXX_LINUX_SPIDEV_BUFSIZ_PATH, "r");
+    if (file != NULL)
+    {
+        unsigned int val;
+        if ((fscanf(file, "%u", &val) == 1) && (val >= XENSIV_BGT60TRXX_SPI_BURST_HEADER_SIZE_BYTES))
+        {
+            bufsiz = (uint32_t)val;
+        }
+        (void)fclose(file);
+    }
+
+    return bufsiz;
+}
+
+
+static int32_t rst_init(xensiv_bgt60trxx_linux_iface_t* iface,
+                        const char* gpiochip,
+                        uint32_t rst_line)
+{
+    int32_t status = XENSIV_BGT60TRXX_STATUS_OK;
+
+    int chip_fd = open(gpiochip, O_RDWR);
+    if (chip_fd < 0)
+    {
+        status = XENSIV_BGT60TRXX_STATUS_COM_ERROR;
+    }
+    else
+    {
+        struct gpiohandle_request req;
+        (void)memset(&req, 0, sizeof(req));
+        req.lineoffsets[0] = rst_line;
+        req.lines = 1U;
+        req.flags = GPIOHANDLE_REQUEST_OUTPUT;
+        req.default_values[0] = 1U;
+        (void)strncpy(req.consumer_label, XENSIV_BGT60TRXX_LINUX_CONSUMER,
+                      sizeof(req.consumer_label) - 1U);
+
+        if (ioctl(chip_fd, GPIO_GET_LINEHANDLE_IOCTL, &req) < 0)
+        {
+            status = XENSIV_BGT60TRXX_STATUS_COM_ERROR;
+        }
+        else
+        {
+            iface->rst_fd = req.fd;
+        }
+
+        (void)close(chip_fd);
+    }
+
+    return status;
+}
+
+
+static void set_xfer(struct spi_ioc_transfer* xfer,
+                     const void* tx_data,
+                     void* rx_data,
+                     uint32_t len,
+                     uint32_t speed_hz,
+                     uint8_t bits_per_word)
+{
+    (void)memset(xfer, 0, sizeof(*xfer));
+    xfer->tx_buf = (uint64_t)(uintptr_t)tx_data;
+    xfer->rx_buf = (uint64_t)(uintptr_t)rx_data;
+    xfer->len = len;
+    xfer->speed_hz = speed_hz;
+    xfer->bits_per_word = bits_per_word;
+}
+
+
+#endif // defined(__linux__)
@@ -0,0 +1,189 @@
+/***********************************************************************************************//**
+ * \file xensiv_bgt60trxx_linux.h
+ *
+ * \brief
+ * This file contains the Linux platform functions declarations
+ * for interacting with the XENSIV(TM) BGT60TRxx 60GHz FMCW radar sensors.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2022 Infineon Technologies AG
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#ifndef XENSIV_BGT60TRXX_LINUX_H_
+#define XENSIV_BGT60TRXX_LINUX_H_
+
+#include <stddef.h>
+#if defined(XENSIV_BGT60TRXX_PLATFORM_LOCK)
+#include <pthread.h>
+#endif
+#if defined(XENSIV_BGT60TRXX_PLATFORM_INLINE)
+#include <assert.h>
+#endif
+
+#include "xensiv_bgt60trxx.h"
+
+/**
+ * \addtogroup group_board_libs_linux XENSIV(TM) BGT60TRxx Radar Sensor Linux Interface
+ * \{
+ * Provides the Linux interface to the XENSIV(TM) BGT60TRxx 60GHz FMCW radar sensors
+ * library and the implementation of the platform functions using the spidev user space API
+ * (/dev/spidevX.Y) and the GPIO character device (/dev/gpiochipN) for the reset pin.
+ *
+ * The SPI chip select is driven by the kernel SPI controller driver. Each register access is
+ * issued as one SPI_IOC_MESSAGE. The FIFO burst read (burst command header and payload) is
+ * issued as one multi-segment SPI_IOC_MESSAGE, so the build must define
+ * XENSIV_BGT60TRXX_PLATFORM_SPI_BURST_READ for all library sources.
+ *
+ * \note spidev limits the size of a single message to its bufsiz module parameter
+ * (4096 bytes by default). FIFO reads larger than that are split into several messages keeping
+ * the chip select asserted in between (cs_change). Load spidev with e.g. bufsiz=65536 to read
+ * a complete frame with a single system call.
+ *
+ * \note The FIFO is read using 12-bit SPI words, the SPI controller must support this word size.
+ * For controllers supporting only 8-bit words, define XENSIV_BGT60TRXX_FIFO_READ_RAW instead of
+ * XENSIV_BGT60TRXX_PLATFORM_SPI_BURST_READ and add xensiv_bgt60trxx_unpack.c to the build.
+ *
+ * xensiv_bgt60trxx_platform_get_time_us is implemented using CLOCK_MONOTONIC, define
+ * XENSIV_BGT60TRXX_PLATFORM_GET_TIME to time stamp the frames of the frame assembler and to
+ * measure the reset timeouts. xensiv_bgt60trxx_platform_delay_us is implemented using nanosleep,
+ * define XENSIV_BGT60TRXX_PLATFORM_DELAY_US to shorten the hard reset and the polling delays.
+ * xensiv_bgt60trxx_platform_lock is implemented using a mutex per interface, define
+ * XENSIV_BGT60TRXX_PLATFORM_LOCK to call the driver functions for a sensor from several threads
+ * and link with -pthread.
+ */
+
+#if defined(__linux__)
+
+/************************************** Macros *******************************************/
+
+/** Maximum number of bytes of a single spidev transfer segment */
+#ifndef XENSIV_BGT60TRXX_LINUX_XFER_MAX_BYTES
+#define XENSIV_BGT60TRXX_LINUX_XFER_MAX_BYTES           (4096U)
+#endif
+
+/******************************** Type definitions ****************************************/
+
+/**
+ * Structure holding the XENSIV(TM) BGT60TRxx Linux interface.
+ *
+ * Application code should not rely on the specific content of this struct.
+ * They are considered an implementation detail which is subject to change
+ * between platforms and/or library releases.
+ */
+typedef struct
+{
+    int spi_fd;
+    int rst_fd;
+    uint32_t speed_hz;
+    uint32_t msg_max_bytes;
+    #if defined(XENSIV_BGT60TRXX_PLATFORM_LOCK)
+    pthread_mutex_t lock;
+    #endif
+    uint16_t fifo_tx[XENSIV_BGT60TRXX_LINUX_XFER_MAX_BYTES / sizeof(uint16_t)];
+} xensiv_bgt60trxx_linux_iface_t;
+
+/**
+ * Structure holding the XENSIV(TM) BGT60TRxx Linux object.
+ * Content initialized using \ref xensiv_bgt60trxx_linux_init
+ *
+ */
+typedef struct
+{
+    xensiv_bgt60trxx_t dev; /**< sensor object */
+    xensiv_bgt60trxx_linux_iface_t iface; /**< interface object for communication */
+} xensiv_bgt60trxx_linux_t;
+
+/******************************* Function prototypes *************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Initializes the XENSIV(TM) BGT60TRxx sensor.
+ * Opens the spidev device and configures it for SPI Mode 0 (CPOL=0, CPHA=0) with MSB first.
+ * If the reset pin is used (\p gpiochip not NULL) the function requests the GPIO line and
+ * generates a hardware reset sequence.
+ *
+ * The function initializes a sensor object using the configuration register list.
+ *
+ * @param[inout] obj       Pointer to the BGT60TRxx Linux object. The caller must
+ * allocate the memory for this object but the init function will initialize its contents.
+ * @param[in]    spidev    Path of the spidev device, e.g. "/dev/spidev0.0".
+ * @param[in]    gpiochip  Path of the GPIO chip the SPI_DIO3 pin of the sensor is connected to,
+ *                         e.g. "/dev/gpiochip0".
+ *                         @note Can be NULL if the reset pin is not used
+ * @param[in]    rst_line  Line offset of the reset pin in \p gpiochip.
+ * @param[in]    speed_hz  SPI clock frequency in Hz.
+ * @param[in]    regs      Pointer to the configuration registers list.
+ * @param[in]    len       Length of the configuration registers list.
+ * @return XENSIV_BGT60TRXX_STATUS_OK if properly initialized; else an error indicating what
+ * went wrong.
+ */
+int32_t xensiv_bgt60trxx_linux_init(xensiv_bgt60trxx_linux_t* obj,
+                                    const char* spidev,
+                                    const char* gpiochip,
+                                    uint32_t rst_line,
+                                    uint32_t speed_hz,
+                                    const uint32_t* regs,
+                                    size_t len);
+
+/**
+ * Frees up any resources allocated by the XENSIV(TM) BGT60TRxx as part of
+ * \ref xensiv_bgt60trxx_linux_init()
+ * @param[in] obj  Pointer to the BGT60TRxx Linux object.
+ */
+void xensiv_bgt60trxx_linux_free(xensiv_bgt60trxx_linux_t* obj);
+
+#if defined(XENSIV_BGT60TRXX_PLATFORM_INLINE)
+/** \cond INTERNAL */
+/* Platform functions called for every register access, see xensiv_bgt60trxx_platform.h */
+static inline void xensiv_bgt60trxx_platform_spi_cs_set(const void* iface, bool val)
+{
+    /* The chip select is driven by the SPI controller for each SPI_IOC_MESSAGE */
+    (void)iface;
+    (void)val;
+}
+
+
+static inline uint32_t xensiv_bgt60trxx_platform_word_reverse(uint32_t x)
+{
+    return (((x & 0x000000ffUL) << 24) |
+            ((x & 0x0000ff00UL) <<  8) |
+            ((x & 0x00ff0000UL) >>  8) |
+            ((x & 0xff000000UL) >> 24));
+}
+
+
+static inline void xensiv_bgt60trxx_platform_assert(bool expr)
+{
+    assert(expr);
+    (void)expr; /* make release build */
+}
+
+
+/** \endcond */
+#endif // defined(XENSIV_BGT60TRXX_PLATFORM_INLINE)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // defined(__linux__)
+
+/** \} group_board_libs_linux */
+
+#endif // ifndef XENSIV_BGT60TRXX_LINUX_H_
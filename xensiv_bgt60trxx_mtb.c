@@ -29,12 +29,37 @@
 #include "xensiv_bgt60trxx_mtb.h"
 #include "xensiv_bgt60trxx_platform.h"
 
+#if defined(XENSIV_BGT60TRXX_MTB_USE_DMA) && \
+    (!defined(CYHAL_API_VERSION) || (CYHAL_API_VERSION < 2))
+#error "XENSIV_BGT60TRXX_MTB_USE_DMA requires the SPI trigger outputs of HAL API version 2 or later"
+#endif
+
+#if defined(XENSIV_BGT60TRXX_PLATFORM_LOCK) && \
+    !(defined(CY_RTOS_AWARE) || defined(COMPONENT_RTOS_AWARE))
+#error "XENSIV_BGT60TRXX_PLATFORM_LOCK requires the RTOS_AWARE component"
+#endif
+
 /*******************************************************************************
 * Macros
 *******************************************************************************/
 #define XENSIV_BGT60TRXX_ERROR(x)           (((x) == XENSIV_BGT60TRXX_STATUS_OK) ? CY_RSLT_SUCCESS :\
                                              CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_BOARD_HARDWARE_XENSIV_BGT60TRXX, (x)))
 
+#if defined(XENSIV_BGT60TRXX_MTB_USE_DMA)
+/* Ownership of the ping-pong frame buffers */
+#define DMA_BUF_FREE                        (0U)
+#define DMA_BUF_FILLING                     (1U)
+#define DMA_BUF_READY                       (2U)
+#define DMA_BUF_APP                         (3U)
+
+/* Value shifted out on MOSI while reading the FIFO, same as the PDL default */
+#define DMA_TX_DUMMY                        (0xFFFFU)
+
+/* A payload is transferred in segments of up to DMA_MAX_ROWS rows of DMA_MAX_ROW samples, a 2D
+ * transfer within the X and Y count limits of the DataWire channels, and a last 1D segment */
+#define DMA_MAX_ROW                         (256U)
+#define DMA_MAX_ROWS                        (256U)
+#endif
 
 /*******************************************************************************
  * Function Prototypes
@@ -52,6 +77,16 @@ static cy_rslt_t config_int(xensiv_bgt60trxx_mtb_interrupt_pin_t* intpin,
                             cyhal_gpio_event_callback_t callback,
                             void* callback_arg);
 
+#if defined(XENSIV_BGT60TRXX_MTB_USE_DMA)
+static bool dma_fifo_read(xensiv_bgt60trxx_mtb_iface_t* iface, uint16_t* rx_data, uint32_t len);
+
+static cy_rslt_t dma_segment_start(xensiv_bgt60trxx_mtb_iface_t* iface);
+
+static void dma_wait(xensiv_bgt60trxx_mtb_iface_t* iface);
+
+static void dma_rx_complete(void* callback_arg, cyhal_dma_event_t event);
+#endif
+
 /*******************************************************************************
  * Public interface implementation
  ********************************************************************************/
@@ -74,6 +109,16 @@ cy_rslt_t xensiv_bgt60trxx_mtb_init(xensiv_bgt60trxx_mtb_t* obj,
     iface->selpin = selpin;
     iface->rstpin = rstpin;
     set_pin(&(iface->irqpin), NC);
+    #if defined(XENSIV_BGT60TRXX_MTB_USE_DMA)
+    iface->dma_enabled = false;
+    iface->dma_nonblocking = false;
+    iface->dma_active = false;
+    iface->dma_cs_release = false;
+    iface->dma_fallbacks = 0U;
+    #if defined(XENSIV_BGT60TRXX_PLATFORM_SPI_FIFO_READ_ASYNC)
+    iface->dma_done = NULL;
+    #endif
+    #endif
 
     cy_rslt_t rslt = cyhal_gpio_init(selpin,
                                      CYHAL_GPIO_DIR_OUTPUT,
@@ -88,20 +133,22 @@ cy_rslt_t xensiv_bgt60trxx_mtb_init(xensiv_bgt60trxx_mtb_t* obj,
                                true);
     }
 
+    #if defined(XENSIV_BGT60TRXX_PLATFORM_LOCK)
+    if (CY_RSLT_SUCCESS == rslt)
+    {
+        rslt = cy_rtos_init_semaphore(&(iface->lock), 1U, 1U);
+    }
+    #endif
 
     xensiv_bgt60trxx_t* dev = &obj->dev;
 
-    /* perform device hard reset before beginning init via SPI */
-    xensiv_bgt60trxx_platform_rst_set(iface, true);
-    xensiv_bgt60trxx_platform_spi_cs_set(iface, true);
-    xensiv_bgt60trxx_platform_delay(1U);
-    xensiv_bgt60trxx_platform_rst_set(iface, false);
-    xensiv_bgt60trxx_platform_delay(1U);
-    xensiv_bgt60trxx_platform_rst_set(iface, true);
-    xensiv_bgt60trxx_platform_delay(1U);
-
     if (CY_RSLT_SUCCESS == rslt)
     {
+        /* perform device hard reset before beginning init via SPI */
+        dev->iface = iface;
+        dev->shadow = NULL;
+        xensiv_bgt60trxx_hard_reset(dev);
+
         int32_t res = xensiv_bgt60trxx_init(dev, iface, false);
         rslt = XENSIV_BGT60TRXX_ERROR(res);
     }
@@ -173,9 +220,200 @@ void xensiv_bgt60trxx_mtb_free(xensiv_bgt60trxx_mtb_t* obj)
     {
         free_pin(iface->irqpin);
     }
+
+    #if defined(XENSIV_BGT60TRXX_MTB_USE_DMA)
+    if (iface->dma_enabled)
+    {
+        dma_wait(iface);
+        cyhal_dma_free(&(iface->dma_rx));
+        cyhal_dma_free(&(iface->dma_tx));
+        #if defined(CY_RTOS_AWARE) || defined(COMPONENT_RTOS_AWARE)
+        (void)cy_rtos_deinit_semaphore(&(iface->dma_sem));
+        #endif
+        iface->dma_enabled = false;
+    }
+    #endif
+
+    #if defined(XENSIV_BGT60TRXX_PLATFORM_LOCK)
+    (void)cy_rtos_deinit_semaphore(&(iface->lock));
+    #endif
 }
 
 
+#if defined(XENSIV_BGT60TRXX_MTB_USE_DMA)
+cy_rslt_t xensiv_bgt60trxx_mtb_dma_init(xensiv_bgt60trxx_mtb_t* obj,
+                                        uint8_t intr_priority,
+                                        uint16_t* buf0,
+                                        uint16_t* buf1,
+                                        uint32_t num_samples)
+{
+    CY_ASSERT(obj != NULL);
+    CY_ASSERT((buf0 == NULL) == (buf1 == NULL));
+    CY_ASSERT((buf0 == NULL) || (num_samples > 0U));
+
+    xensiv_bgt60trxx_mtb_iface_t* iface = &obj->iface;
+    CY_ASSERT(!iface->dma_enabled);
+
+    iface->dma_bufs[0] = buf0;
+    iface->dma_bufs[1] = buf1;
+    iface->dma_buf_state[0] = DMA_BUF_FREE;
+    iface->dma_buf_state[1] = DMA_BUF_FREE;
+    iface->dma_fill_idx = 0U;
+    iface->dma_get_idx = 0U;
+    iface->dma_num_samples = num_samples;
+
+    cyhal_source_t rx_source;
+    cyhal_source_t tx_source;
+
+    /* RX channel has the higher priority to keep the RX FIFO from overflowing */
+    cy_rslt_t rslt = cyhal_dma_init(&(iface->dma_rx), CYHAL_DMA_PRIORITY_HIGH,
+                                    CYHAL_DMA_DIRECTION_PERIPH2MEM);
+    if (CY_RSLT_SUCCESS != rslt)
+    {
+        return rslt;
+    }
+
+    rslt = cyhal_dma_init(&(iface->dma_tx), CYHAL_DMA_PRIORITY_LOW, CYHAL_DMA_DIRECTION_MEM2PERIPH);
+    if (CY_RSLT_SUCCESS != rslt)
+    {
+        cyhal_dma_free(&(iface->dma_rx));
+        return rslt;
+    }
+
+    rslt = cyhal_spi_enable_output(iface->spi, CYHAL_SPI_OUTPUT_TRIGGER_RX_FIFO_LEVEL_REACHED,
+                                   &rx_source);
+    if (CY_RSLT_SUCCESS == rslt)
+    {
+        rslt = cyhal_spi_enable_output(iface->spi, CYHAL_SPI_OUTPUT_TRIGGER_TX_FIFO_LEVEL_REACHED,
+                                       &tx_source);
+    }
+
+    if (CY_RSLT_SUCCESS == rslt)
+    {
+        rslt = cyhal_dma_connect_digital(&(iface->dma_rx), rx_source,
+                                         CYHAL_DMA_INPUT_TRIGGER_SINGLE_ELEMENT);
+    }
+
+    if (CY_RSLT_SUCCESS == rslt)
+    {
+        rslt = cyhal_dma_connect_digital(&(iface->dma_tx), tx_source,
+                                         CYHAL_DMA_INPUT_TRIGGER_SINGLE_ELEMENT);
+    }
+
+    #if defined(CY_RTOS_AWARE) || defined(COMPONENT_RTOS_AWARE)
+    if (CY_RSLT_SUCCESS == rslt)
+    {
+        rslt = cy_rtos_init_semaphore(&(iface->dma_sem), 1U, 0U);
+    }
+    #endif
+
+    if (CY_RSLT_SUCCESS == rslt)
+    {
+        cyhal_dma_register_callback(&(iface->dma_rx), dma_rx_complete, iface);
+        cyhal_dma_enable_event(&(iface->dma_rx), CYHAL_DMA_TRANSFER_COMPLETE, intr_priority, true);
+        iface->dma_enabled = true;
+    }
+    else
+    {
+        cyhal_dma_free(&(iface->dma_rx));
+        cyhal_dma_free(&(iface->dma_tx));
+    }
+
+    return rslt;
+}
+
+
+cy_rslt_t xensiv_bgt60trxx_mtb_dma_read_start(xensiv_bgt60trxx_mtb_t* obj)
+{
+    CY_ASSERT(obj != NULL);
+
+    xensiv_bgt60trxx_mtb_iface_t* iface = &obj->iface;
+    CY_ASSERT(iface->dma_enabled);
+    CY_ASSERT(iface->dma_bufs[0] != NULL);
+
+    uint8_t idx = iface->dma_fill_idx;
+    if (DMA_BUF_FREE != iface->dma_buf_state[idx])
+    {
+        return XENSIV_BGT60TRXX_RSLT_ERR_DMA_BUSY;
+    }
+
+    iface->dma_buf_state[idx] = DMA_BUF_FILLING;
+    iface->dma_nonblocking = true;
+    int32_t res = xensiv_bgt60trxx_get_fifo_data(&obj->dev, iface->dma_bufs[idx],
+                                                 iface->dma_num_samples);
+    iface->dma_nonblocking = false;
+
+    if (XENSIV_BGT60TRXX_STATUS_OK == res)
+    {
+        /* the payload was read without DMA if the channels could not be configured, counted in
+         * xensiv_bgt60trxx_mtb_dma_get_num_fallbacks */
+        uint32_t state = cyhal_system_critical_section_enter();
+        if (!iface->dma_active && (DMA_BUF_FILLING == iface->dma_buf_state[idx]))
+        {
+            iface->dma_buf_state[idx] = DMA_BUF_READY;
+        }
+        cyhal_system_critical_section_exit(state);
+
+        iface->dma_fill_idx = idx ^ 1U;
+    }
+    else
+    {
+        /* the payload transfer may have been started before the error was detected */
+        dma_wait(iface);
+        iface->dma_buf_state[idx] = DMA_BUF_FREE;
+    }
+
+    return XENSIV_BGT60TRXX_ERROR(res);
+}
+
+
+uint16_t* xensiv_bgt60trxx_mtb_dma_get_frame(xensiv_bgt60trxx_mtb_t* obj)
+{
+    CY_ASSERT(obj != NULL);
+
+    xensiv_bgt60trxx_mtb_iface_t* iface = &obj->iface;
+    uint16_t* frame = NULL;
+
+    uint8_t idx = iface->dma_get_idx;
+    if (DMA_BUF_READY == iface->dma_buf_state[idx])
+    {
+        iface->dma_buf_state[idx] = DMA_BUF_APP;
+        iface->dma_get_idx = idx ^ 1U;
+        frame = iface->dma_bufs[idx];
+    }
+
+    return frame;
+}
+
+
+void xensiv_bgt60trxx_mtb_dma_release_frame(xensiv_bgt60trxx_mtb_t* obj, const uint16_t* frame)
+{
+    CY_ASSERT(obj != NULL);
+
+    xensiv_bgt60trxx_mtb_iface_t* iface = &obj->iface;
+
+    for (uint8_t idx = 0U; idx < 2U; ++idx)
+    {
+        if (frame == iface->dma_bufs[idx])
+        {
+            CY_ASSERT(DMA_BUF_APP == iface->dma_buf_state[idx]);
+            iface->dma_buf_state[idx] = DMA_BUF_FREE;
+        }
+    }
+}
+
+
+uint32_t xensiv_bgt60trxx_mtb_dma_get_num_fallbacks(const xensiv_bgt60trxx_mtb_t* obj)
+{
+    CY_ASSERT(obj != NULL);
+
+    return obj->iface.dma_fallbacks;
+}
+
+
+#endif // defined(XENSIV_BGT60TRXX_MTB_USE_DMA)
+
+
 /*******************************************************************************
  * Platform functions implementation
  ********************************************************************************/
@@ -202,6 +440,10 @@ int32_t xensiv_bgt60trxx_platform_spi_transfer(void* iface,
 
     const xensiv_bgt60trxx_mtb_iface_t* mtb_iface = iface;
 
+    #if defined(XENSIV_BGT60TRXX_MTB_USE_DMA)
+    dma_wait(iface);
+    #endif
+
     spi_set_data_width(mtb_iface->spi->base, 8U);
     Cy_SCB_SetByteMode(mtb_iface->spi->base, true);
     cy_en_scb_spi_status_t status = Cy_SCB_SPI_Transfer(mtb_iface->spi->base, tx_data, rx_data, len,
@@ -228,6 +470,25 @@ int32_t xensiv_bgt60trxx_platform_spi_fifo_read(void* iface,
     CY_ASSERT(iface != NULL);
     CY_ASSERT(rx_data != NULL);
 
+    #if defined(XENSIV_BGT60TRXX_MTB_USE_DMA)
+    xensiv_bgt60trxx_mtb_iface_t* dma_iface = iface;
+    if (dma_iface->dma_enabled)
+    {
+        dma_wait(dma_iface);
+        if (dma_fifo_read(dma_iface, rx_data, len))
+        {
+            if (dma_iface->dma_nonblocking)
+            {
+                return XENSIV_BGT60TRXX_STATUS_OK;
+            }
+            dma_wait(dma_iface);
+            return dma_iface->dma_status;
+        }
+        /* DMA channels could not be configured, fall back to the SCB driver */
+        ++dma_iface->dma_fallbacks;
+    }
+    #endif
+
     const xensiv_bgt60trxx_mtb_iface_t* mtb_iface = iface;
 
     spi_set_data_width(mtb_iface->spi->base, 12U);
@@ -249,6 +510,47 @@ int32_t xensiv_bgt60trxx_platform_spi_fifo_read(void* iface,
 }
 
 
+#if defined(XENSIV_BGT60TRXX_PLATFORM_SPI_FIFO_READ_ASYNC)
+int32_t xensiv_bgt60trxx_platform_spi_fifo_read_async(void* iface,
+                                                      uint16_t* rx_data,
+                                                      uint32_t len,
+                                                      xensiv_bgt60trxx_platform_xfer_done_t done,
+                                                      void* arg)
+{
+    CY_ASSERT(iface != NULL);
+    CY_ASSERT(rx_data != NULL);
+    CY_ASSERT(done != NULL);
+
+    #if defined(XENSIV_BGT60TRXX_MTB_USE_DMA)
+    xensiv_bgt60trxx_mtb_iface_t* mtb_iface = iface;
+    if (mtb_iface->dma_enabled)
+    {
+        dma_wait(mtb_iface);
+        mtb_iface->dma_done = done;
+        mtb_iface->dma_done_arg = arg;
+        if (dma_fifo_read(mtb_iface, rx_data, len))
+        {
+            /* done is called by the DMA transfer complete interrupt */
+            return XENSIV_BGT60TRXX_STATUS_OK;
+        }
+        mtb_iface->dma_done = NULL;
+    }
+    #endif
+
+    /* counts the fallback if the DMA channels cannot be configured */
+    int32_t retval = xensiv_bgt60trxx_platform_spi_fifo_read(iface, rx_data, len);
+    if (XENSIV_BGT60TRXX_STATUS_OK == retval)
+    {
+        done(arg, retval);
+    }
+
+    return retval;
+}
+
+
+#endif // defined(XENSIV_BGT60TRXX_PLATFORM_SPI_FIFO_READ_ASYNC)
+
+
 void xensiv_bgt60trxx_platform_rst_set(const void* iface, bool val)
 {
     CY_ASSERT(iface != NULL);
@@ -261,6 +563,7 @@ void xensiv_bgt60trxx_platform_rst_set(const void* iface, bool val)
 }
 
 
+#if !defined(XENSIV_BGT60TRXX_PLATFORM_INLINE)
 void xensiv_bgt60trxx_platform_spi_cs_set(const void* iface, bool val)
 {
     CY_ASSERT(iface != NULL);
@@ -269,16 +572,83 @@ void xensiv_bgt60trxx_platform_spi_cs_set(const void* iface, bool val)
 
     CY_ASSERT(mtb_iface->selpin != NC);
 
+    #if defined(XENSIV_BGT60TRXX_MTB_USE_DMA)
+    xensiv_bgt60trxx_mtb_iface_t* dma_iface = (xensiv_bgt60trxx_mtb_iface_t*)iface;
+    if (val)
+    {
+        /* CS is released by the DMA transfer complete interrupt if a payload is still streaming */
+        uint32_t state = cyhal_system_critical_section_enter();
+        bool active = dma_iface->dma_active;
+        dma_iface->dma_cs_release = active;
+        cyhal_system_critical_section_exit(state);
+        if (active)
+        {
+            return;
+        }
+    }
+    else
+    {
+        dma_wait(dma_iface);
+    }
+    #endif
+
     cyhal_gpio_write(mtb_iface->selpin, val);
 }
 
 
+#endif // !defined(XENSIV_BGT60TRXX_PLATFORM_INLINE)
+
+
 void xensiv_bgt60trxx_platform_delay(uint32_t ms)
 {
     (void)cyhal_system_delay_ms(ms);
 }
 
 
+void xensiv_bgt60trxx_platform_delay_us(uint32_t us)
+{
+    while (us > UINT16_MAX)
+    {
+        cyhal_system_delay_us(UINT16_MAX);
+        us -= UINT16_MAX;
+    }
+
+    cyhal_system_delay_us((uint16_t)us);
+}
+
+
+void xensiv_bgt60trxx_platform_memory_barrier(void)
+{
+    __DMB();
+}
+
+
+#if defined(XENSIV_BGT60TRXX_PLATFORM_LOCK)
+void xensiv_bgt60trxx_platform_lock(void* iface)
+{
+    CY_ASSERT(iface != NULL);
+
+    xensiv_bgt60trxx_mtb_iface_t* mtb_iface = iface;
+
+    (void)cy_rtos_get_semaphore(&(mtb_iface->lock), CY_RTOS_NEVER_TIMEOUT, false);
+}
+
+
+void xensiv_bgt60trxx_platform_unlock(void* iface)
+{
+    CY_ASSERT(iface != NULL);
+
+    xensiv_bgt60trxx_mtb_iface_t* mtb_iface = iface;
+
+    /* released from the DMA transfer complete interrupt after an asynchronous FIFO read */
+    (void)cy_rtos_set_semaphore(&(mtb_iface->lock), (__get_IPSR() != 0U));
+}
+
+
+#endif // defined(XENSIV_BGT60TRXX_PLATFORM_LOCK)
+
+
+#if !defined(XENSIV_BGT60TRXX_PLATFORM_INLINE)
 uint32_t xensiv_bgt60trxx_platform_word_reverse(uint32_t x)
 {
     return __REV(x);
@@ -292,6 +662,9 @@ void xensiv_bgt60trxx_platform_assert(bool expr)
 }
 
 
+#endif // !defined(XENSIV_BGT60TRXX_PLATFORM_INLINE)
+
+
 /*******************************************************************************
  * Static functions implementation
  ********************************************************************************/
@@ -367,4 +740,175 @@ static cy_rslt_t config_int(xensiv_bgt60trxx_mtb_interrupt_pin_t* intpin,
 }
 
 
+#if defined(XENSIV_BGT60TRXX_MTB_USE_DMA)
+/* Starts the DMA transfer of the FIFO payload, returns false if the first segment could not be
+   configured. The following segments are started by the DMA transfer complete interrupt. */
+static bool dma_fifo_read(xensiv_bgt60trxx_mtb_iface_t* iface, uint16_t* rx_data, uint32_t len)
+{
+    CySCB_Type* base = iface->spi->base;
+
+    spi_set_data_width(base, 12U);
+    Cy_SCB_SetByteMode(base, false);
+    Cy_SCB_ClearRxFifo(base);
+    Cy_SCB_ClearTxFifo(base);
+
+    /* RX: one element per received word. TX: refill while the TX FIFO is below half full,
+     * which bounds the words in flight to what the RX FIFO can hold. */
+    Cy_SCB_SetRxFifoLevel(base, 0U);
+    Cy_SCB_SetTxFifoLevel(base, Cy_SCB_GetFifoSize(base) / 2U);
+
+    iface->dma_rx_ptr = rx_data;
+    iface->dma_remaining = len;
+    iface->dma_status = XENSIV_BGT60TRXX_STATUS_OK;
+    iface->dma_active = true;
+
+    bool started = (CY_RSLT_SUCCESS == dma_segment_start(iface));
+    if (!started)
+    {
+        iface->dma_active = false;
+    }
+
+    return started;
+}
+
+
+/* Configures and enables both channels for the next segment of the payload */
+static cy_rslt_t dma_segment_start(xensiv_bgt60trxx_mtb_iface_t* iface)
+{
+    static const uint16_t tx_dummy = DMA_TX_DUMMY;
+
+    CySCB_Type* base = iface->spi->base;
+    uint32_t len = iface->dma_remaining;
+    uint32_t row = 1U;
+
+    if (len >= DMA_MAX_ROW)
+    {
+        uint32_t rows = len / DMA_MAX_ROW;
+        if (rows > DMA_MAX_ROWS)
+        {
+            rows = DMA_MAX_ROWS;
+        }
+
+        len = rows * DMA_MAX_ROW;
+        row = DMA_MAX_ROW;
+    }
+
+    /* one element per trigger in any case, the burst size only sets the row length */
+    cyhal_dma_cfg_t rx_cfg =
+    {
+        .src_addr       = (uint32_t)&SCB_RX_FIFO_RD(base),
+        .src_increment  = 0,
+        .dst_addr       = (uint32_t)iface->dma_rx_ptr,
+        .dst_increment  = 1,
+        .transfer_width = 16U,
+        .length         = len,
+        .burst_size     = row,
+        .action         = CYHAL_DMA_TRANSFER_FULL
+    };
+
+    cyhal_dma_cfg_t tx_cfg =
+    {
+        .src_addr       = (uint32_t)&tx_dummy,
+        .src_increment  = 0,
+        .dst_addr       = (uint32_t)&SCB_TX_FIFO_WR(base),
+        .dst_increment  = 0,
+        .transfer_width = 16U,
+        .length         = len,
+        .burst_size     = row,
+        .action         = CYHAL_DMA_TRANSFER_FULL
+    };
+
+    cy_rslt_t rslt = cyhal_dma_configure(&(iface->dma_rx), &rx_cfg);
+    if (CY_RSLT_SUCCESS == rslt)
+    {
+        rslt = cyhal_dma_configure(&(iface->dma_tx), &tx_cfg);
+    }
+
+    if (CY_RSLT_SUCCESS == rslt)
+    {
+        iface->dma_rx_ptr += len;
+        iface->dma_remaining -= len;
+        (void)cyhal_dma_enable(&(iface->dma_rx));
+        /* the TX FIFO is empty, so enabling the TX channel starts clocking the segment */
+        (void)cyhal_dma_enable(&(iface->dma_tx));
+    }
+
+    return rslt;
+}
+
+
+static void dma_wait(xensiv_bgt60trxx_mtb_iface_t* iface)
+{
+    #if defined(CY_RTOS_AWARE) || defined(COMPONENT_RTOS_AWARE)
+    /* a stale token left by a non-blocking read is consumed by re-checking the flag */
+    while (iface->dma_active)
+    {
+        (void)cy_rtos_get_semaphore(&(iface->dma_sem), CY_RTOS_NEVER_TIMEOUT, false);
+    }
+    #else
+    /* check and sleep with interrupts masked, a pending interrupt still wakes up the core */
+    uint32_t state = cyhal_system_critical_section_enter();
+    while (iface->dma_active)
+    {
+        __WFI();
+        cyhal_system_critical_section_exit(state);
+        state = cyhal_system_critical_section_enter();
+    }
+    cyhal_system_critical_section_exit(state);
+    #endif
+}
+
+
+static void dma_rx_complete(void* callback_arg, cyhal_dma_event_t event)
+{
+    CY_UNUSED_PARAMETER(event);
+
+    xensiv_bgt60trxx_mtb_iface_t* iface = callback_arg;
+
+    if (iface->dma_remaining > 0U)
+    {
+        /* CS stays asserted, the SPI clock pauses until the next segment is enabled */
+        if (CY_RSLT_SUCCESS == dma_segment_start(iface))
+        {
+            return;
+        }
+
+        iface->dma_remaining = 0U;
+        iface->dma_status = XENSIV_BGT60TRXX_STATUS_COM_ERROR;
+    }
+
+    if (iface->dma_cs_release)
+    {
+        iface->dma_cs_release = false;
+        cyhal_gpio_write(iface->selpin, true);
+    }
+
+    for (uint8_t idx = 0U; idx < 2U; ++idx)
+    {
+        if (DMA_BUF_FILLING == iface->dma_buf_state[idx])
+        {
+            iface->dma_buf_state[idx] = (XENSIV_BGT60TRXX_STATUS_OK == iface->dma_status) ?
+                                        DMA_BUF_READY : DMA_BUF_FREE;
+        }
+    }
+
+    iface->dma_active = false;
+
+    #if defined(CY_RTOS_AWARE) || defined(COMPONENT_RTOS_AWARE)
+    (void)cy_rtos_set_semaphore(&(iface->dma_sem), true);
+    #endif
+
+    #if defined(XENSIV_BGT60TRXX_PLATFORM_SPI_FIFO_READ_ASYNC)
+    xensiv_bgt60trxx_platform_xfer_done_t done = iface->dma_done;
+    if (done != NULL)
+    {
+        iface->dma_done = NULL;
+        done(iface->dma_done_arg, iface->dma_status);
+    }
+    #endif
+}
+
+
+#endif // defined(XENSIV_BGT60TRXX_MTB_USE_DMA)
+
 #endif // defined(CY_USING_HAL)
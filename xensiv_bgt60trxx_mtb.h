@@ -29,6 +29,7 @@
 #include "cy_result.h"
 
 #include "xensiv_bgt60trxx.h"
+#include "xensiv_bgt60trxx_platform.h"
 
 /**
  * \addtogroup group_board_libs_mtb XENSIV(TM) BGT60TRxx Radar Sensor ModusToolBox(TM) Interface
@@ -39,6 +40,10 @@
  * \note The library uses delays while waiting for the sensor. If the RTOS_AWARE component is set
  * or CY_RTOS_AWARE is defined, the driver will defer to the RTOS for delays. Because of this, it is
  * not safe to call any functions until after the RTOS scheduler has started.
+ * \note If XENSIV_BGT60TRXX_PLATFORM_LOCK is defined, the driver functions for a sensor can be
+ * called from several RTOS tasks. The lock is a binary semaphore of the RTOS abstraction, which
+ * is released from the DMA transfer complete interrupt after an asynchronous FIFO read; the
+ * RTOS_AWARE component is required.
  *
  * \section subsection_board_libs_snippets Code snippets
  * \subsection subsection_board_libs_snippet_1 Snippet 1: Initialization.
@@ -55,6 +60,15 @@
 #if defined(CY_USING_HAL)
 #include "cyhal_gpio.h"
 #include "cyhal_spi.h"
+#if defined(XENSIV_BGT60TRXX_MTB_USE_DMA)
+#include "cyhal_dma.h"
+#if defined(CY_RTOS_AWARE) || defined(COMPONENT_RTOS_AWARE)
+#include "cyabs_rtos.h"
+#endif
+#endif
+#if defined(XENSIV_BGT60TRXX_PLATFORM_LOCK)
+#include "cyabs_rtos.h"
+#endif
 
 /************************************** Macros *******************************************/
 
@@ -76,6 +90,10 @@
 #define XENSIV_BGT60TRXX_RSLT_ERR_INTPIN_INUSE\
     (CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_BOARD_HARDWARE_XENSIV_BGT60TRXX, 0x100))
 
+/** No free frame buffer available for a DMA FIFO read */
+#define XENSIV_BGT60TRXX_RSLT_ERR_DMA_BUSY\
+    (CY_RSLT_CREATE(CY_RSLT_TYPE_ERROR, CY_RSLT_MODULE_BOARD_HARDWARE_XENSIV_BGT60TRXX, 0x101))
+
 /******************************** Type definitions ****************************************/
 
 /** \cond INTERNAL */
@@ -99,6 +117,33 @@ typedef struct
     cyhal_gpio_t selpin;
     cyhal_gpio_t rstpin;
     xensiv_bgt60trxx_mtb_interrupt_pin_t irqpin;
+    #if defined(XENSIV_BGT60TRXX_MTB_USE_DMA)
+    cyhal_dma_t dma_rx;
+    cyhal_dma_t dma_tx;
+    bool dma_enabled;
+    bool dma_nonblocking;
+    volatile bool dma_active;
+    volatile bool dma_cs_release;
+    uint16_t* dma_bufs[2];
+    volatile uint8_t dma_buf_state[2];
+    uint8_t dma_fill_idx;
+    uint8_t dma_get_idx;
+    uint32_t dma_num_samples;
+    uint16_t* dma_rx_ptr;
+    volatile uint32_t dma_remaining;
+    volatile int32_t dma_status;
+    uint32_t dma_fallbacks;
+    #if defined(XENSIV_BGT60TRXX_PLATFORM_SPI_FIFO_READ_ASYNC)
+    xensiv_bgt60trxx_platform_xfer_done_t dma_done;
+    void* dma_done_arg;
+    #endif
+    #if defined(CY_RTOS_AWARE) || defined(COMPONENT_RTOS_AWARE)
+    cy_semaphore_t dma_sem;
+    #endif
+    #endif // defined(XENSIV_BGT60TRXX_MTB_USE_DMA)
+    #if defined(XENSIV_BGT60TRXX_PLATFORM_LOCK)
+    cy_semaphore_t lock;
+    #endif
 } xensiv_bgt60trxx_mtb_iface_t;
 
 
@@ -183,6 +228,109 @@ cy_rslt_t xensiv_bgt60trxx_mtb_interrupt_init(xensiv_bgt60trxx_mtb_t* obj,
  */
 void xensiv_bgt60trxx_mtb_free(xensiv_bgt60trxx_mtb_t* obj);
 
+#if defined(XENSIV_BGT60TRXX_MTB_USE_DMA) || defined(DOXYGEN)
+/** Enables the DMA-driven FIFO readout.
+ * Allocates two DMA channels serving the TX and RX FIFOs of the SCB used by the SPI HAL object.
+ * Once enabled, the FIFO payload of \ref xensiv_bgt60trxx_get_fifo_data is transferred by DMA and
+ * the CPU sleeps (or, if the RTOS_AWARE component is set or CY_RTOS_AWARE is defined, the
+ * calling thread blocks) until the transfer completes instead of polling the SPI block.
+ * Payloads longer than 256 samples are transferred in 2D segments of up to 65536 samples, each
+ * started by the DMA transfer complete interrupt of the previous one while the SPI CS stays
+ * asserted. A read whose DMA transfer cannot be configured is done by the SCB driver instead
+ * and counted, see \ref xensiv_bgt60trxx_mtb_dma_get_num_fallbacks.
+ * Only available if XENSIV_BGT60TRXX_MTB_USE_DMA is defined.
+ *
+ * Optionally, a pair of frame buffers can be passed to read frames without blocking: a frame
+ * is read into one buffer with \ref xensiv_bgt60trxx_mtb_dma_read_start while the application
+ * processes the other one obtained with \ref xensiv_bgt60trxx_mtb_dma_get_frame.
+ *
+ * @param[inout] obj           Pointer to the BGT60TRxx ModusToolbox(TM) object.
+ * @param[in]    intr_priority The priority for the DMA transfer complete interrupt.
+ * @param[in]    buf0          First frame buffer of \p num_samples samples. Can be NULL.
+ * @param[in]    buf1          Second frame buffer of \p num_samples samples. Can be NULL.
+ * @param[in]    num_samples   Number of samples of a frame.
+ * @return CY_RSLT_SUCCESS if the DMA channels were successfully allocated; else an error
+ * indicating what went wrong.
+ */
+cy_rslt_t xensiv_bgt60trxx_mtb_dma_init(xensiv_bgt60trxx_mtb_t* obj,
+                                        uint8_t intr_priority,
+                                        uint16_t* buf0,
+                                        uint16_t* buf1,
+                                        uint32_t num_samples);
+
+/** Starts reading a frame from the FIFO into a free frame buffer and returns without waiting
+ * for the payload transfer to complete. The SPI CS is released by the DMA transfer complete
+ * interrupt. Typically called after the FIFO interrupt signaled the availability of a frame.
+ * @note Any other access to the sensor waits until the transfer is complete.
+ *
+ * @param[inout] obj  Pointer to the BGT60TRxx ModusToolbox(TM) object.
+ * @return CY_RSLT_SUCCESS if the transfer was started; XENSIV_BGT60TRXX_RSLT_ERR_DMA_BUSY if both
+ * frame buffers are in use; else an error indicating what went wrong.
+ */
+cy_rslt_t xensiv_bgt60trxx_mtb_dma_read_start(xensiv_bgt60trxx_mtb_t* obj);
+
+/** Obtains a frame buffer completely filled by \ref xensiv_bgt60trxx_mtb_dma_read_start.
+ * The application owns the buffer until it is returned with
+ * \ref xensiv_bgt60trxx_mtb_dma_release_frame.
+ *
+ * @param[inout] obj  Pointer to the BGT60TRxx ModusToolbox(TM) object.
+ * @return Pointer to the frame buffer, NULL if no frame is available.
+ */
+uint16_t* xensiv_bgt60trxx_mtb_dma_get_frame(xensiv_bgt60trxx_mtb_t* obj);
+
+/** Returns a frame buffer obtained with \ref xensiv_bgt60trxx_mtb_dma_get_frame so it can be
+ * filled again.
+ *
+ * @param[inout] obj    Pointer to the BGT60TRxx ModusToolbox(TM) object.
+ * @param[in]    frame  Pointer to the frame buffer.
+ */
+void xensiv_bgt60trxx_mtb_dma_release_frame(xensiv_bgt60trxx_mtb_t* obj, const uint16_t* frame);
+
+/** Obtains the number of FIFO reads done by the blocking SCB driver instead of DMA, because the
+ * DMA channels could not be configured for the transfer. A read started with
+ * \ref xensiv_bgt60trxx_mtb_dma_read_start then returns after the payload was received.
+ *
+ * @param[in]    obj  Pointer to the BGT60TRxx ModusToolbox(TM) object.
+ * @return Number of FIFO reads without DMA since \ref xensiv_bgt60trxx_mtb_init.
+ */
+uint32_t xensiv_bgt60trxx_mtb_dma_get_num_fallbacks(const xensiv_bgt60trxx_mtb_t* obj);
+#endif // defined(XENSIV_BGT60TRXX_MTB_USE_DMA) || defined(DOXYGEN)
+
+#if defined(XENSIV_BGT60TRXX_PLATFORM_INLINE)
+/** \cond INTERNAL */
+#if defined(XENSIV_BGT60TRXX_MTB_USE_DMA)
+#error "XENSIV_BGT60TRXX_PLATFORM_INLINE is not supported with XENSIV_BGT60TRXX_MTB_USE_DMA"
+#endif
+
+/* Platform functions called for every register access, see xensiv_bgt60trxx_platform.h */
+static inline void xensiv_bgt60trxx_platform_spi_cs_set(const void* iface, bool val)
+{
+    CY_ASSERT(iface != NULL);
+
+    const xensiv_bgt60trxx_mtb_iface_t* mtb_iface = iface;
+
+    CY_ASSERT(mtb_iface->selpin != NC);
+
+    cyhal_gpio_write(mtb_iface->selpin, val);
+}
+
+
+static inline uint32_t xensiv_bgt60trxx_platform_word_reverse(uint32_t x)
+{
+    return __REV(x);
+}
+
+
+static inline void xensiv_bgt60trxx_platform_assert(bool expr)
+{
+    CY_ASSERT(expr);
+    (void)expr; /* make release build */
+}
+
+
+/** \endcond */
+#endif // defined(XENSIV_BGT60TRXX_PLATFORM_INLINE)
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,232 @@
+/***********************************************************************************************//**
+ * \file xensiv_bgt60trxx_multi.c
+ *
+ * \brief
+ * This file contains the implementation of the multi-sensor manager for several
+ * XENSIV(TM) BGT60TRxx 60GHz FMCW radar sensors sharing one SPI bus.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2022 Infineon Technologies AG
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#include <stddef.h>
+#include <string.h>
+
+#include "xensiv_bgt60trxx_multi.h"
+#include "xensiv_bgt60trxx_platform.h"
+
+/*******************************************************************************
+ * Function Prototypes
+ ********************************************************************************/
+static inline uint32_t get_time(void);
+
+static void set_deadline(xensiv_bgt60trxx_multi_t* multi, xensiv_bgt60trxx_multi_dev_t* md,
+                         uint32_t now, uint32_t fill);
+
+static bool is_before(const xensiv_bgt60trxx_multi_dev_t* md,
+                      const xensiv_bgt60trxx_multi_dev_t* other);
+
+/*******************************************************************************
+ * Public interface implementation
+ ********************************************************************************/
+void xensiv_bgt60trxx_multi_init(xensiv_bgt60trxx_multi_t* multi)
+{
+    xensiv_bgt60trxx_platform_assert(multi != NULL);
+
+    (void)memset(multi, 0, sizeof(*multi));
+    multi->stats_start = get_time();
+}
+
+
+uint32_t xensiv_bgt60trxx_multi_add(xensiv_bgt60trxx_multi_t* multi,
+                                    xensiv_bgt60trxx_frame_assembler_t* fa,
+                                    uint32_t sample_rate)
+{
+    xensiv_bgt60trxx_platform_assert(multi != NULL);
+    xensiv_bgt60trxx_platform_assert(fa != NULL);
+    xensiv_bgt60trxx_platform_assert(sample_rate > 0U);
+    xensiv_bgt60trxx_platform_assert(multi->num_devs < XENSIV_BGT60TRXX_MULTI_MAX_DEVICES);
+
+    uint32_t idx = multi->num_devs;
+    xensiv_bgt60trxx_multi_dev_t* md = &multi->devs[idx];
+
+    (void)memset(md, 0, sizeof(*md));
+    md->fa = fa;
+    md->fifo_samples = (uint32_t)xensiv_bgt60trxx_get_fifo_size(fa->dev) *
+                       XENSIV_BGT60TRXX_NUM_SAMPLES_FIFO_WORD;
+    md->sample_rate = sample_rate;
+    ++multi->num_devs;
+
+    return idx;
+}
+
+
+void xensiv_bgt60trxx_multi_irq(xensiv_bgt60trxx_multi_t* multi, uint32_t idx)
+{
+    xensiv_bgt60trxx_platform_assert(multi != NULL);
+    xensiv_bgt60trxx_platform_assert(idx < multi->num_devs);
+
+    ++multi->devs[idx].num_irqs;
+}
+
+
+int32_t xensiv_bgt60trxx_multi_poll(xensiv_bgt60trxx_multi_t* multi, uint32_t* idx)
+{
+    xensiv_bgt60trxx_platform_assert(multi != NULL);
+    xensiv_bgt60trxx_platform_assert(idx != NULL);
+
+    uint32_t now = get_time();
+    xensiv_bgt60trxx_multi_dev_t* next = NULL;
+
+    for (uint32_t i = 0U; i < multi->num_devs; ++i)
+    {
+        xensiv_bgt60trxx_multi_dev_t* md = &multi->devs[i];
+
+        /* the FIFO holds one chunk when the interrupt fires */
+        uint32_t num_irqs = md->num_irqs;
+        if (num_irqs != md->num_irqs_seen)
+        {
+            md->num_irqs_seen = num_irqs;
+            if (!md->pending)
+            {
+                md->pending = true;
+                set_deadline(multi, md, now, md->fa->chunk_size);
+            }
+        }
+
+        if (md->pending && ((next == NULL) || is_before(md, next)))
+        {
+            next = md;
+        }
+    }
+
+    int32_t status = XENSIV_BGT60TRXX_STATUS_OK;
+
+    if (next == NULL)
+    {
+        *idx = XENSIV_BGT60TRXX_MULTI_IDLE;
+    }
+    else
+    {
+        *idx = (uint32_t)(next - multi->devs);
+
+        status = xensiv_bgt60trxx_frame_assembler_read(next->fa);
+
+        if (XENSIV_BGT60TRXX_STATUS_OK == status)
+        {
+            ++next->stats.num_reads;
+
+            uint32_t fill;
+            status = xensiv_bgt60trxx_get_fifo_fill(next->fa->dev, &fill);
+            if (XENSIV_BGT60TRXX_STATUS_OK == status)
+            {
+                if (fill > next->stats.max_fill)
+                {
+                    next->stats.max_fill = fill;
+                }
+
+                /* the interrupt line stays high while a chunk is waiting */
+                next->pending = (fill >= next->fa->chunk_size);
+                if (next->pending)
+                {
+                    set_deadline(multi, next, get_time(), fill);
+                }
+            }
+        }
+        else if (XENSIV_BGT60TRXX_STATUS_BUFFER_FULL == status)
+        {
+            /* retry after the other pending sensors, the frames must be released first */
+            ++next->stats.num_stalled;
+            set_deadline(multi, next, get_time(), 0U);
+        }
+
+        if ((XENSIV_BGT60TRXX_STATUS_OK != status) &&
+            (XENSIV_BGT60TRXX_STATUS_BUFFER_FULL != status))
+        {
+            ++next->stats.num_errors;
+            next->pending = false;
+        }
+
+        next->stats.busy_us += get_time() - now;
+    }
+
+    return status;
+}
+
+
+void xensiv_bgt60trxx_multi_get_stats(const xensiv_bgt60trxx_multi_t* multi,
+                                      uint32_t idx,
+                                      xensiv_bgt60trxx_multi_stats_t* stats)
+{
+    xensiv_bgt60trxx_platform_assert(multi != NULL);
+    xensiv_bgt60trxx_platform_assert(idx < multi->num_devs);
+    xensiv_bgt60trxx_platform_assert(stats != NULL);
+
+    *stats = multi->devs[idx].stats;
+    stats->elapsed_us = get_time() - multi->stats_start;
+}
+
+
+void xensiv_bgt60trxx_multi_reset_stats(xensiv_bgt60trxx_multi_t* multi)
+{
+    xensiv_bgt60trxx_platform_assert(multi != NULL);
+
+    for (uint32_t i = 0U; i < multi->num_devs; ++i)
+    {
+        (void)memset(&multi->devs[i].stats, 0, sizeof(multi->devs[i].stats));
+    }
+
+    multi->stats_start = get_time();
+}
+
+
+/*******************************************************************************
+ * Static functions implementation
+ ********************************************************************************/
+static inline uint32_t get_time(void)
+{
+#if defined(XENSIV_BGT60TRXX_PLATFORM_GET_TIME)
+    return xensiv_bgt60trxx_platform_get_time_us();
+#else
+    return 0U;
+#endif
+}
+
+
+/* Sets the time the FIFO overflows with the given filling level. Without time measurement the
+   sensor is queued behind the sensors already pending. A BUFFER_FULL retry passes fill 0, so
+   that sensors with data waiting in the FIFO go first. */
+static void set_deadline(xensiv_bgt60trxx_multi_t* multi, xensiv_bgt60trxx_multi_dev_t* md,
+                         uint32_t now, uint32_t fill)
+{
+#if defined(XENSIV_BGT60TRXX_PLATFORM_GET_TIME)
+    (void)multi;
+    uint32_t space = (fill < md->fifo_samples) ? (md->fifo_samples - fill) : 0U;
+    md->deadline = now + (uint32_t)(((uint64_t)space * 1000000U) / md->sample_rate);
+#else
+    (void)now;
+    (void)fill;
+    md->deadline = ++multi->seq;
+#endif
+}
+
+
+static bool is_before(const xensiv_bgt60trxx_multi_dev_t* md,
+                      const xensiv_bgt60trxx_multi_dev_t* other)
+{
+    return ((int32_t)(md->deadline - other->deadline) < 0);
+}
@@ -0,0 +1,197 @@
+/***********************************************************************************************//**
+ * \file xensiv_bgt60trxx_multi.h
+ *
+ * \brief
+ * This file contains the declarations of the multi-sensor manager for several
+ * XENSIV(TM) BGT60TRxx 60GHz FMCW radar sensors sharing one SPI bus.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2022 Infineon Technologies AG
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#ifndef XENSIV_BGT60TRXX_MULTI_H_
+#define XENSIV_BGT60TRXX_MULTI_H_
+
+#include "xensiv_bgt60trxx_frame.h"
+
+/**
+ * \addtogroup group_board_libs_multi XENSIV(TM) BGT60TRxx Multi-Sensor Manager
+ * \{
+ * Serializes the FIFO reads of several sensors sharing one SPI bus, each with its own chip
+ * select, and schedules them so that no FIFO overflows.
+ *
+ * Each sensor is a \ref xensiv_bgt60trxx_t with its own iface: the platform selects the chip
+ * select line from the iface, e.g. several xensiv_bgt60trxx_mtb_iface_t pointing to the same
+ * cyhal_spi_t with different selpin, or one spidev device per chip select on Linux. The FIFO of
+ * each sensor is read in chunks by a \ref xensiv_bgt60trxx_frame_assembler_t added to the
+ * manager with \ref xensiv_bgt60trxx_multi_add.
+ *
+ * The FIFO interrupt of each sensor only calls \ref xensiv_bgt60trxx_multi_irq. A single context
+ * calls \ref xensiv_bgt60trxx_multi_poll, which reads one chunk of the most urgent sensor per
+ * call, and does all other accesses to the sensors. The urgency is the time left until the FIFO
+ * overflows, estimated from the free space of the FIFO and the sample rate of the sensor:
+ * - A sensor becomes pending when its interrupt is seen by \ref xensiv_bgt60trxx_multi_poll. Its
+ *   FIFO then holds one chunk (the FIFO compare reference set by the frame assembler).
+ * - After reading a chunk the FIFO filling level is read. If at least one more chunk is waiting,
+ *   the sensor stays pending, with the time left computed from the filling level. The interrupt
+ *   does not fire again in that case since the interrupt line has not been released.
+ * - The pending sensor with the earliest overflow is read first.
+ * Time is measured with xensiv_bgt60trxx_platform_get_time_us, which requires
+ * XENSIV_BGT60TRXX_PLATFORM_GET_TIME. Without it, the pending sensors are read in the order their
+ * interrupts were seen.
+ *
+ * The manager counts per sensor the chunks read and the time spent on the bus reading them, to
+ * obtain the bus utilization of each sensor, see \ref xensiv_bgt60trxx_multi_get_stats.
+ */
+
+/************************************** Macros *******************************************/
+
+/** Maximum number of sensors of a manager */
+#ifndef XENSIV_BGT60TRXX_MULTI_MAX_DEVICES
+#define XENSIV_BGT60TRXX_MULTI_MAX_DEVICES              (4U)
+#endif
+
+/** Index returned by \ref xensiv_bgt60trxx_multi_poll if no sensor is pending */
+#define XENSIV_BGT60TRXX_MULTI_IDLE                     (0xFFFFFFFFU)
+
+/******************************** Type definitions ****************************************/
+
+/** Statistics of a sensor of the manager */
+typedef struct
+{
+    uint32_t num_reads;         /**< Chunks read */
+    uint32_t num_stalled;       /**< Chunks not read because the ring buffer was full */
+    uint32_t num_errors;        /**< Reads that failed */
+    uint32_t max_fill;          /**< Largest FIFO filling level after a read, in samples */
+    uint32_t busy_us;           /**< Time spent on the bus for the sensor */
+    uint32_t elapsed_us;        /**< Time since the statistics were reset */
+} xensiv_bgt60trxx_multi_stats_t;
+
+/**
+ * Structure holding a sensor of the manager.
+ *
+ * Application code should not rely on the specific content of this struct.
+ * They are considered an implementation detail which is subject to change
+ * between platforms and/or library releases.
+ */
+typedef struct
+{
+    xensiv_bgt60trxx_frame_assembler_t* fa;
+    uint32_t fifo_samples;             /* FIFO size in samples */
+    uint32_t sample_rate;              /* samples per second written to the FIFO */
+    volatile uint32_t num_irqs;        /* written by the interrupt context */
+    uint32_t num_irqs_seen;
+    bool pending;
+    uint32_t deadline;                 /* time of the FIFO overflow, or order of the interrupt */
+    xensiv_bgt60trxx_multi_stats_t stats;
+} xensiv_bgt60trxx_multi_dev_t;
+
+/**
+ * Structure holding the multi-sensor manager.
+ *
+ * Application code should not rely on the specific content of this struct.
+ * They are considered an implementation detail which is subject to change
+ * between platforms and/or library releases.
+ */
+typedef struct
+{
+    xensiv_bgt60trxx_multi_dev_t devs[XENSIV_BGT60TRXX_MULTI_MAX_DEVICES];
+    uint32_t num_devs;
+    uint32_t seq;                      /* interrupt order without time measurement */
+    uint32_t stats_start;
+} xensiv_bgt60trxx_multi_t;
+
+/******************************* Function prototypes *************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Initializes the multi-sensor manager without sensors.
+ *
+ * @param[out] multi Pointer to the multi-sensor manager object.
+ */
+void xensiv_bgt60trxx_multi_init(xensiv_bgt60trxx_multi_t* multi);
+
+/**
+ * @brief Adds a sensor to the manager.
+ * @note Call before starting the frame generation of the sensor.
+ *
+ * @param[inout] multi Pointer to the multi-sensor manager object.
+ * @param[in] fa Pointer to the initialized frame assembler reading the FIFO of the sensor.
+ * @param[in] sample_rate Number of samples per second written to the FIFO while chirps are
+ * generated, i.e. the ADC sample rate times the number of active RX antennas.
+ * @return Index of the sensor, passed to \ref xensiv_bgt60trxx_multi_irq.
+ */
+uint32_t xensiv_bgt60trxx_multi_add(xensiv_bgt60trxx_multi_t* multi,
+                                    xensiv_bgt60trxx_frame_assembler_t* fa,
+                                    uint32_t sample_rate);
+
+/**
+ * @brief Signals the FIFO interrupt of a sensor.
+ * Call from the FIFO interrupt handler of the sensor. Does not access the bus.
+ *
+ * @param[inout] multi Pointer to the multi-sensor manager object.
+ * @param[in] idx Index of the sensor.
+ */
+void xensiv_bgt60trxx_multi_irq(xensiv_bgt60trxx_multi_t* multi, uint32_t idx);
+
+/**
+ * @brief Reads one chunk from the FIFO of the most urgent pending sensor.
+ * Call repeatedly until \p idx is \ref XENSIV_BGT60TRXX_MULTI_IDLE, then get and release the
+ * assembled frames of each sensor and wait for the next interrupt.
+ *
+ * @param[inout] multi Pointer to the multi-sensor manager object.
+ * @param[out] idx Index of the sensor read, \ref XENSIV_BGT60TRXX_MULTI_IDLE if no sensor is
+ * pending.
+ * @return XENSIV_BGT60TRXX_STATUS_OK if the chunk was read or no sensor is pending; else the
+ * error of \ref xensiv_bgt60trxx_frame_assembler_read or of the FIFO filling level read.
+ * After XENSIV_BGT60TRXX_STATUS_BUFFER_FULL the sensor stays pending, but the other pending
+ * sensors are read first. After other errors the sensor is pending again with its next
+ * interrupt, i.e. once the FIFO was reset: enable the recovery of the frame assembler (see
+ * \ref xensiv_bgt60trxx_frame_assembler_enable_recovery) to handle FIFO overflows.
+ */
+int32_t xensiv_bgt60trxx_multi_poll(xensiv_bgt60trxx_multi_t* multi, uint32_t* idx);
+
+/**
+ * @brief Obtains the statistics of a sensor.
+ * The bus utilization of the sensor is busy_us / elapsed_us. Both are zero without
+ * XENSIV_BGT60TRXX_PLATFORM_GET_TIME.
+ *
+ * @param[in] multi Pointer to the multi-sensor manager object.
+ * @param[in] idx Index of the sensor.
+ * @param[out] stats Pointer to the statistics.
+ */
+void xensiv_bgt60trxx_multi_get_stats(const xensiv_bgt60trxx_multi_t* multi,
+                                      uint32_t idx,
+                                      xensiv_bgt60trxx_multi_stats_t* stats);
+
+/**
+ * @brief Resets the statistics of all sensors.
+ *
+ * @param[inout] multi Pointer to the multi-sensor manager object.
+ */
+void xensiv_bgt60trxx_multi_reset_stats(xensiv_bgt60trxx_multi_t* multi);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** \} group_board_libs_multi */
+
+#endif // ifndef XENSIV_BGT60TRXX_MULTI_H_
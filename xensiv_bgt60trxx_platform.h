@@ -34,6 +34,15 @@
  * declared in this file. See the example implementation in xensiv_bgt60trxx_mtb.c using the
  * PSoC&trade; 6 HAL.
  *
+ * Every register access calls \ref xensiv_bgt60trxx_platform_word_reverse,
+ * \ref xensiv_bgt60trxx_platform_spi_cs_set twice and \ref xensiv_bgt60trxx_platform_assert.
+ * To save these calls on small cores, a platform can define the three functions as static inline
+ * functions in a header: define XENSIV_BGT60TRXX_PLATFORM_INLINE for all library sources as the
+ * name of that header, e.g. -DXENSIV_BGT60TRXX_PLATFORM_INLINE='"xensiv_bgt60trxx_mtb.h"'. The
+ * header is then included at the end of this file instead of the declarations of the three
+ * functions. It may include this file itself, as long as the definitions follow the types they
+ * use. xensiv_bgt60trxx_mtb.h (without XENSIV_BGT60TRXX_MTB_USE_DMA) and
+ * xensiv_bgt60trxx_linux.h provide them; the simulator and replay platforms do not.
  */
 
 #include <stdint.h>
@@ -51,6 +60,7 @@ extern "C" {
  */
 void xensiv_bgt60trxx_platform_rst_set(const void* iface, bool val);
 
+#if !defined(XENSIV_BGT60TRXX_PLATFORM_INLINE)
 /**
  * @brief Platform-specific function that that sets the output value of the SPI CS pin.
  *
@@ -59,6 +69,8 @@ void xensiv_bgt60trxx_platform_rst_set(const void* iface, bool val);
  */
 void xensiv_bgt60trxx_platform_spi_cs_set(const void* iface, bool val);
 
+#endif // !defined(XENSIV_BGT60TRXX_PLATFORM_INLINE)
+
 /**
  * @brief Platform-specific function that performs a SPI write/read transfer to
  * the register file of the sensor.
@@ -66,6 +78,8 @@ void xensiv_bgt60trxx_platform_spi_cs_set(const void* iface, bool val);
  * If the data that will be received is not important, pass NULL as rx_data.
  * If the data that will be transmitted is not important, pass NULL as tx_data.
  * Note that passing NULL as rxBuffer and txBuffer are considered invalid cases.
+ * tx_data and rx_data may point to the same buffer, each byte is transmitted before the byte
+ * at the same position is received.
  *
  * @param[in] iface Platform SPI interface object.
  * @param[in] tx_data The pointer of the buffer with data to transmit.
@@ -96,6 +110,61 @@ int32_t xensiv_bgt60trxx_platform_spi_fifo_read(void* iface,
                                                 uint16_t* rx_data,
                                                 uint32_t len);
 
+/**
+ * @brief Optional platform-specific function that performs the complete SPI burst read of
+ * the sensor FIFO as a single transaction: the burst mode command header followed by the
+ * FIFO payload, with the SPI CS asserted for the whole transfer.
+ * Only required if XENSIV_BGT60TRXX_PLATFORM_SPI_BURST_READ is defined. In that case the driver
+ * does not toggle CS around the FIFO read and checks the GSR0 status after the transfer.
+ *
+ * @param[in] iface Platform SPI interface object.
+ * @param[in] tx_header The pointer to the burst mode command (4 bytes).
+ * @param[out] rx_header The pointer to the buffer to store the bytes received during the
+ * header (4 bytes). The first byte contains the GSR0 status.
+ * @param[out] rx_data The pointer to the buffer to store the received data.
+ * @param[in] len The number of FIFO data elements of 12bits to receive.
+ * @return XENSIV_BGT60TRXX_STATUS_OK if the read is completed without errors,
+ * otherwise returns XENSIV_BGT60TRXX_STATUS_COM_ERROR.
+ */
+int32_t xensiv_bgt60trxx_platform_spi_burst_read(void* iface,
+                                                 uint8_t* tx_header,
+                                                 uint8_t* rx_header,
+                                                 uint16_t* rx_data,
+                                                 uint32_t len);
+
+/**
+ * @brief Completion handler passed to \ref xensiv_bgt60trxx_platform_spi_fifo_read_async.
+ *
+ * @param[in] arg The argument passed to xensiv_bgt60trxx_platform_spi_fifo_read_async.
+ * @param[in] status XENSIV_BGT60TRXX_STATUS_OK if the read was completed without errors,
+ * otherwise XENSIV_BGT60TRXX_STATUS_COM_ERROR.
+ */
+typedef void (* xensiv_bgt60trxx_platform_xfer_done_t)(void* arg, int32_t status);
+
+/**
+ * @brief Optional platform-specific function that starts the SPI read of the FIFO payload
+ * (see \ref xensiv_bgt60trxx_platform_spi_fifo_read) and returns without waiting for it to
+ * complete, e.g. using DMA.
+ * Only required if XENSIV_BGT60TRXX_PLATFORM_SPI_FIFO_READ_ASYNC is defined and
+ * XENSIV_BGT60TRXX_PLATFORM_SPI_BURST_READ is not. The SPI CS is asserted when the function is
+ * called and is released by the driver from the completion handler.
+ * If the read was started, \p done must be called exactly once, either from the transfer
+ * complete interrupt or before returning if the platform cannot read asynchronously.
+ *
+ * @param[in] iface Platform SPI interface object.
+ * @param[in] rx_data The pointer to the buffer to store the received data.
+ * @param[in] len The number of FIFO data elements of 12bits to receive.
+ * @param[in] done Completion handler.
+ * @param[in] arg Argument passed to \p done.
+ * @return XENSIV_BGT60TRXX_STATUS_OK if the read was started, otherwise returns
+ * XENSIV_BGT60TRXX_STATUS_COM_ERROR and \p done is not called.
+ */
+int32_t xensiv_bgt60trxx_platform_spi_fifo_read_async(void* iface,
+                                                      uint16_t* rx_data,
+                                                      uint32_t len,
+                                                      xensiv_bgt60trxx_platform_xfer_done_t done,
+                                                      void* arg);
+
 /**
  * @brief Platform-specific function that waits for a specified time period in milliseconds.
  *
@@ -103,6 +172,66 @@ int32_t xensiv_bgt60trxx_platform_spi_fifo_read(void* iface,
  */
 void xensiv_bgt60trxx_platform_delay(uint32_t ms);
 
+/**
+ * @brief Optional platform-specific function that waits for a specified time period in
+ * microseconds.
+ * Only required if XENSIV_BGT60TRXX_PLATFORM_DELAY_US is defined. In that case the driver uses it
+ * for the reset pulse and the short waits while polling the sensor; otherwise these waits are
+ * rounded up to milliseconds and done with \ref xensiv_bgt60trxx_platform_delay.
+ *
+ * @param[in] us Number of microseconds to wait for.
+ */
+void xensiv_bgt60trxx_platform_delay_us(uint32_t us);
+
+/**
+ * @brief Optional platform-specific function that returns the time of a free-running monotonic
+ * clock in microseconds, wrapping around after 2^32 microseconds.
+ * Only required if XENSIV_BGT60TRXX_PLATFORM_GET_TIME is defined. In that case the frame
+ * assembler time stamps the frames it receives.
+ *
+ * @return Current time in microseconds.
+ */
+uint32_t xensiv_bgt60trxx_platform_get_time_us(void);
+
+/**
+ * @brief Platform-specific function that orders the memory accesses before the call against the
+ * ones after it, for the compiler and the CPU.
+ * Only required by the frame assembler, which publishes the frames read in one context (e.g. the
+ * FIFO interrupt) to another context through counters. On a single core Cortex-M a data memory
+ * barrier (__DMB) is sufficient, on an application processor use a full fence, e.g.
+ * __atomic_thread_fence(__ATOMIC_SEQ_CST) with GCC.
+ */
+void xensiv_bgt60trxx_platform_memory_barrier(void);
+
+/**
+ * @brief Optional platform-specific function that acquires the lock of the SPI interface,
+ * waiting until it is free.
+ * Only required if XENSIV_BGT60TRXX_PLATFORM_LOCK is defined. In that case the driver holds the
+ * lock for each SPI transaction framed by the SPI CS and for each read-modify-write of a
+ * register, so that the driver functions can be called for the same sensor from several threads.
+ * The lock is never acquired recursively, a non-recursive mutex is sufficient. Sensors sharing
+ * an SPI bus with driver controlled chip selects may share one lock.
+ * The lock is not held while waiting for the sensor (polling delays), nor while calling the
+ * callback of \ref xensiv_bgt60trxx_get_fifo_data_async.
+ *
+ * @param[in] iface Platform SPI interface object.
+ */
+void xensiv_bgt60trxx_platform_lock(void* iface);
+
+/**
+ * @brief Optional platform-specific function that releases the lock acquired with
+ * \ref xensiv_bgt60trxx_platform_lock.
+ * Only required if XENSIV_BGT60TRXX_PLATFORM_LOCK is defined. If
+ * XENSIV_BGT60TRXX_PLATFORM_SPI_FIFO_READ_ASYNC is defined as well, the lock acquired for an
+ * asynchronous FIFO read is released from the completion handler of
+ * \ref xensiv_bgt60trxx_platform_spi_fifo_read_async, i.e. possibly from an interrupt and not by
+ * the thread that acquired it: use e.g. a binary semaphore instead of a mutex.
+ *
+ * @param[in] iface Platform SPI interface object.
+ */
+void xensiv_bgt60trxx_platform_unlock(void* iface);
+
+#if !defined(XENSIV_BGT60TRXX_PLATFORM_INLINE)
 /**
  * @brief Platform-specific function to reverse the byte order (32 bits).
  * A sample implementation would look like
@@ -126,10 +255,16 @@ uint32_t xensiv_bgt60trxx_platform_word_reverse(uint32_t x);
  */
 void xensiv_bgt60trxx_platform_assert(bool expr);
 
+#endif // !defined(XENSIV_BGT60TRXX_PLATFORM_INLINE)
+
 #ifdef __cplusplus
 }
 #endif
 
+#if defined(XENSIV_BGT60TRXX_PLATFORM_INLINE)
+#include XENSIV_BGT60TRXX_PLATFORM_INLINE
+#endif
+
 /** \} group_board_libs_platform */
 
 #endif // ifndef XENSIV_BGT60TRXX_PLATFORM_H_
@@ -0,0 +1,357 @@
+/***********************************************************************************************//**
+ * \file xensiv_bgt60trxx_range.c
+ *
+ * \brief
+ * This file contains the implementation of the range processing functions
+ * for the XENSIV(TM) BGT60TRxx 60GHz FMCW radar sensors.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2022 Infineon Technologies AG
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#include <math.h>
+#include <stddef.h>
+
+#include "xensiv_bgt60trxx_range.h"
+#include "xensiv_bgt60trxx_cube.h"
+#include "xensiv_bgt60trxx_platform.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define XENSIV_BGT60TRXX_RANGE_Q15_ONE              (32767)
+#define XENSIV_BGT60TRXX_RANGE_Q15_ROUND            (0x4000)
+#define XENSIV_BGT60TRXX_RANGE_Q15_SHIFT            (15)
+
+/* Headroom left by the fixed point input scaling: the mean-free 13-bit samples are shifted by
+ * two bits, so that the complex FFT input magnitude stays below 1.0 */
+#define XENSIV_BGT60TRXX_RANGE_Q15_INPUT_SHIFT      (2)
+
+/* Offsets in the table: window, twiddles of the fft_size / 2 point complex FFT, twiddles
+ * W_N^k, k < fft_size / 4, of the split into the real-input spectrum */
+#define XENSIV_BGT60TRXX_RANGE_FFT_TW(num_samples)      (num_samples)
+#define XENSIV_BGT60TRXX_RANGE_SPLIT_TW(num_samples, m) \
+    ((num_samples) + XENSIV_BGT60TRXX_FFT_TWIDDLE_LEN(m))
+
+
+/*******************************************************************************
+ * Function Prototypes
+ ********************************************************************************/
+static void range_init(xensiv_bgt60trxx_range_t* range,
+                       uint32_t num_samples,
+                       uint32_t fft_size,
+                       xensiv_bgt60trxx_window_t window,
+                       float* table_f32,
+                       int16_t* table_q15);
+
+static void split_f32(float* data, const float* twiddle, uint32_t m);
+
+static inline int32_t mul_q15(int32_t a, int32_t b);
+
+static void split_q15(int16_t* data, const int16_t* twiddle, uint32_t m);
+
+/*******************************************************************************
+ * Public interface implementation
+ ********************************************************************************/
+void xensiv_bgt60trxx_range_init_f32(xensiv_bgt60trxx_range_t* range,
+                                     uint32_t num_samples,
+                                     uint32_t fft_size,
+                                     xensiv_bgt60trxx_window_t window,
+                                     float* table)
+{
+    xensiv_bgt60trxx_platform_assert(table != NULL);
+
+    range_init(range, num_samples, fft_size, window, table, NULL);
+}
+
+
+void xensiv_bgt60trxx_range_init_q15(xensiv_bgt60trxx_range_t* range,
+                                     uint32_t num_samples,
+                                     uint32_t fft_size,
+                                     xensiv_bgt60trxx_window_t window,
+                                     int16_t* table)
+{
+    xensiv_bgt60trxx_platform_assert(table != NULL);
+
+    range_init(range, num_samples, fft_size, window, NULL, table);
+}
+
+
+void xensiv_bgt60trxx_range_chirp_f32(const xensiv_bgt60trxx_range_t* range,
+                                      const float* in,
+                                      float* out)
+{
+    xensiv_bgt60trxx_platform_assert(range != NULL);
+    xensiv_bgt60trxx_platform_assert(in != NULL);
+    xensiv_bgt60trxx_platform_assert(out != NULL);
+
+    const float* window = (const float*)range->table;
+    uint32_t num_samples = range->num_samples;
+    uint32_t m = range->fft_size / 2U;
+
+    float sum = 0.0f;
+    for (uint32_t n = 0U; n < num_samples; ++n)
+    {
+        sum += in[n];
+    }
+    float mean = sum / (float)num_samples;
+
+    /* pack even samples into the real and odd samples into the imaginary part of an m point
+     * complex sequence, in bit reversed order */
+    uint32_t r = 0U;
+    for (uint32_t k = 0U; k < m; ++k)
+    {
+        uint32_t n = 2U * k;
+        float re = 0.0f;
+        float im = 0.0f;
+
+        if ((n + 1U) < num_samples)
+        {
+            re = (in[n] - mean) * window[n];
+            im = (in[n + 1U] - mean) * window[n + 1U];
+        }
+        else if (n < num_samples)
+        {
+            re = (in[n] - mean) * window[n];
+        }
+        else
+        {
+            /* zero padding */
+        }
+
+        out[2U * r] = re;
+        out[(2U * r) + 1U] = im;
+        r = xensiv_bgt60trxx_fft_bitrev_next(r, m);
+    }
+
+    xensiv_bgt60trxx_fft_f32(out, &window[XENSIV_BGT60TRXX_RANGE_FFT_TW(num_samples)], m);
+    split_f32(out, &window[XENSIV_BGT60TRXX_RANGE_SPLIT_TW(num_samples, m)], m);
+}
+
+
+void xensiv_bgt60trxx_range_chirp_q15(const xensiv_bgt60trxx_range_t* range,
+                                      const int16_t* in,
+                                      int16_t* out)
+{
+    xensiv_bgt60trxx_platform_assert(range != NULL);
+    xensiv_bgt60trxx_platform_assert(in != NULL);
+    xensiv_bgt60trxx_platform_assert(out != NULL);
+
+    const int16_t* window = (const int16_t*)range->table;
+    uint32_t num_samples = range->num_samples;
+    uint32_t m = range->fft_size / 2U;
+
+    int32_t sum = 0;
+    for (uint32_t n = 0U; n < num_samples; ++n)
+    {
+        sum += in[n];
+    }
+    int32_t mean = sum / (int32_t)num_samples;
+
+    uint32_t r = 0U;
+    for (uint32_t k = 0U; k < m; ++k)
+    {
+        int32_t val[2] = { 0, 0 };
+
+        for (uint32_t i = 0U; i < 2U; ++i)
+        {
+            uint32_t n = (2U * k) + i;
+            if (n < num_samples)
+            {
+                val[i] = ((((int32_t)in[n] - mean) * (1 << XENSIV_BGT60TRXX_RANGE_Q15_INPUT_SHIFT) *
+                           window[n]) + XENSIV_BGT60TRXX_RANGE_Q15_ROUND) >>
+                         XENSIV_BGT60TRXX_RANGE_Q15_SHIFT;
+            }
+        }
+
+        out[2U * r] = (int16_t)val[0];
+        out[(2U * r) + 1U] = (int16_t)val[1];
+        r = xensiv_bgt60trxx_fft_bitrev_next(r, m);
+    }
+
+    xensiv_bgt60trxx_fft_q15(out, &window[XENSIV_BGT60TRXX_RANGE_FFT_TW(num_samples)], m);
+    split_q15(out, &window[XENSIV_BGT60TRXX_RANGE_SPLIT_TW(num_samples, m)], m);
+}
+
+
+void xensiv_bgt60trxx_range_cube_f32(const xensiv_bgt60trxx_range_t* range,
+                                     const xensiv_bgt60trxx_frame_geometry_t* geometry,
+                                     const float* cube,
+                                     float* out)
+{
+    xensiv_bgt60trxx_platform_assert(range != NULL);
+    xensiv_bgt60trxx_platform_assert(geometry != NULL);
+    xensiv_bgt60trxx_platform_assert(geometry->num_samples_per_chirp == range->num_samples);
+
+    uint32_t stride = xensiv_bgt60trxx_cube_stride(geometry, (uint32_t)sizeof(float));
+    uint32_t num_rows = geometry->num_rx_antennas * geometry->num_chirps_per_frame;
+
+    for (uint32_t row = 0U; row < num_rows; ++row)
+    {
+        xensiv_bgt60trxx_range_chirp_f32(range, &cube[row * stride], &out[row * range->fft_size]);
+    }
+}
+
+
+void xensiv_bgt60trxx_range_cube_q15(const xensiv_bgt60trxx_range_t* range,
+                                     const xensiv_bgt60trxx_frame_geometry_t* geometry,
+                                     const int16_t* cube,
+                                     int16_t* out)
+{
+    xensiv_bgt60trxx_platform_assert(range != NULL);
+    xensiv_bgt60trxx_platform_assert(geometry != NULL);
+    xensiv_bgt60trxx_platform_assert(geometry->num_samples_per_chirp == range->num_samples);
+
+    uint32_t stride = xensiv_bgt60trxx_cube_stride(geometry, (uint32_t)sizeof(int16_t));
+    uint32_t num_rows = geometry->num_rx_antennas * geometry->num_chirps_per_frame;
+
+    for (uint32_t row = 0U; row < num_rows; ++row)
+    {
+        xensiv_bgt60trxx_range_chirp_q15(range, &cube[row * stride], &out[row * range->fft_size]);
+    }
+}
+
+
+/*******************************************************************************
+ * Static functions implementation
+ ********************************************************************************/
+static void range_init(xensiv_bgt60trxx_range_t* range,
+                       uint32_t num_samples,
+                       uint32_t fft_size,
+                       xensiv_bgt60trxx_window_t window,
+                       float* table_f32,
+                       int16_t* table_q15)
+{
+    xensiv_bgt60trxx_platform_assert(range != NULL);
+    xensiv_bgt60trxx_platform_assert((fft_size >= XENSIV_BGT60TRXX_RANGE_FFT_SIZE_MIN) &&
+                                     (fft_size <= XENSIV_BGT60TRXX_RANGE_FFT_SIZE_MAX) &&
+                                     ((fft_size & (fft_size - 1U)) == 0U));
+    xensiv_bgt60trxx_platform_assert((num_samples > 0U) && (num_samples <= fft_size));
+
+    uint32_t m = fft_size / 2U;
+
+    range->num_samples = num_samples;
+    range->fft_size = fft_size;
+    range->table = (table_f32 != NULL) ? (const void*)table_f32 : (const void*)table_q15;
+
+    /* the float window includes the 1 / fft_size output scaling and compensates the factor two
+     * of the split, which the float path does not divide out */
+    for (uint32_t n = 0U; n < num_samples; ++n)
+    {
+        double w = xensiv_bgt60trxx_window_value(window, n, num_samples);
+
+        if (table_f32 != NULL)
+        {
+            table_f32[n] = (float)(w / (2.0 * (double)fft_size));
+        }
+        else
+        {
+            table_q15[n] = (int16_t)lround(w * XENSIV_BGT60TRXX_RANGE_Q15_ONE);
+        }
+    }
+
+    uint32_t fft_tw = XENSIV_BGT60TRXX_RANGE_FFT_TW(num_samples);
+    uint32_t split_tw = XENSIV_BGT60TRXX_RANGE_SPLIT_TW(num_samples, m);
+
+    if (table_f32 != NULL)
+    {
+        xensiv_bgt60trxx_fft_init_f32(&table_f32[fft_tw], m);
+        xensiv_bgt60trxx_fft_twiddles_f32(&table_f32[split_tw], fft_size / 4U, fft_size);
+    }
+    else
+    {
+        xensiv_bgt60trxx_fft_init_q15(&table_q15[fft_tw], m);
+        xensiv_bgt60trxx_fft_twiddles_q15(&table_q15[split_tw], fft_size / 4U, fft_size);
+    }
+}
+
+
+/* Converts the FFT of the packed sequence into the first m bins of the real-input spectrum:
+ * X[k] = E[k] + W_N^k * O[k], E[k] = Z[k] + conj(Z[m - k]), O[k] = (Z[k] - conj(Z[m - k])) / i
+ * and X[m - k] = conj(E[k] - W_N^k * O[k]). The factor two is compensated by the window. */
+static void split_f32(float* data, const float* twiddle, uint32_t m)
+{
+    /* DC, the Nyquist bin Re(Z[0]) - Im(Z[0]) is dropped */
+    data[0] = 2.0f * (data[0] + data[1]);
+    data[1] = 0.0f;
+
+    for (uint32_t k = 1U; k < (m / 2U); ++k)
+    {
+        uint32_t mk = m - k;
+        float ar = data[2U * k];
+        float ai = data[(2U * k) + 1U];
+        float br = data[2U * mk];
+        float bi = -data[(2U * mk) + 1U];
+        float er = ar + br;
+        float ei = ai + bi;
+        float o_re = ai - bi;
+        float o_im = br - ar;
+        float wr = twiddle[2U * k];
+        float wi = twiddle[(2U * k) + 1U];
+        float tr = (wr * o_re) - (wi * o_im);
+        float ti = (wr * o_im) + (wi * o_re);
+
+        data[2U * k] = er + tr;
+        data[(2U * k) + 1U] = ei + ti;
+        data[2U * mk] = er - tr;
+        data[(2U * mk) + 1U] = ti - ei;
+    }
+
+    /* k = m / 2: W_N^k = -i, X = 2 * conj(Z) */
+    data[m] = 2.0f * data[m];
+    data[m + 1U] = -2.0f * data[m + 1U];
+}
+
+
+/* Q15 product of a value and a twiddle factor component, rounded */
+static inline int32_t mul_q15(int32_t a, int32_t b)
+{
+    return ((a * b) + XENSIV_BGT60TRXX_RANGE_Q15_ROUND) >> XENSIV_BGT60TRXX_RANGE_Q15_SHIFT;
+}
+
+
+/* Same as split_f32, scaled by 1/2 */
+static void split_q15(int16_t* data, const int16_t* twiddle, uint32_t m)
+{
+    data[0] = (int16_t)(((int32_t)data[0] + data[1]) >> 1);
+    data[1] = 0;
+
+    for (uint32_t k = 1U; k < (m / 2U); ++k)
+    {
+        uint32_t mk = m - k;
+        int32_t ar = data[2U * k];
+        int32_t ai = data[(2U * k) + 1U];
+        int32_t br = data[2U * mk];
+        int32_t bi = -(int32_t)data[(2U * mk) + 1U];
+        int32_t er = (ar + br) >> 1;
+        int32_t ei = (ai + bi) >> 1;
+        int32_t o_re = (ai - bi) >> 1;
+        int32_t o_im = (br - ar) >> 1;
+        int32_t wr = twiddle[2U * k];
+        int32_t wi = twiddle[(2U * k) + 1U];
+        int32_t tr = mul_q15(wr, o_re) - mul_q15(wi, o_im);
+        int32_t ti = mul_q15(wr, o_im) + mul_q15(wi, o_re);
+
+        data[2U * k] = (int16_t)((er + tr) >> 1);
+        data[(2U * k) + 1U] = (int16_t)((ei + ti) >> 1);
+        data[2U * mk] = (int16_t)((er - tr) >> 1);
+        data[(2U * mk) + 1U] = (int16_t)((ti - ei) >> 1);
+    }
+
+    data[m] = (int16_t)(data[m] >> 1);
+    data[m + 1U] = (int16_t)(-data[m + 1U] >> 1);
+}
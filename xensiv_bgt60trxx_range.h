@@ -0,0 +1,184 @@
+/***********************************************************************************************//**
+ * \file xensiv_bgt60trxx_range.h
+ *
+ * \brief
+ * This file contains the declarations of the range processing functions
+ * for the XENSIV(TM) BGT60TRxx 60GHz FMCW radar sensors.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2022 Infineon Technologies AG
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#ifndef XENSIV_BGT60TRXX_RANGE_H_
+#define XENSIV_BGT60TRXX_RANGE_H_
+
+#include "xensiv_bgt60trxx.h"
+#include "xensiv_bgt60trxx_fft.h"
+
+/**
+ * \addtogroup group_board_libs_range XENSIV(TM) BGT60TRxx Range Processing
+ * \{
+ * Computes the range spectrum of each chirp of a radar cube (see \ref group_board_libs_cube):
+ * the mean of the chirp is removed, the samples are windowed, zero-padded to the FFT size and
+ * transformed with a real-input FFT. The result holds fft_size / 2 complex range bins, real and
+ * imaginary parts interleaved, from DC up to (excluding) the Nyquist frequency.
+ *
+ * The window and the twiddle factors are computed once by \ref xensiv_bgt60trxx_range_init_f32
+ * or \ref xensiv_bgt60trxx_range_init_q15 into a caller-provided table of
+ * \ref XENSIV_BGT60TRXX_RANGE_TABLE_LEN elements.
+ *
+ * Two implementations are provided:
+ * - float, scaled by 1 / fft_size, vectorized as described in \ref group_board_libs_fft.
+ * - fixed point for MCUs without floating point unit, working on the int16_t cube. Each FFT stage
+ *   is scaled by 1/2 to avoid overflows, the result equals the float result in Q13 format
+ *   (8192 corresponds to 1.0).
+ */
+
+/************************************** Macros *******************************************/
+
+/** Minimum FFT size */
+#define XENSIV_BGT60TRXX_RANGE_FFT_SIZE_MIN             (8U)
+
+/** Maximum FFT size */
+#define XENSIV_BGT60TRXX_RANGE_FFT_SIZE_MAX             (65536U)
+
+/** Number of elements of the window and twiddle table */
+#define XENSIV_BGT60TRXX_RANGE_TABLE_LEN(num_samples, fft_size) \
+    ((num_samples) + (fft_size) + ((fft_size) / 2U))
+
+/******************************** Type definitions ****************************************/
+
+/**
+ * Structure holding the range processing configuration.
+ *
+ * Application code should not rely on the specific content of this struct.
+ * They are considered an implementation detail which is subject to change
+ * between platforms and/or library releases.
+ */
+typedef struct
+{
+    uint32_t num_samples;              /* samples per chirp */
+    uint32_t fft_size;                 /* real FFT size, fft_size / 2 complex points */
+    const void* table;                 /* window, stage twiddles, split twiddles */
+} xensiv_bgt60trxx_range_t;
+
+/******************************* Function prototypes *************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Initializes the float range processing and computes its window and twiddle table.
+ *
+ * @param[out] range Pointer to the range processing object.
+ * @param[in] num_samples Number of samples per chirp.
+ * @param[in] fft_size FFT size, a power of two from \ref XENSIV_BGT60TRXX_RANGE_FFT_SIZE_MIN to
+ * \ref XENSIV_BGT60TRXX_RANGE_FFT_SIZE_MAX, not less than \p num_samples. Samples beyond
+ * \p num_samples are zero-padded.
+ * @param[in] window Window applied to the chirp samples.
+ * @param[out] table Pointer to the table of
+ * \ref XENSIV_BGT60TRXX_RANGE_TABLE_LEN (\p num_samples, \p fft_size) elements. Must stay valid
+ * while the range processing object is used.
+ */
+void xensiv_bgt60trxx_range_init_f32(xensiv_bgt60trxx_range_t* range,
+                                     uint32_t num_samples,
+                                     uint32_t fft_size,
+                                     xensiv_bgt60trxx_window_t window,
+                                     float* table);
+
+/**
+ * @brief Initializes the fixed point range processing and computes its window and twiddle table.
+ *
+ * @param[out] range Pointer to the range processing object.
+ * @param[in] num_samples Number of samples per chirp.
+ * @param[in] fft_size FFT size, see \ref xensiv_bgt60trxx_range_init_f32.
+ * @param[in] window Window applied to the chirp samples.
+ * @param[out] table Pointer to the table of
+ * \ref XENSIV_BGT60TRXX_RANGE_TABLE_LEN (\p num_samples, \p fft_size) elements. Must stay valid
+ * while the range processing object is used.
+ */
+void xensiv_bgt60trxx_range_init_q15(xensiv_bgt60trxx_range_t* range,
+                                     uint32_t num_samples,
+                                     uint32_t fft_size,
+                                     xensiv_bgt60trxx_window_t window,
+                                     int16_t* table);
+
+/**
+ * @brief Computes the range spectrum of one chirp.
+ * @note The range processing object must be initialized with
+ * \ref xensiv_bgt60trxx_range_init_f32.
+ *
+ * @param[in] range Pointer to the range processing object.
+ * @param[in] in Pointer to the num_samples chirp samples.
+ * @param[out] out Pointer to fft_size elements receiving fft_size / 2 complex range bins.
+ * Must not overlap \p in.
+ */
+void xensiv_bgt60trxx_range_chirp_f32(const xensiv_bgt60trxx_range_t* range,
+                                      const float* in,
+                                      float* out);
+
+/**
+ * @brief Computes the range spectrum of one chirp in fixed point.
+ * @note The range processing object must be initialized with
+ * \ref xensiv_bgt60trxx_range_init_q15.
+ *
+ * @param[in] range Pointer to the range processing object.
+ * @param[in] in Pointer to the num_samples chirp samples, centered around zero.
+ * @param[out] out Pointer to fft_size elements receiving fft_size / 2 complex range bins.
+ * Must not overlap \p in.
+ */
+void xensiv_bgt60trxx_range_chirp_q15(const xensiv_bgt60trxx_range_t* range,
+                                      const int16_t* in,
+                                      int16_t* out);
+
+/**
+ * @brief Computes the range spectra of all chirps of a float radar cube.
+ * The spectrum of RX antenna rx and chirp c is written to
+ * out[(rx * num_chirps_per_frame + c) * fft_size].
+ *
+ * @param[in] range Pointer to the range processing object, num_samples must match the geometry.
+ * @param[in] geometry Pointer to the frame geometry.
+ * @param[in] cube Pointer to the radar cube, see \ref xensiv_bgt60trxx_cube_from_frame_f32.
+ * @param[out] out Pointer to num_rx_antennas * num_chirps_per_frame * fft_size elements.
+ */
+void xensiv_bgt60trxx_range_cube_f32(const xensiv_bgt60trxx_range_t* range,
+                                     const xensiv_bgt60trxx_frame_geometry_t* geometry,
+                                     const float* cube,
+                                     float* out);
+
+/**
+ * @brief Computes the range spectra of all chirps of an int16_t radar cube in fixed point.
+ * The output layout is the same as for \ref xensiv_bgt60trxx_range_cube_f32.
+ *
+ * @param[in] range Pointer to the range processing object, num_samples must match the geometry.
+ * @param[in] geometry Pointer to the frame geometry.
+ * @param[in] cube Pointer to the radar cube, see \ref xensiv_bgt60trxx_cube_from_frame_i16.
+ * @param[out] out Pointer to num_rx_antennas * num_chirps_per_frame * fft_size elements.
+ */
+void xensiv_bgt60trxx_range_cube_q15(const xensiv_bgt60trxx_range_t* range,
+                                     const xensiv_bgt60trxx_frame_geometry_t* geometry,
+                                     const int16_t* cube,
+                                     int16_t* out);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** \} group_board_libs_range */
+
+#endif // ifndef XENSIV_BGT60TRXX_RANGE_H_
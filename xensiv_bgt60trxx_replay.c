@@ -0,0 +1,382 @@
+/***********************************************************************************************//**
+ * \file xensiv_bgt60trxx_replay.c
+ *
+ * \brief
+ * This file contains the implementation of the replay platform, feeding an SPI trace back through
+ * the driver for the XENSIV(TM) BGT60TRxx 60GHz FMCW radar sensors.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2022 Infineon Technologies AG
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#include <assert.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "xensiv_bgt60trxx.h"
+#include "xensiv_bgt60trxx_replay.h"
+#include "xensiv_bgt60trxx_platform.h"
+
+/*******************************************************************************
+* Local variables
+*******************************************************************************/
+/* Log consumed by the platform functions without interface argument */
+static xensiv_bgt60trxx_replay_t* replay_active = NULL;
+
+
+/*******************************************************************************
+ * Function Prototypes
+ ********************************************************************************/
+static const uint8_t* next_record(xensiv_bgt60trxx_replay_t* replay,
+                                  xensiv_bgt60trxx_trace_type_t type,
+                                  uint32_t len,
+                                  xensiv_bgt60trxx_trace_record_t* header);
+
+static void replay_level(const void* iface, xensiv_bgt60trxx_trace_type_t type, bool val);
+
+static void replay_delay(xensiv_bgt60trxx_trace_type_t type, uint32_t value);
+
+static inline int32_t record_status(const xensiv_bgt60trxx_trace_record_t* header);
+
+/*******************************************************************************
+ * Public interface implementation
+ ********************************************************************************/
+void xensiv_bgt60trxx_replay_init(xensiv_bgt60trxx_replay_t* replay,
+                                  const uint8_t* log,
+                                  uint32_t len)
+{
+    assert(replay != NULL);
+    assert((log != NULL) || (len == 0U));
+
+    (void)memset(replay, 0, sizeof(*replay));
+    replay->log = log;
+    replay->len = len;
+
+    replay_active = replay;
+}
+
+
+bool xensiv_bgt60trxx_replay_finished(const xensiv_bgt60trxx_replay_t* replay)
+{
+    assert(replay != NULL);
+
+    return (replay->pos >= replay->len);
+}
+
+
+/*******************************************************************************
+ * Platform functions implementation
+ ********************************************************************************/
+int32_t xensiv_bgt60trxx_platform_spi_transfer(void* iface,
+                                               uint8_t* tx_data,
+                                               uint8_t* rx_data,
+                                               uint32_t len)
+{
+    assert(iface != NULL);
+    assert((tx_data != NULL) || (rx_data != NULL));
+
+    xensiv_bgt60trxx_replay_t* replay = iface;
+    uint32_t tx_len = (tx_data != NULL) ? len : 0U;
+    uint32_t rx_len = (rx_data != NULL) ? len : 0U;
+    xensiv_bgt60trxx_trace_record_t header;
+
+    const uint8_t* payload = next_record(replay, XENSIV_BGT60TRXX_TRACE_SPI_TRANSFER,
+                                         tx_len + rx_len, &header);
+    if (payload == NULL)
+    {
+        return XENSIV_BGT60TRXX_STATUS_COM_ERROR;
+    }
+
+    uint32_t flags = (tx_data != NULL) ? XENSIV_BGT60TRXX_TRACE_ARG_TX_MSK : 0U;
+    flags |= (rx_data != NULL) ? XENSIV_BGT60TRXX_TRACE_ARG_RX_MSK : 0U;
+
+    if (((header.arg & (XENSIV_BGT60TRXX_TRACE_ARG_TX_MSK | XENSIV_BGT60TRXX_TRACE_ARG_RX_MSK)) !=
+         flags) ||
+        ((tx_data != NULL) && (memcmp(tx_data, payload, len) != 0)))
+    {
+        ++replay->stats.mismatches;
+    }
+
+    /* the recorded RX bytes follow the TX bytes, if both were recorded */
+    if (((header.arg & XENSIV_BGT60TRXX_TRACE_ARG_RX_MSK) != 0U) && (rx_data != NULL))
+    {
+        (void)memcpy(rx_data, &payload[header.len - len], len);
+    }
+
+    return record_status(&header);
+}
+
+
+int32_t xensiv_bgt60trxx_platform_spi_fifo_read(void* iface,
+                                                uint16_t* rx_data,
+                                                uint32_t len)
+{
+    assert(iface != NULL);
+    assert(rx_data != NULL);
+
+    xensiv_bgt60trxx_replay_t* replay = iface;
+    xensiv_bgt60trxx_trace_record_t header;
+
+    const uint8_t* payload = next_record(replay, XENSIV_BGT60TRXX_TRACE_FIFO_READ,
+                                         len * sizeof(uint16_t), &header);
+    if (payload == NULL)
+    {
+        return XENSIV_BGT60TRXX_STATUS_COM_ERROR;
+    }
+
+    (void)memcpy(rx_data, payload, header.len);
+
+    return record_status(&header);
+}
+
+
+int32_t xensiv_bgt60trxx_platform_spi_burst_read(void* iface,
+                                                 uint8_t* tx_header,
+                                                 uint8_t* rx_header,
+                                                 uint16_t* rx_data,
+                                                 uint32_t len)
+{
+    assert(iface != NULL);
+    assert((tx_header != NULL) && (rx_header != NULL) && (rx_data != NULL));
+
+    xensiv_bgt60trxx_replay_t* replay = iface;
+    xensiv_bgt60trxx_trace_record_t header;
+
+    const uint8_t* payload = next_record(replay, XENSIV_BGT60TRXX_TRACE_BURST_READ,
+                                         (2U * XENSIV_BGT60TRXX_SPI_BURST_HEADER_SIZE_BYTES) +
+                                         (len * (uint32_t)sizeof(uint16_t)),
+                                         &header);
+    if (payload == NULL)
+    {
+        return XENSIV_BGT60TRXX_STATUS_COM_ERROR;
+    }
+
+    if (memcmp(tx_header, payload, XENSIV_BGT60TRXX_SPI_BURST_HEADER_SIZE_BYTES) != 0)
+    {
+        ++replay->stats.mismatches;
+    }
+
+    payload = &payload[XENSIV_BGT60TRXX_SPI_BURST_HEADER_SIZE_BYTES];
+    (void)memcpy(rx_header, payload, XENSIV_BGT60TRXX_SPI_BURST_HEADER_SIZE_BYTES);
+
+    payload = &payload[XENSIV_BGT60TRXX_SPI_BURST_HEADER_SIZE_BYTES];
+    (void)memcpy(rx_data, payload, len * sizeof(uint16_t));
+
+    return record_status(&header);
+}
+
+
+int32_t xensiv_bgt60trxx_platform_spi_fifo_read_async(void* iface,
+                                                      uint16_t* rx_data,
+                                                      uint32_t len,
+                                                      xensiv_bgt60trxx_platform_xfer_done_t done,
+                                                      void* arg)
+{
+    assert(iface != NULL);
+    assert((rx_data != NULL) && (done != NULL));
+
+    xensiv_bgt60trxx_replay_t* replay = iface;
+    xensiv_bgt60trxx_trace_record_t header;
+
+    /* the payload is empty if the read failed, its length is checked below */
+    const uint8_t* payload = next_record(replay, XENSIV_BGT60TRXX_TRACE_FIFO_READ_ASYNC,
+                                         0xFFFFFFFFU, &header);
+    if (payload == NULL)
+    {
+        return XENSIV_BGT60TRXX_STATUS_COM_ERROR;
+    }
+
+    int32_t status = record_status(&header);
+
+    if ((header.arg & XENSIV_BGT60TRXX_TRACE_ARG_STARTED_MSK) != 0U)
+    {
+        if (header.len == (len * sizeof(uint16_t)))
+        {
+            (void)memcpy(rx_data, payload, header.len);
+        }
+        else if (header.len != 0U)
+        {
+            ++replay->stats.mismatches;
+        }
+
+        done(arg, status);
+        status = XENSIV_BGT60TRXX_STATUS_OK;
+    }
+
+    return status;
+}
+
+
+void xensiv_bgt60trxx_platform_rst_set(const void* iface, bool val)
+{
+    replay_level(iface, XENSIV_BGT60TRXX_TRACE_RST, val);
+}
+
+
+void xensiv_bgt60trxx_platform_spi_cs_set(const void* iface, bool val)
+{
+    replay_level(iface, XENSIV_BGT60TRXX_TRACE_CS, val);
+}
+
+
+void xensiv_bgt60trxx_platform_delay(uint32_t ms)
+{
+    replay_delay(XENSIV_BGT60TRXX_TRACE_DELAY, ms);
+}
+
+
+void xensiv_bgt60trxx_platform_delay_us(uint32_t us)
+{
+    replay_delay(XENSIV_BGT60TRXX_TRACE_DELAY_US, us);
+}
+
+
+uint32_t xensiv_bgt60trxx_platform_get_time_us(void)
+{
+    return (replay_active != NULL) ? replay_active->time_us : 0U;
+}
+
+
+void xensiv_bgt60trxx_platform_memory_barrier(void)
+{
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+
+void xensiv_bgt60trxx_platform_lock(void* iface)
+{
+    (void)iface;
+}
+
+
+void xensiv_bgt60trxx_platform_unlock(void* iface)
+{
+    (void)iface;
+}
+
+
+uint32_t xensiv_bgt60trxx_platform_word_reverse(uint32_t x)
+{
+    return (((x & 0x000000ffUL) << 24) |
+            ((x & 0x0000ff00UL) <<  8) |
+            ((x & 0x00ff0000UL) >>  8) |
+            ((x & 0xff000000UL) >> 24));
+}
+
+
+void xensiv_bgt60trxx_platform_assert(bool expr)
+{
+    assert(expr);
+    (void)expr; /* make release build */
+}
+
+
+/*******************************************************************************
+ * Static functions implementation
+ ********************************************************************************/
+/* Consumes the next record if it has the given type and payload length (any length if
+   0xFFFFFFFF), skipping LOST records. Returns its payload, NULL on a divergence. */
+static const uint8_t* next_record(xensiv_bgt60trxx_replay_t* replay,
+                                  xensiv_bgt60trxx_trace_type_t type,
+                                  uint32_t len,
+                                  xensiv_bgt60trxx_trace_record_t* header)
+{
+    const uint8_t* payload = NULL;
+    bool valid = true;
+
+    while (valid && (payload == NULL))
+    {
+        valid = ((replay->len - replay->pos) >= sizeof(*header));
+        if (valid)
+        {
+            (void)memcpy(header, &replay->log[replay->pos], sizeof(*header));
+            valid = ((replay->len - replay->pos - sizeof(*header)) >= header->len);
+        }
+
+        if (valid && (header->type == (uint8_t)XENSIV_BGT60TRXX_TRACE_LOST))
+        {
+            uint32_t num_lost;
+            (void)memcpy(&num_lost, &replay->log[replay->pos + sizeof(*header)], sizeof(num_lost));
+            replay->stats.lost += num_lost;
+            replay->pos += (uint32_t)sizeof(*header) + header->len;
+        }
+        else if (valid)
+        {
+            valid = (header->type == (uint8_t)type) &&
+                    ((len == 0xFFFFFFFFU) || (header->len == len));
+            if (valid)
+            {
+                payload = &replay->log[replay->pos + sizeof(*header)];
+                replay->pos += (uint32_t)sizeof(*header) + header->len;
+                replay->time_us = header->time_us;
+                ++replay->stats.records;
+            }
+        }
+        else
+        {
+            /* end of the log */
+        }
+    }
+
+    if (!valid)
+    {
+        ++replay->stats.divergences;
+    }
+
+    return payload;
+}
+
+
+static void replay_level(const void* iface, xensiv_bgt60trxx_trace_type_t type, bool val)
+{
+    assert(iface != NULL);
+
+    /* The replayed log is mutable state behind the opaque interface pointer */
+    xensiv_bgt60trxx_replay_t* replay = (xensiv_bgt60trxx_replay_t*)(uintptr_t)iface;
+    xensiv_bgt60trxx_trace_record_t header;
+
+    if ((next_record(replay, type, 0U, &header) != NULL) && ((header.arg != 0U) != val))
+    {
+        ++replay->stats.mismatches;
+    }
+}
+
+
+static void replay_delay(xensiv_bgt60trxx_trace_type_t type, uint32_t value)
+{
+    xensiv_bgt60trxx_replay_t* replay = replay_active;
+    xensiv_bgt60trxx_trace_record_t header;
+
+    assert(replay != NULL);
+
+    const uint8_t* payload = next_record(replay, type, sizeof(value), &header);
+    if (payload != NULL)
+    {
+        uint32_t recorded;
+        (void)memcpy(&recorded, payload, sizeof(recorded));
+        if (recorded != value)
+        {
+            ++replay->stats.mismatches;
+        }
+    }
+}
+
+
+static inline int32_t record_status(const xensiv_bgt60trxx_trace_record_t* header)
+{
+    return (int32_t)((uint32_t)header->arg & XENSIV_BGT60TRXX_TRACE_ARG_STATUS_MSK);
+}
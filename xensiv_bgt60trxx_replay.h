@@ -0,0 +1,116 @@
+/***********************************************************************************************//**
+ * \file xensiv_bgt60trxx_replay.h
+ *
+ * \brief
+ * This file contains the declarations of the replay platform, feeding an SPI trace back through
+ * the driver for the XENSIV(TM) BGT60TRxx 60GHz FMCW radar sensors.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2022 Infineon Technologies AG
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#ifndef XENSIV_BGT60TRXX_REPLAY_H_
+#define XENSIV_BGT60TRXX_REPLAY_H_
+
+#include "xensiv_bgt60trxx_trace.h"
+
+/**
+ * \addtogroup group_board_libs_replay XENSIV(TM) BGT60TRxx SPI Replay
+ * \{
+ * Host implementation of the platform functions declared in xensiv_bgt60trxx_platform.h
+ * backed by a log recorded with the trace recorder (see \ref group_board_libs_trace) instead of
+ * a SPI bus.
+ *
+ * Each platform call of the driver consumes the next record of the log: the data and the status
+ * received are returned from the record, the data sent, the transfer lengths, the pin levels and
+ * the delays are compared with the record. As long as the driver issues the same accesses as
+ * when the log was recorded, it receives bit-exactly the same data, so a field problem can be
+ * reproduced on the host and driver changes can be checked and benchmarked against captured
+ * traffic:
+ * - An access with other data sent than recorded counts as a mismatch and still returns the
+ *   recorded data.
+ * - An access with another type or length than the next record, or past the end of the log,
+ *   counts as a divergence: the record is not consumed and transfers fail with
+ *   XENSIV_BGT60TRXX_STATUS_COM_ERROR.
+ *
+ * Delays do not wait. Time is the time stamp of the last record consumed, returned by
+ * xensiv_bgt60trxx_platform_get_time_us, so timeouts of the driver expire as in the recording.
+ * An asynchronous FIFO read completes before returning. The lock functions do nothing.
+ *
+ * Pass a pointer to a \ref xensiv_bgt60trxx_replay_t object as the iface argument of
+ * xensiv_bgt60trxx_init(). Only one log is replayed at a time, the last one initialized.
+ */
+
+/******************************** Type definitions ****************************************/
+
+/** Replay counters */
+typedef struct
+{
+    uint32_t records;         /**< Number of records consumed */
+    uint32_t mismatches;      /**< Accesses sending other data, levels or delays than recorded */
+    uint32_t divergences;     /**< Accesses not matching the type or length of the next record */
+    uint32_t lost;            /**< Records dropped by the recorder, from the LOST records */
+} xensiv_bgt60trxx_replay_stats_t;
+
+/**
+ * Structure holding the replayed log.
+ *
+ * Application code should not rely on the specific content of this struct, except the
+ * statistics. They are considered an implementation detail which is subject to change
+ * between platforms and/or library releases.
+ */
+typedef struct
+{
+    xensiv_bgt60trxx_replay_stats_t stats;  /**< Replay counters */
+    const uint8_t* log;
+    uint32_t len;
+    uint32_t pos;
+    uint32_t time_us;
+} xensiv_bgt60trxx_replay_t;
+
+/******************************* Function prototypes *************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Initializes the replay of a log from its start.
+ *
+ * @param[out] replay Pointer to the replay object.
+ * @param[in] log Pointer to the log, the bytes read with xensiv_bgt60trxx_trace_read.
+ * @param[in] len Length of the log in bytes.
+ */
+void xensiv_bgt60trxx_replay_init(xensiv_bgt60trxx_replay_t* replay,
+                                  const uint8_t* log,
+                                  uint32_t len);
+
+/**
+ * @brief Checks whether all records of the log have been consumed.
+ *
+ * @param[in] replay Pointer to the replay object.
+ * @return true if the end of the log is reached.
+ */
+bool xensiv_bgt60trxx_replay_finished(const xensiv_bgt60trxx_replay_t* replay);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** \} group_board_libs_replay */
+
+#endif // ifndef XENSIV_BGT60TRXX_REPLAY_H_
@@ -0,0 +1,821 @@
+/***********************************************************************************************//**
+ * \file xensiv_bgt60trxx_sim.c
+ *
+ * \brief
+ * This file contains the implementation of the simulated platform
+ * for the XENSIV(TM) BGT60TRxx 60GHz FMCW radar sensors.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2022 Infineon Technologies AG
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#include <assert.h>
+#include <math.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "xensiv_bgt60trxx_sim.h"
+#include "xensiv_bgt60trxx_platform.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define XENSIV_BGT60TRXX_SIM_BURST_CMD              (0xFFU)
+#define XENSIV_BGT60TRXX_SIM_REG_DATA_MSK           (0x00FFFFFFUL)
+#define XENSIV_BGT60TRXX_SIM_SAMPLE_MSK             (0x0FFFU)
+#define XENSIV_BGT60TRXX_SIM_ADC_MID                (2048.0)
+#define XENSIV_BGT60TRXX_SIM_BEAT_AMPLITUDE         (1500.0)
+#define XENSIV_BGT60TRXX_SIM_NOISE_MSK              (0x0FU)
+#define XENSIV_BGT60TRXX_SIM_PI                     (3.14159265358979323846)
+#define XENSIV_BGT60TRXX_SIM_STAT0_READY_MSK        (XENSIV_BGT60TRXX_REG_STAT0_MADC_RDY_MSK | \
+                                                     XENSIV_BGT60TRXX_REG_STAT0_MADC_BGUP_MSK | \
+                                                     XENSIV_BGT60TRXX_REG_STAT0_LDO_RDY_MSK)
+/* ready_ns while in deep sleep mode, the STAT0 ready bits stay clear */
+#define XENSIV_BGT60TRXX_SIM_DEEP_SLEEP_NS          (UINT64_MAX)
+
+
+/*******************************************************************************
+* Type definitions
+*******************************************************************************/
+struct xensiv_bgt60trxx_sim_device
+{
+    uint32_t chip_id;
+    uint32_t fifo_addr;
+    uint32_t fstat_addr;
+    uint32_t fifo_size;
+};
+
+
+/*******************************************************************************
+* Local variables
+*******************************************************************************/
+static const struct xensiv_bgt60trxx_sim_device sim_devices[] =
+{
+    {
+        .chip_id = 0x000303UL,
+        .fifo_addr = XENSIV_BGT60TRXX_REG_FIFO_TR13C,
+        .fstat_addr = XENSIV_BGT60TRXX_REG_FSTAT_TR13C,
+        .fifo_size = 8192U
+    },
+    {
+        .chip_id = 0x000606UL,
+        .fifo_addr = XENSIV_BGT60TRXX_REG_FIFO_UTR13D,
+        .fstat_addr = XENSIV_BGT60TRXX_REG_FSTAT_UTR13D,
+        .fifo_size = 8192U
+    },
+    {
+        .chip_id = 0x000707UL,
+        .fifo_addr = XENSIV_BGT60TRXX_REG_FIFO_UTR11,
+        .fstat_addr = XENSIV_BGT60TRXX_REG_FSTAT_UTR11,
+        .fifo_size = 2048U
+    }
+};
+
+/* Virtual time base shared by all simulated sensors */
+static uint64_t sim_now_ns = 0U;
+
+
+/*******************************************************************************
+ * Function Prototypes
+ ********************************************************************************/
+static void sim_reset(xensiv_bgt60trxx_sim_t* sim);
+
+static void sim_update(xensiv_bgt60trxx_sim_t* sim);
+
+static uint16_t sim_sample(xensiv_bgt60trxx_sim_t* sim, uint32_t idx);
+
+static void fifo_clear(xensiv_bgt60trxx_sim_t* sim);
+
+static void fifo_push(xensiv_bgt60trxx_sim_t* sim, uint16_t sample);
+
+static uint16_t fifo_pop(xensiv_bgt60trxx_sim_t* sim);
+
+static uint32_t reg_read(xensiv_bgt60trxx_sim_t* sim, uint32_t addr);
+
+static void reg_write(xensiv_bgt60trxx_sim_t* sim, uint32_t addr, uint32_t data);
+
+static uint8_t gsr0_read(const xensiv_bgt60trxx_sim_t* sim);
+
+static uint8_t spi_byte(xensiv_bgt60trxx_sim_t* sim, uint8_t tx);
+
+static void spi_bus_time(const xensiv_bgt60trxx_sim_t* sim, uint64_t bits);
+
+/*******************************************************************************
+ * Public interface implementation
+ ********************************************************************************/
+void xensiv_bgt60trxx_sim_init(xensiv_bgt60trxx_sim_t* sim,
+                               const xensiv_bgt60trxx_sim_config_t* cfg)
+{
+    assert(sim != NULL);
+    assert(cfg != NULL);
+    assert((cfg->device >= XENSIV_DEVICE_BGT60TR13C) &&
+           (cfg->device <= XENSIV_DEVICE_BGT60UTR11));
+    assert(cfg->sample_rate_hz > 0U);
+    assert((cfg->num_samples_per_chirp * cfg->num_chirps_per_frame *
+            cfg->num_rx_antennas) > 0U);
+
+    (void)memset(sim, 0, sizeof(*sim));
+    sim->cfg = *cfg;
+
+    const struct xensiv_bgt60trxx_sim_device* device = &sim_devices[cfg->device];
+    sim->fifo_addr = device->fifo_addr;
+    sim->fstat_addr = device->fstat_addr;
+    sim->fifo_size = device->fifo_size;
+    sim->rst_level = true;
+    sim->noise = 1U;
+
+    sim_reset(sim);
+    sim->stats.resets = 0U;
+}
+
+
+void xensiv_bgt60trxx_sim_advance(uint32_t us)
+{
+    sim_now_ns += (uint64_t)us * 1000U;
+}
+
+
+bool xensiv_bgt60trxx_sim_irq(xensiv_bgt60trxx_sim_t* sim)
+{
+    assert(sim != NULL);
+
+    sim_update(sim);
+
+    uint32_t cref = (sim->regs[XENSIV_BGT60TRXX_REG_SFCTL] &
+                     XENSIV_BGT60TRXX_REG_SFCTL_FIFO_CREF_MSK) >>
+                    XENSIV_BGT60TRXX_REG_SFCTL_FIFO_CREF_POS;
+
+    return ((sim->fifo_fill / XENSIV_BGT60TRXX_NUM_SAMPLES_FIFO_WORD) > cref);
+}
+
+
+bool xensiv_bgt60trxx_sim_complete_async(xensiv_bgt60trxx_sim_t* sim)
+{
+    assert(sim != NULL);
+
+    void (* done)(void* arg, int32_t status) = sim->async_done;
+    bool pending = (done != NULL);
+
+    if (pending)
+    {
+        /* the driver may start the next read from the completion */
+        sim->async_done = NULL;
+        done(sim->async_arg, sim->async_status);
+    }
+
+    return pending;
+}
+
+
+uint64_t xensiv_bgt60trxx_sim_get_time(void)
+{
+    return sim_now_ns;
+}
+
+
+/*******************************************************************************
+ * Platform functions implementation
+ ********************************************************************************/
+int32_t xensiv_bgt60trxx_platform_spi_transfer(void* iface,
+                                               uint8_t* tx_data,
+                                               uint8_t* rx_data,
+                                               uint32_t len)
+{
+    assert(iface != NULL);
+    assert((tx_data != NULL) || (rx_data != NULL));
+
+    xensiv_bgt60trxx_sim_t* sim = iface;
+
+    sim_update(sim);
+
+    for (uint32_t i = 0U; i < len; ++i)
+    {
+        uint8_t rx = spi_byte(sim, (tx_data != NULL) ? tx_data[i] : 0xFFU);
+        if (rx_data != NULL)
+        {
+            rx_data[i] = rx;
+        }
+    }
+
+    ++sim->stats.transfers;
+    sim->stats.bytes += len;
+    spi_bus_time(sim, (uint64_t)len * 8U);
+
+    return sim->cs_active ? XENSIV_BGT60TRXX_STATUS_OK : XENSIV_BGT60TRXX_STATUS_COM_ERROR;
+}
+
+
+int32_t xensiv_bgt60trxx_platform_spi_fifo_read(void* iface,
+                                                uint16_t* rx_data,
+                                                uint32_t len)
+{
+    assert(iface != NULL);
+    assert(rx_data != NULL);
+
+    xensiv_bgt60trxx_sim_t* sim = iface;
+
+#if defined(XENSIV_BGT60TRXX_PLATFORM_LOCK)
+    /* A transaction of another thread could interleave */
+    assert(sim->locked);
+#endif
+
+    sim_update(sim);
+
+    bool fifo_burst = sim->burst && !sim->burst_write && (sim->burst_addr == sim->fifo_addr);
+
+    for (uint32_t i = 0U; i < len; ++i)
+    {
+        rx_data[i] = fifo_burst ? fifo_pop(sim) : 0U;
+    }
+
+    ++sim->stats.transfers;
+    sim->stats.bytes += ((uint64_t)len * XENSIV_BGT60TRXX_FIFO_WORD_SIZE_BYTES) /
+                        XENSIV_BGT60TRXX_NUM_SAMPLES_FIFO_WORD;
+    spi_bus_time(sim, (uint64_t)len * 12U);
+
+    return (sim->cs_active && fifo_burst) ?
+           XENSIV_BGT60TRXX_STATUS_OK :
+           XENSIV_BGT60TRXX_STATUS_COM_ERROR;
+}
+
+
+int32_t xensiv_bgt60trxx_platform_spi_burst_read(void* iface,
+                                                 uint8_t* tx_header,
+                                                 uint8_t* rx_header,
+                                                 uint16_t* rx_data,
+                                                 uint32_t len)
+{
+    xensiv_bgt60trxx_platform_spi_cs_set(iface, false);
+
+    int32_t status = xensiv_bgt60trxx_platform_spi_transfer(iface, tx_header, rx_header,
+                                                            XENSIV_BGT60TRXX_SPI_BURST_HEADER_SIZE_BYTES);
+    if (XENSIV_BGT60TRXX_STATUS_OK == status)
+    {
+        status = xensiv_bgt60trxx_platform_spi_fifo_read(iface, rx_data, len);
+    }
+
+    xensiv_bgt60trxx_platform_spi_cs_set(iface, true);
+
+    return status;
+}
+
+
+int32_t xensiv_bgt60trxx_platform_spi_fifo_read_async(void* iface,
+                                                      uint16_t* rx_data,
+                                                      uint32_t len,
+                                                      xensiv_bgt60trxx_platform_xfer_done_t done,
+                                                      void* arg)
+{
+    assert(iface != NULL);
+    assert(done != NULL);
+
+    xensiv_bgt60trxx_sim_t* sim = iface;
+
+    /* only one read at a time, the driver holds CS until it completes */
+    assert(sim->async_done == NULL);
+
+    /* the samples are transferred at once, the completion may be deferred */
+    int32_t status = xensiv_bgt60trxx_platform_spi_fifo_read(iface, rx_data, len);
+    if (XENSIV_BGT60TRXX_STATUS_OK == status)
+    {
+        if (sim->cfg.async_deferred)
+        {
+            sim->async_done = done;
+            sim->async_arg = arg;
+            sim->async_status = status;
+        }
+        else
+        {
+            done(arg, status);
+        }
+    }
+
+    return status;
+}
+
+
+void xensiv_bgt60trxx_platform_rst_set(const void* iface, bool val)
+{
+    assert(iface != NULL);
+
+    /* The simulated sensor is mutable state behind the opaque interface pointer */
+    xensiv_bgt60trxx_sim_t* sim = (xensiv_bgt60trxx_sim_t*)(uintptr_t)iface;
+
+    if (val && !sim->rst_level)
+    {
+        /* Rising edge of the reset pin */
+        sim_reset(sim);
+    }
+
+    sim->rst_level = val;
+}
+
+
+void xensiv_bgt60trxx_platform_spi_cs_set(const void* iface, bool val)
+{
+    assert(iface != NULL);
+
+    xensiv_bgt60trxx_sim_t* sim = (xensiv_bgt60trxx_sim_t*)(uintptr_t)iface;
+
+    if (!val && !sim->cs_active)
+    {
+        ++sim->stats.cs_assertions;
+    }
+
+#if defined(XENSIV_BGT60TRXX_PLATFORM_LOCK)
+    /* A transaction of another thread could interleave */
+    assert(val || sim->locked);
+#endif
+
+    /* Each CS assertion starts a new command */
+    sim->cs_active = !val;
+    sim->cmd = 0U;
+    sim->cmd_len = 0U;
+    sim->burst = false;
+}
+
+
+void xensiv_bgt60trxx_platform_delay(uint32_t ms)
+{
+    xensiv_bgt60trxx_sim_advance(ms * 1000U);
+}
+
+
+void xensiv_bgt60trxx_platform_delay_us(uint32_t us)
+{
+    xensiv_bgt60trxx_sim_advance(us);
+}
+
+
+uint32_t xensiv_bgt60trxx_platform_get_time_us(void)
+{
+    return (uint32_t)(sim_now_ns / 1000U);
+}
+
+
+void xensiv_bgt60trxx_platform_memory_barrier(void)
+{
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+
+void xensiv_bgt60trxx_platform_lock(void* iface)
+{
+    assert(iface != NULL);
+
+    xensiv_bgt60trxx_sim_t* sim = iface;
+
+    /* A second acquisition would deadlock with a non-recursive mutex */
+    assert(!sim->locked);
+
+    sim->locked = true;
+    ++sim->stats.locks;
+}
+
+
+void xensiv_bgt60trxx_platform_unlock(void* iface)
+{
+    assert(iface != NULL);
+
+    xensiv_bgt60trxx_sim_t* sim = iface;
+
+    assert(sim->locked);
+
+    sim->locked = false;
+}
+
+
+uint32_t xensiv_bgt60trxx_platform_word_reverse(uint32_t x)
+{
+    return (((x & 0x000000ffUL) << 24) |
+            ((x & 0x0000ff00UL) <<  8) |
+            ((x & 0x00ff0000UL) >>  8) |
+            ((x & 0xff000000UL) >> 24));
+}
+
+
+void xensiv_bgt60trxx_platform_assert(bool expr)
+{
+    assert(expr);
+    (void)expr; /* make release build */
+}
+
+
+/*******************************************************************************
+ * Static functions implementation
+ ********************************************************************************/
+static void sim_reset(xensiv_bgt60trxx_sim_t* sim)
+{
+    (void)memset(sim->regs, 0, sizeof(sim->regs));
+    sim->regs[XENSIV_BGT60TRXX_REG_CHIP_ID] = sim_devices[sim->cfg.device].chip_id;
+
+    fifo_clear(sim);
+    sim->running = false;
+    sim->frame_cnt = 0U;
+    sim->frame_sample = 0U;
+    sim->lfsr = XENSIV_BGT60TRXX_INITIAL_TEST_WORD;
+    sim->reset_polls = 0U;
+    sim->ready_ns = XENSIV_BGT60TRXX_SIM_DEEP_SLEEP_NS;
+    ++sim->stats.resets;
+}
+
+
+static void sim_update(xensiv_bgt60trxx_sim_t* sim)
+{
+    const xensiv_bgt60trxx_sim_config_t* cfg = &sim->cfg;
+    uint32_t frame_len = cfg->num_samples_per_chirp * cfg->num_chirps_per_frame *
+                         cfg->num_rx_antennas;
+    uint64_t frame_time_ns = ((uint64_t)frame_len * 1000000000U) / cfg->sample_rate_hz;
+    uint64_t frame_period_ns = (uint64_t)cfg->frame_period_us * 1000U;
+
+    if (frame_period_ns < frame_time_ns)
+    {
+        frame_period_ns = frame_time_ns;
+    }
+
+    while (sim->running)
+    {
+        uint64_t elapsed_us = (sim_now_ns - sim->frame_start_ns) / 1000U;
+        uint64_t due = (elapsed_us * cfg->sample_rate_hz) / 1000000U;
+        if (due > frame_len)
+        {
+            due = frame_len;
+        }
+
+        while (sim->frame_sample < due)
+        {
+            fifo_push(sim, sim_sample(sim, sim->frame_sample));
+            ++sim->frame_sample;
+            if (sim->frame_sample == frame_len)
+            {
+                ++sim->frame_cnt;
+                ++sim->stats.frames;
+            }
+        }
+
+        if ((sim->frame_sample < frame_len) ||
+            (sim_now_ns < (sim->frame_start_ns + frame_period_ns)))
+        {
+            break;
+        }
+
+        sim->frame_start_ns += frame_period_ns;
+        sim->frame_sample = 0U;
+
+        if ((sim->fifo_fill == (sim->fifo_size * XENSIV_BGT60TRXX_NUM_SAMPLES_FIFO_WORD)) &&
+            ((sim_now_ns - sim->frame_start_ns) > frame_period_ns))
+        {
+            /* FIFO full, skip the frames that would be dropped entirely */
+            uint64_t skip = ((sim_now_ns - sim->frame_start_ns) / frame_period_ns) - 1U;
+            sim->frame_start_ns += skip * frame_period_ns;
+            sim->frame_cnt += (uint32_t)skip;
+            sim->stats.frames += (uint32_t)skip;
+            sim->stats.overflows += (uint32_t)(skip * frame_len);
+        }
+    }
+}
+
+
+static uint16_t sim_sample(xensiv_bgt60trxx_sim_t* sim, uint32_t idx)
+{
+    const xensiv_bgt60trxx_sim_config_t* cfg = &sim->cfg;
+    uint32_t chirp_len = cfg->num_samples_per_chirp * cfg->num_rx_antennas;
+    uint32_t sample = (idx % chirp_len) / cfg->num_rx_antennas;
+    uint32_t antenna = idx % cfg->num_rx_antennas;
+    uint16_t value;
+
+    bool lfsr_en = ((sim->regs[XENSIV_BGT60TRXX_REG_SFCTL] &
+                     XENSIV_BGT60TRXX_REG_SFCTL_LFSR_EN_MSK) != 0U);
+
+    if ((lfsr_en && (antenna == 0U)) || (cfg->data == XENSIV_BGT60TRXX_SIM_DATA_LFSR))
+    {
+        value = sim->lfsr;
+        sim->lfsr = xensiv_bgt60trxx_get_next_test_word(sim->lfsr);
+    }
+    else
+    {
+        /* Single target, antennas spaced by a quarter of pi in phase */
+        double phase = ((2.0 * XENSIV_BGT60TRXX_SIM_PI * (double)cfg->beat_freq_hz *
+                         (double)sample) / (double)cfg->sample_rate_hz) +
+                       ((XENSIV_BGT60TRXX_SIM_PI / 4.0) * (double)antenna);
+
+        sim->noise = (sim->noise * 1103515245U) + 12345U;
+        int32_t noise = (int32_t)((sim->noise >> 16) & XENSIV_BGT60TRXX_SIM_NOISE_MSK) -
+                        (int32_t)(XENSIV_BGT60TRXX_SIM_NOISE_MSK / 2U);
+
+        value = (uint16_t)((int32_t)(XENSIV_BGT60TRXX_SIM_ADC_MID +
+                                     (XENSIV_BGT60TRXX_SIM_BEAT_AMPLITUDE * sin(phase))) +
+                           noise);
+    }
+
+    return (value & XENSIV_BGT60TRXX_SIM_SAMPLE_MSK);
+}
+
+
+static void fifo_clear(xensiv_bgt60trxx_sim_t* sim)
+{
+    sim->fifo_rd = 0U;
+    sim->fifo_fill = 0U;
+    sim->fof_err = false;
+    sim->fuf_err = false;
+}
+
+
+static void fifo_push(xensiv_bgt60trxx_sim_t* sim, uint16_t sample)
+{
+    uint32_t capacity = sim->fifo_size * XENSIV_BGT60TRXX_NUM_SAMPLES_FIFO_WORD;
+
+    if (sim->fifo_fill == capacity)
+    {
+        sim->fof_err = true;
+        ++sim->stats.overflows;
+    }
+    else
+    {
+        sim->fifo[(sim->fifo_rd + sim->fifo_fill) % capacity] = sample;
+        ++sim->fifo_fill;
+    }
+}
+
+
+static uint16_t fifo_pop(xensiv_bgt60trxx_sim_t* sim)
+{
+    uint16_t sample = 0U;
+
+    if (sim->fifo_fill == 0U)
+    {
+        sim->fuf_err = true;
+        ++sim->stats.underflows;
+    }
+    else
+    {
+        sample = sim->fifo[sim->fifo_rd];
+        sim->fifo_rd = (sim->fifo_rd + 1U) % (sim->fifo_size * XENSIV_BGT60TRXX_NUM_SAMPLES_FIFO_WORD);
+        --sim->fifo_fill;
+    }
+
+    return sample;
+}
+
+
+static uint32_t reg_read(xensiv_bgt60trxx_sim_t* sim, uint32_t addr)
+{
+    uint32_t data = 0U;
+
+    ++sim->stats.reg_reads;
+
+    if (addr == XENSIV_BGT60TRXX_REG_MAIN)
+    {
+        data = sim->regs[XENSIV_BGT60TRXX_REG_MAIN];
+        if ((data & XENSIV_BGT60TRXX_REG_MAIN_RESET_MSK) != 0U)
+        {
+            /* Reset bits clear after the configured number of polls */
+            if (sim->reset_polls > 0U)
+            {
+                --sim->reset_polls;
+            }
+            else
+            {
+                data &= ~(uint32_t)XENSIV_BGT60TRXX_REG_MAIN_RESET_MSK;
+                sim->regs[XENSIV_BGT60TRXX_REG_MAIN] = data;
+            }
+        }
+    }
+    else if (addr == XENSIV_BGT60TRXX_REG_STAT0)
+    {
+        if (sim_now_ns >= sim->ready_ns)
+        {
+            data = XENSIV_BGT60TRXX_SIM_STAT0_READY_MSK;
+        }
+    }
+    else if (addr == XENSIV_BGT60TRXX_REG_STAT1)
+    {
+        uint32_t chirp_len = sim->cfg.num_samples_per_chirp * sim->cfg.num_rx_antennas;
+        data = ((sim->frame_cnt << XENSIV_BGT60TRXX_REG_STAT1_FRAME_CNT_POS) &
+                XENSIV_BGT60TRXX_REG_STAT1_FRAME_CNT_MSK) |
+               (((sim->frame_sample / chirp_len) << XENSIV_BGT60TRXX_REG_STAT1_SHAPE_GRP_CNT_POS) &
+                XENSIV_BGT60TRXX_REG_STAT1_SHAPE_GRP_CNT_MSK);
+    }
+    else if (addr == sim->fstat_addr)
+    {
+        uint32_t words = sim->fifo_fill / XENSIV_BGT60TRXX_NUM_SAMPLES_FIFO_WORD;
+        uint32_t cref = (sim->regs[XENSIV_BGT60TRXX_REG_SFCTL] &
+                         XENSIV_BGT60TRXX_REG_SFCTL_FIFO_CREF_MSK) >>
+                        XENSIV_BGT60TRXX_REG_SFCTL_FIFO_CREF_POS;
+
+        data = (words << XENSIV_BGT60TRXX_REG_FSTAT_FILL_STATUS_POS) &
+               XENSIV_BGT60TRXX_REG_FSTAT_FILL_STATUS_MSK;
+        data |= (words == 0U) ? XENSIV_BGT60TRXX_REG_FSTAT_EMPTY_MSK : 0U;
+        data |= (words > cref) ? XENSIV_BGT60TRXX_REG_FSTAT_CREF_MSK : 0U;
+        data |= (words == sim->fifo_size) ? XENSIV_BGT60TRXX_REG_FSTAT_FULL_MSK : 0U;
+        data |= sim->fof_err ? XENSIV_BGT60TRXX_REG_FSTAT_FOF_ERR_MSK : 0U;
+        data |= sim->fuf_err ? XENSIV_BGT60TRXX_REG_FSTAT_FUF_ERR_MSK : 0U;
+    }
+    else if (addr == sim->fifo_addr)
+    {
+        uint32_t sample0 = fifo_pop(sim);
+        data = (sample0 << 12) | fifo_pop(sim);
+    }
+    else if (addr < XENSIV_BGT60TRXX_SIM_NUM_REGS)
+    {
+        data = sim->regs[addr];
+    }
+    else
+    {
+        /* Unmapped address reads as zero */
+    }
+
+    return data;
+}
+
+
+static void reg_write(xensiv_bgt60trxx_sim_t* sim, uint32_t addr, uint32_t data)
+{
+    ++sim->stats.reg_writes;
+
+    data &= XENSIV_BGT60TRXX_SIM_REG_DATA_MSK;
+
+    if (addr == XENSIV_BGT60TRXX_REG_MAIN)
+    {
+        uint32_t reset = data & XENSIV_BGT60TRXX_REG_MAIN_RESET_MSK;
+
+        if ((reset & (uint32_t)XENSIV_BGT60TRXX_RESET_SW) != 0U)
+        {
+            sim_reset(sim);
+        }
+        if ((reset & (uint32_t)XENSIV_BGT60TRXX_RESET_FIFO) != 0U)
+        {
+            fifo_clear(sim);
+        }
+        if ((reset & (uint32_t)XENSIV_BGT60TRXX_RESET_FSM) != 0U)
+        {
+            /* Back to deep sleep mode */
+            sim->ready_ns = XENSIV_BGT60TRXX_SIM_DEEP_SLEEP_NS;
+        }
+        if (reset != 0U)
+        {
+            sim->running = false;
+            sim->reset_polls = sim->cfg.reset_polls;
+        }
+        else if ((data & XENSIV_BGT60TRXX_REG_MAIN_FRAME_START_MSK) != 0U)
+        {
+            sim->running = true;
+            sim->frame_start_ns = sim_now_ns;
+            sim->frame_sample = 0U;
+            if (XENSIV_BGT60TRXX_SIM_DEEP_SLEEP_NS == sim->ready_ns)
+            {
+                /* Leaving deep sleep mode powers up the LDO and the MADC */
+                sim->ready_ns = sim_now_ns + ((uint64_t)sim->cfg.ready_delay_us * 1000U);
+            }
+        }
+        else
+        {
+            /* No trigger */
+        }
+
+        /* FRAME_START is a trigger and reads back as zero */
+        sim->regs[XENSIV_BGT60TRXX_REG_MAIN] =
+            data & ~(uint32_t)XENSIV_BGT60TRXX_REG_MAIN_FRAME_START_MSK;
+    }
+    else if ((addr == XENSIV_BGT60TRXX_REG_CHIP_ID) ||
+             (addr == XENSIV_BGT60TRXX_REG_STAT1) ||
+             (addr == XENSIV_BGT60TRXX_REG_STAT0) ||
+             (addr == sim->fstat_addr) ||
+             (addr == sim->fifo_addr))
+    {
+        /* Read-only */
+    }
+    else if (addr < XENSIV_BGT60TRXX_SIM_NUM_REGS)
+    {
+        sim->regs[addr] = data;
+    }
+    else
+    {
+        /* Unmapped address */
+    }
+}
+
+
+static uint8_t gsr0_read(const xensiv_bgt60trxx_sim_t* sim)
+{
+    uint8_t gsr0 = 0U;
+
+    if (sim->fof_err || sim->fuf_err)
+    {
+        gsr0 |= (uint8_t)XENSIV_BGT60TRXX_REG_GSR0_FOU_ERR_MSK;
+    }
+    if ((sim->regs[XENSIV_BGT60TRXX_REG_SFCTL] & XENSIV_BGT60TRXX_REG_SFCTL_MISO_HS_READ_MSK) != 0U)
+    {
+        gsr0 |= (uint8_t)XENSIV_BGT60TRXX_REG_GSR0_MISO_HS_READ_MSK;
+    }
+
+    return gsr0;
+}
+
+
+/* Decodes one byte of the SPI protocol and returns the byte shifted out by the sensor.
+   Commands are 32 bits: GSR0 is shifted out during the first byte, the register data during
+   the remaining three bytes of a read. After a burst command 24-bit words follow. */
+static uint8_t spi_byte(xensiv_bgt60trxx_sim_t* sim, uint8_t tx)
+{
+    uint8_t rx = 0U;
+
+    sim->cmd = (sim->cmd << 8) | tx;
+    ++sim->cmd_len;
+
+    if (sim->burst)
+    {
+        if (sim->cmd_len == 1U)
+        {
+            sim->rx_word = sim->burst_write ? 0U : reg_read(sim, sim->burst_addr);
+        }
+
+        rx = (uint8_t)(sim->rx_word >> (8U * (3U - sim->cmd_len)));
+
+        if (sim->cmd_len == 3U)
+        {
+            if (sim->burst_write)
+            {
+                reg_write(sim, sim->burst_addr, sim->cmd);
+            }
+
+            /* FIFO bursts keep reading the FIFO register */
+            if (sim->burst_addr != sim->fifo_addr)
+            {
+                ++sim->burst_addr;
+            }
+
+            sim->cmd = 0U;
+            sim->cmd_len = 0U;
+
+            if (sim->burst_len > 0U)
+            {
+                --sim->burst_len;
+                sim->burst = (sim->burst_len > 0U);
+            }
+        }
+    }
+    else
+    {
+        if (sim->cmd_len == 1U)
+        {
+            rx = gsr0_read(sim);
+            bool read = ((tx & 0x01U) == 0U) && (tx != XENSIV_BGT60TRXX_SIM_BURST_CMD);
+            sim->rx_word = read ? reg_read(sim, (uint32_t)tx >> 1) : 0U;
+        }
+        else
+        {
+            rx = (uint8_t)(sim->rx_word >> (8U * (4U - sim->cmd_len)));
+        }
+
+        if (sim->cmd_len == 4U)
+        {
+            uint32_t cmd = sim->cmd;
+            uint32_t addr = cmd >> 25;
+
+            if ((cmd >> 24) == XENSIV_BGT60TRXX_SIM_BURST_CMD)
+            {
+                sim->burst = true;
+                sim->burst_addr = (cmd >> 17) & 0x7FU;
+                sim->burst_write = (((cmd >> 16) & 0x01U) != 0U);
+                sim->burst_len = (cmd >> 9) & 0x7FU; /* 0 for unbounded */
+            }
+            else if (((cmd >> 24) & 0x01U) != 0U)
+            {
+                reg_write(sim, addr, cmd);
+            }
+            else
+            {
+                /* Register read already shifted out */
+            }
+
+            sim->cmd = 0U;
+            sim->cmd_len = 0U;
+        }
+    }
+
+    return rx;
+}
+
+
+static void spi_bus_time(const xensiv_bgt60trxx_sim_t* sim, uint64_t bits)
+{
+    if (sim->cfg.spi_clock_hz > 0U)
+    {
+        sim_now_ns += (bits * 1000000000U) / sim->cfg.spi_clock_hz;
+    }
+}
@@ -0,0 +1,211 @@
+/***********************************************************************************************//**
+ * \file xensiv_bgt60trxx_sim.h
+ *
+ * \brief
+ * This file contains the declarations of the simulated platform
+ * for the XENSIV(TM) BGT60TRxx 60GHz FMCW radar sensors.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2022 Infineon Technologies AG
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#ifndef XENSIV_BGT60TRXX_SIM_H_
+#define XENSIV_BGT60TRXX_SIM_H_
+
+#include "xensiv_bgt60trxx.h"
+
+/**
+ * \addtogroup group_board_libs_sim XENSIV(TM) BGT60TRxx Radar Sensor Simulator
+ * \{
+ * Host implementation of the platform functions declared in xensiv_bgt60trxx_platform.h
+ * backed by a simulated sensor instead of a SPI bus.
+ *
+ * The simulator decodes the SPI protocol (register access, burst read and burst write) and
+ * models the register file, the CHIP_ID of the selected device, the MAIN reset bits, the
+ * SFCTL FIFO compare reference, the STAT0 readiness bits (clear in deep sleep mode), the STAT1
+ * frame counter, the FSTAT flags, the GSR0 status and a FIFO sized like the real device.
+ *
+ * Time is virtual: it advances with \ref xensiv_bgt60trxx_sim_advance,
+ * with xensiv_bgt60trxx_platform_delay and, if spi_clock_hz is not zero, with the time each
+ * SPI transfer takes on the bus. All simulated sensors share the same time base, which is also
+ * returned by xensiv_bgt60trxx_platform_get_time_us. While frame generation is running the FIFO
+ * is filled at the configured sample rate with either the LFSR test sequence or a synthetic beat
+ * signal. Setting SFCTL LFSR_EN replaces the data of the
+ * first RX antenna by the LFSR test sequence, like the real device.
+ *
+ * The lock functions (XENSIV_BGT60TRXX_PLATFORM_LOCK) do not block, the simulator is not
+ * thread-safe. They assert that the lock is not acquired recursively and, if
+ * XENSIV_BGT60TRXX_PLATFORM_LOCK is defined, that the SPI CS is only asserted with the lock held.
+ *
+ * Pass a pointer to a \ref xensiv_bgt60trxx_sim_t object as the iface argument of
+ * xensiv_bgt60trxx_init().
+ */
+
+/************************************** Macros *******************************************/
+
+/** Number of addressable registers in the simulated register file */
+#define XENSIV_BGT60TRXX_SIM_NUM_REGS                   (128U)
+
+/** Maximum FIFO size in words of all supported devices */
+#define XENSIV_BGT60TRXX_SIM_FIFO_MAX_WORDS             (8192U)
+
+/******************************** Type definitions ****************************************/
+
+/** Data generated by the simulated ADC */
+typedef enum
+{
+    XENSIV_BGT60TRXX_SIM_DATA_BEAT = 0, /**< Synthetic beat signal, one target per antenna */
+    XENSIV_BGT60TRXX_SIM_DATA_LFSR = 1  /**< LFSR test sequence on all antennas */
+} xensiv_bgt60trxx_sim_data_t;
+
+/** Configuration of the simulated sensor */
+typedef struct
+{
+    xensiv_bgt60trxx_device_t device; /**< Simulated device, defines CHIP_ID and FIFO size */
+    xensiv_bgt60trxx_sim_data_t data; /**< Data generated while SFCTL LFSR_EN is cleared */
+    uint32_t sample_rate_hz;          /**< ADC sample rate */
+    uint32_t num_samples_per_chirp;   /**< Samples per chirp and antenna */
+    uint32_t num_chirps_per_frame;    /**< Chirps per frame */
+    uint32_t num_rx_antennas;         /**< Active RX antennas, samples are interleaved */
+    uint32_t frame_period_us;         /**< Frame repetition time */
+    uint32_t beat_freq_hz;            /**< Beat frequency of the synthetic target */
+    uint32_t spi_clock_hz;            /**< SPI clock used to advance time, 0 for no bus time */
+    uint32_t reset_polls;             /**< MAIN reads until reset bits clear */
+    uint32_t ready_delay_us;          /**< Time from frame start until the STAT0 ready bits are
+                                           set; after a software, FSM or hard reset the sensor
+                                           is in deep sleep mode with the bits clear */
+    bool async_deferred;              /**< Complete asynchronous FIFO reads in
+                                           \ref xensiv_bgt60trxx_sim_complete_async instead of
+                                           before xensiv_bgt60trxx_platform_spi_fifo_read_async
+                                           returns */
+} xensiv_bgt60trxx_sim_config_t;
+
+/** Bus activity counters of the simulated sensor */
+typedef struct
+{
+    uint32_t cs_assertions;   /**< Number of SPI CS assertions */
+    uint32_t transfers;       /**< Number of SPI transfers (including FIFO reads) */
+    uint64_t bytes;           /**< Number of bytes transferred, FIFO samples count 1.5 bytes */
+    uint32_t reg_writes;      /**< Number of registers written */
+    uint32_t reg_reads;       /**< Number of registers read */
+    uint32_t resets;          /**< Number of soft and hard resets */
+    uint32_t frames;          /**< Number of frames generated */
+    uint32_t overflows;       /**< Number of samples dropped because the FIFO was full */
+    uint32_t underflows;      /**< Number of samples read from an empty FIFO */
+    uint32_t locks;           /**< Number of lock acquisitions */
+} xensiv_bgt60trxx_sim_stats_t;
+
+/**
+ * Structure holding the simulated sensor.
+ *
+ * Application code should not rely on the specific content of this struct.
+ * They are considered an implementation detail which is subject to change
+ * between platforms and/or library releases.
+ */
+typedef struct
+{
+    xensiv_bgt60trxx_sim_config_t cfg;
+    xensiv_bgt60trxx_sim_stats_t stats;
+    uint32_t regs[XENSIV_BGT60TRXX_SIM_NUM_REGS];
+    uint32_t fifo_addr;
+    uint32_t fstat_addr;
+    uint32_t fifo_size;       /* in words of two samples */
+    uint16_t fifo[2U * XENSIV_BGT60TRXX_SIM_FIFO_MAX_WORDS];
+    uint32_t fifo_rd;         /* in samples */
+    uint32_t fifo_fill;       /* in samples */
+    bool fof_err;
+    bool fuf_err;
+    bool running;
+    bool rst_level;
+    uint32_t reset_polls;
+    uint64_t ready_ns;
+    uint64_t frame_start_ns;
+    uint32_t frame_sample;
+    uint32_t frame_cnt;
+    uint16_t lfsr;
+    uint32_t noise;
+    /* SPI decoder state */
+    bool cs_active;
+    uint32_t cmd;             /* received bytes of the current command or burst word */
+    uint32_t cmd_len;
+    uint32_t rx_word;         /* word shifted out during the current command or burst word */
+    uint32_t burst_addr;
+    uint32_t burst_len;
+    bool burst;
+    bool burst_write;
+    bool locked;
+    /* asynchronous FIFO read waiting for completion */
+    void (* async_done)(void* arg, int32_t status);
+    void* async_arg;
+    int32_t async_status;
+} xensiv_bgt60trxx_sim_t;
+
+/******************************* Function prototypes *************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Initializes the simulated sensor in its power-on state.
+ *
+ * @param[out] sim Pointer to the simulated sensor object.
+ * @param[in] cfg Pointer to the simulation configuration.
+ */
+void xensiv_bgt60trxx_sim_init(xensiv_bgt60trxx_sim_t* sim,
+                               const xensiv_bgt60trxx_sim_config_t* cfg);
+
+/**
+ * @brief Advances the virtual time shared by all simulated sensors.
+ * Frames due in the elapsed time are generated on the next access to each sensor.
+ *
+ * @param[in] us Number of microseconds to advance.
+ */
+void xensiv_bgt60trxx_sim_advance(uint32_t us);
+
+/**
+ * @brief Obtains the level of the simulated IRQ pin.
+ * The pin is high while the FIFO filling level exceeds the compare reference set in SFCTL.
+ *
+ * @param[inout] sim Pointer to the simulated sensor object.
+ * @return true if the IRQ pin is high.
+ */
+bool xensiv_bgt60trxx_sim_irq(xensiv_bgt60trxx_sim_t* sim);
+
+/**
+ * @brief Completes the asynchronous FIFO read started on a sensor configured with
+ * async_deferred, invoking the completion function of the driver.
+ *
+ * @param[inout] sim Pointer to the simulated sensor object.
+ * @return true if a read was waiting for completion.
+ */
+bool xensiv_bgt60trxx_sim_complete_async(xensiv_bgt60trxx_sim_t* sim);
+
+/**
+ * @brief Obtains the virtual time shared by all simulated sensors.
+ *
+ * @return Virtual time in nanoseconds.
+ */
+uint64_t xensiv_bgt60trxx_sim_get_time(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** \} group_board_libs_sim */
+
+#endif // ifndef XENSIV_BGT60TRXX_SIM_H_
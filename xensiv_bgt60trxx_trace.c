@@ -0,0 +1,423 @@
+/***********************************************************************************************//**
+ * \file xensiv_bgt60trxx_trace.c
+ *
+ * \brief
+ * This file contains the implementation of the SPI transaction trace recorder
+ * for the XENSIV(TM) BGT60TRxx 60GHz FMCW radar sensors.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2022 Infineon Technologies AG
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#include <stddef.h>
+#include <string.h>
+
+#if defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L) && !defined(__STDC_NO_ATOMICS__)
+#include <stdatomic.h>
+#define XENSIV_BGT60TRXX_TRACE_C11_ATOMICS
+#endif
+
+#include "xensiv_bgt60trxx.h"
+#include "xensiv_bgt60trxx_trace.h"
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define XENSIV_BGT60TRXX_TRACE_HEADER_SIZE          (sizeof(xensiv_bgt60trxx_trace_record_t))
+#define XENSIV_BGT60TRXX_TRACE_LEN_MAX              (0xFFFFU)
+
+
+/*******************************************************************************
+* Local variables
+*******************************************************************************/
+/* Recorder the driver accesses are recorded into, NULL if not recording */
+static xensiv_bgt60trxx_trace_t* trace_active = NULL;
+
+
+/*******************************************************************************
+ * Function Prototypes
+ ********************************************************************************/
+static bool record_begin(xensiv_bgt60trxx_trace_t* trace, uint32_t len);
+
+static void record_put(xensiv_bgt60trxx_trace_t* trace, const void* data, uint32_t len);
+
+static void record_end(xensiv_bgt60trxx_trace_t* trace, xensiv_bgt60trxx_trace_type_t type,
+                       uint32_t arg);
+
+static void record(xensiv_bgt60trxx_trace_t* trace, xensiv_bgt60trxx_trace_type_t type,
+                   uint32_t arg, const void* data, uint32_t len);
+
+static void ring_write(xensiv_bgt60trxx_trace_t* trace, uint32_t pos, const void* data,
+                       uint32_t len);
+
+static inline void ring_fence(void);
+
+static inline uint32_t status_arg(int32_t status);
+
+#if defined(XENSIV_BGT60TRXX_PLATFORM_SPI_FIFO_READ_ASYNC)
+static void fifo_read_done(void* arg, int32_t status);
+#endif
+
+/*******************************************************************************
+ * Public interface implementation
+ ********************************************************************************/
+void xensiv_bgt60trxx_trace_init(xensiv_bgt60trxx_trace_t* trace, uint8_t* buf, uint32_t size)
+{
+    xensiv_bgt60trxx_platform_assert(trace != NULL);
+    xensiv_bgt60trxx_platform_assert(buf != NULL);
+    xensiv_bgt60trxx_platform_assert((size > 0U) && ((size & (size - 1U)) == 0U));
+
+    (void)memset(trace, 0, sizeof(*trace));
+    trace->buf = buf;
+    trace->size = size;
+}
+
+
+void xensiv_bgt60trxx_trace_start(xensiv_bgt60trxx_trace_t* trace)
+{
+    trace_active = trace;
+}
+
+
+uint32_t xensiv_bgt60trxx_trace_read(xensiv_bgt60trxx_trace_t* trace, uint8_t* dst,
+                                     uint32_t max_len)
+{
+    xensiv_bgt60trxx_platform_assert(trace != NULL);
+    xensiv_bgt60trxx_platform_assert((dst != NULL) || (max_len == 0U));
+
+    uint32_t tail = trace->tail;
+    uint32_t len = trace->head - tail;
+
+    /* the records are complete once head has been read */
+    ring_fence();
+
+    if (len > max_len)
+    {
+        len = max_len;
+    }
+
+    uint32_t pos = tail & (trace->size - 1U);
+    uint32_t first = trace->size - pos;
+    if (first > len)
+    {
+        first = len;
+    }
+
+    (void)memcpy(dst, &trace->buf[pos], first);
+    (void)memcpy(&dst[first], trace->buf, len - first);
+
+    /* the bytes are copied before the producer may overwrite them */
+    ring_fence();
+    trace->tail = tail + len;
+
+    return len;
+}
+
+
+uint32_t xensiv_bgt60trxx_trace_get_dropped(const xensiv_bgt60trxx_trace_t* trace)
+{
+    xensiv_bgt60trxx_platform_assert(trace != NULL);
+
+    return trace->num_dropped;
+}
+
+
+/*******************************************************************************
+ * Traced platform functions
+ ********************************************************************************/
+void xensiv_bgt60trxx_trace_rst_set(const void* iface, bool val)
+{
+    xensiv_bgt60trxx_platform_rst_set(iface, val);
+
+    record(trace_active, XENSIV_BGT60TRXX_TRACE_RST, val ? 1U : 0U, NULL, 0U);
+}
+
+
+void xensiv_bgt60trxx_trace_spi_cs_set(const void* iface, bool val)
+{
+    xensiv_bgt60trxx_platform_spi_cs_set(iface, val);
+
+    record(trace_active, XENSIV_BGT60TRXX_TRACE_CS, val ? 1U : 0U, NULL, 0U);
+}
+
+
+int32_t xensiv_bgt60trxx_trace_spi_transfer(void* iface,
+                                            uint8_t* tx_data,
+                                            uint8_t* rx_data,
+                                            uint32_t len)
+{
+    xensiv_bgt60trxx_trace_t* trace = trace_active;
+    uint32_t tx_len = (tx_data != NULL) ? len : 0U;
+    uint32_t rx_len = (rx_data != NULL) ? len : 0U;
+
+    /* TX is recorded before the transfer, RX may overwrite it in place */
+    bool recording = (trace != NULL) && record_begin(trace, tx_len + rx_len);
+    if (recording)
+    {
+        record_put(trace, tx_data, tx_len);
+    }
+
+    int32_t status = xensiv_bgt60trxx_platform_spi_transfer(iface, tx_data, rx_data, len);
+
+    if (recording)
+    {
+        uint32_t arg = status_arg(status);
+        arg |= (tx_data != NULL) ? XENSIV_BGT60TRXX_TRACE_ARG_TX_MSK : 0U;
+        arg |= (rx_data != NULL) ? XENSIV_BGT60TRXX_TRACE_ARG_RX_MSK : 0U;
+
+        record_put(trace, rx_data, rx_len);
+        record_end(trace, XENSIV_BGT60TRXX_TRACE_SPI_TRANSFER, arg);
+    }
+
+    return status;
+}
+
+
+int32_t xensiv_bgt60trxx_trace_spi_fifo_read(void* iface,
+                                             uint16_t* rx_data,
+                                             uint32_t len)
+{
+    int32_t status = xensiv_bgt60trxx_platform_spi_fifo_read(iface, rx_data, len);
+
+    record(trace_active, XENSIV_BGT60TRXX_TRACE_FIFO_READ, status_arg(status), rx_data,
+           len * sizeof(uint16_t));
+
+    return status;
+}
+
+
+#if defined(XENSIV_BGT60TRXX_PLATFORM_SPI_BURST_READ)
+int32_t xensiv_bgt60trxx_trace_spi_burst_read(void* iface,
+                                              uint8_t* tx_header,
+                                              uint8_t* rx_header,
+                                              uint16_t* rx_data,
+                                              uint32_t len)
+{
+    int32_t status = xensiv_bgt60trxx_platform_spi_burst_read(iface, tx_header, rx_header,
+                                                              rx_data, len);
+    xensiv_bgt60trxx_trace_t* trace = trace_active;
+
+    if ((trace != NULL) &&
+        record_begin(trace, (2U * XENSIV_BGT60TRXX_SPI_BURST_HEADER_SIZE_BYTES) +
+                     (len * (uint32_t)sizeof(uint16_t))))
+    {
+        record_put(trace, tx_header, XENSIV_BGT60TRXX_SPI_BURST_HEADER_SIZE_BYTES);
+        record_put(trace, rx_header, XENSIV_BGT60TRXX_SPI_BURST_HEADER_SIZE_BYTES);
+        record_put(trace, rx_data, len * sizeof(uint16_t));
+        record_end(trace, XENSIV_BGT60TRXX_TRACE_BURST_READ, status_arg(status));
+    }
+
+    return status;
+}
+
+
+#endif // defined(XENSIV_BGT60TRXX_PLATFORM_SPI_BURST_READ)
+#if defined(XENSIV_BGT60TRXX_PLATFORM_SPI_FIFO_READ_ASYNC)
+int32_t xensiv_bgt60trxx_trace_spi_fifo_read_async(void* iface,
+                                                   uint16_t* rx_data,
+                                                   uint32_t len,
+                                                   xensiv_bgt60trxx_platform_xfer_done_t done,
+                                                   void* arg)
+{
+    xensiv_bgt60trxx_trace_t* trace = trace_active;
+    int32_t status;
+
+    if (trace != NULL)
+    {
+        /* one asynchronous read at a time, the CS is asserted until it completes */
+        xensiv_bgt60trxx_platform_assert(trace->async_done == NULL);
+
+        trace->async_data = rx_data;
+        trace->async_len = len;
+        trace->async_done = done;
+        trace->async_arg = arg;
+
+        status = xensiv_bgt60trxx_platform_spi_fifo_read_async(iface, rx_data, len,
+                                                               fifo_read_done, trace);
+        if (XENSIV_BGT60TRXX_STATUS_OK != status)
+        {
+            trace->async_done = NULL;
+            record(trace, XENSIV_BGT60TRXX_TRACE_FIFO_READ_ASYNC, status_arg(status), NULL, 0U);
+        }
+    }
+    else
+    {
+        status = xensiv_bgt60trxx_platform_spi_fifo_read_async(iface, rx_data, len, done, arg);
+    }
+
+    return status;
+}
+
+
+#endif // defined(XENSIV_BGT60TRXX_PLATFORM_SPI_FIFO_READ_ASYNC)
+void xensiv_bgt60trxx_trace_delay(uint32_t ms)
+{
+    xensiv_bgt60trxx_platform_delay(ms);
+
+    record(trace_active, XENSIV_BGT60TRXX_TRACE_DELAY, 0U, &ms, sizeof(ms));
+}
+
+
+#if defined(XENSIV_BGT60TRXX_PLATFORM_DELAY_US)
+void xensiv_bgt60trxx_trace_delay_us(uint32_t us)
+{
+    xensiv_bgt60trxx_platform_delay_us(us);
+
+    record(trace_active, XENSIV_BGT60TRXX_TRACE_DELAY_US, 0U, &us, sizeof(us));
+}
+
+
+#endif // defined(XENSIV_BGT60TRXX_PLATFORM_DELAY_US)
+
+/*******************************************************************************
+ * Static functions implementation
+ ********************************************************************************/
+/* Reserves a record with len bytes of payload, preceded by a LOST record if records were
+   dropped before. The record is dropped if it does not fit into the free space. */
+static bool record_begin(xensiv_bgt60trxx_trace_t* trace, uint32_t len)
+{
+    uint32_t need = XENSIV_BGT60TRXX_TRACE_HEADER_SIZE + len;
+    if (trace->num_lost > 0U)
+    {
+        need += XENSIV_BGT60TRXX_TRACE_HEADER_SIZE + sizeof(uint32_t);
+    }
+
+    uint32_t head = trace->head;
+    bool fits = (len <= XENSIV_BGT60TRXX_TRACE_LEN_MAX) &&
+                (need <= (trace->size - (head - trace->tail)));
+
+    if (fits)
+    {
+        trace->rec = head;
+        trace->wr = head + XENSIV_BGT60TRXX_TRACE_HEADER_SIZE;
+
+        if (trace->num_lost > 0U)
+        {
+            uint32_t num_lost = trace->num_lost;
+            trace->num_lost = 0U;
+            record_put(trace, &num_lost, sizeof(num_lost));
+            record_end(trace, XENSIV_BGT60TRXX_TRACE_LOST, 0U);
+
+            trace->rec = trace->wr;
+            trace->wr += XENSIV_BGT60TRXX_TRACE_HEADER_SIZE;
+        }
+    }
+    else
+    {
+        ++trace->num_lost;
+        ++trace->num_dropped;
+    }
+
+    return fits;
+}
+
+
+static void record_put(xensiv_bgt60trxx_trace_t* trace, const void* data, uint32_t len)
+{
+    ring_write(trace, trace->wr, data, len);
+    trace->wr += len;
+}
+
+
+/* Writes the header of the record and publishes it to the consumer */
+static void record_end(xensiv_bgt60trxx_trace_t* trace, xensiv_bgt60trxx_trace_type_t type,
+                       uint32_t arg)
+{
+    xensiv_bgt60trxx_trace_record_t header;
+
+    header.type = (uint8_t)type;
+    header.arg = (uint8_t)arg;
+    header.len = (uint16_t)(trace->wr - trace->rec - XENSIV_BGT60TRXX_TRACE_HEADER_SIZE);
+#if defined(XENSIV_BGT60TRXX_PLATFORM_GET_TIME)
+    header.time_us = xensiv_bgt60trxx_platform_get_time_us();
+#else
+    header.time_us = 0U;
+#endif
+
+    ring_write(trace, trace->rec, &header, sizeof(header));
+
+    /* the record is written before it is published */
+    ring_fence();
+    trace->head = trace->wr;
+}
+
+
+static void record(xensiv_bgt60trxx_trace_t* trace, xensiv_bgt60trxx_trace_type_t type,
+                   uint32_t arg, const void* data, uint32_t len)
+{
+    if ((trace != NULL) && record_begin(trace, len))
+    {
+        record_put(trace, data, len);
+        record_end(trace, type, arg);
+    }
+}
+
+
+static void ring_write(xensiv_bgt60trxx_trace_t* trace, uint32_t pos, const void* data,
+                       uint32_t len)
+{
+    const uint8_t* src = data;
+    uint32_t offset = pos & (trace->size - 1U);
+    uint32_t first = trace->size - offset;
+    if (first > len)
+    {
+        first = len;
+    }
+
+    if (len > 0U)
+    {
+        (void)memcpy(&trace->buf[offset], src, first);
+        (void)memcpy(trace->buf, &src[first], len - first);
+    }
+}
+
+
+/* Orders the accesses to the ring buffer and to its indices. Without C11 atomics or GCC
+   builtins, the volatile indices only order the accesses on single core CPUs. */
+static inline void ring_fence(void)
+{
+#if defined(XENSIV_BGT60TRXX_TRACE_C11_ATOMICS)
+    atomic_thread_fence(memory_order_seq_cst);
+#elif defined(__GNUC__)
+    __sync_synchronize();
+#endif
+}
+
+
+static inline uint32_t status_arg(int32_t status)
+{
+    return (uint32_t)status & XENSIV_BGT60TRXX_TRACE_ARG_STATUS_MSK;
+}
+
+
+#if defined(XENSIV_BGT60TRXX_PLATFORM_SPI_FIFO_READ_ASYNC)
+static void fifo_read_done(void* arg, int32_t status)
+{
+    xensiv_bgt60trxx_trace_t* trace = arg;
+    xensiv_bgt60trxx_platform_xfer_done_t done = trace->async_done;
+
+    trace->async_done = NULL;
+    record(trace, XENSIV_BGT60TRXX_TRACE_FIFO_READ_ASYNC,
+           status_arg(status) | XENSIV_BGT60TRXX_TRACE_ARG_STARTED_MSK,
+           trace->async_data,
+           (XENSIV_BGT60TRXX_STATUS_OK == status) ? (trace->async_len * sizeof(uint16_t)) : 0U);
+
+    done(trace->async_arg, status);
+}
+
+
+#endif // defined(XENSIV_BGT60TRXX_PLATFORM_SPI_FIFO_READ_ASYNC)
@@ -0,0 +1,222 @@
+/***********************************************************************************************//**
+ * \file xensiv_bgt60trxx_trace.h
+ *
+ * \brief
+ * This file contains the declarations of the SPI transaction trace recorder
+ * for the XENSIV(TM) BGT60TRxx 60GHz FMCW radar sensors.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2022 Infineon Technologies AG
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#ifndef XENSIV_BGT60TRXX_TRACE_H_
+#define XENSIV_BGT60TRXX_TRACE_H_
+
+#include "xensiv_bgt60trxx_platform.h"
+
+/**
+ * \addtogroup group_board_libs_trace XENSIV(TM) BGT60TRxx SPI Trace
+ * \{
+ * Records the bus accesses of the driver into a binary log, which can be fed back through the
+ * driver with the replay platform (see \ref group_board_libs_replay).
+ *
+ * If XENSIV_BGT60TRXX_TRACE is defined when compiling xensiv_bgt60trxx.c, the driver calls the
+ * xensiv_bgt60trxx_trace_* functions below instead of the platform functions of the same name.
+ * They call the platform function and, while a recorder is started with
+ * \ref xensiv_bgt60trxx_trace_start, append a record with the data sent and received to its
+ * ring buffer. Without a started recorder they only add a pointer check to each platform call.
+ *
+ * The log is a sequence of records, each a \ref xensiv_bgt60trxx_trace_record_t header in the
+ * byte order of the recording CPU followed by len bytes of payload (types without the
+ * XENSIV_BGT60TRXX_TRACE_ prefix):
+ * | type                | arg               | payload                                        |
+ * |---------------------|-------------------|------------------------------------------------|
+ * | SPI_TRANSFER        | status, TX/RX     | TX bytes if any, then RX bytes if any          |
+ * | FIFO_READ           | status            | samples (uint16_t)                             |
+ * | BURST_READ          | status            | TX header (4 bytes), RX header (4), samples    |
+ * | FIFO_READ_ASYNC     | status, started   | samples if started and completed successfully  |
+ * | CS, RST             | pin level         | -                                              |
+ * | DELAY, DELAY_US     | -                 | milliseconds or microseconds (uint32_t)        |
+ * | LOST                | -                 | number of records dropped (uint32_t)           |
+ * The time stamp is taken when the access completes, using
+ * xensiv_bgt60trxx_platform_get_time_us if XENSIV_BGT60TRXX_PLATFORM_GET_TIME is defined,
+ * otherwise it is zero. An asynchronous FIFO read is recorded when it completes.
+ *
+ * The ring buffer is lock-free with a single producer and a single consumer: the driver appends
+ * records while another context, e.g. a low priority thread or the main loop, drains them with
+ * \ref xensiv_bgt60trxx_trace_read to a file, UART or a larger buffer. A record that does not fit
+ * into the free space is dropped and counted; the next record that fits is preceded by a
+ * \ref XENSIV_BGT60TRXX_TRACE_LOST record. The driver must not access the bus from two contexts
+ * at the same time while recording, e.g. trace a single sensor or the sensors of one
+ * \ref xensiv_bgt60trxx_multi_t. The largest record, a FIFO read of num_samples, takes
+ * 16 + 2 * num_samples bytes.
+ */
+
+/************************************** Macros *******************************************/
+
+/** Mask of the status in the arg of a record */
+#define XENSIV_BGT60TRXX_TRACE_ARG_STATUS_MSK           (0x0FU)
+
+/** Flag of the arg of \ref XENSIV_BGT60TRXX_TRACE_SPI_TRANSFER: TX bytes in the payload */
+#define XENSIV_BGT60TRXX_TRACE_ARG_TX_MSK               (0x10U)
+
+/** Flag of the arg of \ref XENSIV_BGT60TRXX_TRACE_SPI_TRANSFER: RX bytes in the payload */
+#define XENSIV_BGT60TRXX_TRACE_ARG_RX_MSK               (0x20U)
+
+/** Flag of the arg of \ref XENSIV_BGT60TRXX_TRACE_FIFO_READ_ASYNC: the read was started */
+#define XENSIV_BGT60TRXX_TRACE_ARG_STARTED_MSK          (0x10U)
+
+/******************************** Type definitions ****************************************/
+
+/** Type of a trace record */
+typedef enum
+{
+    XENSIV_BGT60TRXX_TRACE_SPI_TRANSFER = 1,    /**< Platform function spi_transfer */
+    XENSIV_BGT60TRXX_TRACE_FIFO_READ = 2,       /**< Platform function spi_fifo_read */
+    XENSIV_BGT60TRXX_TRACE_BURST_READ = 3,      /**< Platform function spi_burst_read */
+    XENSIV_BGT60TRXX_TRACE_FIFO_READ_ASYNC = 4, /**< Platform function spi_fifo_read_async */
+    XENSIV_BGT60TRXX_TRACE_CS = 5,              /**< Platform function spi_cs_set */
+    XENSIV_BGT60TRXX_TRACE_RST = 6,             /**< Platform function rst_set */
+    XENSIV_BGT60TRXX_TRACE_DELAY = 7,           /**< Platform function delay */
+    XENSIV_BGT60TRXX_TRACE_DELAY_US = 8,        /**< Platform function delay_us */
+    XENSIV_BGT60TRXX_TRACE_LOST = 9             /**< Records dropped before this one */
+} xensiv_bgt60trxx_trace_type_t;
+
+/** Header of a trace record, followed by len bytes of payload */
+typedef struct
+{
+    uint8_t type;       /**< \ref xensiv_bgt60trxx_trace_type_t */
+    uint8_t arg;        /**< Status and flags, or the pin level */
+    uint16_t len;       /**< Payload size in bytes */
+    uint32_t time_us;   /**< Time stamp */
+} xensiv_bgt60trxx_trace_record_t;
+
+/**
+ * Structure holding the trace recorder.
+ *
+ * Application code should not rely on the specific content of this struct.
+ * They are considered an implementation detail which is subject to change
+ * between platforms and/or library releases.
+ */
+typedef struct
+{
+    uint8_t* buf;
+    uint32_t size;                  /* power of two */
+    volatile uint32_t head;         /* written by the producer, free running */
+    volatile uint32_t tail;         /* written by the consumer, free running */
+    uint32_t rec;                   /* position of the header of the record being built */
+    uint32_t wr;                    /* write position of its payload */
+    uint32_t num_lost;              /* records dropped since the last LOST record */
+    volatile uint32_t num_dropped;  /* records dropped since the start */
+    uint16_t* async_data;           /* asynchronous FIFO read in progress */
+    uint32_t async_len;
+    xensiv_bgt60trxx_platform_xfer_done_t async_done;
+    void* async_arg;
+} xensiv_bgt60trxx_trace_t;
+
+/******************************* Function prototypes *************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Initializes the trace recorder with an empty ring buffer.
+ *
+ * @param[out] trace Pointer to the trace recorder object.
+ * @param[in] buf Pointer to the ring buffer, allocated by the caller.
+ * @param[in] size Size of the ring buffer in bytes, a power of two.
+ */
+void xensiv_bgt60trxx_trace_init(xensiv_bgt60trxx_trace_t* trace, uint8_t* buf, uint32_t size);
+
+/**
+ * @brief Starts recording the bus accesses of the driver into the trace recorder, or stops
+ * recording.
+ * @note Call while the driver does not access the bus.
+ *
+ * @param[in] trace Pointer to the initialized trace recorder object, NULL to stop recording.
+ */
+void xensiv_bgt60trxx_trace_start(xensiv_bgt60trxx_trace_t* trace);
+
+/**
+ * @brief Removes recorded bytes from the ring buffer.
+ * The log is the concatenation of the bytes read, records may be split between calls.
+ * May be called from another context than the driver, concurrently with recording.
+ *
+ * @param[inout] trace Pointer to the trace recorder object.
+ * @param[out] dst Pointer to the buffer receiving the bytes.
+ * @param[in] max_len Size of the buffer.
+ * @return Number of bytes written to \p dst.
+ */
+uint32_t xensiv_bgt60trxx_trace_read(xensiv_bgt60trxx_trace_t* trace, uint8_t* dst,
+                                     uint32_t max_len);
+
+/**
+ * @brief Obtains the number of records dropped because the ring buffer was full.
+ *
+ * @param[in] trace Pointer to the trace recorder object.
+ * @return Number of records dropped since \ref xensiv_bgt60trxx_trace_init.
+ */
+uint32_t xensiv_bgt60trxx_trace_get_dropped(const xensiv_bgt60trxx_trace_t* trace);
+
+/**
+ * @brief Records and performs \ref xensiv_bgt60trxx_platform_rst_set.
+ * Called by the driver if XENSIV_BGT60TRXX_TRACE is defined, same for the functions below.
+ */
+void xensiv_bgt60trxx_trace_rst_set(const void* iface, bool val);
+
+/** @brief Records and performs \ref xensiv_bgt60trxx_platform_spi_cs_set. */
+void xensiv_bgt60trxx_trace_spi_cs_set(const void* iface, bool val);
+
+/** @brief Records and performs \ref xensiv_bgt60trxx_platform_spi_transfer. */
+int32_t xensiv_bgt60trxx_trace_spi_transfer(void* iface,
+                                            uint8_t* tx_data,
+                                            uint8_t* rx_data,
+                                            uint32_t len);
+
+/** @brief Records and performs \ref xensiv_bgt60trxx_platform_spi_fifo_read. */
+int32_t xensiv_bgt60trxx_trace_spi_fifo_read(void* iface,
+                                             uint16_t* rx_data,
+                                             uint32_t len);
+
+/** @brief Records and performs \ref xensiv_bgt60trxx_platform_spi_burst_read. */
+int32_t xensiv_bgt60trxx_trace_spi_burst_read(void* iface,
+                                              uint8_t* tx_header,
+                                              uint8_t* rx_header,
+                                              uint16_t* rx_data,
+                                              uint32_t len);
+
+/** @brief Records and performs \ref xensiv_bgt60trxx_platform_spi_fifo_read_async. */
+int32_t xensiv_bgt60trxx_trace_spi_fifo_read_async(void* iface,
+                                                   uint16_t* rx_data,
+                                                   uint32_t len,
+                                                   xensiv_bgt60trxx_platform_xfer_done_t done,
+                                                   void* arg);
+
+/** @brief Records and performs \ref xensiv_bgt60trxx_platform_delay. */
+void xensiv_bgt60trxx_trace_delay(uint32_t ms);
+
+/** @brief Records and performs \ref xensiv_bgt60trxx_platform_delay_us. */
+void xensiv_bgt60trxx_trace_delay_us(uint32_t us);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** \} group_board_libs_trace */
+
+#endif // ifndef XENSIV_BGT60TRXX_TRACE_H_
@@ -0,0 +1,259 @@
+/***********************************************************************************************//**
+ * \file xensiv_bgt60trxx_unpack.c
+ *
+ * \brief
+ * This file contains the implementation of the FIFO data unpacking function
+ * for the XENSIV(TM) BGT60TRxx 60GHz FMCW radar sensors.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2022 Infineon Technologies AG
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#include <stddef.h>
+
+#include "xensiv_bgt60trxx.h"
+#include "xensiv_bgt60trxx_unpack.h"
+#include "xensiv_bgt60trxx_platform.h"
+
+#if !defined(XENSIV_BGT60TRXX_UNPACK_PORTABLE)
+#if defined(__AVX2__)
+#define XENSIV_BGT60TRXX_UNPACK_AVX2
+#include <immintrin.h>
+#elif defined(__SSSE3__)
+#define XENSIV_BGT60TRXX_UNPACK_SSSE3
+#include <tmmintrin.h>
+#elif (defined(__ARM_NEON) || defined(__ARM_NEON__)) && defined(XENSIV_BGT60TRXX_ENABLE_NEON)
+#define XENSIV_BGT60TRXX_UNPACK_NEON
+#include <arm_neon.h>
+#endif
+#endif // !defined(XENSIV_BGT60TRXX_UNPACK_PORTABLE)
+
+/*******************************************************************************
+* Macros
+*******************************************************************************/
+#define XENSIV_BGT60TRXX_SAMPLE_MSK                 (0x0FFFU)
+
+/* Bytes read by one iteration of the x86 kernels: 4 (SSSE3) or 8 (AVX2) FIFO words,
+ * plus the unused tail of the last 16-byte load */
+#define XENSIV_BGT60TRXX_UNPACK_SSSE3_WORDS         (4U)
+#define XENSIV_BGT60TRXX_UNPACK_SSSE3_LOAD_BYTES    (16U)
+#define XENSIV_BGT60TRXX_UNPACK_AVX2_WORDS          (8U)
+#define XENSIV_BGT60TRXX_UNPACK_AVX2_LOAD_BYTES     (28U)
+#define XENSIV_BGT60TRXX_UNPACK_NEON_WORDS          (8U)
+
+
+/*******************************************************************************
+ * Function Prototypes
+ ********************************************************************************/
+static void unpack_words(const uint8_t* src, uint16_t* dst, uint32_t num_words);
+static void pack_words(const uint16_t* src, uint8_t* dst, uint32_t num_words);
+
+#if defined(XENSIV_BGT60TRXX_UNPACK_AVX2) || defined(XENSIV_BGT60TRXX_UNPACK_SSSE3)
+static inline __m128i unpack_shuffle_mask(void);
+
+static inline __m128i unpack_fix(__m128i v);
+
+static inline __m128i pack_shuffle_mask(void);
+#endif
+
+/*******************************************************************************
+ * Public interface implementation
+ ********************************************************************************/
+void xensiv_bgt60trxx_unpack_samples(const uint8_t* src, uint16_t* dst, uint32_t num_samples)
+{
+    xensiv_bgt60trxx_platform_assert(src != NULL);
+    xensiv_bgt60trxx_platform_assert(dst != NULL);
+    xensiv_bgt60trxx_platform_assert((num_samples % XENSIV_BGT60TRXX_NUM_SAMPLES_FIFO_WORD) == 0U);
+
+    uint32_t num_words = num_samples / XENSIV_BGT60TRXX_NUM_SAMPLES_FIFO_WORD;
+
+#if defined(XENSIV_BGT60TRXX_UNPACK_AVX2)
+    const __m128i mask128 = unpack_shuffle_mask();
+    const __m256i mask = _mm256_inserti128_si256(_mm256_castsi128_si256(mask128), mask128, 1);
+    const __m256i hi_lanes = _mm256_set1_epi32(0x0FFF0000);
+    const __m256i lo_lanes = _mm256_set1_epi32(0x0000FFFF);
+
+    while ((num_words * XENSIV_BGT60TRXX_FIFO_WORD_SIZE_BYTES) >=
+           XENSIV_BGT60TRXX_UNPACK_AVX2_LOAD_BYTES)
+    {
+        /* 4 FIFO words per 128-bit lane, the shuffle does not cross lanes */
+        __m256i v = _mm256_inserti128_si256(
+            _mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)src)),
+            _mm_loadu_si128((const __m128i*)(src + 12U)), 1);
+        v = _mm256_shuffle_epi8(v, mask);
+        v = _mm256_or_si256(_mm256_and_si256(_mm256_srli_epi16(v, 4), lo_lanes),
+                            _mm256_and_si256(v, hi_lanes));
+        _mm256_storeu_si256((__m256i*)dst, v);
+
+        src += XENSIV_BGT60TRXX_UNPACK_AVX2_WORDS * XENSIV_BGT60TRXX_FIFO_WORD_SIZE_BYTES;
+        dst += XENSIV_BGT60TRXX_UNPACK_AVX2_WORDS * XENSIV_BGT60TRXX_NUM_SAMPLES_FIFO_WORD;
+        num_words -= XENSIV_BGT60TRXX_UNPACK_AVX2_WORDS;
+    }
+#endif // defined(XENSIV_BGT60TRXX_UNPACK_AVX2)
+
+#if defined(XENSIV_BGT60TRXX_UNPACK_AVX2) || defined(XENSIV_BGT60TRXX_UNPACK_SSSE3)
+    const __m128i mask_sse = unpack_shuffle_mask();
+
+    while ((num_words * XENSIV_BGT60TRXX_FIFO_WORD_SIZE_BYTES) >=
+           XENSIV_BGT60TRXX_UNPACK_SSSE3_LOAD_BYTES)
+    {
+        __m128i v = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)src), mask_sse);
+        _mm_storeu_si128((__m128i*)dst, unpack_fix(v));
+
+        src += XENSIV_BGT60TRXX_UNPACK_SSSE3_WORDS * XENSIV_BGT60TRXX_FIFO_WORD_SIZE_BYTES;
+        dst += XENSIV_BGT60TRXX_UNPACK_SSSE3_WORDS * XENSIV_BGT60TRXX_NUM_SAMPLES_FIFO_WORD;
+        num_words -= XENSIV_BGT60TRXX_UNPACK_SSSE3_WORDS;
+    }
+#endif
+
+#if defined(XENSIV_BGT60TRXX_UNPACK_NEON)
+    const uint8x8_t lo_nibble = vdup_n_u8(0x0FU);
+
+    while (num_words >= XENSIV_BGT60TRXX_UNPACK_NEON_WORDS)
+    {
+        /* de-interleave the three bytes of 8 FIFO words */
+        uint8x8x3_t b = vld3_u8(src);
+        uint16x8x2_t s;
+        s.val[0] = vorrq_u16(vshll_n_u8(b.val[0], 4), vmovl_u8(vshr_n_u8(b.val[1], 4)));
+        s.val[1] = vorrq_u16(vshll_n_u8(vand_u8(b.val[1], lo_nibble), 8), vmovl_u8(b.val[2]));
+        vst2q_u16(dst, s);
+
+        src += XENSIV_BGT60TRXX_UNPACK_NEON_WORDS * XENSIV_BGT60TRXX_FIFO_WORD_SIZE_BYTES;
+        dst += XENSIV_BGT60TRXX_UNPACK_NEON_WORDS * XENSIV_BGT60TRXX_NUM_SAMPLES_FIFO_WORD;
+        num_words -= XENSIV_BGT60TRXX_UNPACK_NEON_WORDS;
+    }
+#endif // defined(XENSIV_BGT60TRXX_UNPACK_NEON)
+
+    unpack_words(src, dst, num_words);
+}
+
+
+void xensiv_bgt60trxx_pack_samples(const uint16_t* src, uint8_t* dst, uint32_t num_samples)
+{
+    xensiv_bgt60trxx_platform_assert(src != NULL);
+    xensiv_bgt60trxx_platform_assert(dst != NULL);
+    xensiv_bgt60trxx_platform_assert((num_samples % XENSIV_BGT60TRXX_NUM_SAMPLES_FIFO_WORD) == 0U);
+
+    uint32_t num_words = num_samples / XENSIV_BGT60TRXX_NUM_SAMPLES_FIFO_WORD;
+
+#if defined(XENSIV_BGT60TRXX_UNPACK_AVX2) || defined(XENSIV_BGT60TRXX_UNPACK_SSSE3)
+    const __m128i mask = pack_shuffle_mask();
+    const __m128i sample_msk = _mm_set1_epi32(XENSIV_BGT60TRXX_SAMPLE_MSK);
+
+    /* each iteration stores 16 bytes of which the last 4 are overwritten by the next one */
+    while ((num_words * XENSIV_BGT60TRXX_FIFO_WORD_SIZE_BYTES) >=
+           XENSIV_BGT60TRXX_UNPACK_SSSE3_LOAD_BYTES)
+    {
+        /* the two samples of a FIFO word as one 24-bit value per 32-bit lane */
+        __m128i v = _mm_loadu_si128((const __m128i*)src);
+        v = _mm_or_si128(_mm_slli_epi32(_mm_and_si128(v, sample_msk), 12),
+                         _mm_and_si128(_mm_srli_epi32(v, 16), sample_msk));
+        _mm_storeu_si128((__m128i*)dst, _mm_shuffle_epi8(v, mask));
+
+        src += XENSIV_BGT60TRXX_UNPACK_SSSE3_WORDS * XENSIV_BGT60TRXX_NUM_SAMPLES_FIFO_WORD;
+        dst += XENSIV_BGT60TRXX_UNPACK_SSSE3_WORDS * XENSIV_BGT60TRXX_FIFO_WORD_SIZE_BYTES;
+        num_words -= XENSIV_BGT60TRXX_UNPACK_SSSE3_WORDS;
+    }
+#endif
+
+#if defined(XENSIV_BGT60TRXX_UNPACK_NEON)
+    const uint16x8_t lo_nibble = vdupq_n_u16(0x0FU);
+
+    while (num_words >= XENSIV_BGT60TRXX_UNPACK_NEON_WORDS)
+    {
+        /* de-interleave the first and second samples of 8 FIFO words */
+        uint16x8x2_t s = vld2q_u16(src);
+        uint8x8x3_t b;
+        b.val[0] = vshrn_n_u16(s.val[0], 4);
+        b.val[1] = vmovn_u16(vorrq_u16(vshlq_n_u16(s.val[0], 4),
+                                       vandq_u16(vshrq_n_u16(s.val[1], 8), lo_nibble)));
+        b.val[2] = vmovn_u16(s.val[1]);
+        vst3_u8(dst, b);
+
+        src += XENSIV_BGT60TRXX_UNPACK_NEON_WORDS * XENSIV_BGT60TRXX_NUM_SAMPLES_FIFO_WORD;
+        dst += XENSIV_BGT60TRXX_UNPACK_NEON_WORDS * XENSIV_BGT60TRXX_FIFO_WORD_SIZE_BYTES;
+        num_words -= XENSIV_BGT60TRXX_UNPACK_NEON_WORDS;
+    }
+#endif // defined(XENSIV_BGT60TRXX_UNPACK_NEON)
+
+    pack_words(src, dst, num_words);
+}
+
+
+/*******************************************************************************
+ * Static functions implementation
+ ********************************************************************************/
+static void unpack_words(const uint8_t* src, uint16_t* dst, uint32_t num_words)
+{
+    for (uint32_t i = 0U; i < num_words; ++i)
+    {
+        /* all bytes are read before the samples are stored to allow unpacking in place */
+        uint32_t b0 = src[0];
+        uint32_t b1 = src[1];
+        uint32_t b2 = src[2];
+
+        dst[0] = (uint16_t)((b0 << 4) | (b1 >> 4));
+        dst[1] = (uint16_t)(((b1 << 8) | b2) & XENSIV_BGT60TRXX_SAMPLE_MSK);
+
+        src += XENSIV_BGT60TRXX_FIFO_WORD_SIZE_BYTES;
+        dst += XENSIV_BGT60TRXX_NUM_SAMPLES_FIFO_WORD;
+    }
+}
+
+
+static void pack_words(const uint16_t* src, uint8_t* dst, uint32_t num_words)
+{
+    for (uint32_t i = 0U; i < num_words; ++i)
+    {
+        uint32_t s0 = src[0] & XENSIV_BGT60TRXX_SAMPLE_MSK;
+        uint32_t s1 = src[1] & XENSIV_BGT60TRXX_SAMPLE_MSK;
+
+        dst[0] = (uint8_t)(s0 >> 4);
+        dst[1] = (uint8_t)((s0 << 4) | (s1 >> 8));
+        dst[2] = (uint8_t)s1;
+
+        src += XENSIV_BGT60TRXX_NUM_SAMPLES_FIFO_WORD;
+        dst += XENSIV_BGT60TRXX_FIFO_WORD_SIZE_BYTES;
+    }
+}
+
+
+#if defined(XENSIV_BGT60TRXX_UNPACK_AVX2) || defined(XENSIV_BGT60TRXX_UNPACK_SSSE3)
+/* Builds a big endian 16-bit lane for each sample: bytes (b1, b0) for the first sample of a
+ * FIFO word and (b2, b1) for the second one */
+static inline __m128i unpack_shuffle_mask(void)
+{
+    return _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+}
+
+
+/* First samples are in the upper 12 bits of their lane, second samples in the lower 12 bits */
+static inline __m128i unpack_fix(__m128i v)
+{
+    return _mm_or_si128(_mm_and_si128(_mm_srli_epi16(v, 4), _mm_set1_epi32(0x0000FFFF)),
+                        _mm_and_si128(v, _mm_set1_epi32(0x0FFF0000)));
+}
+
+
+/* Stores the 24-bit value of each 32-bit lane big endian, 12 bytes in total */
+static inline __m128i pack_shuffle_mask(void)
+{
+    return _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+}
+
+
+#endif // defined(XENSIV_BGT60TRXX_UNPACK_AVX2) || defined(XENSIV_BGT60TRXX_UNPACK_SSSE3)
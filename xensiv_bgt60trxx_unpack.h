@@ -0,0 +1,82 @@
+/***********************************************************************************************//**
+ * \file xensiv_bgt60trxx_unpack.h
+ *
+ * \brief
+ * This file contains the declaration of the FIFO data unpacking function
+ * for the XENSIV(TM) BGT60TRxx 60GHz FMCW radar sensors.
+ *
+ ***************************************************************************************************
+ * \copyright
+ * Copyright 2022 Infineon Technologies AG
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ **************************************************************************************************/
+
+#ifndef XENSIV_BGT60TRXX_UNPACK_H_
+#define XENSIV_BGT60TRXX_UNPACK_H_
+
+#include <stdint.h>
+
+/**
+ * \addtogroup group_board_libs_unpack XENSIV(TM) BGT60TRxx FIFO Data Unpacking
+ * \{
+ * Converts the packed FIFO data read using 8-bit SPI words (see
+ * \ref xensiv_bgt60trxx_get_fifo_data_raw) into 12-bit samples, and 12-bit samples back into
+ * the packed format, e.g. to store frames without the four unused bits of each sample.
+ *
+ * A FIFO word of \ref XENSIV_BGT60TRXX_FIFO_WORD_SIZE_BYTES bytes holds two samples, most
+ * significant bit first: the first sample is made of the first byte and the upper nibble of the
+ * second byte, the second sample of the lower nibble of the second byte and the third byte.
+ *
+ * The implementation is selected at compile time: AVX2 (__AVX2__) or SSSE3 (__SSSE3__) if the
+ * compiler targets these instruction sets, portable C otherwise. Define
+ * XENSIV_BGT60TRXX_UNPACK_PORTABLE to force the portable implementation. The NEON kernels
+ * (__ARM_NEON) have not been verified on hardware yet and are used only if
+ * XENSIV_BGT60TRXX_ENABLE_NEON is defined.
+ */
+
+/******************************* Function prototypes *************************************/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Unpacks FIFO words into 12-bit samples.
+ * \p src may lie inside the destination buffer at an offset of at least \p num_samples / 2
+ * bytes from \p dst, which allows unpacking in place from the end of the sample buffer.
+ *
+ * @param[in] src Pointer to the packed FIFO data, \p num_samples * 3 / 2 bytes.
+ * @param[out] dst Pointer to the sample buffer.
+ * @param[in] num_samples Number of samples, must be even.
+ */
+void xensiv_bgt60trxx_unpack_samples(const uint8_t* src, uint16_t* dst, uint32_t num_samples);
+
+/**
+ * @brief Packs 12-bit samples into FIFO words.
+ * The upper four bits of the samples are ignored.
+ *
+ * @param[in] src Pointer to the sample buffer.
+ * @param[out] dst Pointer to the packed data, \p num_samples * 3 / 2 bytes.
+ * @param[in] num_samples Number of samples, must be even.
+ */
+void xensiv_bgt60trxx_pack_samples(const uint16_t* src, uint8_t* dst, uint32_t num_samples);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** \} group_board_libs_unpack */
+
+#endif // ifndef XENSIV_BGT60TRXX_UNPACK_H_